@@ -0,0 +1,59 @@
+/**
+ * @file HeadlessSupport.hpp
+ * @brief Small helpers shared by the headless tools (CLI and daemon).
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <thread>
+
+#include "application/AsyncTaskManager.hpp"
+
+namespace ideawalker::app {
+
+/** @brief Parses a non-negative decimal count; rejects signs, suffixes and overflow. */
+inline bool ParseCount(const std::string& text, std::size_t& value) {
+    if (text.empty() || text.front() < '0' || text.front() > '9') return false;
+    try {
+        std::size_t used = 0;
+        const unsigned long parsed = std::stoul(text, &used);
+        if (used != text.size()) return false;
+        value = static_cast<std::size_t>(parsed);
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+/** @brief Stable short name of a task type, as printed in NDJSON events and /v1/tasks. */
+inline const char* TaskTypeName(application::TaskType type) {
+    switch (type) {
+        case application::TaskType::AI_Processing: return "ai";
+        case application::TaskType::Indexing: return "indexing";
+        case application::TaskType::Transcription: return "transcription";
+        case application::TaskType::Export: return "export";
+        case application::TaskType::UpdateCheck: return "update";
+        case application::TaskType::Layout: return "layout";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Blocks until no background task is left.
+ *
+ * Detached tasks hold pointers into the services, so hosts call this before tearing
+ * them down. @p onPoll runs between checks (e.g. to report progress).
+ */
+inline void WaitForBackgroundTasks(application::AsyncTaskManager& taskManager,
+                                   const std::function<void()>& onPoll = nullptr) {
+    while (!taskManager.GetActiveTasks().empty()) {
+        if (onPoll) onPoll();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+}
+
+} // namespace ideawalker::app
@@ -3,6 +3,7 @@
  * @brief Implementation of the IdeaWalkerApp class.
  */
 #include "app/IdeaWalkerApp.hpp"
+#include "app/ServiceComposition.hpp"
 
 #include "ui/UiRenderer.hpp"
 
@@ -20,15 +21,9 @@
 #include <string>
 #include <vector>
 #include "infrastructure/ConfigLoader.hpp"
-#include "infrastructure/FileRepository.hpp"
-#include "infrastructure/OllamaAdapter.hpp"
+#include "infrastructure/FrameProfiler.hpp"
 #include "infrastructure/WhisperCppAdapter.hpp"
 #include "infrastructure/PathUtils.hpp"
-#include "infrastructure/PersistenceService.hpp"
-#include "infrastructure/FileSystemArtifactScanner.hpp"
-#include "infrastructure/writing/WritingEventStoreFs.hpp"
-#include "infrastructure/writing/WritingTrajectoryRepositoryFs.hpp"
-#include "application/AppServices.hpp"
 
 namespace ideawalker::app {
 
@@ -122,26 +117,7 @@ bool LoadFonts(ImGuiIO& io) {
     return emojiLoaded;
 }
 
-application::AppServices BuildServicesForRoot(const std::filesystem::path& root) {
-    auto repo = std::make_unique<infrastructure::FileRepository>(
-        (root / "inbox").string(),
-        (root / "notas").string(),
-        (root / ".history").string(),
-        (root / "observations").string()
-    );
-    auto sharedAi = std::make_shared<infrastructure::OllamaAdapter>();
-    
-    auto savedModel = infrastructure::ConfigLoader::GetAIModelPreference(root.string());
-    if (savedModel) {
-        std::cout << "[IdeaWalkerApp] Loading saved model preference: " << *savedModel << std::endl;
-        sharedAi->setModel(*savedModel);
-        // Skipping replacement for now, need to find usage first.
-    }
-
-    sharedAi->initialize();
-
-    auto taskManager = std::make_shared<application::AsyncTaskManager>();
-
+std::unique_ptr<domain::TranscriptionService> MakeTranscriber(const std::filesystem::path& root) {
     auto modelsDir = infrastructure::PathUtils::GetModelsDir();
     std::string modelPath = (modelsDir / "ggml-base.bin").string();
     if (!std::filesystem::exists(modelPath)) {
@@ -150,48 +126,13 @@ application::AppServices BuildServicesForRoot(const std::filesystem::path& root)
         }
     }
     std::string inboxPath = (root / "inbox").string();
-    auto transcriber = std::make_unique<infrastructure::WhisperCppAdapter>(modelPath, inboxPath);
-
-    application::AppServices services;
-    auto knowledge = std::make_unique<application::KnowledgeService>(std::move(repo));
-    auto processing = std::make_unique<application::AIProcessingService>(*knowledge, sharedAi, taskManager, std::move(transcriber));
-
-    services.knowledgeService = std::move(knowledge);
-    services.aiProcessingService = std::move(processing);
-    services.persistenceService = std::make_shared<infrastructure::PersistenceService>();
-    services.conversationService = std::make_unique<application::ConversationService>(
-        sharedAi,
-        services.persistenceService,
-        taskManager,
-        root.string());
-
-    auto scanPath = (root / "inbox").string();
-    auto obsPath = (root / "observations").string();
-    auto scanner = std::make_unique<infrastructure::FileSystemArtifactScanner>(scanPath);
-    services.ingestionService = std::make_unique<application::DocumentIngestionService>(std::move(scanner), sharedAi, obsPath);
-
-    auto scientificInboxPath = (root / "inbox" / "scientific").string();
-    auto scientificObsPath = (root / "observations" / "scientific").string();
-    auto strataConsumablesPath = (root / "strata" / "consumables").string();
-    auto scientificScanner = std::make_unique<infrastructure::FileSystemArtifactScanner>(scientificInboxPath);
-    services.scientificIngestionService = std::make_unique<application::scientific::ScientificIngestionService>(
-        std::move(scientificScanner),
-        sharedAi,
-        scientificObsPath,
-        strataConsumablesPath);
-
-    services.contextAssembler = std::make_unique<application::ContextAssembler>(*services.knowledgeService, *services.ingestionService);
-    services.suggestionService = std::make_unique<application::SuggestionService>(sharedAi, root.string());
-
-    auto eventStore = std::make_unique<infrastructure::writing::WritingEventStoreFs>(root.string(), services.persistenceService);
-    auto trajRepo = std::make_shared<infrastructure::writing::WritingTrajectoryRepositoryFs>(std::move(eventStore));
-    services.writingTrajectoryService = std::make_unique<application::writing::WritingTrajectoryService>(std::move(trajRepo));
-    services.graphService = std::make_unique<application::GraphService>();
-    services.projectService = std::make_unique<application::ProjectService>();
-    services.exportService = std::make_unique<application::KnowledgeExportService>();
-    services.taskManager = taskManager;
-
-    return services;
+    return std::make_unique<infrastructure::WhisperCppAdapter>(modelPath, inboxPath);
+}
+
+application::AppServices BuildDesktopServices(const std::filesystem::path& root) {
+    ServiceOptions options;
+    options.transcriber = MakeTranscriber(root);
+    return BuildServicesForRoot(root, std::move(options));
 }
 
 } // namespace
@@ -206,9 +147,9 @@ bool IdeaWalkerApp::Init() {
     // Dependency Injection / Composition Root
     auto root = std::filesystem::path(defaultRoot);
     m_state.servicesFactory = [](const std::string& rootPath) {
-        return BuildServicesForRoot(std::filesystem::path(rootPath));
+        return BuildDesktopServices(std::filesystem::path(rootPath));
     };
-    m_state.InjectServices(BuildServicesForRoot(root));
+    m_state.InjectServices(BuildDesktopServices(root));
 
     // Unified Config Loader
     auto videoDriver = infrastructure::ConfigLoader::GetVideoDriverPreference(defaultRoot);
@@ -323,18 +264,28 @@ int IdeaWalkerApp::Run() {
         ImGui_ImplSDL2_NewFrame();
         ImGui::NewFrame();
 
-        ui::DrawUI(m_state);
+        {
+            infrastructure::ProfileZone zone("DrawUI");
+            ui::DrawUI(m_state);
+        }
         if (m_state.ui.requestExit) {
             done = true;
         }
 
-        ImGui::Render();
-        ImGuiIO& io = ImGui::GetIO();
-        glViewport(0, 0, static_cast<int>(io.DisplaySize.x), static_cast<int>(io.DisplaySize.y));
-        glClearColor(0.10f, 0.10f, 0.10f, 1.00f);
-        glClear(GL_COLOR_BUFFER_BIT);
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
-        SDL_GL_SwapWindow(m_window);
+        {
+            infrastructure::ProfileZone zone("Render");
+            ImGui::Render();
+            ImGuiIO& io = ImGui::GetIO();
+            glViewport(0, 0, static_cast<int>(io.DisplaySize.x), static_cast<int>(io.DisplaySize.y));
+            glClearColor(0.10f, 0.10f, 0.10f, 1.00f);
+            glClear(GL_COLOR_BUFFER_BIT);
+            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        }
+        {
+            infrastructure::ProfileZone zone("SwapWindow");
+            SDL_GL_SwapWindow(m_window);
+        }
+        infrastructure::FrameProfiler::Instance().endFrame();
     }
 
     Shutdown();
@@ -0,0 +1,94 @@
+/**
+ * @file ServiceComposition.cpp
+ * @brief Implementation of the shared composition root.
+ */
+
+#include "app/ServiceComposition.hpp"
+
+#include <iostream>
+#include <string>
+
+#include "infrastructure/ConfigLoader.hpp"
+#include "infrastructure/FileRepository.hpp"
+#include "infrastructure/FileSystemArtifactScanner.hpp"
+#include "infrastructure/OllamaAdapter.hpp"
+#include "infrastructure/PersistenceService.hpp"
+#include "infrastructure/writing/WritingEventStoreFs.hpp"
+#include "infrastructure/writing/WritingTrajectoryRepositoryFs.hpp"
+
+namespace ideawalker::app {
+
+application::AppServices BuildServicesForRoot(const std::filesystem::path& root, ServiceOptions options) {
+    auto repo = std::make_unique<infrastructure::FileRepository>(
+        (root / "inbox").string(),
+        (root / "notas").string(),
+        (root / ".history").string(),
+        (root / "observations").string()
+    );
+    auto sharedAi = std::make_shared<infrastructure::OllamaAdapter>();
+    
+    auto savedModel = infrastructure::ConfigLoader::GetAIModelPreference(root.string());
+    if (savedModel) {
+        std::cout << "[ServiceComposition] Loading saved model preference: " << *savedModel << std::endl;
+        sharedAi->setModel(*savedModel);
+        // Skipping replacement for now, need to find usage first.
+    }
+
+    sharedAi->initialize();
+
+    auto taskManager = std::make_shared<application::AsyncTaskManager>();
+
+    application::AppServices services;
+    auto knowledge = std::make_unique<application::KnowledgeService>(std::move(repo));
+    auto processing = std::make_unique<application::AIProcessingService>(*knowledge, sharedAi, taskManager, std::move(options.transcriber));
+
+    services.knowledgeService = std::move(knowledge);
+    services.aiProcessingService = std::move(processing);
+    services.persistenceService = std::make_shared<infrastructure::PersistenceService>();
+    services.conversationService = std::make_unique<application::ConversationService>(
+        sharedAi,
+        services.persistenceService,
+        taskManager,
+        root.string());
+
+    auto scanPath = (root / "inbox").string();
+    auto obsPath = (root / "observations").string();
+    auto scanner = std::make_unique<infrastructure::FileSystemArtifactScanner>(scanPath);
+    services.ingestionService = std::make_unique<application::DocumentIngestionService>(std::move(scanner), sharedAi, obsPath);
+
+    auto scientificInboxPath = (root / "inbox" / "scientific").string();
+    auto scientificObsPath = (root / "observations" / "scientific").string();
+    auto strataConsumablesPath = (root / "strata" / "consumables").string();
+    auto scientificScanner = std::make_unique<infrastructure::FileSystemArtifactScanner>(scientificInboxPath);
+    application::scientific::IngestionConcurrency ingestionConcurrency;
+    if (options.ingestionConcurrency) {
+        ingestionConcurrency = *options.ingestionConcurrency;
+    } else if (auto llmConcurrency = infrastructure::ConfigLoader::GetLLMConcurrencyPreference(root.string());
+               llmConcurrency && *llmConcurrency > 0) {
+        ingestionConcurrency.llmCalls = static_cast<size_t>(*llmConcurrency);
+        ingestionConcurrency.articlesInFlight = ingestionConcurrency.llmCalls + 1;
+    }
+    services.scientificIngestionService = std::make_unique<application::scientific::ScientificIngestionService>(
+        std::move(scientificScanner),
+        sharedAi,
+        scientificObsPath,
+        strataConsumablesPath,
+        taskManager,
+        ingestionConcurrency);
+
+    services.contextAssembler = std::make_unique<application::ContextAssembler>(*services.knowledgeService, *services.ingestionService);
+    services.suggestionService = std::make_unique<application::SuggestionService>(sharedAi, root.string());
+
+    auto eventStore = std::make_unique<infrastructure::writing::WritingEventStoreFs>(root.string(), services.persistenceService);
+    auto trajRepo = std::make_shared<infrastructure::writing::WritingTrajectoryRepositoryFs>(std::move(eventStore));
+    services.writingTrajectoryService = std::make_unique<application::writing::WritingTrajectoryService>(std::move(trajRepo));
+    services.graphService = std::make_unique<application::GraphService>(taskManager);
+    services.mermaidLayouts = std::make_unique<application::MermaidLayoutCache>(taskManager);
+    services.projectService = std::make_unique<application::ProjectService>();
+    services.exportService = std::make_unique<application::KnowledgeExportService>();
+    services.taskManager = taskManager;
+
+    return services;
+}
+
+} // namespace ideawalker::app
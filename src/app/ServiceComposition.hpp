@@ -0,0 +1,35 @@
+/**
+ * @file ServiceComposition.hpp
+ * @brief Composition root shared by the desktop app and the headless tools.
+ */
+
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+
+#include "application/AppServices.hpp"
+#include "domain/TranscriptionService.hpp"
+
+namespace ideawalker::app {
+
+/**
+ * @struct ServiceOptions
+ * @brief Per-host choices when wiring the services of a project root.
+ */
+struct ServiceOptions {
+    /** Audio transcriber; Whisper decodes audio through SDL, so headless hosts leave it empty. */
+    std::unique_ptr<domain::TranscriptionService> transcriber;
+    /** Overrides the scientific ingestion limits read from settings.json. */
+    std::optional<application::scientific::IngestionConcurrency> ingestionConcurrency;
+};
+
+/**
+ * @brief Wires every application service for the project at @p root.
+ *
+ * Links no UI code (no SDL, no ImGui): the GUI only adds its transcriber on top.
+ */
+application::AppServices BuildServicesForRoot(const std::filesystem::path& root, ServiceOptions options = {});
+
+} // namespace ideawalker::app
@@ -5,8 +5,10 @@
 
 #include "application/AIProcessingService.hpp"
 #include "application/scientific/ScientificIngestionService.hpp"
-#include <sstream>
+#include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <sstream>
 
 namespace ideawalker::application {
 
@@ -49,44 +51,48 @@ std::string AIProcessingService::FilterTaskLines(const std::string& text) {
     return out.str();
 }
 
-void AIProcessingService::ProcessInboxAsync(bool force, bool fastMode) {
-    m_taskManager->SubmitTask(TaskType::AI_Processing, "Processando Inbox", [this, force, fastMode](std::shared_ptr<TaskStatus> status) {
-        auto rawThoughts = m_knowledge.GetRawThoughts();
-        size_t total = rawThoughts.size();
-        for (size_t i = 0; i < total; ++i) {
-            const auto& thought = rawThoughts[i];
-            std::string insightId = NormalizeToId(thought.filename);
-            
-            if (!force && !m_knowledge.GetRepository().shouldProcess(thought, insightId)) {
-                status->progress = static_cast<float>(i + 1) / total;
-                continue;
-            }
+void AIProcessingService::ProcessThought(const domain::RawThought& thought, bool force, bool fastMode) {
+    std::string insightId = NormalizeToId(thought.filename);
+    if (!force && !m_knowledge.GetRepository().shouldProcess(thought, insightId)) {
+        return;
+    }
 
-            auto insight = m_ai->processRawThought(thought.content, fastMode, [status](const std::string& msg) {
-                // Update status if needed
-            });
+    auto insight = m_ai->processRawThought(thought.content, fastMode, [](const std::string&) {});
+    if (!insight) return;
 
-            if (insight) {
-                auto meta = insight->getMetadata();
-                
-                // INTENT ROUTING
-                bool isScientific = false;
-                for (const auto& tag : meta.tags) {
-                    if (tag == "#ScientificObserver") isScientific = true;
-                }
+    auto meta = insight->getMetadata();
+
+    // INTENT ROUTING
+    bool isScientific = false;
+    for (const auto& tag : meta.tags) {
+        if (tag == "#ScientificObserver") isScientific = true;
+    }
+
+    if (isScientific && m_scientificService) {
+         // Intent: Scientific Ingestion (Candidate Bundle)
+         m_scientificService->ingestScientificBundle(insight->getContent(), insightId);
+    } else {
+        // Intent: Standard Note Persistence
+        meta.id = insightId;
+        domain::Insight normalized(meta, insight->getContent());
+        m_knowledge.GetRepository().saveInsight(normalized);
+    }
+}
+
+std::shared_ptr<TaskStatus> AIProcessingService::ProcessInboxAsync(bool force, bool fastMode, size_t parallelism) {
+    return m_taskManager->SubmitTask(TaskType::AI_Processing, "Processando Inbox", [this, force, fastMode, parallelism](std::shared_ptr<TaskStatus> status) {
+        const auto rawThoughts = m_knowledge.GetRawThoughts();
+        const size_t total = rawThoughts.size();
+        std::atomic<size_t> done{0};
+
+        // Each note writes only its own insight, so notes can be processed side by side;
+        // this task is one of the workers and waits for the others before consolidating.
+        m_taskManager->RunParallel(TaskType::AI_Processing, "Processando Inbox (paralelo)", total, parallelism,
+            [&](size_t i) {
+                ProcessThought(rawThoughts[i], force, fastMode);
+                status->progress = static_cast<float>(++done) / total;
+            });
 
-                if (isScientific && m_scientificService) {
-                     // Intent: Scientific Ingestion (Candidate Bundle)
-                     m_scientificService->ingestScientificBundle(insight->getContent(), insightId);
-                } else {
-                    // Intent: Standard Note Persistence
-                    meta.id = insightId;
-                    domain::Insight normalized(meta, insight->getContent());
-                    m_knowledge.GetRepository().saveInsight(normalized);
-                }
-            }
-            status->progress = static_cast<float>(i + 1) / total;
-        }
         // Auto-consolidate after batch
         ConsolidateTasksAsync();
     });
@@ -142,8 +148,8 @@ void AIProcessingService::ProcessItemAsync(const std::string& filename, bool for
     });
 }
 
-void AIProcessingService::ConsolidateTasksAsync() {
-    m_taskManager->SubmitTask(TaskType::AI_Processing, "Consolidando Tarefas", [this](std::shared_ptr<TaskStatus> status) {
+std::shared_ptr<TaskStatus> AIProcessingService::ConsolidateTasksAsync() {
+    return m_taskManager->SubmitTask(TaskType::AI_Processing, "Consolidando Tarefas", [this](std::shared_ptr<TaskStatus> status) {
         auto insights = m_knowledge.GetAllInsights();
         std::ostringstream taskList;
         bool hasTasks = false;
@@ -29,14 +29,18 @@ public:
                         std::unique_ptr<domain::TranscriptionService> transcriber,
                         std::shared_ptr<scientific::ScientificIngestionService> scientificService = nullptr);
 
-    /** @brief Triggers background processing of the entire inbox. */
-    void ProcessInboxAsync(bool force = false, bool fastMode = false);
+    /**
+     * @brief Triggers background processing of the entire inbox.
+     * @param parallelism Notes processed at once (each one is an independent LLM call).
+     * @return Status of the batch task (consolidation runs as a follow-up task).
+     */
+    std::shared_ptr<TaskStatus> ProcessInboxAsync(bool force = false, bool fastMode = false, size_t parallelism = 1);
 
     /** @brief Triggers background processing of a specific inbox item. */
     void ProcessItemAsync(const std::string& filename, bool force = false, bool fastMode = false);
 
     /** @brief Triggers background task consolidation. */
-    void ConsolidateTasksAsync();
+    std::shared_ptr<TaskStatus> ConsolidateTasksAsync();
 
     /** @brief Triggers background audio transcription. */
     void TranscribeAudioAsync(const std::string& audioPath);
@@ -52,6 +56,7 @@ private:
     std::shared_ptr<scientific::ScientificIngestionService> m_scientificService;
 
     // Internal helpers
+    void ProcessThought(const domain::RawThought& thought, bool force, bool fastMode);
     static std::string NormalizeToId(const std::string& filename);
     static std::string FilterTaskLines(const std::string& text);
 };
@@ -15,6 +15,7 @@
 #include "application/SuggestionService.hpp"
 #include "application/writing/WritingTrajectoryService.hpp"
 #include "application/GraphService.hpp"
+#include "application/MermaidLayoutCache.hpp"
 #include "application/ProjectService.hpp"
 #include "application/KnowledgeExportService.hpp"
 #include "application/AsyncTaskManager.hpp"
@@ -32,6 +33,7 @@ struct AppServices {
     std::unique_ptr<SuggestionService> suggestionService;
     std::unique_ptr<writing::WritingTrajectoryService> writingTrajectoryService;
     std::unique_ptr<GraphService> graphService;
+    std::unique_ptr<MermaidLayoutCache> mermaidLayouts;
     std::unique_ptr<ProjectService> projectService;
     std::unique_ptr<KnowledgeExportService> exportService;
     std::shared_ptr<infrastructure::PersistenceService> persistenceService;
@@ -14,6 +14,9 @@
 #include <atomic>
 #include <memory>
 #include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
 
 namespace ideawalker::application {
 
@@ -26,7 +29,8 @@ enum class TaskType {
     Indexing,
     Transcription,
     Export,
-    UpdateCheck
+    UpdateCheck,
+    Layout
 };
 
 /**
@@ -89,6 +93,53 @@ public:
         return status;
     }
 
+    /**
+     * @brief Runs fn(i) for every i in [0, count) on up to @p workers threads and waits for all.
+     *
+     * Workers pull indices from a shared counter, so uneven items balance out. The calling
+     * thread is one of the workers (one worker means no background task); the others are
+     * tasks of @p type reporting the share of items done. After the first exception no new
+     * index is handed out, and it is rethrown here once every worker has stopped.
+     */
+    template<typename F>
+    void RunParallel(TaskType type, const std::string& description, std::size_t count, std::size_t workers, F&& fn) {
+        std::atomic<std::size_t> next{0};
+        std::atomic<std::size_t> done{0};
+        std::atomic<bool> stop{false};
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::size_t finished = 0;
+        std::exception_ptr failure;
+        auto drain = [&](TaskStatus* status) {
+            try {
+                for (std::size_t i = next++; i < count && !stop; i = next++) {
+                    fn(i);
+                    const std::size_t completed = ++done;
+                    if (status) status->progress = static_cast<float>(completed) / static_cast<float>(count);
+                }
+            } catch (...) {
+                stop = true;
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!failure) failure = std::current_exception();
+            }
+        };
+
+        const std::size_t helpers = count == 0 ? 0 : std::min(std::max<std::size_t>(1, workers), count) - 1;
+        for (std::size_t h = 0; h < helpers; ++h) {
+            SubmitTask(type, description, [&](std::shared_ptr<TaskStatus> status) {
+                drain(status.get());
+                std::lock_guard<std::mutex> lock(mutex);
+                ++finished;
+                cv.notify_all();
+            });
+        }
+        drain(nullptr);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&] { return finished == helpers; });
+        if (failure) std::rethrow_exception(failure);
+    }
+
     /** @brief Returns snapshots of all active tasks. */
     std::vector<std::shared_ptr<TaskStatus>> GetActiveTasks() {
         std::lock_guard<std::mutex> lock(m_tasksMutex);
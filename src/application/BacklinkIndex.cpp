@@ -0,0 +1,111 @@
+/**
+ * @file BacklinkIndex.cpp
+ * @brief Implementation of BacklinkIndex.
+ */
+
+#include "application/BacklinkIndex.hpp"
+#include <algorithm>
+#include <unordered_set>
+
+namespace ideawalker::application {
+
+namespace {
+std::string TrimTarget(std::string target) {
+    target.erase(0, target.find_first_not_of(" \t\n\r"));
+    const size_t end = target.find_last_not_of(" \t\n\r");
+    if (end != std::string::npos) target.erase(end + 1);
+    return target;
+}
+
+/** @brief Every wikilink form that resolves to the note. */
+std::vector<std::string> NamesOf(const std::string& id, const std::string& title,
+                                 const std::vector<std::string>& aliases) {
+    std::vector<std::string> names = {id};
+    const size_t dot = id.find_last_of('.');
+    if (dot != std::string::npos && dot > 0) names.push_back(id.substr(0, dot));
+    if (!title.empty()) names.push_back(title);
+    names.insert(names.end(), aliases.begin(), aliases.end());
+    std::sort(names.begin(), names.end());
+    names.erase(std::unique(names.begin(), names.end()), names.end());
+    return names;
+}
+} // namespace
+
+void BacklinkIndex::update(const domain::Insight& insight) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    updateLocked(insight);
+}
+
+void BacklinkIndex::remove(const std::string& noteId) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    removeLocked(noteId);
+}
+
+void BacklinkIndex::sync(const std::vector<domain::Insight>& insights) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::unordered_set<std::string> present;
+    present.reserve(insights.size());
+    for (const auto& insight : insights) {
+        const auto& meta = insight.getMetadata();
+        present.insert(meta.id);
+        auto it = m_notes.find(meta.id);
+        if (it != m_notes.end() && meta.revision != 0 && it->second.revision == meta.revision) continue;
+        updateLocked(insight);
+    }
+    std::vector<std::string> gone;
+    for (const auto& [id, entry] : m_notes) {
+        if (!present.count(id)) gone.push_back(id);
+    }
+    for (const auto& id : gone) removeLocked(id);
+    m_loaded = true;
+}
+
+bool BacklinkIndex::isLoaded() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_loaded;
+}
+
+std::vector<std::string> BacklinkIndex::backlinks(const std::string& noteId) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto note = m_notes.find(noteId);
+    const auto names = note != m_notes.end() ? note->second.names : NamesOf(noteId, "", {});
+
+    std::set<std::string> citing;
+    for (const auto& name : names) {
+        auto it = m_citing.find(name);
+        if (it != m_citing.end()) citing.insert(it->second.begin(), it->second.end());
+    }
+    citing.erase(noteId);
+    return {citing.begin(), citing.end()};
+}
+
+void BacklinkIndex::updateLocked(const domain::Insight& insight) {
+    const auto& meta = insight.getMetadata();
+    removeLocked(meta.id);
+
+    NoteEntry entry;
+    entry.revision = meta.revision;
+    entry.names = NamesOf(meta.id, meta.title, meta.aliases);
+    std::unordered_set<std::string> seen;
+    for (const auto& raw : domain::Insight::extractReferences(insight.getContent())) {
+        std::string target = TrimTarget(raw);
+        if (target.empty() || !seen.insert(target).second) continue;
+        m_citing[target].insert(meta.id);
+        entry.references.push_back(std::move(target));
+    }
+    m_notes[meta.id] = std::move(entry);
+}
+
+void BacklinkIndex::removeLocked(const std::string& noteId) {
+    auto it = m_notes.find(noteId);
+    if (it == m_notes.end()) return;
+    for (const auto& ref : it->second.references) {
+        auto citing = m_citing.find(ref);
+        if (citing == m_citing.end()) continue;
+        citing->second.erase(noteId);
+        if (citing->second.empty()) m_citing.erase(citing);
+    }
+    m_notes.erase(it);
+}
+
+} // namespace ideawalker::application
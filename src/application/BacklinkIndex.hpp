@@ -0,0 +1,59 @@
+/**
+ * @file BacklinkIndex.hpp
+ * @brief Reverse wikilink index: which notes cite a given note.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "domain/Insight.hpp"
+
+namespace ideawalker::application {
+
+/**
+ * @class BacklinkIndex
+ * @brief Maps every [[wikilink]] target to the notes citing it, so a backlink query is a lookup.
+ *
+ * A note is cited as [[Id]], [[Id without extension]], [[Title]] or [[Alias]]. Notes are
+ * indexed one at a time as they change; sync() reconciles the index with a full listing
+ * and skips notes whose repository revision stamp is unchanged. Thread-safe.
+ */
+class BacklinkIndex {
+public:
+    /** @brief (Re)indexes one note from its content. O(that note). */
+    void update(const domain::Insight& insight);
+
+    /** @brief Drops a note (its outgoing links and its names). */
+    void remove(const std::string& noteId);
+
+    /** @brief Reconciles with the complete set of notes; marks the index loaded. */
+    void sync(const std::vector<domain::Insight>& insights);
+
+    /** @brief True once sync() has seen the whole repository. */
+    bool isLoaded() const;
+
+    /** @brief Notes citing the note (sorted, without the note itself). */
+    std::vector<std::string> backlinks(const std::string& noteId) const;
+
+private:
+    struct NoteEntry {
+        std::uint64_t revision = 0;
+        std::vector<std::string> names;      ///< Id, id stem, title and aliases.
+        std::vector<std::string> references; ///< Trimmed, distinct wikilink targets.
+    };
+
+    void updateLocked(const domain::Insight& insight);
+    void removeLocked(const std::string& noteId);
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, NoteEntry> m_notes;
+    std::unordered_map<std::string, std::set<std::string>> m_citing; ///< Wikilink target -> citing note ids.
+    bool m_loaded = false;
+};
+
+} // namespace ideawalker::application
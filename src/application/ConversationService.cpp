@@ -11,11 +11,85 @@
 #include <iomanip>
 #include <iostream>
 #include <fstream> 
+#include <set>
+#include <nlohmann/json.hpp>
 
 namespace ideawalker::application {
 
 namespace fs = std::filesystem;
 
+namespace {
+
+constexpr int kDialogueSchemaVersion = 1;
+constexpr const char* kDialogueLogExtension = ".ndjson";
+constexpr const char* kDialogueIndexFile = "index.ndjson";
+
+using Role = domain::AIService::ChatMessage::Role;
+
+long long NowMillis() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+Role RoleFromString(const std::string& role) {
+    if (role == "system") return Role::System;
+    if (role == "assistant") return Role::Assistant;
+    return Role::User;
+}
+
+// Rough BPE-like estimate (~4 chars per token); the chat API does not report usage.
+std::size_t EstimateTokens(const std::string& text) {
+    return (text.size() + 3) / 4;
+}
+
+/**
+ * @brief Lists session files by scanning the directory (used only to rebuild a missing index).
+ * Legacy Markdown transcripts are kept unless an NDJSON log with the same stem exists.
+ */
+std::vector<std::string> ScanDialogueFiles(const fs::path& dialoguesDir) {
+    std::vector<std::string> files;
+    if (!fs::exists(dialoguesDir) || !fs::is_directory(dialoguesDir)) return files;
+
+    std::set<std::string> logStems;
+    std::vector<fs::path> markdown;
+    for (const auto& entry : fs::directory_iterator(dialoguesDir)) {
+        if (!entry.is_regular_file()) continue;
+        const auto& path = entry.path();
+        if (path.extension() == kDialogueLogExtension && path.filename() != kDialogueIndexFile) {
+            logStems.insert(path.stem().string());
+            files.push_back(path.filename().string());
+        } else if (path.extension() == ".md") {
+            markdown.push_back(path);
+        }
+    }
+    for (const auto& path : markdown) {
+        if (logStems.count(path.stem().string()) == 0) {
+            files.push_back(path.filename().string());
+        }
+    }
+    return files;
+}
+
+std::string RenderMarkdown(const std::string& noteId,
+                           const std::string& startTime,
+                           const std::vector<domain::AIService::ChatMessage>& history) {
+    std::stringstream ss;
+    ss << "# Conversa do Projeto\n\n";
+    ss << "Data: " << startTime << "\n";
+    ss << "Nota Foco: " << noteId << "\n\n";
+    ss << "---\n\n";
+
+    for (const auto& msg : history) {
+        if (msg.role == Role::System) continue; 
+        
+        ss << "### " << (msg.role == Role::User ? "Usuário" : "IdeaWalker") << "\n";
+        ss << msg.content << "\n\n"; 
+    }
+    return ss.str();
+}
+
+} // namespace
+
 ConversationService::ConversationService(std::shared_ptr<domain::AIService> aiService, 
                                          std::shared_ptr<infrastructure::PersistenceService> persistence,
                                          std::shared_ptr<AsyncTaskManager> taskManager,
@@ -23,7 +97,9 @@ ConversationService::ConversationService(std::shared_ptr<domain::AIService> aiSe
     : m_aiService(std::move(aiService)),
       m_persistence(std::move(persistence)),
       m_taskManager(std::move(taskManager)),
-      m_projectRoot(projectRoot) {}
+      m_projectRoot(projectRoot) {
+    reconcileIndex();
+}
 
 void ConversationService::startSession(const ContextBundle& bundle) {
     std::lock_guard<std::mutex> lock(m_mutex);
@@ -36,13 +112,16 @@ void ConversationService::startSession(const ContextBundle& bundle) {
     std::stringstream ss;
     ss << std::put_time(std::localtime(&in_time_t), "%Y-%m-%d_%H-%M-%S");
     m_sessionStartTime = ss.str();
+    m_sessionFile = sessionBaseName() + kDialogueLogExtension;
+    m_persistedCount = 0;
+    m_sessionRegistered = false;
 
     // Initial System Message
     std::string systemPrompt = generateSystemPrompt(bundle);
-    m_history.push_back({domain::AIService::ChatMessage::Role::System, systemPrompt});
+    m_history.push_back({Role::System, systemPrompt});
 
     // Save initial state
-    saveSession(m_history);
+    appendPendingMessagesLocked();
 }
 
 void ConversationService::sendMessage(const std::string& userMessage) {
@@ -51,48 +130,31 @@ void ConversationService::sendMessage(const std::string& userMessage) {
     std::vector<domain::AIService::ChatMessage> historyCopy;
     {
         std::lock_guard<std::mutex> lock(m_mutex);
-        m_history.push_back({domain::AIService::ChatMessage::Role::User, userMessage});
+        m_history.push_back({Role::User, userMessage});
         m_isThinking.store(true);
-        historyCopy = m_history; // Snapshot for saving
+        historyCopy = m_history; // Snapshot for the AI request
+        // Save immediately after user message (appends only this record)
+        appendPendingMessagesLocked();
     }
-    
-    // Save immediately after user message
-    saveSession(historyCopy);
 
-    if (!m_taskManager) {
-        auto responseOpt = m_aiService->chat(historyCopy, false);
-
-        std::vector<domain::AIService::ChatMessage> updatedHistorySnapshot;
-        {
-            std::lock_guard<std::mutex> lock(m_mutex);
-            m_isThinking.store(false);
-            if (responseOpt) {
-                m_history.push_back({domain::AIService::ChatMessage::Role::Assistant, *responseOpt});
-            } else {
-                m_history.push_back({domain::AIService::ChatMessage::Role::Assistant, "[Erro: Sem resposta da IA]"});
-            }
-            updatedHistorySnapshot = m_history;
+    auto handleReply = [this](const std::optional<std::string>& responseOpt) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isThinking.store(false);
+        if (responseOpt) {
+            m_history.push_back({Role::Assistant, *responseOpt});
+        } else {
+            m_history.push_back({Role::Assistant, "[Erro: Sem resposta da IA]"});
         }
-        saveSession(updatedHistorySnapshot);
+        appendPendingMessagesLocked();
+    };
+
+    if (!m_taskManager) {
+        handleReply(m_aiService->chat(historyCopy, false));
         return;
     }
 
-    m_taskManager->SubmitTask(TaskType::AI_Processing, "Conversation: AI reply", [this, historyCopy](std::shared_ptr<TaskStatus>) {
-        auto responseOpt = m_aiService->chat(historyCopy, false);
-
-        std::vector<domain::AIService::ChatMessage> updatedHistorySnapshot;
-        {
-            std::lock_guard<std::mutex> lock(m_mutex);
-            m_isThinking.store(false);
-            if (responseOpt) {
-                m_history.push_back({domain::AIService::ChatMessage::Role::Assistant, *responseOpt});
-            } else {
-                m_history.push_back({domain::AIService::ChatMessage::Role::Assistant, "[Erro: Sem resposta da IA]"});
-            }
-            updatedHistorySnapshot = m_history;
-        }
-        
-        saveSession(updatedHistorySnapshot);
+    m_taskManager->SubmitTask(TaskType::AI_Processing, "Conversation: AI reply", [this, historyCopy, handleReply](std::shared_ptr<TaskStatus>) {
+        handleReply(m_aiService->chat(historyCopy, false));
     });
 }
 
@@ -117,36 +179,131 @@ bool ConversationService::isThinking() const {
     return m_isThinking.load();
 }
 
-void ConversationService::saveSession(const std::vector<domain::AIService::ChatMessage>& historySnapshot) {
-    if (m_projectRoot.empty() || m_sessionStartTime.empty() || !m_persistence) return;
-
-    fs::path dialoguesDir = fs::path(m_projectRoot) / "dialogues";
-    // Directory creation is handled by PersistenceService or pre-existing logic, 
-    // but we can ensure it exists here or rely on PersistenceService's parent_path check relative to filename.
-    
-    // Generate filename
+std::string ConversationService::sessionBaseName() const {
     std::string safeNoteId = m_currentNoteId;
     std::replace(safeNoteId.begin(), safeNoteId.end(), '/', '_');
     std::replace(safeNoteId.begin(), safeNoteId.end(), '\\', '_');
-    
-    std::string filename = safeNoteId + "_" + m_sessionStartTime + ".md";
-    fs::path finalPath = dialoguesDir / filename;
+    return safeNoteId + "_" + m_sessionStartTime;
+}
 
-    std::stringstream ss;
-    ss << "# Conversa do Projeto\n\n";
-    ss << "Data: " << m_sessionStartTime << "\n";
-    ss << "Nota Foco: " << m_currentNoteId << "\n\n";
-    ss << "---\n\n";
+void ConversationService::registerSessionLocked() {
+    fs::path dialoguesDir = fs::path(m_projectRoot) / "dialogues";
+    const std::string indexPath = (dialoguesDir / kDialogueIndexFile).string();
 
-    for (const auto& msg : historySnapshot) {
-        if (msg.role == domain::AIService::ChatMessage::Role::System) continue; 
-        
-        ss << "### " << (msg.role == domain::AIService::ChatMessage::Role::User ? "Usuário" : "IdeaWalker") << "\n";
-        ss << msg.content << "\n\n"; 
+    // Projects created before the index existed: seed it once from the directory.
+    if (!m_indexChecked) {
+        m_indexChecked = true;
+        if (!fs::exists(indexPath)) {
+            std::string seeded;
+            for (const auto& file : ScanDialogueFiles(dialoguesDir)) {
+                if (file == m_sessionFile) continue;
+                seeded += nlohmann::json{{"file", file}}.dump() + "\n";
+            }
+            m_persistence->saveTextAsync(indexPath, seeded);
+        }
     }
 
-    // Delegate IO to PersistenceService
-    m_persistence->saveTextAsync(finalPath.string(), ss.str());
+    nlohmann::json entry = {
+        {"file", m_sessionFile},
+        {"noteId", m_currentNoteId},
+        {"startedAt", m_sessionStartTime}
+    };
+    m_persistence->appendTextAsync(indexPath, entry.dump() + "\n");
+    m_sessionRegistered = true;
+}
+
+void ConversationService::reconcileIndex() {
+    if (m_projectRoot.empty() || !m_persistence) return;
+    const fs::path dialoguesDir = fs::path(m_projectRoot) / "dialogues";
+    const fs::path indexPath = dialoguesDir / kDialogueIndexFile;
+    std::ifstream index(indexPath);
+    if (!index.is_open()) return; // Seeded from the directory when the first session registers.
+
+    const auto onDisk = ScanDialogueFiles(dialoguesDir);
+    std::set<std::string> indexed;
+    std::string kept;
+    bool stale = false;
+    std::string line;
+    while (std::getline(index, line)) {
+        if (line.empty()) continue;
+        auto entry = nlohmann::json::parse(line, nullptr, false);
+        if (entry.is_discarded() || !entry.contains("file") || !entry["file"].is_string()) {
+            stale = true;
+            continue;
+        }
+        const std::string file = entry["file"].get<std::string>();
+        // Superseded legacy transcripts still exist on disk, so they are kept like any other entry.
+        if (!fs::exists(dialoguesDir / file) || !indexed.insert(file).second) {
+            stale = true;
+            continue;
+        }
+        kept += line + "\n";
+    }
+    for (const auto& file : onDisk) {
+        if (indexed.count(file) > 0) continue;
+        kept += nlohmann::json{{"file", file}}.dump() + "\n";
+        stale = true;
+    }
+
+    m_indexChecked = true;
+    if (stale) m_persistence->saveTextAsync(indexPath.string(), kept);
+}
+
+void ConversationService::appendPendingMessagesLocked() {
+    if (m_projectRoot.empty() || m_sessionFile.empty() || !m_persistence) return;
+    if (m_persistedCount >= m_history.size() && m_sessionRegistered) return;
+
+    std::string lines;
+    if (!m_sessionRegistered) {
+        registerSessionLocked();
+        nlohmann::json header = {
+            {"schemaVersion", kDialogueSchemaVersion},
+            {"type", "session"},
+            {"noteId", m_currentNoteId},
+            {"startedAt", m_sessionStartTime},
+            {"ts", NowMillis()}
+        };
+        lines += header.dump() + "\n";
+    }
+
+    const std::string model = m_aiService ? m_aiService->getCurrentModel() : std::string();
+    for (std::size_t i = m_persistedCount; i < m_history.size(); ++i) {
+        const auto& msg = m_history[i];
+        nlohmann::json record = {
+            {"schemaVersion", kDialogueSchemaVersion},
+            {"type", "message"},
+            {"role", domain::AIService::ChatMessage::RoleToString(msg.role)},
+            {"ts", NowMillis()},
+            {"model", model},
+            {"tokens", EstimateTokens(msg.content)},
+            {"tokensEstimated", true},
+            {"content", msg.content}
+        };
+        lines += record.dump() + "\n";
+    }
+    m_persistedCount = m_history.size();
+
+    // Delegate IO to PersistenceService (O(message), never re-serializes the session)
+    const fs::path logPath = fs::path(m_projectRoot) / "dialogues" / m_sessionFile;
+    m_persistence->appendTextAsync(logPath.string(), lines);
+}
+
+std::string ConversationService::renderMarkdownTranscript() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return RenderMarkdown(m_currentNoteId, m_sessionStartTime, m_history);
+}
+
+std::string ConversationService::exportMarkdownTranscript() {
+    std::string content;
+    fs::path exportPath;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_projectRoot.empty() || m_sessionFile.empty() || !m_persistence) return {};
+        content = RenderMarkdown(m_currentNoteId, m_sessionStartTime, m_history);
+        exportPath = fs::path(m_projectRoot) / "dialogues" / fs::path(m_sessionFile).replace_extension(".md");
+    }
+    m_persistence->saveTextAsync(exportPath.string(), content);
+    return exportPath.string();
 }
 
 std::vector<std::string> ConversationService::listDialogues() const {
@@ -154,12 +311,25 @@ std::vector<std::string> ConversationService::listDialogues() const {
     if (m_projectRoot.empty()) return files;
 
     fs::path dialoguesDir = fs::path(m_projectRoot) / "dialogues";
-    if (fs::exists(dialoguesDir) && fs::is_directory(dialoguesDir)) {
-        for (const auto& entry : fs::directory_iterator(dialoguesDir)) {
-            if (entry.is_regular_file() && entry.path().extension() == ".md") {
-                files.push_back(entry.path().filename().string());
-            }
+    std::ifstream index(dialoguesDir / kDialogueIndexFile);
+    if (index.is_open()) {
+        std::set<std::string> seen;
+        std::string line;
+        while (std::getline(index, line)) {
+            if (line.empty()) continue;
+            auto entry = nlohmann::json::parse(line, nullptr, false);
+            if (entry.is_discarded() || !entry.contains("file") || !entry["file"].is_string()) continue;
+            std::string file = entry["file"].get<std::string>();
+            if (seen.insert(file).second) files.push_back(std::move(file));
         }
+        // A legacy transcript that was continued is superseded by its NDJSON log.
+        files.erase(std::remove_if(files.begin(), files.end(), [&seen](const std::string& file) {
+            fs::path path(file);
+            return path.extension() == ".md" &&
+                   seen.count(path.stem().string() + kDialogueLogExtension) > 0;
+        }), files.end());
+    } else {
+        files = ScanDialogueFiles(dialoguesDir);
     }
     // Sort by name (which has timestamp) descending
     std::sort(files.rbegin(), files.rend());
@@ -175,49 +345,64 @@ bool ConversationService::loadSession(const std::string& filename) {
     std::ifstream ifs(filePath);
     if (!ifs.is_open()) return false;
 
-    // Reset current state
-    {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        m_history.clear();
-        m_currentNoteId = "";
-        m_sessionStartTime = "";
-        
-        // Parse basic metadata from filename or content (Simplified)
-        // Filename format: NoteID_Date_Time.md
-        // We can recover NoteID roughly
-        size_t underscore = filename.find_last_of('_'); 
-        // This is tricky without strict parsing, but for now we just load content.
-        // Recovering m_sessionStartTime from filename roughly is possible.
-        
-        // Very basic markdown parsing
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_history.clear();
+    m_currentNoteId = "";
+    m_sessionStartTime = "";
+
+    if (filePath.extension() == kDialogueLogExtension) {
         std::string line;
-        domain::AIService::ChatMessage currentMsg;
-        bool hasMsg = false;
-        
         while (std::getline(ifs, line)) {
-            if (line.rfind("Data: ", 0) == 0) {
-                m_sessionStartTime = line.substr(6);
-            } else if (line.rfind("Nota Foco: ", 0) == 0) {
-                m_currentNoteId = line.substr(11);
-            } else if (line.rfind("### Usuário", 0) == 0) {
-                if (hasMsg) m_history.push_back(currentMsg);
-                currentMsg.role = domain::AIService::ChatMessage::Role::User;
-                currentMsg.content = "";
-                hasMsg = true;
-            } else if (line.rfind("### IdeaWalker", 0) == 0) {
-                if (hasMsg) m_history.push_back(currentMsg);
-                currentMsg.role = domain::AIService::ChatMessage::Role::Assistant;
-                currentMsg.content = "";
-                hasMsg = true;
-            } else {
-                if (hasMsg && currentMsg.role != domain::AIService::ChatMessage::Role::System) { // Skip preamble
-                     if (!line.empty()) currentMsg.content += line + "\n";
-                }
+            if (line.empty()) continue;
+            // A torn trailing line (crash mid-append) is skipped, not fatal.
+            auto record = nlohmann::json::parse(line, nullptr, false);
+            if (record.is_discarded() || !record.is_object()) continue;
+            const std::string type = record.value("type", "");
+            if (type == "session") {
+                m_currentNoteId = record.value("noteId", "");
+                m_sessionStartTime = record.value("startedAt", "");
+            } else if (type == "message") {
+                m_history.push_back({RoleFromString(record.value("role", "user")), record.value("content", "")});
             }
         }
-        if (hasMsg) m_history.push_back(currentMsg);
+        m_sessionFile = filename;
+        m_persistedCount = m_history.size();
+        m_sessionRegistered = true;
+        return true;
     }
+
+    // Legacy Markdown transcript: new messages are written to a fresh NDJSON log
+    // that starts with the whole migrated history.
+    std::string line;
+    domain::AIService::ChatMessage currentMsg;
+    bool hasMsg = false;
     
+    while (std::getline(ifs, line)) {
+        if (line.rfind("Data: ", 0) == 0) {
+            m_sessionStartTime = line.substr(6);
+        } else if (line.rfind("Nota Foco: ", 0) == 0) {
+            m_currentNoteId = line.substr(11);
+        } else if (line.rfind("### Usuário", 0) == 0) {
+            if (hasMsg) m_history.push_back(currentMsg);
+            currentMsg.role = Role::User;
+            currentMsg.content = "";
+            hasMsg = true;
+        } else if (line.rfind("### IdeaWalker", 0) == 0) {
+            if (hasMsg) m_history.push_back(currentMsg);
+            currentMsg.role = Role::Assistant;
+            currentMsg.content = "";
+            hasMsg = true;
+        } else {
+            if (hasMsg && currentMsg.role != Role::System) { // Skip preamble
+                 if (!line.empty()) currentMsg.content += line + "\n";
+            }
+        }
+    }
+    if (hasMsg) m_history.push_back(currentMsg);
+
+    m_sessionFile = filePath.stem().string() + kDialogueLogExtension;
+    m_persistedCount = 0;
+    m_sessionRegistered = false;
     return true;
 }
 
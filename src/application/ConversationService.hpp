@@ -19,6 +19,10 @@ namespace ideawalker::application {
 /**
  * @class ConversationService
  * @brief Manages the lifecycle of a cognitive dialogue session, context injection, and persistence.
+ *
+ * Sessions are stored as append-only NDJSON logs (`dialogues/<note>_<start>.ndjson`,
+ * one record per message) plus a small `dialogues/index.ndjson` listing them.
+ * The Markdown transcript is only rendered on export.
  */
 class ConversationService {
 public:
@@ -60,19 +64,36 @@ public:
     std::string getCurrentNoteId() const;
     
     /**
-     * @brief List all saved dialogue sessions in the project.
+     * @brief List all saved dialogue sessions in the project (read from the dialogue index).
      */
     std::vector<std::string> listDialogues() const;
 
     /**
      * @brief Loads a saved dialogue session.
-     * @param filename The name of the file in the dialogues/ directory.
+     * @param filename The name of the file in the dialogues/ directory (.ndjson or legacy .md).
      * @return True if loaded successfully.
      */
     bool loadSession(const std::string& filename);
 
+    /**
+     * @brief Renders the current session as a Markdown transcript.
+     */
+    std::string renderMarkdownTranscript() const;
+
+    /**
+     * @brief Writes the Markdown transcript of the current session next to its log.
+     * @return Path of the exported file, or empty if there is no session.
+     */
+    std::string exportMarkdownTranscript();
+
 private:
-    void saveSession(const std::vector<domain::AIService::ChatMessage>& historySnapshot);
+    /** @brief Appends every message not yet in the session log (m_mutex must be held). */
+    void appendPendingMessagesLocked();
+    /** @brief Registers the session in the dialogue index, rebuilding it if missing (m_mutex must be held). */
+    void registerSessionLocked();
+    /** @brief Drops index entries whose log is gone and adds logs created outside the app (on project open). */
+    void reconcileIndex();
+    std::string sessionBaseName() const;
     std::string generateSystemPrompt(const ContextBundle& bundle);
 
     std::shared_ptr<domain::AIService> m_aiService;
@@ -83,6 +104,10 @@ private:
     std::string m_currentNoteId;
     std::vector<domain::AIService::ChatMessage> m_history;
     std::string m_sessionStartTime;
+    std::string m_sessionFile;        ///< Log filename inside dialogues/.
+    std::size_t m_persistedCount = 0; ///< Messages of m_history already in the log.
+    bool m_sessionRegistered = false; ///< Session header/index record written.
+    bool m_indexChecked = false;      ///< Index existence verified (or seeded) once.
     
     mutable std::mutex m_mutex;
     std::atomic<bool> m_isThinking{false};
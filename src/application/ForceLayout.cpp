@@ -0,0 +1,304 @@
+/**
+ * @file ForceLayout.cpp
+ * @brief Implementation of ForceLayout.
+ */
+
+#include "application/ForceLayout.hpp"
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+namespace ideawalker::application {
+
+using namespace ideawalker::domain::writing;
+
+namespace {
+
+constexpr std::uint32_t kLeafSize = 8;
+constexpr int kMaxDepth = 20;        // Coincident nodes end up sharing a leaf
+constexpr float kMinDistSq = 400.0f; // Same 20px softening as the all-pairs version
+
+} // namespace
+
+ForceLayout::ForceLayout(ForceLayoutConfig config) : m_config(config) {}
+
+void ForceLayout::setConfig(const ForceLayoutConfig& config) {
+    m_config = config;
+    wake();
+}
+
+void ForceLayout::load(const std::vector<GraphNode>& nodes, const std::vector<GraphLink>& links, float temperature) {
+    const std::size_t n = nodes.size();
+    m_x.resize(n); m_y.resize(n); m_vx.resize(n); m_vy.resize(n);
+    m_fx.assign(n, 0.0f); m_fy.assign(n, 0.0f);
+    m_isInsight.resize(n); m_isTask.resize(n);
+    m_pinned.assign(n, 0);
+
+    std::unordered_map<int, std::uint32_t> indexById;
+    indexById.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto& node = nodes[i];
+        m_x[i] = node.x; m_y[i] = node.y;
+        m_vx[i] = node.vx; m_vy[i] = node.vy;
+        m_isInsight[i] = node.type == NodeType::INSIGHT;
+        m_isTask[i] = node.type == NodeType::TASK;
+        indexById[node.id] = static_cast<std::uint32_t>(i);
+    }
+
+    const float ratio = static_cast<float>(n) / std::max<std::size_t>(1, m_config.boundsReferenceNodes);
+    m_boundsScale = std::max(1.0f, std::sqrt(ratio));
+
+    m_springStart.clear(); m_springEnd.clear(); m_springLength.clear();
+    for (const auto& link : links) {
+        auto a = indexById.find(link.startNode);
+        auto b = indexById.find(link.endNode);
+        if (a == indexById.end() || b == indexById.end()) continue;
+        m_springStart.push_back(a->second);
+        m_springEnd.push_back(b->second);
+        m_springLength.push_back((m_isTask[a->second] || m_isTask[b->second])
+                                 ? m_config.springLengthTask : m_config.springLengthInsight);
+    }
+    wake();
+    m_temperature = std::clamp(temperature, m_config.minTemperature, 1.0f);
+}
+
+void ForceLayout::pin(std::size_t index, float x, float y) {
+    if (index >= size()) return;
+    if (!m_pinned[index] || m_x[index] != x || m_y[index] != y) wake();
+    m_pinned[index] = 1;
+    m_x[index] = x; m_y[index] = y;
+    m_vx[index] = 0.0f; m_vy[index] = 0.0f;
+}
+
+void ForceLayout::unpin(std::size_t index) {
+    if (!isPinned(index)) return;
+    m_pinned[index] = 0;
+    wake();
+}
+
+void ForceLayout::buildTree() {
+    const std::uint32_t n = static_cast<std::uint32_t>(size());
+    m_cells.clear();
+    m_order.resize(n);
+    for (std::uint32_t i = 0; i < n; ++i) m_order[i] = i;
+    if (n == 0) return;
+
+    float minX = m_x[0], maxX = m_x[0], minY = m_y[0], maxY = m_y[0];
+    for (std::uint32_t i = 1; i < n; ++i) {
+        minX = std::min(minX, m_x[i]); maxX = std::max(maxX, m_x[i]);
+        minY = std::min(minY, m_y[i]); maxY = std::max(maxY, m_y[i]);
+    }
+    Cell root;
+    root.minX = minX; root.minY = minY;
+    root.size = std::max(maxX - minX, maxY - minY) + 1.0f;
+    root.begin = 0; root.end = n;
+    m_cells.push_back(root);
+
+    // Top-down split with an explicit stack; children of a cell are stored consecutively.
+    std::vector<std::pair<std::int32_t, int>> pending{{0, 0}};
+    while (!pending.empty()) {
+        auto [cellIndex, depth] = pending.back();
+        pending.pop_back();
+
+        Cell cell = m_cells[cellIndex];
+        float sx = 0, sy = 0, ix = 0, iy = 0;
+        std::uint32_t insights = 0;
+        for (std::uint32_t k = cell.begin; k < cell.end; ++k) {
+            const std::uint32_t i = m_order[k];
+            sx += m_x[i]; sy += m_y[i];
+            if (m_isInsight[i]) { ix += m_x[i]; iy += m_y[i]; ++insights; }
+        }
+        cell.count = cell.end - cell.begin;
+        cell.massX = sx / cell.count; cell.massY = sy / cell.count;
+        cell.insightCount = insights;
+        if (insights > 0) { cell.insightX = ix / insights; cell.insightY = iy / insights; }
+
+        if (cell.count > kLeafSize && depth < kMaxDepth) {
+            const float half = cell.size * 0.5f;
+            const float midX = cell.minX + half;
+            const float midY = cell.minY + half;
+            auto first = m_order.begin() + cell.begin;
+            auto last = m_order.begin() + cell.end;
+            auto splitY = std::partition(first, last, [&](std::uint32_t i) { return m_y[i] < midY; });
+            auto splitTop = std::partition(first, splitY, [&](std::uint32_t i) { return m_x[i] < midX; });
+            auto splitBottom = std::partition(splitY, last, [&](std::uint32_t i) { return m_x[i] < midX; });
+
+            const auto offset = [&](auto it) { return static_cast<std::uint32_t>(it - m_order.begin()); };
+            const std::uint32_t bounds[5] = {cell.begin, offset(splitTop), offset(splitY), offset(splitBottom), cell.end};
+            cell.firstChild = static_cast<std::int32_t>(m_cells.size());
+            for (int q = 0; q < 4; ++q) {
+                Cell child;
+                child.minX = (q % 2) ? midX : cell.minX;
+                child.minY = (q / 2) ? midY : cell.minY;
+                child.size = half;
+                child.begin = bounds[q];
+                child.end = bounds[q + 1];
+                m_cells.push_back(child);
+                if (child.end > child.begin) pending.push_back({cell.firstChild + q, depth + 1});
+            }
+        }
+        m_cells[cellIndex] = cell;
+    }
+}
+
+void ForceLayout::accumulateRepulsion() {
+    const std::size_t n = size();
+    const float rOther = m_config.repulsionOther;
+    const float rInsight = m_config.repulsionInsight;
+    const float rInsightExtra = rInsight - rOther;
+    const float theta2 = m_config.theta * m_config.theta;
+
+    // Positions in tree order: leaves are contiguous and neighbouring nodes walk similar paths.
+    m_sortedX.resize(n); m_sortedY.resize(n); m_sortedInsight.resize(n);
+    for (std::size_t k = 0; k < n; ++k) {
+        const std::uint32_t i = m_order[k];
+        m_sortedX[k] = m_x[i];
+        m_sortedY[k] = m_y[i];
+        m_sortedInsight[k] = m_isInsight[i];
+    }
+    const float* xs = m_sortedX.data();
+    const float* ys = m_sortedY.data();
+    const std::uint8_t* insights = m_sortedInsight.data();
+
+    // Pair repulsion is rOther/d, plus rInsightExtra/d when both nodes are insights,
+    // so a far cell acts as two point charges: all its nodes and its insight nodes.
+    // (d / |d|) * (strength / |d|) == d * strength / |d|^2: no square root needed.
+    auto push = [](float dx, float dy, float strength, float& fx, float& fy) {
+        float distSq = dx * dx + dy * dy;
+        if (distSq < kMinDistSq) distSq = kMinDistSq;
+        const float f = strength / distSq;
+        fx += dx * f;
+        fy += dy * f;
+    };
+
+    std::vector<std::int32_t> stack;
+    stack.reserve(64);
+    for (std::size_t k = 0; k < n; ++k) {
+        const float xi = xs[k], yi = ys[k];
+        const bool insight = insights[k] != 0;
+        float fx = 0.0f, fy = 0.0f;
+
+        stack.clear();
+        stack.push_back(0);
+        while (!stack.empty()) {
+            const Cell& cell = m_cells[stack.back()];
+            stack.pop_back();
+            if (cell.count == 0) continue;
+
+            if (cell.firstChild < 0) {
+                for (std::uint32_t j = cell.begin; j < cell.end; ++j) {
+                    if (j == k) continue;
+                    push(xi - xs[j], yi - ys[j], (insight && insights[j]) ? rInsight : rOther, fx, fy);
+                }
+                continue;
+            }
+
+            const bool inside = xi >= cell.minX && xi < cell.minX + cell.size &&
+                                yi >= cell.minY && yi < cell.minY + cell.size;
+            const float dx = xi - cell.massX;
+            const float dy = yi - cell.massY;
+            if (!inside && cell.size * cell.size < theta2 * (dx * dx + dy * dy)) {
+                push(dx, dy, rOther * cell.count, fx, fy);
+                if (insight && cell.insightCount > 0) {
+                    push(xi - cell.insightX, yi - cell.insightY, rInsightExtra * cell.insightCount, fx, fy);
+                }
+                continue;
+            }
+            for (int q = 0; q < 4; ++q) stack.push_back(cell.firstChild + q);
+        }
+        m_fx[m_order[k]] += fx;
+        m_fy[m_order[k]] += fy;
+    }
+}
+
+bool ForceLayout::step() {
+    const std::size_t n = size();
+    if (m_frozen || n == 0) return false;
+
+    std::fill(m_fx.begin(), m_fx.end(), 0.0f);
+    std::fill(m_fy.begin(), m_fy.end(), 0.0f);
+
+    // 1. Repulsion
+    buildTree();
+    accumulateRepulsion();
+
+    // 2. Attraction
+    for (std::size_t s = 0; s < m_springStart.size(); ++s) {
+        const std::uint32_t a = m_springStart[s];
+        const std::uint32_t b = m_springEnd[s];
+        const float dx = m_x[b] - m_x[a];
+        const float dy = m_y[b] - m_y[a];
+        float dist = std::sqrt(dx * dx + dy * dy);
+        if (dist < 1.0f) dist = 1.0f;
+
+        const float force = (dist - m_springLength[s]) * m_config.springK;
+        const float fx = (dx / dist) * force;
+        const float fy = (dy / dist) * force;
+        m_fx[a] += fx; m_fy[a] += fy;
+        m_fx[b] -= fx; m_fy[b] -= fy;
+    }
+
+    // 3. Center Gravity
+    for (std::size_t i = 0; i < n; ++i) {
+        if (m_isTask[i]) continue;
+        const float dx = m_config.centerX - m_x[i];
+        const float dy = m_config.centerY - m_y[i];
+        if (dx * dx + dy * dy > 100.0f) {
+            m_fx[i] += dx * m_config.gravity;
+            m_fy[i] += dy * m_config.gravity;
+        }
+    }
+
+    // 4. Update Positions (+ 5. Bounds Clamping)
+    double energy = 0.0;
+    std::size_t moving = 0;
+    const float maxV = m_config.maxVelocity * m_temperature;
+    const float minX = m_config.centerX - (m_config.centerX - m_config.minX) * m_boundsScale;
+    const float maxX = m_config.centerX + (m_config.maxX - m_config.centerX) * m_boundsScale;
+    const float minY = m_config.centerY - (m_config.centerY - m_config.minY) * m_boundsScale;
+    const float maxY = m_config.centerY + (m_config.maxY - m_config.centerY) * m_boundsScale;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (m_pinned[i]) {
+            m_vx[i] = m_vy[i] = 0.0f;
+            continue;
+        }
+        float vx = (m_vx[i] + m_fx[i]) * m_config.damping;
+        float vy = (m_vy[i] + m_fy[i]) * m_config.damping;
+        const float v = std::sqrt(vx * vx + vy * vy);
+        if (v > maxV) {
+            vx = (vx / v) * maxV;
+            vy = (vy / v) * maxV;
+        }
+
+        float x = m_x[i] + vx;
+        float y = m_y[i] + vy;
+        if (x < minX) { x = minX; vx *= -0.5f; }
+        if (x > maxX) { x = maxX; vx *= -0.5f; }
+        if (y < minY) { y = minY; vy *= -0.5f; }
+        if (y > maxY) { y = maxY; vy *= -0.5f; }
+
+        m_x[i] = x; m_y[i] = y;
+        m_vx[i] = vx; m_vy[i] = vy;
+        energy += vx * vx + vy * vy;
+        ++moving;
+    }
+
+    m_kineticEnergy = moving ? static_cast<float>(energy / moving) : 0.0f;
+    m_temperature *= m_config.cooling;
+    if (m_kineticEnergy < m_config.freezeEnergy || m_temperature < m_config.minTemperature) {
+        m_frozen = true;
+    }
+    return true;
+}
+
+void ForceLayout::writeBack(std::vector<GraphNode>& nodes) const {
+    const std::size_t n = std::min(nodes.size(), size());
+    for (std::size_t i = 0; i < n; ++i) {
+        nodes[i].x = m_x[i];
+        nodes[i].y = m_y[i];
+        nodes[i].vx = m_vx[i];
+        nodes[i].vy = m_vy[i];
+    }
+}
+
+} // namespace ideawalker::application
@@ -0,0 +1,126 @@
+/**
+ * @file ForceLayout.hpp
+ * @brief Force-directed layout for the Neural Web (Barnes–Hut repulsion, SoA state).
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "domain/writing/MermaidGraph.hpp"
+
+namespace ideawalker::application {
+
+/**
+ * @struct ForceLayoutConfig
+ * @brief Tunables of the Neural Web simulation.
+ */
+struct ForceLayoutConfig {
+    float theta = 0.9f;               ///< Barnes–Hut opening angle (0 = exact all-pairs).
+    float repulsionInsight = 1000.0f; ///< Repulsion between two insight nodes.
+    float repulsionOther = 200.0f;    ///< Repulsion for any pair involving another node type.
+    float springLengthInsight = 300.0f;
+    float springLengthTask = 80.0f;
+    float springK = 0.06f;
+    float damping = 0.60f;
+    float gravity = 0.02f;            ///< Pull of non-task nodes towards the center.
+    float maxVelocity = 8.0f;
+    float centerX = 800.0f;
+    float centerY = 450.0f;
+    float minX = 50.0f, maxX = 1550.0f;
+    float minY = 50.0f, maxY = 850.0f;
+    std::size_t boundsReferenceNodes = 200; ///< Bounds grow with sqrt(n / this) for larger graphs.
+    float freezeEnergy = 0.01f;       ///< Mean kinetic energy per node below which the layout freezes.
+    float cooling = 0.985f;           ///< Temperature decay per step (caps velocity; reset on wake).
+    float minTemperature = 0.005f;    ///< Temperature below which the layout freezes.
+};
+
+/**
+ * @class ForceLayout
+ * @brief Simulation state kept as structure-of-arrays, indexed like the node vector it was loaded from.
+ *
+ * Repulsion is approximated with a Barnes–Hut quadtree (O(n log n) per step).
+ * A temperature caps velocities and cools every step; once it (or the mean kinetic
+ * energy) drops below its threshold the layout freezes until something wakes it
+ * (reload, pin moved, config change), so an idle graph costs nothing.
+ */
+class ForceLayout {
+public:
+    explicit ForceLayout(ForceLayoutConfig config = {});
+
+    /**
+     * @brief Replaces the simulated graph (positions and velocities are taken from the nodes).
+     * @param temperature Starting temperature; below 1 warm-starts a mostly laid out graph.
+     */
+    void load(const std::vector<domain::writing::GraphNode>& nodes,
+              const std::vector<domain::writing::GraphLink>& links,
+              float temperature = 1.0f);
+
+    /**
+     * @brief Advances one integration step.
+     * @return False when the layout is frozen (nothing moved).
+     */
+    bool step();
+
+    /** @brief Holds a node at a position (user drag); wakes the layout if it moved. */
+    void pin(std::size_t index, float x, float y);
+    /** @brief Releases a pinned node (wakes the layout). */
+    void unpin(std::size_t index);
+    bool isPinned(std::size_t index) const { return index < m_pinned.size() && m_pinned[index]; }
+
+    void wake() { m_frozen = false; m_temperature = 1.0f; }
+    bool isFrozen() const { return m_frozen; }
+    float kineticEnergy() const { return m_kineticEnergy; }
+    float temperature() const { return m_temperature; }
+
+    void setConfig(const ForceLayoutConfig& config);
+    const ForceLayoutConfig& config() const { return m_config; }
+
+    std::size_t size() const { return m_x.size(); }
+    std::size_t linkCount() const { return m_springStart.size(); }
+    const std::vector<float>& xs() const { return m_x; }
+    const std::vector<float>& ys() const { return m_y; }
+
+    /** @brief Copies positions and velocities back into the node vector it was loaded from. */
+    void writeBack(std::vector<domain::writing::GraphNode>& nodes) const;
+
+private:
+    struct Cell {
+        float minX, minY, size;        // Square bounds
+        float massX = 0, massY = 0;    // Centroid of every node in the cell
+        float insightX = 0, insightY = 0; // Centroid of insight nodes only
+        std::uint32_t count = 0;
+        std::uint32_t insightCount = 0;
+        std::uint32_t begin = 0, end = 0; // Range in m_order (leaves)
+        std::int32_t firstChild = -1;     // Four consecutive children, -1 for leaves
+    };
+
+    void buildTree();
+    void accumulateRepulsion();
+
+    ForceLayoutConfig m_config;
+
+    // Node state (SoA)
+    std::vector<float> m_x, m_y, m_vx, m_vy;
+    std::vector<float> m_fx, m_fy;
+    std::vector<std::uint8_t> m_isInsight;
+    std::vector<std::uint8_t> m_isTask;
+    std::vector<std::uint8_t> m_pinned;
+
+    // Springs (SoA)
+    std::vector<std::uint32_t> m_springStart, m_springEnd;
+    std::vector<float> m_springLength;
+
+    // Quadtree scratch, reused across steps
+    std::vector<Cell> m_cells;
+    std::vector<std::uint32_t> m_order;
+    std::vector<float> m_sortedX, m_sortedY;
+    std::vector<std::uint8_t> m_sortedInsight;
+
+    bool m_frozen = false;
+    float m_kineticEnergy = 0.0f;
+    float m_temperature = 1.0f;
+    float m_boundsScale = 1.0f;
+};
+
+} // namespace ideawalker::application
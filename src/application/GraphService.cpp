@@ -1,6 +1,14 @@
+/**
+ * @file GraphService.cpp
+ * @brief Implementation of GraphService (incremental Neural Web graph and layout).
+ */
+
 #include "application/GraphService.hpp"
+#include "infrastructure/FrameProfiler.hpp"
 #include <cmath>
 #include <algorithm>
+#include <functional>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -8,256 +16,539 @@ namespace ideawalker::application {
 
 using namespace ideawalker::domain::writing;
 
-void GraphService::RebuildGraph(const std::vector<domain::Insight>& insights, 
-                                bool showTasks,
-                                std::vector<GraphNode>& nodes, 
-                                std::vector<GraphLink>& links) {
+GraphService::GraphService(std::shared_ptr<AsyncTaskManager> taskManager) {
+    if (taskManager) {
+        m_simulation = std::make_unique<GraphSimulation>(std::move(taskManager), m_layout.config());
+    }
+}
+
+namespace {
+constexpr float kTwoPi = 6.2831853f;
+constexpr std::size_t kMinMentionTitle = 4; ///< Shorter titles produce too many false mentions.
+constexpr float kWarmStartTemperature = 0.3f;
+
+std::size_t Fingerprint(const domain::Insight& insight) {
+    const std::hash<std::string_view> hash;
+    std::size_t seed = hash(insight.getMetadata().title);
+    auto mix = [&seed](std::size_t value) { seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2); };
+    for (const auto& tag : insight.getMetadata().tags) mix(hash(tag));
+    for (const auto& alias : insight.getMetadata().aliases) mix(hash(alias));
+    // Repository notes carry an mtime/size stamp; only unstamped ones are hashed in full.
+    const std::uint64_t revision = insight.getMetadata().revision;
+    mix(revision != 0 ? static_cast<std::size_t>(revision) : hash(insight.getContent()));
+    return seed;
+}
+
+bool IsHypothesis(const domain::Insight& insight) {
+    for (const auto& tag : insight.getMetadata().tags) {
+        std::string t = tag;
+        std::transform(t.begin(), t.end(), t.begin(), ::tolower);
+        if (t.find("hypothe") != std::string::npos || t.find("hipote") != std::string::npos) return true;
+    }
+    return false;
+}
+
+std::string TrimTarget(std::string target) {
+    target.erase(0, target.find_first_not_of(" \t\n\r"));
+    const size_t end = target.find_last_not_of(" \t\n\r");
+    if (end != std::string::npos) target.erase(end + 1);
+    return target;
+}
+
+/** @brief Deterministic angle in [0, 2pi) for a key (same key, same spot). */
+float AngleFor(const std::string& key, unsigned salt = 0) {
+    const std::size_t h = std::hash<std::string>{}(key) ^ (salt * 0x9e3779b9u);
+    return static_cast<float>(h % 3600) / 3600.0f * kTwoPi;
+}
+} // namespace
+
+/**
+ * Node and link vector edits collected while applying changes. Removals are applied
+ * in one pass at the end; ids freed here are only recycled by the next edit.
+ */
+struct GraphService::GraphEdit {
+    std::vector<GraphNode>& nodes;
+    std::unordered_map<int, std::size_t> index;
+    std::unordered_set<int> removedNodes;
+    std::unordered_set<int> removedLinks;
+    std::vector<GraphLink> addedLinks;
+    std::vector<int> freedIds;
+
+    explicit GraphEdit(std::vector<GraphNode>& target) : nodes(target) {
+        index.reserve(nodes.size());
+        for (std::size_t i = 0; i < nodes.size(); ++i) index[nodes[i].id] = i;
+    }
+
+    GraphNode* find(int id) {
+        auto it = index.find(id);
+        return it == index.end() ? nullptr : &nodes[it->second];
+    }
+
+    GraphNode& add(GraphNode node) {
+        node.vx = node.vy = 0.0f;
+        index[node.id] = nodes.size();
+        nodes.push_back(std::move(node));
+        return nodes.back();
+    }
+
+    void removeNode(int id) {
+        removedNodes.insert(id);
+        freedIds.push_back(id);
+        index.erase(id);
+    }
+};
+
+int GraphService::AllocateNodeId() {
+    if (!m_freeNodeIds.empty()) {
+        const int id = m_freeNodeIds.back();
+        m_freeNodeIds.pop_back();
+        return id;
+    }
+    return m_nextNodeId++;
+}
+
+int GraphService::AllocateLinkId() {
+    return m_nextLinkId++;
+}
+
+void GraphService::ResetGraph(std::vector<GraphNode>& nodes, std::vector<GraphLink>& links) {
     nodes.clear();
     links.clear();
+    m_notes.clear();
+    m_nameToNote.clear();
+    m_concepts.clear();
+    m_referrers.clear();
+    m_noteByNode.clear();
+    m_titleMatcher = domain::MentionMatcher{};
+    m_freeNodeIds.clear();
+    m_nextNodeId = 0;
+    m_nextLinkId = 0;
+    m_nodeCount = m_linkCount = 0;
+    m_layoutDirty = true;
+    m_loadTemperature = 1.0f;
+}
 
-    if (insights.empty()) return;
+void GraphService::SyncGraph(const std::vector<domain::Insight>& insights,
+                             bool showTasks,
+                             std::vector<GraphNode>& nodes,
+                             std::vector<GraphLink>& links) {
+    infrastructure::ProfileZone zone("GraphService::SyncGraph");
+    // Someone else rewrote the vectors (or another graph was shown): start over.
+    if (nodes.size() != m_nodeCount || links.size() != m_linkCount) ResetGraph(nodes, links);
 
-    std::unordered_map<std::string, int> nameToId;
-    int nextId = 0;
-    int linkIdCounter = 0;
+    const bool tasksToggled = (showTasks != m_showTasks);
+    m_showTasks = showTasks;
 
-    // 1. Create Nodes and internal Task Links
+    std::vector<const domain::Insight*> changed;
+    std::unordered_set<std::string_view> present;
+    present.reserve(insights.size());
     for (const auto& insight : insights) {
-        GraphNode node;
-        node.id = nextId++;
-        node.type = NodeType::INSIGHT;
-        node.title = insight.getMetadata().title.empty() ? insight.getMetadata().id : insight.getMetadata().title;
-        
-        // Detect Hypothesis Nodes
-        for (const auto& tag : insight.getMetadata().tags) {
-            std::string t = tag;
-            std::transform(t.begin(), t.end(), t.begin(), ::tolower);
-            if (t.find("hypothe") != std::string::npos || t.find("hipote") != std::string::npos) {
-                node.type = NodeType::HYPOTHESIS;
-                break;
-            }
+        const std::string& id = insight.getMetadata().id;
+        present.insert(id);
+        auto it = m_notes.find(id);
+        if (it == m_notes.end() || tasksToggled || it->second.fingerprint != Fingerprint(insight)) {
+            changed.push_back(&insight);
         }
-        
-        float angle = (float(node.id) / insights.size()) * 2.0f * 3.14159f;
-        float radius = 100.0f + (rand() % 200); 
-        node.x = 800.0f + std::cos(angle) * radius;
-        node.y = 450.0f + std::sin(angle) * radius;
-        node.vx = node.vy = 0.0f;
+    }
+    std::vector<std::string> removed;
+    for (const auto& [id, note] : m_notes) {
+        if (!present.count(id)) removed.push_back(id);
+    }
+
+    if (changed.empty() && removed.empty()) return;
+    ApplyChanges(changed, removed, insights, nodes, links);
+}
+
+void GraphService::UpdateNote(const std::vector<domain::Insight>& insights,
+                              const std::string& noteId,
+                              std::vector<GraphNode>& nodes,
+                              std::vector<GraphLink>& links) {
+    if (nodes.size() != m_nodeCount || links.size() != m_linkCount) {
+        SyncGraph(insights, m_showTasks, nodes, links);
+        return;
+    }
 
-        nodes.push_back(node);
-        int parentId = node.id;
-        
-        nameToId[insight.getMetadata().id] = node.id;
-        if (!insight.getMetadata().title.empty()) {
-            nameToId[insight.getMetadata().title] = node.id;
+    auto insight = std::find_if(insights.begin(), insights.end(),
+        [&noteId](const domain::Insight& i) { return i.getMetadata().id == noteId; });
+    if (insight == insights.end()) {
+        if (m_notes.count(noteId)) ApplyChanges({}, {noteId}, insights, nodes, links);
+        return;
+    }
+    auto it = m_notes.find(noteId);
+    if (it != m_notes.end() && it->second.fingerprint == Fingerprint(*insight)) return;
+    ApplyChanges({&*insight}, {}, insights, nodes, links);
+}
+
+void GraphService::ApplyChanges(const std::vector<const domain::Insight*>& changed,
+                                const std::vector<std::string>& removed,
+                                const std::vector<domain::Insight>& insights,
+                                std::vector<GraphNode>& nodes,
+                                std::vector<GraphLink>& links) {
+    GraphEdit edit(nodes);
+    std::set<std::string> touchedNames; // Names whose resolution may have changed
+    std::set<std::string> relink;       // Notes whose links are recomputed
+    bool titlesChanged = false;
+    const bool fresh = m_notes.empty();
+
+    auto registerName = [&](const std::string& name, const std::string& noteId) {
+        m_nameToNote[name] = noteId;
+        touchedNames.insert(name);
+    };
+    auto unregisterName = [&](const std::string& name, const std::string& noteId) {
+        auto it = m_nameToNote.find(name);
+        if (it != m_nameToNote.end() && it->second == noteId) m_nameToNote.erase(it);
+        touchedNames.insert(name);
+    };
+    // 1. Removed notes give back their nodes, links, names and ghost references.
+    for (const auto& id : removed) {
+        auto it = m_notes.find(id);
+        if (it == m_notes.end()) continue;
+        NoteRecord& note = it->second;
+        for (int link : note.links) edit.removedLinks.insert(link);
+        for (const auto& name : note.concepts) ReleaseConcept(name, edit);
+        for (const auto& ref : note.references) {
+            auto referrers = m_referrers.find(ref);
+            if (referrers == m_referrers.end()) continue;
+            referrers->second.erase(id);
+            if (referrers->second.empty()) m_referrers.erase(referrers);
         }
+        for (int task : note.taskNodes) edit.removeNode(task);
+        edit.removeNode(note.nodeId);
+        m_noteByNode.erase(note.nodeId);
+        unregisterName(id, id);
+        if (!note.title.empty()) unregisterName(note.title, id);
+        for (const auto& alias : note.aliases) unregisterName(alias, id);
+        titlesChanged |= m_titleMatcher.removePatterns(id);
+        m_notes.erase(it);
+    }
 
-        // Add Tasks as sub-nodes if enabled
-        if (showTasks) {
-            for (const auto& task : insight.getActionables()) {
-                GraphNode taskNode;
-                taskNode.id = nextId++;
-                taskNode.type = NodeType::TASK;
-                taskNode.title = task.description;
-                taskNode.isCompleted = task.isCompleted;
-                taskNode.isInProgress = task.isInProgress;
-
-                float tAngle = (float(rand()) / RAND_MAX) * 2.0f * 3.14159f;
-                taskNode.x = node.x + std::cos(tAngle) * 50.0f;
-                taskNode.y = node.y + std::sin(tAngle) * 50.0f;
-                taskNode.vx = taskNode.vy = 0.0f;
-
-                nodes.push_back(taskNode);
-                links.push_back({linkIdCounter++, parentId, taskNode.id});
+    // 2. Changed and new notes: node, names and wikilink targets (tasks come after placement).
+    std::vector<std::string> newNotes;
+    for (const domain::Insight* insight : changed) {
+        const auto& meta = insight->getMetadata();
+        auto [it, inserted] = m_notes.try_emplace(meta.id);
+        NoteRecord& note = it->second;
+
+        if (inserted) {
+            GraphNode node{};
+            node.id = note.nodeId = AllocateNodeId();
+            edit.add(node);
+            m_noteByNode[note.nodeId] = meta.id;
+            registerName(meta.id, meta.id);
+            newNotes.push_back(meta.id);
+        }
+        if (inserted || note.title != meta.title || note.aliases != meta.aliases) {
+            if (!note.title.empty() && note.title != meta.id) unregisterName(note.title, meta.id);
+            for (const auto& alias : note.aliases) {
+                if (alias != meta.id) unregisterName(alias, meta.id);
             }
+            if (!meta.title.empty()) registerName(meta.title, meta.id);
+            for (const auto& alias : meta.aliases) registerName(alias, meta.id);
+            note.title = meta.title;
+            note.aliases = meta.aliases;
+
+            std::vector<std::string> patterns;
+            if (note.title.size() >= kMinMentionTitle) patterns.push_back(note.title);
+            for (const auto& alias : note.aliases) {
+                if (alias.size() >= kMinMentionTitle) patterns.push_back(alias);
+            }
+            titlesChanged |= m_titleMatcher.setPatterns(meta.id, std::move(patterns), note.nodeId);
+        }
+        note.fingerprint = Fingerprint(*insight);
+
+        GraphNode* node = edit.find(note.nodeId);
+        node->title = meta.title.empty() ? meta.id : meta.title;
+        node->type = IsHypothesis(*insight) ? NodeType::HYPOTHESIS : NodeType::INSIGHT;
+
+        std::vector<std::string> references;
+        std::unordered_set<std::string> seen;
+        for (const auto& raw : domain::Insight::extractReferences(insight->getContent())) {
+            std::string target = TrimTarget(raw);
+            if (!target.empty() && seen.insert(target).second) references.push_back(std::move(target));
+        }
+        for (const auto& ref : note.references) {
+            if (seen.count(ref)) continue;
+            auto referrers = m_referrers.find(ref);
+            if (referrers == m_referrers.end()) continue;
+            referrers->second.erase(meta.id);
+            if (referrers->second.empty()) m_referrers.erase(referrers);
         }
+        for (const auto& ref : references) m_referrers[ref].insert(meta.id);
+        note.references = std::move(references);
+        relink.insert(meta.id);
     }
 
-    // 2. Create Cross-Note Links
-    std::vector<std::pair<std::string, int>> searchableTitles;
-    for (const auto& insight : insights) {
-        std::string title = insight.getMetadata().title;
-        if (title.length() >= 4) {
-            searchableTitles.push_back({title, nameToId[title]});
+    // 3. Notes citing a name that now resolves differently (note created, renamed, deleted).
+    for (const auto& name : touchedNames) {
+        for (const auto& key : {name, name.size() > 3 && name.compare(name.size() - 3, 3, ".md") == 0
+                                           ? name.substr(0, name.size() - 3) : std::string()}) {
+            if (key.empty()) continue;
+            auto referrers = m_referrers.find(key);
+            if (referrers != m_referrers.end()) relink.insert(referrers->second.begin(), referrers->second.end());
         }
     }
 
-    for (const auto& insight : insights) {
-        std::string content = insight.getContent();
-        std::string sourceName = insight.getMetadata().id;
-        int sourceId = nameToId[sourceName];
-
-        // Explicit [[Wikilinks]]
-        const_cast<domain::Insight&>(insight).parseReferencesFromContent();
-        
-        std::unordered_set<int> linkedNodes;
-        for (const auto& ref : insight.getReferences()) {
-            std::string targetName = ref;
-            targetName.erase(0, targetName.find_first_not_of(" \t\n\r"));
-            size_t end = targetName.find_last_not_of(" \t\n\r");
-            if (end != std::string::npos) targetName.erase(end + 1);
-            
-            if (targetName.empty()) continue;
-
-            int targetId = -1;
-            auto it = nameToId.find(targetName);
-            if (it == nameToId.end()) it = nameToId.find(targetName + ".md");
-
-            if (it != nameToId.end()) {
-                targetId = it->second;
-            } else {
-                // Ghost Node Creation
-                GraphNode conceptNode;
-                conceptNode.id = nextId++;
-                conceptNode.type = NodeType::CONCEPT;
-                conceptNode.title = targetName;
-                
-                float angle = (float(rand()) / RAND_MAX) * 2.0f * 3.14159f;
-                conceptNode.x = nodes[sourceId].x + std::cos(angle) * 150.0f;
-                conceptNode.y = nodes[sourceId].y + std::sin(angle) * 150.0f;
-                conceptNode.vx = conceptNode.vy = 0.0f;
-
-                nodes.push_back(conceptNode);
-                targetId = conceptNode.id;
-                nameToId[targetName] = targetId;
+    // 4. Title mentions: only the changed notes, unless the title/alias set itself changed.
+    if (titlesChanged) {
+        m_titleMatcher.compile();
+        for (const auto& insight : insights) {
+            auto it = m_notes.find(insight.getMetadata().id);
+            if (it == m_notes.end()) continue;
+            auto mentions = ScanMentions(it->first, insight.getContent());
+            if (mentions != it->second.mentions) {
+                it->second.mentions = std::move(mentions);
+                relink.insert(it->first);
             }
+        }
+    } else {
+        for (const domain::Insight* insight : changed) {
+            auto& note = m_notes[insight->getMetadata().id];
+            note.mentions = ScanMentions(insight->getMetadata().id, insight->getContent());
+        }
+    }
 
-            if (targetId != sourceId && targetId != -1) {
-                if (linkedNodes.find(targetId) == linkedNodes.end()) {
-                    links.push_back({linkIdCounter++, sourceId, targetId});
-                    linkedNodes.insert(targetId);
-                }
+    // 5. New notes start next to a note they point at, or on a ring around the center.
+    const auto& config = m_layout.config();
+    for (const auto& id : newNotes) {
+        const NoteRecord& note = m_notes[id];
+        const GraphNode* anchor = nullptr;
+        for (const auto& ref : note.references) {
+            auto target = m_nameToNote.find(ref);
+            if (target == m_nameToNote.end()) target = m_nameToNote.find(ref + ".md");
+            if (target == m_nameToNote.end() || target->second == id) continue;
+            if (std::find(newNotes.begin(), newNotes.end(), target->second) != newNotes.end()) continue;
+            anchor = edit.find(m_notes[target->second].nodeId);
+            if (anchor) break;
+        }
+        for (size_t i = 0; !anchor && i < note.mentions.size(); ++i) {
+            auto other = m_noteByNode.find(note.mentions[i]);
+            if (other != m_noteByNode.end() &&
+                std::find(newNotes.begin(), newNotes.end(), other->second) == newNotes.end()) {
+                anchor = edit.find(note.mentions[i]);
             }
         }
+        GraphNode* node = edit.find(note.nodeId);
+        const float angle = AngleFor(id);
+        const float radius = anchor ? 120.0f : 100.0f + static_cast<float>(std::hash<std::string>{}(id) % 200);
+        node->x = (anchor ? anchor->x : config.centerX) + std::cos(angle) * radius;
+        node->y = (anchor ? anchor->y : config.centerY) + std::sin(angle) * radius;
+    }
 
-        // Implicit Semantic Links
-        for (const auto& [title, targetId] : searchableTitles) {
-            if (targetId == sourceId) continue;
-            if (linkedNodes.find(targetId) != linkedNodes.end()) continue;
-
-            if (content.find(title) != std::string::npos) {
-                links.push_back({linkIdCounter++, sourceId, targetId});
-                linkedNodes.insert(targetId);
+    // 6. Task sub-nodes: reuse ids (and positions) of the first tasks, add or drop the rest.
+    for (const domain::Insight* insight : changed) {
+        NoteRecord& note = m_notes[insight->getMetadata().id];
+        static const std::vector<domain::Actionable> kNoTasks;
+        const auto& tasks = m_showTasks ? insight->getActionables() : kNoTasks;
+        while (note.taskNodes.size() > tasks.size()) {
+            edit.removeNode(note.taskNodes.back());
+            note.taskNodes.pop_back();
+        }
+        const GraphNode parent = *edit.find(note.nodeId);
+        for (size_t i = 0; i < tasks.size(); ++i) {
+            GraphNode* taskNode = nullptr;
+            if (i < note.taskNodes.size()) {
+                taskNode = edit.find(note.taskNodes[i]);
+            } else {
+                GraphNode node{};
+                node.id = AllocateNodeId();
+                node.type = NodeType::TASK;
+                const float angle = AngleFor(insight->getMetadata().id, static_cast<unsigned>(i) + 1);
+                node.x = parent.x + std::cos(angle) * 50.0f;
+                node.y = parent.y + std::sin(angle) * 50.0f;
+                note.taskNodes.push_back(node.id);
+                taskNode = &edit.add(node);
             }
+            taskNode->title = tasks[i].description;
+            taskNode->isCompleted = tasks[i].isCompleted;
+            taskNode->isInProgress = tasks[i].isInProgress;
         }
     }
+
+    // 7. Links of every affected note.
+    for (const auto& id : relink) {
+        auto it = m_notes.find(id);
+        if (it != m_notes.end()) RelinkNote(it->second, edit);
+    }
+
+    // 8. Apply removals in one pass and hand the vectors back.
+    if (!edit.removedNodes.empty()) {
+        nodes.erase(std::remove_if(nodes.begin(), nodes.end(),
+            [&edit](const GraphNode& node) { return edit.removedNodes.count(node.id) > 0; }), nodes.end());
+    }
+    if (!edit.removedLinks.empty() || !edit.removedNodes.empty()) {
+        links.erase(std::remove_if(links.begin(), links.end(), [&edit](const GraphLink& link) {
+            return edit.removedLinks.count(link.id) || edit.removedNodes.count(link.startNode) ||
+                   edit.removedNodes.count(link.endNode);
+        }), links.end());
+    }
+    links.insert(links.end(), edit.addedLinks.begin(), edit.addedLinks.end());
+    m_freeNodeIds.insert(m_freeNodeIds.end(), edit.freedIds.begin(), edit.freedIds.end());
+
+    m_nodeCount = nodes.size();
+    m_linkCount = links.size();
+    m_layoutDirty = true;
+    // A mostly unchanged graph only needs to settle locally, so do not shake it from full heat.
+    m_loadTemperature = fresh ? 1.0f : kWarmStartTemperature;
+}
+
+std::vector<int> GraphService::ScanMentions(const std::string& noteId, const std::string& content) const {
+    auto mentions = m_titleMatcher.findPayloads(content);
+    auto self = m_notes.find(noteId);
+    if (self != m_notes.end()) {
+        mentions.erase(std::remove(mentions.begin(), mentions.end(), self->second.nodeId), mentions.end());
+    }
+    return mentions;
+}
+
+void GraphService::RelinkNote(NoteRecord& note, GraphEdit& edit) {
+    for (int link : note.links) edit.removedLinks.insert(link);
+    note.links.clear();
+    std::vector<std::string> previousConcepts;
+    previousConcepts.swap(note.concepts);
+
+    auto addLink = [&](int target) {
+        const int id = AllocateLinkId();
+        edit.addedLinks.push_back({id, note.nodeId, target});
+        note.links.push_back(id);
+    };
+
+    for (int task : note.taskNodes) addLink(task);
+
+    // Explicit [[Wikilinks]] first, then implicit title mentions.
+    const GraphNode source = *edit.find(note.nodeId);
+    std::unordered_set<int> linked;
+    for (const auto& ref : note.references) {
+        const int target = ResolveTarget(ref, note.concepts, edit, &source);
+        if (target != note.nodeId && linked.insert(target).second) addLink(target);
+    }
+    for (int target : note.mentions) {
+        if (target != note.nodeId && linked.insert(target).second) addLink(target);
+    }
+
+    // Released last so ghosts still cited by this note keep their node (and position).
+    for (const auto& name : previousConcepts) ReleaseConcept(name, edit);
 }
 
-void GraphService::UpdatePhysics(std::vector<GraphNode>& nodes, 
+int GraphService::ResolveTarget(const std::string& target, std::vector<std::string>& conceptsOut,
+                                GraphEdit& edit, const GraphNode* near) {
+    auto note = m_nameToNote.find(target);
+    if (note == m_nameToNote.end()) note = m_nameToNote.find(target + ".md");
+    if (note != m_nameToNote.end()) return m_notes[note->second].nodeId;
+
+    // Ghost node for a concept without a note of its own.
+    ConceptRecord& concept = m_concepts[target];
+    if (concept.nodeId < 0) {
+        GraphNode node{};
+        node.id = concept.nodeId = AllocateNodeId();
+        node.type = NodeType::CONCEPT;
+        node.title = target;
+        const float angle = AngleFor(target);
+        node.x = (near ? near->x : m_layout.config().centerX) + std::cos(angle) * 150.0f;
+        node.y = (near ? near->y : m_layout.config().centerY) + std::sin(angle) * 150.0f;
+        edit.add(node);
+    }
+    ++concept.refs;
+    conceptsOut.push_back(target);
+    return concept.nodeId;
+}
+
+void GraphService::ReleaseConcept(const std::string& name, GraphEdit& edit) {
+    auto it = m_concepts.find(name);
+    if (it == m_concepts.end()) return;
+    if (--it->second.refs > 0) return;
+    edit.removeNode(it->second.nodeId);
+    m_concepts.erase(it);
+}
+
+bool GraphService::UpdatePhysics(std::vector<GraphNode>& nodes, 
                                  const std::vector<GraphLink>& links,
                                  const std::unordered_set<int>& selectedNodes) {
-    const float repulsionInsight = 1000.0f; 
-    const float repulsionTask = 200.0f;
-    const float springLengthInsight = 300.0f;
-    const float springLengthTask = 80.0f;
-    const float springK = 0.06f;
-    const float damping = 0.60f;
-    const float centerX = 800.0f;
-    const float centerY = 450.0f;
-
-    std::vector<std::pair<float, float>> forces(nodes.size(), {0.0f, 0.0f});
-
-    // 1. Repulsion
-    for (size_t i = 0; i < nodes.size(); ++i) {
-        for (size_t j = i + 1; j < nodes.size(); ++j) {
-            float dx = nodes[i].x - nodes[j].x;
-            float dy = nodes[i].y - nodes[j].y;
-            float distSq = dx*dx + dy*dy;
-            if (distSq < 400.0f) distSq = 400.0f; 
-
-            float dist = std::sqrt(distSq);
-            float r = (nodes[i].type == NodeType::INSIGHT && nodes[j].type == NodeType::INSIGHT) 
-                      ? repulsionInsight : repulsionTask;
-            
-            float force = r / dist; 
-            float fx = (dx / dist) * force;
-            float fy = (dy / dist) * force;
-
-            forces[i].first += fx;
-            forces[i].second += fy;
-            forces[j].first -= fx;
-            forces[j].second -= fy;
-        }
-    }
+    infrastructure::ProfileZone zone("GraphService::UpdatePhysics");
+    if (m_simulation) return PullSimulation(nodes, links, selectedNodes);
 
-    // 2. Attraction
-    for (const auto& link : links) {
-        if (link.startNode >= (int)nodes.size() || link.endNode >= (int)nodes.size()) continue;
-
-        GraphNode& n1 = nodes[link.startNode];
-        GraphNode& n2 = nodes[link.endNode];
-
-        float dx = n2.x - n1.x;
-        float dy = n2.y - n1.y;
-        float dist = std::sqrt(dx*dx + dy*dy);
-        if (dist < 1.0f) dist = 1.0f;
-
-        float targetLen = (n1.type == NodeType::TASK || n2.type == NodeType::TASK) 
-                          ? springLengthTask : springLengthInsight;
-        
-        float force = (dist - targetLen) * springK;
-        float fx = (dx / dist) * force;
-        float fy = (dy / dist) * force;
-
-        forces[link.startNode].first += fx;
-        forces[link.startNode].second += fy;
-        forces[link.endNode].first -= fx;
-        forces[link.endNode].second -= fy;
+    if (m_layoutDirty || m_layout.size() != nodes.size()) {
+        m_layout.load(nodes, links, m_loadTemperature);
+        m_layoutDirty = false;
     }
 
-    // 3. Center Gravity
+    // Dragged nodes are pinned where the user holds them.
     for (size_t i = 0; i < nodes.size(); ++i) {
-        if (nodes[i].type == NodeType::TASK) continue;
-
-        float dx = centerX - nodes[i].x;
-        float dy = centerY - nodes[i].y;
-        float dist = std::sqrt(dx*dx + dy*dy);
-        
-        if (dist > 10.0f) {
-            float strength = 0.02f; 
-            forces[i].first += (dx / dist) * dist * strength; 
-            forces[i].second += (dy / dist) * dist * strength;
+        if (selectedNodes.count(nodes[i].id)) {
+            m_layout.pin(i, nodes[i].x, nodes[i].y);
+        } else {
+            m_layout.unpin(i);
         }
     }
 
-    // 4. Update Positions
-    for (size_t i = 0; i < nodes.size(); ++i) {
-        auto& node = nodes[i];
-        
-        node.vx = (node.vx + forces[i].first) * damping;
-        node.vy = (node.vy + forces[i].second) * damping;
-
-        float v = std::sqrt(node.vx*node.vx + node.vy*node.vy);
-        const float maxV = 8.0f;
-        if (v > maxV) {
-            node.vx = (node.vx / v) * maxV;
-            node.vy = (node.vy / v) * maxV;
-        }
+    if (!m_layout.step()) return false;
+    m_layout.writeBack(nodes);
+    return true;
+}
 
-        if (selectedNodes.find(node.id) != selectedNodes.end()) {
-            node.vx = 0;
-            node.vy = 0;
-            continue; 
+bool GraphService::PullSimulation(std::vector<GraphNode>& nodes,
+                                  const std::vector<GraphLink>& links,
+                                  const std::unordered_set<int>& selectedNodes) {
+    if (m_layoutDirty) {
+        m_generation = m_simulation->load(nodes, links, m_loadTemperature);
+        m_pins.clear();
+        m_layoutDirty = false;
+    }
+
+    // Drags become pin commands (only when the held position changes).
+    if (!selectedNodes.empty()) {
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            if (!selectedNodes.count(nodes[i].id)) continue;
+            const std::pair<float, float> position{nodes[i].x, nodes[i].y};
+            auto it = m_pins.find(i);
+            if (it == m_pins.end() || it->second != position) {
+                m_simulation->pin(i, position.first, position.second);
+                m_pins[i] = position;
+            }
+        }
+    }
+    for (auto it = m_pins.begin(); it != m_pins.end();) {
+        if (it->first >= nodes.size() || !selectedNodes.count(nodes[it->first].id)) {
+            m_simulation->unpin(it->first);
+            it = m_pins.erase(it);
+        } else {
+            ++it;
         }
+    }
 
-        node.x += node.vx;
-        node.y += node.vy;
+    if (!m_simulation->acquireLatest()) return false;
+    const LayoutSnapshot& snapshot = m_simulation->latest();
+    if (snapshot.generation != m_generation || snapshot.x.size() != nodes.size()) return false;
 
-        // 5. Bounds Clamping
-        if (node.x < 50.0f) { node.x = 50.0f; node.vx *= -0.5f; }
-        if (node.x > 1550.0f) { node.x = 1550.0f; node.vx *= -0.5f; }
-        if (node.y < 50.0f) { node.y = 50.0f; node.vy *= -0.5f; }
-        if (node.y > 850.0f) { node.y = 850.0f; node.vy *= -0.5f; }
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        if (m_pins.count(i)) continue; // The UI owns dragged nodes
+        nodes[i].x = snapshot.x[i];
+        nodes[i].y = snapshot.y[i];
     }
+    return true;
+}
+
+void GraphService::SetLayoutConfig(const ForceLayoutConfig& config) {
+    m_layout.setConfig(config);
+    if (m_simulation) m_simulation->setConfig(config);
+}
+
+bool GraphService::IsLayoutSettled() const {
+    return m_simulation ? !m_simulation->isRunning() : m_layout.isFrozen();
 }
 
 void GraphService::CenterGraph(std::vector<GraphNode>& nodes) {
-    for (auto& node : nodes) {
-        node.x = 800.0f + (rand() % 100 - 50);
-        node.y = 450.0f + (rand() % 100 - 50);
-        node.vx = 0;
-        node.vy = 0;
+    // Golden-angle spiral: compact, deterministic and without coincident nodes.
+    const auto& config = m_layout.config();
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        const float angle = static_cast<float>(i) * 2.3999632f;
+        const float radius = 4.0f * std::sqrt(static_cast<float>(i));
+        nodes[i].x = config.centerX + std::cos(angle) * radius;
+        nodes[i].y = config.centerY + std::sin(angle) * radius;
+        nodes[i].vx = 0;
+        nodes[i].vy = 0;
     }
+    m_layoutDirty = true;
+    m_loadTemperature = 1.0f;
 }
 
 } // namespace ideawalker::application
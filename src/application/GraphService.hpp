@@ -5,27 +5,65 @@
 
 #pragma once
 
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
 #include <vector>
 #include <unordered_set>
 #include "domain/Insight.hpp"
+#include "domain/MentionMatcher.hpp"
 #include "domain/writing/MermaidGraph.hpp"
+#include "application/ForceLayout.hpp"
+#include "application/GraphSimulation.hpp"
 
 namespace ideawalker::application {
 
 class GraphService {
 public:
     /**
-     * @brief Rebuilds the graph nodes and links based on the provided insights.
+     * @param taskManager When given, the layout runs off the render thread (GraphSimulation);
+     *                    otherwise UpdatePhysics steps it synchronously.
      */
-    void RebuildGraph(const std::vector<domain::Insight>& insights, 
-                      bool showTasks,
-                      std::vector<domain::writing::GraphNode>& nodes, 
-                      std::vector<domain::writing::GraphLink>& links);
+    explicit GraphService(std::shared_ptr<AsyncTaskManager> taskManager = nullptr);
+
+    /**
+     * @brief Brings the graph in line with the provided insights, incrementally.
+     *
+     * Notes are diffed against what the graph was built from (by fingerprint: metadata
+     * plus the repository revision stamp, or the content for unstamped notes); only
+     * changed, added or removed notes touch their own nodes and links. Existing nodes
+     * keep their ids and positions, new nodes are placed next to their neighbours.
+     */
+    void SyncGraph(const std::vector<domain::Insight>& insights,
+                   bool showTasks,
+                   std::vector<domain::writing::GraphNode>& nodes,
+                   std::vector<domain::writing::GraphLink>& links);
+
+    /**
+     * @brief Re-reads a single note (removed from the graph if it is no longer in insights).
+     *
+     * Costs O(that note) unless its title changed, in which case every note is rescanned
+     * once for mentions of the new title set.
+     */
+    void UpdateNote(const std::vector<domain::Insight>& insights,
+                    const std::string& noteId,
+                    std::vector<domain::writing::GraphNode>& nodes,
+                    std::vector<domain::writing::GraphLink>& links);
+
+    /** @brief Drops the incremental state; the next sync rebuilds from scratch. */
+    void ResetGraph(std::vector<domain::writing::GraphNode>& nodes,
+                    std::vector<domain::writing::GraphLink>& links);
 
     /**
-     * @brief Updates the physics simulation for the graph.
+     * @brief Advances the layout (selected nodes stay pinned).
+     *
+     * With a background simulation this only forwards drags as pin commands and copies
+     * the newest published positions into the nodes; it never steps on the caller's thread.
+     * @return True if positions changed; false once the layout has settled.
      */
-    void UpdatePhysics(std::vector<domain::writing::GraphNode>& nodes, 
+    bool UpdatePhysics(std::vector<domain::writing::GraphNode>& nodes, 
                        const std::vector<domain::writing::GraphLink>& links,
                        const std::unordered_set<int>& selectedNodes);
 
@@ -33,6 +71,74 @@ public:
      * @brief Resets node positions to the center.
      */
     void CenterGraph(std::vector<domain::writing::GraphNode>& nodes);
+
+    /** @brief Simulation tunables (Barnes–Hut theta, freeze threshold, ...). Wakes the layout. */
+    void SetLayoutConfig(const ForceLayoutConfig& config);
+    const ForceLayoutConfig& GetLayoutConfig() const { return m_layout.config(); }
+
+    /** @brief True when the layout has converged and costs nothing per frame. */
+    bool IsLayoutSettled() const;
+
+private:
+    /** @brief What the graph holds for one note. */
+    struct NoteRecord {
+        std::size_t fingerprint = 0;
+        int nodeId = -1;
+        std::string title;                    ///< Metadata title (may be empty).
+        std::vector<std::string> aliases;     ///< Front matter aliases (also resolve wikilinks).
+        std::vector<int> taskNodes;
+        std::vector<std::string> references;  ///< Trimmed, distinct wikilink targets.
+        std::vector<std::string> concepts;    ///< Ghost nodes this note holds a reference on.
+        std::vector<int> mentions;            ///< Notes (by node id) whose title appears in the content.
+        std::vector<int> links;               ///< Link ids owned by this note.
+    };
+
+    /** @brief Ghost node for a wikilink target that is not a note. */
+    struct ConceptRecord {
+        int nodeId = -1;
+        std::size_t refs = 0;
+    };
+
+    /** @brief Pending edits to the node/link vectors, applied in one pass. */
+    struct GraphEdit;
+
+    void ApplyChanges(const std::vector<const domain::Insight*>& changed,
+                      const std::vector<std::string>& removed,
+                      const std::vector<domain::Insight>& insights,
+                      std::vector<domain::writing::GraphNode>& nodes,
+                      std::vector<domain::writing::GraphLink>& links);
+    std::vector<int> ScanMentions(const std::string& noteId, const std::string& content) const;
+    void RelinkNote(NoteRecord& note, GraphEdit& edit);
+    int ResolveTarget(const std::string& target, std::vector<std::string>& conceptsOut, GraphEdit& edit,
+                      const domain::writing::GraphNode* near);
+    void ReleaseConcept(const std::string& name, GraphEdit& edit);
+    int AllocateNodeId();
+    int AllocateLinkId();
+
+    bool PullSimulation(std::vector<domain::writing::GraphNode>& nodes,
+                        const std::vector<domain::writing::GraphLink>& links,
+                        const std::unordered_set<int>& selectedNodes);
+
+    // Incremental graph model (keyed by note id)
+    std::map<std::string, NoteRecord> m_notes;
+    std::unordered_map<std::string, std::string> m_nameToNote;        ///< Note id, title and aliases -> note id.
+    std::unordered_map<std::string, ConceptRecord> m_concepts;
+    std::unordered_map<std::string, std::set<std::string>> m_referrers; ///< Wikilink target -> notes citing it.
+    std::unordered_map<int, std::string> m_noteByNode;
+    domain::MentionMatcher m_titleMatcher;                              ///< Note id -> titles/aliases (>= 4 chars), payload node id.
+    bool m_showTasks = true;
+    std::size_t m_nodeCount = 0, m_linkCount = 0;                       ///< Sizes after the last sync (detects foreign edits).
+    std::vector<int> m_freeNodeIds;
+    int m_nextNodeId = 0;
+    int m_nextLinkId = 0;
+
+    ForceLayout m_layout; ///< Synchronous mode (and config holder)
+    bool m_layoutDirty = true; ///< Reload the simulation from the node vector on the next step.
+    float m_loadTemperature = 1.0f; ///< Warm start after incremental edits.
+
+    std::unique_ptr<GraphSimulation> m_simulation;
+    std::uint64_t m_generation = 0;                    ///< Graph load the UI expects snapshots for.
+    std::map<size_t, std::pair<float, float>> m_pins;  ///< Node index -> last position sent.
 };
 
 } // namespace ideawalker::application
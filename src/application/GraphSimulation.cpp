@@ -0,0 +1,173 @@
+/**
+ * @file GraphSimulation.cpp
+ * @brief Implementation of GraphSimulation.
+ */
+
+#include "application/GraphSimulation.hpp"
+#include <algorithm>
+#include <chrono>
+
+namespace ideawalker::application {
+
+using namespace ideawalker::domain::writing;
+
+void LayoutTripleBuffer::publish() {
+    const int previous = m_middle.exchange(m_back | kFreshBit, std::memory_order_acq_rel);
+    m_back = previous & kIndexMask;
+}
+
+bool LayoutTripleBuffer::acquire() {
+    if (!(m_middle.load(std::memory_order_acquire) & kFreshBit)) return false;
+    const int previous = m_middle.exchange(m_front, std::memory_order_acq_rel);
+    m_front = previous & kIndexMask;
+    return true;
+}
+
+GraphSimulation::GraphSimulation(std::shared_ptr<AsyncTaskManager> taskManager, ForceLayoutConfig config)
+    : m_taskManager(std::move(taskManager)), m_layout(config) {}
+
+GraphSimulation::~GraphSimulation() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_stopRequested = true;
+    m_commands.clear();
+    m_cv.notify_all();
+    m_cv.wait(lock, [this] { return !m_running; });
+}
+
+std::uint64_t GraphSimulation::load(const std::vector<GraphNode>& nodes, const std::vector<GraphLink>& links,
+                                    float temperature) {
+    Command command{Command::Kind::Load};
+    command.temperature = temperature;
+    command.nodes = nodes;
+    command.links = links;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        command.generation = ++m_nextGeneration;
+    }
+    const std::uint64_t generation = command.generation;
+    post(std::move(command));
+    return generation;
+}
+
+void GraphSimulation::pin(std::size_t index, float x, float y) {
+    Command command{Command::Kind::Pin};
+    command.index = index;
+    command.x = x;
+    command.y = y;
+    post(std::move(command));
+}
+
+void GraphSimulation::unpin(std::size_t index) {
+    Command command{Command::Kind::Unpin};
+    command.index = index;
+    post(std::move(command));
+}
+
+void GraphSimulation::setConfig(const ForceLayoutConfig& config) {
+    Command command{Command::Kind::Config};
+    command.config = config;
+    post(std::move(command));
+}
+
+void GraphSimulation::setStepsPerSecond(double stepsPerSecond) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stepsPerSecond = stepsPerSecond;
+}
+
+bool GraphSimulation::isRunning() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_running;
+}
+
+void GraphSimulation::waitUntilIdle() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cv.wait(lock, [this] { return !m_running; });
+}
+
+void GraphSimulation::post(Command command) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_stopRequested || !m_taskManager) return;
+    m_commands.push_back(std::move(command));
+    m_cv.notify_all();
+    if (m_running) return;
+
+    // (Re)start the stepping task; it ends by itself once the layout freezes.
+    m_running = true;
+    auto taskManager = m_taskManager; // Keeps the manager alive until the task is cleaned up
+    m_taskManager->SubmitTask(TaskType::Layout, "Neural Web: organizando layout",
+        [this, taskManager](std::shared_ptr<TaskStatus> status) { run(status); });
+}
+
+void GraphSimulation::apply(Command& command) {
+    switch (command.kind) {
+    case Command::Kind::Load:
+        m_layout.load(command.nodes, command.links, command.temperature);
+        m_layoutGeneration = command.generation;
+        m_steps = 0;
+        break;
+    case Command::Kind::Pin:
+        m_layout.pin(command.index, command.x, command.y);
+        break;
+    case Command::Kind::Unpin:
+        m_layout.unpin(command.index);
+        break;
+    case Command::Kind::Config:
+        m_layout.setConfig(command.config);
+        break;
+    }
+}
+
+void GraphSimulation::run(const std::shared_ptr<TaskStatus>& status) {
+    try {
+        stepUntilSettled(status);
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_running = false;
+        m_cv.notify_all();
+        throw;
+    }
+}
+
+void GraphSimulation::stepUntilSettled(const std::shared_ptr<TaskStatus>& status) {
+    using Clock = std::chrono::steady_clock;
+    auto nextStep = Clock::now();
+    std::vector<Command> commands;
+
+    for (;;) {
+        double stepsPerSecond = 0.0;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            commands.swap(m_commands);
+            if (m_stopRequested || (commands.empty() && m_layout.isFrozen())) {
+                m_running = false;
+                m_cv.notify_all();
+                return;
+            }
+            stepsPerSecond = m_stepsPerSecond;
+        }
+
+        for (auto& command : commands) apply(command);
+        commands.clear();
+        if (!m_layout.step()) continue;
+        ++m_steps;
+
+        LayoutSnapshot& snapshot = m_buffer.back();
+        snapshot.generation = m_layoutGeneration;
+        snapshot.step = m_steps;
+        snapshot.settled = m_layout.isFrozen();
+        snapshot.x = m_layout.xs();
+        snapshot.y = m_layout.ys();
+        m_buffer.publish();
+        status->progress = 1.0f - m_layout.temperature();
+
+        if (stepsPerSecond > 0.0) {
+            // Pace to the display rate so the layout animates; stop requests cut the wait short.
+            const auto interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / stepsPerSecond));
+            nextStep = std::max(nextStep + interval, Clock::now());
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait_until(lock, nextStep, [this] { return m_stopRequested; });
+        }
+    }
+}
+
+} // namespace ideawalker::application
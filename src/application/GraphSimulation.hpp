@@ -0,0 +1,132 @@
+/**
+ * @file GraphSimulation.hpp
+ * @brief Neural Web layout running off the render thread (AsyncTaskManager + triple buffer).
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "application/AsyncTaskManager.hpp"
+#include "application/ForceLayout.hpp"
+
+namespace ideawalker::application {
+
+/**
+ * @struct LayoutSnapshot
+ * @brief Node positions published by the simulation (indexed like the loaded node vector).
+ */
+struct LayoutSnapshot {
+    std::uint64_t generation = 0; ///< Graph load this snapshot belongs to.
+    std::uint64_t step = 0;       ///< Simulation step that produced it.
+    bool settled = false;         ///< Layout froze after this step.
+    std::vector<float> x, y;
+};
+
+/**
+ * @class LayoutTripleBuffer
+ * @brief Lock-free single-producer/single-consumer hand-off of the latest snapshot.
+ *
+ * The writer fills back() and publish()es it; the reader acquire()s the newest
+ * published buffer. Neither side ever waits, and intermediate snapshots the
+ * reader did not pick up are simply overwritten.
+ */
+class LayoutTripleBuffer {
+public:
+    LayoutSnapshot& back() { return m_buffers[m_back]; }
+    void publish();
+
+    /** @brief Switches front() to the newest snapshot. Returns false if nothing new was published. */
+    bool acquire();
+    const LayoutSnapshot& front() const { return m_buffers[m_front]; }
+
+private:
+    static constexpr int kIndexMask = 0x3;
+    static constexpr int kFreshBit = 0x4;
+
+    LayoutSnapshot m_buffers[3];
+    int m_back = 0;               // Writer-owned
+    int m_front = 2;              // Reader-owned
+    std::atomic<int> m_middle{1}; // Shared: index | kFreshBit
+};
+
+/**
+ * @class GraphSimulation
+ * @brief Owns a ForceLayout stepped by a background task while the layout is settling.
+ *
+ * The render thread only posts commands (load, pin, unpin, config) and reads the
+ * latest LayoutSnapshot. A task is submitted to the AsyncTaskManager whenever a
+ * command wakes the layout and it ends by itself once the layout freezes.
+ */
+class GraphSimulation {
+public:
+    explicit GraphSimulation(std::shared_ptr<AsyncTaskManager> taskManager, ForceLayoutConfig config = {});
+    ~GraphSimulation();
+
+    GraphSimulation(const GraphSimulation&) = delete;
+    GraphSimulation& operator=(const GraphSimulation&) = delete;
+
+    /** @brief Replaces the simulated graph. Returns the generation its snapshots will carry. */
+    std::uint64_t load(const std::vector<domain::writing::GraphNode>& nodes,
+                       const std::vector<domain::writing::GraphLink>& links,
+                       float temperature = 1.0f);
+
+    /** @brief Holds a node (by index) at a position while the user drags it. */
+    void pin(std::size_t index, float x, float y);
+    void unpin(std::size_t index);
+    void setConfig(const ForceLayoutConfig& config);
+
+    /** @brief Simulation pacing; 0 steps as fast as possible. Default 60 (one step per vsync frame). */
+    void setStepsPerSecond(double stepsPerSecond);
+
+    /** @brief Render thread: picks up the newest snapshot. Returns true if it changed. */
+    bool acquireLatest() { return m_buffer.acquire(); }
+    const LayoutSnapshot& latest() const { return m_buffer.front(); }
+
+    /** @brief True while a background task is stepping the layout. */
+    bool isRunning() const;
+
+    /** @brief Blocks until the layout has settled (or stop). For tests and headless use. */
+    void waitUntilIdle();
+
+private:
+    struct Command {
+        enum class Kind { Load, Pin, Unpin, Config } kind;
+        std::size_t index = 0;
+        float x = 0.0f, y = 0.0f;
+        float temperature = 1.0f;
+        std::uint64_t generation = 0;
+        std::vector<domain::writing::GraphNode> nodes;
+        std::vector<domain::writing::GraphLink> links;
+        ForceLayoutConfig config;
+    };
+
+    void post(Command command);
+    void run(const std::shared_ptr<TaskStatus>& status);
+    void stepUntilSettled(const std::shared_ptr<TaskStatus>& status);
+    void apply(Command& command);
+
+    std::shared_ptr<AsyncTaskManager> m_taskManager;
+
+    // Worker-owned
+    ForceLayout m_layout;
+    std::uint64_t m_layoutGeneration = 0;
+    std::uint64_t m_steps = 0;
+
+    // Shared, guarded by m_mutex
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::vector<Command> m_commands;
+    bool m_running = false;
+    bool m_stopRequested = false;
+    std::uint64_t m_nextGeneration = 0;
+    double m_stepsPerSecond = 60.0;
+
+    LayoutTripleBuffer m_buffer;
+};
+
+} // namespace ideawalker::application
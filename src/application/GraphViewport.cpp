@@ -0,0 +1,101 @@
+/**
+ * @file GraphViewport.cpp
+ * @brief Implementation of GraphViewport.
+ */
+
+#include "application/GraphViewport.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace ideawalker::application {
+
+using namespace ideawalker::domain::writing;
+
+void GraphCamera::zoomAt(float factor, float anchorX, float anchorY, float minZoom, float maxZoom) {
+    const float gridX = toGridX(anchorX);
+    const float gridY = toGridY(anchorY);
+    zoom = std::clamp(zoom * factor, minZoom, maxZoom);
+    panX = anchorX - gridX * zoom;
+    panY = anchorY - gridY * zoom;
+}
+
+GraphDetail SelectDetail(float zoom, float fontSize, const GraphLodConfig& config) {
+    if (zoom >= 0.999f) return GraphDetail::Full;
+    if (fontSize * zoom >= config.minLegiblePixels) return GraphDetail::Titles;
+    return GraphDetail::Dots;
+}
+
+void GraphViewport::update(const std::vector<GraphNode>& nodes, const GraphCamera& camera,
+                           float canvasWidth, float canvasHeight, const GraphLodConfig& config) {
+    const std::size_t n = nodes.size();
+    m_visible.clear();
+    m_visibleFlag.assign(n, 0);
+
+    int maxId = -1;
+    for (const auto& node : nodes) maxId = std::max(maxId, node.id);
+    m_indexById.assign(static_cast<std::size_t>(maxId + 1), -1);
+
+    // Visible grid rectangle, widened by the margin (in screen pixels).
+    const float margin = config.cullMarginPixels;
+    const float minX = camera.toGridX(-margin), maxX = camera.toGridX(canvasWidth + margin);
+    const float minY = camera.toGridY(-margin), maxY = camera.toGridY(canvasHeight + margin);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const GraphNode& node = nodes[i];
+        if (node.id >= 0) m_indexById[node.id] = static_cast<int>(i);
+        const float w = node.w > 0.0f ? node.w : config.defaultNodeWidth;
+        const float h = node.h > 0.0f ? node.h : config.defaultNodeHeight;
+        if (node.x + w < minX || node.x > maxX || node.y + h < minY || node.y > maxY) continue;
+        m_visibleFlag[i] = 1;
+        m_visible.push_back(static_cast<std::uint32_t>(i));
+    }
+}
+
+const std::vector<GraphCluster>& GraphViewport::cluster(const std::vector<GraphNode>& nodes,
+                                                        const GraphCamera& camera, const GraphLodConfig& config) {
+    m_clusters.clear();
+    m_clusterOf.assign(nodes.size(), -1);
+    m_cellKeys.clear();
+
+    const float cell = std::max(1.0f, config.clusterCellPixels);
+    for (std::uint32_t index : m_visible) {
+        const float cx = std::floor(camera.toCanvasX(nodes[index].x) / cell);
+        const float cy = std::floor(camera.toCanvasY(nodes[index].y) / cell);
+        const auto kx = static_cast<std::uint32_t>(std::clamp(cx + 32768.0f, 0.0f, 65535.0f));
+        const auto ky = static_cast<std::uint32_t>(std::clamp(cy + 32768.0f, 0.0f, 65535.0f));
+        m_cellKeys.push_back((static_cast<std::uint64_t>((kx << 16) | ky) << 32) | index);
+    }
+    std::sort(m_cellKeys.begin(), m_cellKeys.end());
+
+    for (std::size_t begin = 0; begin < m_cellKeys.size();) {
+        const std::uint64_t key = m_cellKeys[begin] >> 32;
+        std::size_t end = begin;
+        while (end < m_cellKeys.size() && (m_cellKeys[end] >> 32) == key) ++end;
+        const auto count = static_cast<std::uint32_t>(end - begin);
+
+        if (count >= config.clusterMinNodes) {
+            GraphCluster super;
+            super.count = count;
+            super.node = static_cast<std::uint32_t>(m_cellKeys[begin] & 0xffffffffu);
+            for (std::size_t k = begin; k < end; ++k) {
+                const auto index = static_cast<std::uint32_t>(m_cellKeys[k] & 0xffffffffu);
+                super.x += camera.toCanvasX(nodes[index].x);
+                super.y += camera.toCanvasY(nodes[index].y);
+                m_clusterOf[index] = static_cast<int>(m_clusters.size());
+            }
+            super.x /= static_cast<float>(count);
+            super.y /= static_cast<float>(count);
+            m_clusters.push_back(super);
+        } else {
+            for (std::size_t k = begin; k < end; ++k) {
+                const auto index = static_cast<std::uint32_t>(m_cellKeys[k] & 0xffffffffu);
+                m_clusterOf[index] = static_cast<int>(m_clusters.size());
+                m_clusters.push_back({camera.toCanvasX(nodes[index].x), camera.toCanvasY(nodes[index].y), 1, index});
+            }
+        }
+        begin = end;
+    }
+    return m_clusters;
+}
+
+} // namespace ideawalker::application
@@ -0,0 +1,113 @@
+/**
+ * @file GraphViewport.hpp
+ * @brief Camera, culling, level of detail and clustering for drawing the Neural Web.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "domain/writing/MermaidGraph.hpp"
+
+namespace ideawalker::application {
+
+/**
+ * @struct GraphCamera
+ * @brief Maps grid space to canvas space: canvas = grid * zoom + pan.
+ *
+ * At zoom 1 this is exactly the ImNodes convention (pan = editor panning), so the
+ * camera can be handed back and forth between ImNodes and the overview renderer.
+ */
+struct GraphCamera {
+    float panX = 0.0f, panY = 0.0f;
+    float zoom = 1.0f;
+
+    float toCanvasX(float x) const { return x * zoom + panX; }
+    float toCanvasY(float y) const { return y * zoom + panY; }
+    float toGridX(float x) const { return (x - panX) / zoom; }
+    float toGridY(float y) const { return (y - panY) / zoom; }
+
+    /** @brief Zooms by a factor, keeping the canvas point (anchorX, anchorY) fixed. */
+    void zoomAt(float factor, float anchorX, float anchorY, float minZoom = 0.05f, float maxZoom = 1.0f);
+};
+
+/** @brief How much of each node is drawn. */
+enum class GraphDetail {
+    Full,   ///< ImNodes nodes (interactive), zoom 1.
+    Titles, ///< Boxes with titles drawn through the draw list.
+    Dots    ///< Dots, dense regions merged into cluster super-nodes.
+};
+
+/**
+ * @struct GraphLodConfig
+ * @brief Thresholds of the level-of-detail renderer.
+ */
+struct GraphLodConfig {
+    float minLegiblePixels = 8.0f;   ///< Titles are drawn only if font size * zoom reaches this.
+    float clusterCellPixels = 28.0f; ///< Screen cell used to merge dense regions in Dots mode.
+    std::uint32_t clusterMinNodes = 4; ///< Cells with at least this many nodes become one super-node.
+    float cullMarginPixels = 64.0f;  ///< Nodes this close to the edge are still drawn.
+    float defaultNodeWidth = 200.0f; ///< Size assumed for nodes never measured by ImNodes.
+    float defaultNodeHeight = 40.0f;
+};
+
+/** @brief Picks the level of detail for a zoom and font size. */
+GraphDetail SelectDetail(float zoom, float fontSize, const GraphLodConfig& config = {});
+
+/**
+ * @struct GraphCluster
+ * @brief One drawable item in Dots mode: a single node or a super-node.
+ */
+struct GraphCluster {
+    float x = 0.0f, y = 0.0f;  ///< Canvas-space position (centroid for super-nodes).
+    std::uint32_t count = 0;   ///< Number of nodes merged.
+    std::uint32_t node = 0;    ///< Index of the node when count == 1 (else of its first member).
+};
+
+/**
+ * @class GraphViewport
+ * @brief Per-frame view of the node vector: what is visible and how it is grouped.
+ *
+ * Everything is O(nodes) with no allocation once the buffers have grown, so the
+ * frame cost depends on what is on screen rather than on how it is drawn.
+ */
+class GraphViewport {
+public:
+    /**
+     * @brief Recomputes visibility for a canvas of the given size.
+     * @param nodes Graph nodes (ids may be sparse; w/h of 0 means "not measured yet").
+     */
+    void update(const std::vector<domain::writing::GraphNode>& nodes,
+                const GraphCamera& camera, float canvasWidth, float canvasHeight,
+                const GraphLodConfig& config = {});
+
+    /** @brief Indices (into the node vector) of nodes that intersect the canvas. */
+    const std::vector<std::uint32_t>& visible() const { return m_visible; }
+    bool isVisible(std::uint32_t index) const { return index < m_visibleFlag.size() && m_visibleFlag[index]; }
+
+    /** @brief Node index for an id, or -1 (ids are small dense integers). */
+    int indexOf(int id) const {
+        return (id >= 0 && static_cast<std::size_t>(id) < m_indexById.size()) ? m_indexById[id] : -1;
+    }
+
+    /**
+     * @brief Groups visible nodes into screen cells; cells with enough nodes become super-nodes.
+     * @return Items to draw. clusterOf() then maps a node index to its item.
+     */
+    const std::vector<GraphCluster>& cluster(const std::vector<domain::writing::GraphNode>& nodes,
+                                             const GraphCamera& camera, const GraphLodConfig& config = {});
+    /** @brief Item index for a visible node after cluster(), or -1. */
+    int clusterOf(std::uint32_t index) const {
+        return index < m_clusterOf.size() ? m_clusterOf[index] : -1;
+    }
+
+private:
+    std::vector<std::uint32_t> m_visible;
+    std::vector<std::uint8_t> m_visibleFlag;
+    std::vector<int> m_indexById;
+    std::vector<GraphCluster> m_clusters;
+    std::vector<int> m_clusterOf;
+    std::vector<std::uint64_t> m_cellKeys; // Scratch: (cell key << 32 | node index), sorted
+};
+
+} // namespace ideawalker::application
@@ -4,6 +4,7 @@
  */
 
 #include "application/KnowledgeService.hpp"
+#include "infrastructure/FrameProfiler.hpp"
 #include <algorithm>
 
 namespace ideawalker::application {
@@ -13,6 +14,7 @@ KnowledgeService::KnowledgeService(std::unique_ptr<domain::ThoughtRepository> re
 
 void KnowledgeService::UpdateNote(const std::string& filename, const std::string& content) {
     m_repo->updateNote(filename, content);
+    ReindexNote(filename);
 }
 
 void KnowledgeService::ToggleTask(const std::string& filename, int index) {
@@ -22,6 +24,7 @@ void KnowledgeService::ToggleTask(const std::string& filename, int index) {
             insight.parseActionablesFromContent();
             insight.toggleActionable(index);
             m_repo->updateNote(filename, insight.getContent());
+            ReindexNote(filename);
             break;
         }
     }
@@ -34,6 +37,7 @@ void KnowledgeService::SetTaskStatus(const std::string& filename, int index, boo
             insight.parseActionablesFromContent();
             insight.setActionableStatus(index, completed, inProgress);
             m_repo->updateNote(filename, insight.getContent());
+            ReindexNote(filename);
             break;
         }
     }
@@ -44,9 +48,21 @@ std::vector<domain::Insight> KnowledgeService::GetAllInsights() {
     for (auto& insight : insights) {
         insight.parseActionablesFromContent();
     }
+    m_backlinks.sync(insights);
     return insights;
 }
 
+std::optional<domain::Insight> KnowledgeService::GetInsight(const std::string& filename) {
+    auto insight = m_repo->fetchInsight(filename);
+    if (insight) {
+        insight->parseActionablesFromContent();
+        m_backlinks.update(*insight);
+    } else {
+        m_backlinks.remove(filename);
+    }
+    return insight;
+}
+
 std::vector<domain::RawThought> KnowledgeService::GetRawThoughts() {
     return m_repo->fetchInbox();
 }
@@ -56,7 +72,18 @@ std::map<std::string, int> KnowledgeService::GetActivityHistory() {
 }
 
 std::vector<std::string> KnowledgeService::GetBacklinks(const std::string& filename) {
-    return m_repo->getBacklinks(filename);
+    infrastructure::ProfileZone zone("KnowledgeService::GetBacklinks");
+    if (!m_backlinks.isLoaded()) m_backlinks.sync(m_repo->fetchHistory());
+    return m_backlinks.backlinks(filename);
+}
+
+void KnowledgeService::ReindexNote(const std::string& filename) {
+    if (!m_backlinks.isLoaded()) return;
+    if (auto insight = m_repo->fetchInsight(filename)) {
+        m_backlinks.update(*insight);
+    } else {
+        m_backlinks.remove(filename);
+    }
 }
 
 std::vector<std::string> KnowledgeService::GetNoteHistory(const std::string& noteId) {
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include "application/BacklinkIndex.hpp"
 #include "domain/ThoughtRepository.hpp"
 #include "domain/Insight.hpp"
 #include <memory>
@@ -34,13 +35,21 @@ public:
     /** @brief Returns all processed insights with parsed tasks. */
     std::vector<domain::Insight> GetAllInsights();
 
+    /** @brief Returns one insight with parsed tasks (nullopt if the note is gone). */
+    std::optional<domain::Insight> GetInsight(const std::string& filename);
+
     /** @brief Returns raw items from the inbox. */
     std::vector<domain::RawThought> GetRawThoughts();
 
     /** @brief Returns activity statistics. */
     std::map<std::string, int> GetActivityHistory();
 
-    /** @brief Returns files linking to the target. */
+    /**
+     * @brief Returns files linking to the target, from the backlink index.
+     *
+     * The first call indexes the repository once; afterwards the index follows UpdateNote
+     * and the insight reads (notes saved straight through the repository show up there).
+     */
     std::vector<std::string> GetBacklinks(const std::string& filename);
 
     /** @brief Returns history versions for a note. */
@@ -59,7 +68,11 @@ public:
     domain::ThoughtRepository& GetRepository() { return *m_repo; }
 
 private:
+    /** @brief Re-reads one note into the backlink index (once the index is loaded). */
+    void ReindexNote(const std::string& filename);
+
     std::unique_ptr<domain::ThoughtRepository> m_repo;
+    BacklinkIndex m_backlinks;
 };
 
 } // namespace ideawalker::application
@@ -0,0 +1,248 @@
+/**
+ * @file MarkdownDocument.cpp
+ * @brief Implementation of MarkdownDocument and MarkdownPreview.
+ */
+
+#include "application/MarkdownDocument.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace ideawalker::application {
+
+namespace {
+
+bool StartsWith(std::string_view text, std::string_view prefix) {
+    return text.substr(0, prefix.size()) == prefix;
+}
+
+std::uint32_t Offset(std::string_view source, std::string_view part) {
+    return static_cast<std::uint32_t>(part.data() - source.data());
+}
+
+std::uint32_t Length(std::string_view part) {
+    return static_cast<std::uint32_t>(part.size());
+}
+
+std::string_view TrimBlanks(std::string_view text) {
+    const auto begin = text.find_first_not_of(" \t");
+    if (begin == std::string_view::npos) return text.substr(text.size());
+    const auto end = text.find_last_not_of(" \t");
+    return text.substr(begin, end - begin + 1);
+}
+
+void ParseLine(std::string_view source, std::string_view line, MarkdownBlock& block, std::vector<MarkdownSpan>& spans) {
+    const auto firstChar = line.find_first_not_of(" \t");
+    if (firstChar == std::string_view::npos) {
+        block.kind = MarkdownBlockKind::Blank;
+        return;
+    }
+    const std::string_view indent = line.substr(0, firstChar);
+    const std::string_view trimmed = line.substr(firstChar);
+    block.indentBegin = Offset(source, indent);
+    block.indentLength = Length(indent);
+
+    auto setText = [&](MarkdownBlockKind kind, std::size_t skip) {
+        block.kind = kind;
+        const std::string_view text = trimmed.substr(skip);
+        block.textBegin = Offset(source, text);
+        block.textLength = Length(text);
+    };
+
+    static constexpr std::string_view kBullets[] = {"- ", "* ", "• ", "– ", "— "};
+
+    if (StartsWith(trimmed, "# ")) {
+        setText(MarkdownBlockKind::Heading, 2);
+        block.level = 1;
+    } else if (StartsWith(trimmed, "## ")) {
+        setText(MarkdownBlockKind::Heading, 3);
+        block.level = 2;
+    } else if (StartsWith(trimmed, "### ")) {
+        setText(MarkdownBlockKind::Heading, 4);
+        block.level = 3;
+    } else if (StartsWith(trimmed, "- [ ] ") || StartsWith(trimmed, "* [ ] ")) {
+        setText(MarkdownBlockKind::Task, 6);
+    } else if (StartsWith(trimmed, "- [x] ") || StartsWith(trimmed, "* [x] ")) {
+        setText(MarkdownBlockKind::Task, 6);
+        block.checked = true;
+    } else if (StartsWith(trimmed, "> ")) {
+        setText(MarkdownBlockKind::Quote, 2);
+    } else {
+        for (std::string_view bullet : kBullets) {
+            if (StartsWith(trimmed, bullet)) {
+                setText(MarkdownBlockKind::Bullet, bullet.size());
+                return;
+            }
+        }
+
+        setText(MarkdownBlockKind::Paragraph, 0);
+        std::size_t lastPos = 0;
+        std::size_t startPos = trimmed.find("[[");
+        if (startPos == std::string_view::npos) return;
+
+        block.spanBegin = static_cast<std::uint32_t>(spans.size());
+        auto addSpan = [&](std::size_t begin, std::size_t length, bool link) {
+            spans.push_back({Offset(source, trimmed) + static_cast<std::uint32_t>(begin),
+                             static_cast<std::uint32_t>(length), link});
+        };
+        while (startPos != std::string_view::npos) {
+            const std::size_t endPos = trimmed.find("]]", startPos + 2);
+            if (endPos == std::string_view::npos) break;
+            if (startPos > lastPos) addSpan(lastPos, startPos - lastPos, false);
+            addSpan(startPos + 2, endPos - startPos - 2, true);
+            lastPos = endPos + 2;
+            startPos = trimmed.find("[[", lastPos);
+        }
+        if (lastPos < trimmed.size()) addSpan(lastPos, trimmed.size() - lastPos, false);
+        block.spanCount = static_cast<std::uint32_t>(spans.size()) - block.spanBegin;
+    }
+}
+
+} // namespace
+
+MarkdownDocument MarkdownDocument::Parse(std::string_view text) {
+    return Parse(MarkdownPieces{text});
+}
+
+MarkdownDocument MarkdownDocument::Parse(const MarkdownPieces& pieces) {
+    MarkdownDocument doc;
+    for (std::size_t piece = 0; piece < pieces.size(); ++piece) {
+        doc.parsePiece(pieces[piece], static_cast<std::uint32_t>(piece));
+    }
+    return doc;
+}
+
+void MarkdownDocument::parsePiece(std::string_view text, std::uint32_t piece) {
+    m_sourceSize += text.size();
+
+    bool inCodeBlock = false;
+    MarkdownBlock code;
+
+    std::size_t lineBegin = 0;
+    while (lineBegin < text.size()) {
+        std::size_t lineEnd = text.find('\n', lineBegin);
+        const std::size_t next = lineEnd == std::string_view::npos ? text.size() : lineEnd + 1;
+        if (lineEnd == std::string_view::npos) lineEnd = text.size();
+        std::string_view line = text.substr(lineBegin, lineEnd - lineBegin);
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        m_lines.push_back({piece, static_cast<std::uint32_t>(lineBegin), Length(line)});
+
+        if (StartsWith(line, "```")) {
+            if (inCodeBlock) {
+                code.textLength = static_cast<std::uint32_t>(lineBegin) - code.textBegin;
+                if (code.kind == MarkdownBlockKind::Mermaid) code.diagram = m_diagramCount++;
+                m_blocks.push_back(code);
+                inCodeBlock = false;
+            } else {
+                inCodeBlock = true;
+                const std::string_view lang = TrimBlanks(line.substr(3));
+                code = MarkdownBlock{};
+                code.piece = piece;
+                code.kind = lang == "mermaid" ? MarkdownBlockKind::Mermaid : MarkdownBlockKind::Code;
+                code.langBegin = Offset(text, lang);
+                code.langLength = Length(lang);
+                code.textBegin = static_cast<std::uint32_t>(next);
+            }
+        } else if (!inCodeBlock) {
+            MarkdownBlock block;
+            block.piece = piece;
+            ParseLine(text, line, block, m_spans);
+            m_blocks.push_back(block);
+        }
+        lineBegin = next;
+    }
+}
+
+bool MarkdownPreview::sync(const MarkdownPieces& text, std::uint64_t textRevision) {
+    std::size_t size = 0;
+    for (std::string_view piece : text) size += piece.size();
+    if (parsed && revision == textRevision && document.sourceSize() == size) return false;
+    document = MarkdownDocument::Parse(text);
+    revision = textRevision;
+    parsed = true;
+    // Diagrams keep their graphs by ordinal, so a diagram being laid out in background
+    // still shows its previous layout; the cache returns the same graph if the body is unchanged.
+    diagrams.resize(static_cast<std::size_t>(document.diagramCount()));
+    diagramStale.assign(diagrams.size(), 1);
+    diagramKeys.assign(diagrams.size(), 0);
+    layoutStale = true;
+    return true;
+}
+
+void MarkdownLayout::reset(const MarkdownDocument& document, const MarkdownPieces& source, float width,
+                           const MarkdownMetrics& metrics) {
+    const auto& blocks = document.blocks();
+    m_width = width;
+    m_heights.assign(blocks.size(), 0.0f);
+    m_measured.assign(blocks.size(), 0);
+
+    const float charsPerLine = std::max(1.0f, width / std::max(1.0f, metrics.charWidth));
+    auto wrappedLines = [charsPerLine](std::uint32_t bytes) {
+        return std::max(1.0f, std::ceil(static_cast<float>(bytes) / charsPerLine));
+    };
+
+    for (std::size_t i = 0; i < blocks.size(); ++i) {
+        const MarkdownBlock& block = blocks[i];
+        float h = metrics.lineHeight;
+        switch (block.kind) {
+            case MarkdownBlockKind::Blank:
+                h = metrics.spacing;
+                break;
+            case MarkdownBlockKind::Heading:
+                h = metrics.lineHeight + (block.level == 1 ? metrics.separator : 0.0f);
+                break;
+            case MarkdownBlockKind::Code: {
+                const std::string_view body = MarkdownDocument::Slice(source[block.piece], block.textBegin, block.textLength);
+                const auto lines = static_cast<float>(std::count(body.begin(), body.end(), '\n'));
+                h = (lines + (block.langLength > 0 ? 1.0f : 0.0f)) * metrics.lineHeight + metrics.codeChrome;
+                break;
+            }
+            case MarkdownBlockKind::Mermaid:
+                h = metrics.diagramHeight;
+                break;
+            default:
+                h = wrappedLines(block.indentLength + block.textLength) * metrics.lineHeight;
+                break;
+        }
+        m_heights[i] = h;
+    }
+
+    // O(n) Fenwick construction.
+    m_tree.assign(m_heights.size() + 1, 0.0);
+    for (std::size_t i = 1; i <= m_heights.size(); ++i) {
+        m_tree[i] += m_heights[i - 1];
+        const std::size_t parent = i + (i & (~i + 1));
+        if (parent <= m_heights.size()) m_tree[parent] += m_tree[i];
+    }
+}
+
+void MarkdownLayout::setHeight(std::size_t block, float height) {
+    if (block >= m_heights.size()) return;
+    m_measured[block] = 1;
+    const double delta = static_cast<double>(height) - m_heights[block];
+    if (delta == 0.0) return;
+    m_heights[block] = height;
+    for (std::size_t i = block + 1; i < m_tree.size(); i += i & (~i + 1)) m_tree[i] += delta;
+}
+
+double MarkdownLayout::offsetOf(std::size_t block) const {
+    double sum = 0.0;
+    for (std::size_t i = std::min(block, m_heights.size()); i > 0; i -= i & (~i + 1)) sum += m_tree[i];
+    return sum;
+}
+
+std::size_t MarkdownLayout::blockAt(double y) const {
+    if (m_heights.empty()) return 0;
+    // Largest prefix of blocks whose total height is <= y: the next block covers y.
+    std::size_t pos = 0;
+    std::size_t step = 1;
+    while (step * 2 < m_tree.size()) step *= 2;
+    for (; step > 0; step /= 2) {
+        if (pos + step < m_tree.size() && m_tree[pos + step] <= y) {
+            pos += step;
+            y -= m_tree[pos];
+        }
+    }
+    return std::min(pos, m_heights.size() - 1);
+}
+
+} // namespace ideawalker::application
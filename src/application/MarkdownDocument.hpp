@@ -0,0 +1,173 @@
+/**
+ * @file MarkdownDocument.hpp
+ * @brief Block-level Markdown structure parsed once per edit and walked by the preview renderer.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+#include "domain/writing/MermaidGraph.hpp"
+
+namespace ideawalker::application {
+
+/**
+ * @brief A text given as a sequence of pieces (a rope), e.g. the notes of the unified view.
+ * Every piece is parsed on its own: lines and code fences never cross a piece boundary.
+ */
+using MarkdownPieces = std::vector<std::string_view>;
+
+/** @brief Kind of a preview block (one source line, or a whole fenced code block). */
+enum class MarkdownBlockKind : std::uint8_t {
+    Blank,
+    Heading,   ///< "# ", "## ", "### " (level 1-3)
+    Task,      ///< "- [ ] " / "- [x] " (also with "*")
+    Bullet,    ///< "- ", "* ", "• ", "– ", "— "
+    Quote,     ///< "> "
+    Paragraph, ///< Anything else; may contain [[links]]
+    Code,      ///< Closed ``` fence (text is the body, lang the info string)
+    Mermaid    ///< Closed ```mermaid fence
+};
+
+/**
+ * @struct MarkdownSpan
+ * @brief Piece of a paragraph: plain text or the target of a [[link]].
+ */
+struct MarkdownSpan {
+    std::uint32_t begin = 0, length = 0; ///< Byte range in the block's piece.
+    bool link = false;
+};
+
+/**
+ * @struct MarkdownBlock
+ * @brief One parsed block. Ranges are byte offsets into its piece of the source (no copies).
+ */
+struct MarkdownBlock {
+    MarkdownBlockKind kind = MarkdownBlockKind::Blank;
+    std::uint32_t piece = 0;     ///< Piece of the source holding the block.
+    std::uint8_t level = 0;      ///< Heading level.
+    bool checked = false;        ///< Task state.
+    std::uint32_t indentBegin = 0, indentLength = 0; ///< Leading whitespace.
+    std::uint32_t textBegin = 0, textLength = 0;     ///< Text after the marker, or code body.
+    std::uint32_t langBegin = 0, langLength = 0;     ///< Code fence language.
+    std::uint32_t spanBegin = 0, spanCount = 0;      ///< Paragraph spans (0 = whole text is plain).
+    int diagram = -1;            ///< Ordinal of a Mermaid block in its document.
+};
+
+/**
+ * @struct MarkdownLine
+ * @brief One source line (without its terminator), for clipped plain-text views.
+ */
+struct MarkdownLine {
+    std::uint32_t piece = 0;
+    std::uint32_t begin = 0, length = 0;
+};
+
+/**
+ * @class MarkdownDocument
+ * @brief Flat list of blocks for a Markdown text.
+ *
+ * The document does not own the text: callers keep the source alive and pass it
+ * back when reading block contents. Offsets are 32-bit (pieces up to 4 GiB).
+ */
+class MarkdownDocument {
+public:
+    /** @brief Parses a text. O(text length); unclosed code fences are dropped (as before). */
+    static MarkdownDocument Parse(std::string_view text);
+    /** @brief Parses every piece in order into one document. */
+    static MarkdownDocument Parse(const MarkdownPieces& pieces);
+
+    const std::vector<MarkdownBlock>& blocks() const { return m_blocks; }
+    const std::vector<MarkdownSpan>& spans() const { return m_spans; }
+    const std::vector<MarkdownLine>& lines() const { return m_lines; }
+    int diagramCount() const { return m_diagramCount; }
+    std::size_t sourceSize() const { return m_sourceSize; }
+
+    static std::string_view Slice(std::string_view source, std::uint32_t begin, std::uint32_t length) {
+        return begin + static_cast<std::size_t>(length) <= source.size() ? source.substr(begin, length) : std::string_view();
+    }
+
+private:
+    void parsePiece(std::string_view text, std::uint32_t piece);
+
+    std::vector<MarkdownBlock> m_blocks;
+    std::vector<MarkdownSpan> m_spans;
+    std::vector<MarkdownLine> m_lines;
+    int m_diagramCount = 0;
+    std::size_t m_sourceSize = 0;
+};
+
+/**
+ * @struct MarkdownMetrics
+ * @brief Font-dependent sizes used to estimate block heights before they are measured.
+ */
+struct MarkdownMetrics {
+    float lineHeight = 17.0f;      ///< Text line height including item spacing.
+    float charWidth = 7.0f;        ///< Average glyph advance (bytes are counted, so UTF-8 overestimates).
+    float spacing = 4.0f;          ///< Height of a blank line (ImGui::Spacing).
+    float separator = 4.0f;        ///< Extra height below level-1 headings.
+    float codeChrome = 24.0f;      ///< Frame and padding around a code block.
+    float diagramHeight = 730.0f;  ///< Mermaid block: toolbar plus the 700 px canvas.
+};
+
+/**
+ * @class MarkdownLayout
+ * @brief Vertical layout of a document for virtualized drawing.
+ *
+ * Every block starts with an estimated height; the renderer replaces it with the
+ * measured one the first time the block is drawn. Heights live in a Fenwick tree,
+ * so updating one block and finding the block at a scroll offset are O(log n).
+ */
+class MarkdownLayout {
+public:
+    /** @brief Estimates every block for a wrap width. O(blocks + code length). */
+    void reset(const MarkdownDocument& document, const MarkdownPieces& source, float width, const MarkdownMetrics& metrics);
+
+    std::size_t size() const { return m_heights.size(); }
+    float width() const { return m_width; }
+    float height(std::size_t block) const { return m_heights[block]; }
+    bool measured(std::size_t block) const { return m_measured[block] != 0; }
+
+    /** @brief Records the drawn height of a block. */
+    void setHeight(std::size_t block, float height);
+
+    /** @brief Sum of the heights of the blocks before @p block. */
+    double offsetOf(std::size_t block) const;
+    double totalHeight() const { return offsetOf(m_heights.size()); }
+
+    /** @brief Index of the block covering offset @p y (clamped to the last block). */
+    std::size_t blockAt(double y) const;
+
+private:
+    std::vector<float> m_heights;
+    std::vector<std::uint8_t> m_measured;
+    std::vector<double> m_tree; // Fenwick tree over m_heights (1-based)
+    float m_width = 0.0f;
+};
+
+/**
+ * @struct MarkdownPreview
+ * @brief Per-view cache: the parsed document plus the Mermaid graphs of its diagrams.
+ *
+ * The owner bumps a revision counter whenever the text changes; sync() reparses only
+ * when that counter (or, as a safety net, the text size) differs from the cached one.
+ */
+struct MarkdownPreview {
+    MarkdownDocument document;
+    /// Indexed by MarkdownBlock::diagram; shared with the MermaidLayoutCache (null until first laid out).
+    std::vector<std::shared_ptr<const domain::writing::PreviewGraphState>> diagrams;
+    std::vector<std::uint8_t> diagramStale; ///< Diagram body must be looked up (or laid out) again.
+    std::vector<std::uint64_t> diagramKeys; ///< Layout cache key while a stale diagram waits for its layout (0 = not requested).
+    MarkdownLayout layout;
+    bool layoutStale = true; ///< Document changed since the layout was estimated.
+    std::uint64_t revision = 0;
+    bool parsed = false;
+
+    /** @brief Reparses if needed. Returns true if it did. */
+    bool sync(const MarkdownPieces& text, std::uint64_t textRevision);
+    bool sync(std::string_view text, std::uint64_t textRevision) { return sync(MarkdownPieces{text}, textRevision); }
+};
+
+} // namespace ideawalker::application
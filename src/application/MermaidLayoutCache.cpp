@@ -0,0 +1,129 @@
+/**
+ * @file MermaidLayoutCache.cpp
+ * @brief Implementation of MermaidLayoutCache.
+ */
+
+#include "application/MermaidLayoutCache.hpp"
+#include "application/AsyncTaskManager.hpp"
+#include "infrastructure/FrameProfiler.hpp"
+#include <algorithm>
+#include <iostream>
+
+namespace ideawalker::application {
+
+using namespace ideawalker::domain::writing;
+
+MermaidLayoutCache::MermaidLayoutCache(std::shared_ptr<AsyncTaskManager> taskManager, MermaidLayoutConfig config)
+    : m_taskManager(std::move(taskManager)), m_config(config) {}
+
+MermaidLayoutCache::~MermaidLayoutCache() {
+    waitUntilIdle();
+}
+
+std::uint64_t MermaidLayoutCache::Key(std::string_view content, int baseId, std::uint64_t measureKey) {
+    // FNV-1a over the body, then the id base and the measurement key.
+    std::uint64_t h = 14695981039346656037ull;
+    auto mix = [&h](std::uint64_t value) {
+        for (int i = 0; i < 8; ++i) {
+            h ^= (value >> (i * 8)) & 0xffu;
+            h *= 1099511628211ull;
+        }
+    };
+    for (unsigned char c : content) {
+        h ^= c;
+        h *= 1099511628211ull;
+    }
+    mix(static_cast<std::uint64_t>(static_cast<std::uint32_t>(baseId)));
+    mix(measureKey);
+    return h;
+}
+
+MermaidLayout MermaidLayoutCache::Compute(const std::string& content, int baseId,
+                                          const MermaidParser::SizeCalculator& calculator) {
+    infrastructure::ProfileZone zone("MermaidLayoutCache::Compute");
+    auto graph = std::make_shared<PreviewGraphState>();
+    MermaidParser::Parse(content, *graph, calculator, baseId);
+    return graph;
+}
+
+MermaidLayout MermaidLayoutCache::acquire(std::uint64_t key, const std::string& content, int baseId,
+                                          MermaidParser::SizeCalculator calculator) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(key);
+        // The body is compared once per acquire (never per frame) to rule out collisions.
+        if (it != m_entries.end() && it->second.layout->lastContent == content) {
+            m_lru.splice(m_lru.begin(), m_lru, it->second.lru);
+            return it->second.layout;
+        }
+        if (m_pending.count(key)) return nullptr;
+    }
+
+    const auto lines = static_cast<std::size_t>(std::count(content.begin(), content.end(), '\n'));
+    if (!m_taskManager || lines <= m_config.asyncLineThreshold) {
+        MermaidLayout layout = Compute(content, baseId, calculator);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        insertLocked(key, layout);
+        return layout;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending.insert(key);
+    }
+    m_taskManager->SubmitTask(TaskType::Layout, "Mermaid: calculando layout",
+        [this, key, content, baseId, calculator = std::move(calculator)](std::shared_ptr<TaskStatus>) {
+            MermaidLayout layout;
+            try {
+                layout = Compute(content, baseId, calculator);
+            } catch (const std::exception& e) {
+                std::cerr << "[MermaidLayoutCache] Layout failed: " << e.what() << std::endl;
+            }
+            std::lock_guard<std::mutex> lock(m_mutex);
+            // A failed layout leaves an empty diagram rather than a preview waiting forever.
+            insertLocked(key, layout ? layout : std::make_shared<PreviewGraphState>());
+            m_pending.erase(key);
+            m_cv.notify_all();
+        });
+    return nullptr;
+}
+
+MermaidLayout MermaidLayoutCache::find(std::uint64_t key) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_entries.find(key);
+    if (it == m_entries.end()) return nullptr;
+    m_lru.splice(m_lru.begin(), m_lru, it->second.lru);
+    return it->second.layout;
+}
+
+bool MermaidLayoutCache::pending(std::uint64_t key) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_pending.count(key) != 0;
+}
+
+std::size_t MermaidLayoutCache::size() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+void MermaidLayoutCache::waitUntilIdle() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cv.wait(lock, [this] { return m_pending.empty(); });
+}
+
+void MermaidLayoutCache::insertLocked(std::uint64_t key, MermaidLayout layout) {
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        it->second.layout = std::move(layout);
+        m_lru.splice(m_lru.begin(), m_lru, it->second.lru);
+        return;
+    }
+    m_lru.push_front(key);
+    m_entries.emplace(key, Entry{std::move(layout), m_lru.begin()});
+    while (m_entries.size() > std::max<std::size_t>(1, m_config.capacity)) {
+        m_entries.erase(m_lru.back());
+        m_lru.pop_back();
+    }
+}
+
+} // namespace ideawalker::application
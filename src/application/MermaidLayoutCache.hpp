@@ -0,0 +1,99 @@
+/**
+ * @file MermaidLayoutCache.hpp
+ * @brief Laid-out Mermaid diagrams shared by every preview, keyed by a hash of the diagram.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include "domain/writing/MermaidParser.hpp"
+
+namespace ideawalker::application {
+
+class AsyncTaskManager;
+
+/** @brief An immutable laid-out diagram; previews hold it while the cache may evict it. */
+using MermaidLayout = std::shared_ptr<const domain::writing::PreviewGraphState>;
+
+/**
+ * @struct MermaidLayoutConfig
+ * @brief Capacity of the cache and the size above which diagrams are laid out in background.
+ */
+struct MermaidLayoutConfig {
+    std::size_t capacity = 64;         ///< Diagrams kept (least recently used are evicted).
+    std::size_t asyncLineThreshold = 200; ///< Bodies with more lines than this go to a Layout task.
+};
+
+/**
+ * @class MermaidLayoutCache
+ * @brief Parses and lays out each distinct diagram once.
+ *
+ * Switching notes, reopening a file or showing the same diagram in several views
+ * reuses the layout instead of measuring and placing every node again. Large
+ * diagrams are handed to the AsyncTaskManager so the render thread never stalls
+ * on them; acquire() returns null until the result is ready and find() picks it up.
+ * The size calculator may then run on the task's thread and must be thread-safe.
+ */
+class MermaidLayoutCache {
+public:
+    explicit MermaidLayoutCache(std::shared_ptr<AsyncTaskManager> taskManager = nullptr, MermaidLayoutConfig config = {});
+    /** @brief Waits for the background layouts still running. */
+    ~MermaidLayoutCache();
+
+    MermaidLayoutCache(const MermaidLayoutCache&) = delete;
+    MermaidLayoutCache& operator=(const MermaidLayoutCache&) = delete;
+
+    /**
+     * @brief Key of a diagram body.
+     * @param baseId First node id of the diagram (part of the result).
+     * @param measureKey Identifies the size calculator (e.g. font and size).
+     */
+    static std::uint64_t Key(std::string_view content, int baseId, std::uint64_t measureKey);
+
+    /**
+     * @brief Returns the layout for @p key, computing it on a miss.
+     * @return Null while a background layout runs (poll with find()).
+     */
+    MermaidLayout acquire(std::uint64_t key, const std::string& content, int baseId,
+                          domain::writing::MermaidParser::SizeCalculator calculator);
+
+    /** @brief Cached layout for @p key, or null (not computed yet, still running or evicted). */
+    MermaidLayout find(std::uint64_t key);
+
+    /** @brief True while a background layout for @p key runs. */
+    bool pending(std::uint64_t key) const;
+
+    std::size_t size() const;
+
+    /** @brief Blocks until no background layout runs. For tests and headless use. */
+    void waitUntilIdle();
+
+private:
+    struct Entry {
+        MermaidLayout layout;
+        std::list<std::uint64_t>::iterator lru;
+    };
+
+    static MermaidLayout Compute(const std::string& content, int baseId,
+                                 const domain::writing::MermaidParser::SizeCalculator& calculator);
+    void insertLocked(std::uint64_t key, MermaidLayout layout);
+
+    std::shared_ptr<AsyncTaskManager> m_taskManager;
+    MermaidLayoutConfig m_config;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::unordered_map<std::uint64_t, Entry> m_entries;
+    std::list<std::uint64_t> m_lru; // Front = most recently used
+    std::unordered_set<std::uint64_t> m_pending;
+};
+
+} // namespace ideawalker::application
@@ -4,6 +4,7 @@
  */
 
 #include "application/SuggestionService.hpp"
+#include "application/AsyncTaskManager.hpp"
 #include <cmath>
 #include <numeric>
 #include <filesystem>
@@ -82,8 +83,16 @@ std::vector<domain::Suggestion> SuggestionService::generateNarrativeSuggestions(
     return {};
 }
 
-void SuggestionService::indexProject(const std::vector<domain::Insight>& notes) {
-    bool changed = false;
+size_t SuggestionService::indexProject(const std::vector<domain::Insight>& notes,
+                                       AsyncTaskManager* taskManager,
+                                       size_t workers) {
+    struct Missing {
+        std::string id;
+        std::string hash;
+        std::string content;
+        std::vector<float> embedding;
+    };
+    std::vector<Missing> missing;
     for (const auto& note : notes) {
         std::string content = note.getContent();
         std::string id = note.getMetadata().id;
@@ -96,16 +105,28 @@ void SuggestionService::indexProject(const std::vector<domain::Insight>& notes)
         
         std::string hash = computeHash(content);
         if (!m_cache->get(id, hash)) {
-            auto vec = m_ai->getEmbedding(content);
-            if (!vec.empty()) {
-                m_cache->update(id, hash, vec);
-                changed = true;
-            }
+            missing.push_back({std::move(id), std::move(hash), std::move(content), {}});
         }
     }
-    if (changed) {
+
+    // Only the embedding requests run in parallel; the cache is updated afterwards on this thread.
+    auto embed = [&](size_t i) { missing[i].embedding = m_ai->getEmbedding(missing[i].content); };
+    if (!taskManager) {
+        for (size_t i = 0; i < missing.size(); ++i) embed(i);
+    } else {
+        taskManager->RunParallel(TaskType::Indexing, "Indexando embeddings", missing.size(), workers, embed);
+    }
+
+    size_t indexed = 0;
+    for (auto& entry : missing) {
+        if (entry.embedding.empty()) continue;
+        m_cache->update(entry.id, entry.hash, entry.embedding);
+        ++indexed;
+    }
+    if (indexed > 0) {
         m_cache->persist();
     }
+    return indexed;
 }
 
 void SuggestionService::shutdown() {
@@ -13,6 +13,8 @@
 
 namespace ideawalker::application {
 
+class AsyncTaskManager;
+
 /**
  * @class SuggestionService
  * @brief Responsible for identifying potential connections between notes.
@@ -36,8 +38,13 @@ public:
 
     /**
      * @brief Indexes existing notes to ensure embeddings are available for comparison.
+     * @param taskManager When given with @p workers > 1, missing embeddings are fetched in parallel tasks.
+     * @param workers Embedding requests in flight at once.
+     * @return Number of notes whose embedding was (re)computed.
      */
-    void indexProject(const std::vector<domain::Insight>& notes);
+    size_t indexProject(const std::vector<domain::Insight>& notes,
+                        AsyncTaskManager* taskManager = nullptr,
+                        size_t workers = 1);
 
     /** @brief Saves the embedding cache to disk. */
     void shutdown();
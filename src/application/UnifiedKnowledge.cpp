@@ -0,0 +1,56 @@
+/**
+ * @file UnifiedKnowledge.cpp
+ * @brief Implementation of UnifiedKnowledge.
+ */
+
+#include "application/UnifiedKnowledge.hpp"
+
+namespace ideawalker::application {
+
+namespace {
+constexpr std::string_view kNoteSeparator = "\n\n---\n\n";
+} // namespace
+
+void UnifiedKnowledge::invalidate() {
+    m_stale = true;
+    ++m_revision;
+}
+
+void UnifiedKnowledge::clear() {
+    m_headers.clear();
+    m_pieces.clear();
+    invalidate();
+}
+
+const MarkdownPieces& UnifiedKnowledge::pieces(const std::vector<domain::Insight>& insights) {
+    if (!m_stale) return m_pieces;
+    m_stale = false;
+
+    // Headers first: the pieces point into them, so the vector must not grow afterwards.
+    m_headers.clear();
+    m_headers.reserve(insights.size());
+    for (const auto& insight : insights) {
+        m_headers.push_back("## " + insight.getMetadata().id + "\n\n");
+    }
+
+    m_pieces.clear();
+    m_pieces.reserve(insights.size() * 3);
+    for (std::size_t i = 0; i < insights.size(); ++i) {
+        m_pieces.push_back(m_headers[i]);
+        m_pieces.push_back(insights[i].getContent());
+        if (i + 1 < insights.size()) m_pieces.push_back(kNoteSeparator);
+    }
+    return m_pieces;
+}
+
+std::string UnifiedKnowledge::assemble(const std::vector<domain::Insight>& insights) {
+    const MarkdownPieces& parts = pieces(insights);
+    std::size_t size = 0;
+    for (std::string_view part : parts) size += part.size();
+    std::string text;
+    text.reserve(size);
+    for (std::string_view part : parts) text.append(part);
+    return text;
+}
+
+} // namespace ideawalker::application
@@ -0,0 +1,45 @@
+/**
+ * @file UnifiedKnowledge.hpp
+ * @brief Unified knowledge view as a piece table over the note contents.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "application/MarkdownDocument.hpp"
+#include "domain/Insight.hpp"
+
+namespace ideawalker::application {
+
+/**
+ * @class UnifiedKnowledge
+ * @brief All notes read as one document ("## id", content, "---" between notes) without copying them.
+ *
+ * Pieces are views into the Insight contents plus small owned headers, rebuilt lazily
+ * (O(notes), no content bytes touched) the first time they are read after invalidate().
+ * The views follow the insight vector: call invalidate() whenever it changes.
+ */
+class UnifiedKnowledge {
+public:
+    /** @brief Marks the pieces stale and bumps the revision. O(1). */
+    void invalidate();
+    /** @brief Drops the pieces (project closed). */
+    void clear();
+
+    /** @brief Current pieces, rebuilt from @p insights if stale. */
+    const MarkdownPieces& pieces(const std::vector<domain::Insight>& insights);
+    std::uint64_t revision() const { return m_revision; }
+
+    /** @brief Contiguous copy of the whole text (clipboard/export only). */
+    std::string assemble(const std::vector<domain::Insight>& insights);
+
+private:
+    std::vector<std::string> m_headers;
+    MarkdownPieces m_pieces;
+    std::uint64_t m_revision = 0;
+    bool m_stale = true;
+};
+
+} // namespace ideawalker::application
@@ -4,264 +4,267 @@
  */
 
 #include "application/scientific/EpistemicValidator.hpp"
+#include "application/AsyncTaskManager.hpp"
+#include "domain/MentionMatcher.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cctype>
-#include <sstream>
+#include <string_view>
+#include <thread>
 
 namespace ideawalker::application::scientific {
 
 namespace {
 
-std::string Normalize(const std::string& input) {
-    std::string out;
-    out.reserve(input.size());
-    for (unsigned char c : input) {
-        out.push_back(static_cast<char>(std::tolower(c)));
-    }
-    return out;
-}
+/** Needles compiled once per process; matching runs on lowercased text. */
+struct CompiledRules {
+    domain::MentionMatcher normative; ///< D) normative verbs
+    domain::MentionMatcher vagueTime; ///< C) vague time windows (only without numbers)
 
-bool ContainsAny(const std::string& haystack, const std::vector<std::string>& needles) {
-    const std::string norm = Normalize(haystack);
-    for (const auto& needle : needles) {
-        if (norm.find(needle) != std::string::npos) return true;
+    CompiledRules() {
+        normative.build({{"permite", 0}, {"garante", 0}, {"leva a", 0}, {"ideal", 0},
+                         {"deve", 0}, {"should", 0}, {"must", 0}, {"recommend", 0}});
+        vagueTime.build({{"decade", 0}, {"long", 0}, {"years", 0}, {"anos", 0}});
     }
-    return false;
+};
+
+const CompiledRules& Rules() {
+    static const CompiledRules rules;
+    return rules;
 }
 
-bool IsNonEmptyString(const nlohmann::json& j, const char* key) {
-    return j.contains(key) && j[key].is_string() && !j[key].get<std::string>().empty();
+enum Check : size_t { Contextuality, Baseline, Temporal, Language, Mechanisms, Layer, CheckCount };
+constexpr std::array<const char*, CheckCount> kCheckNames = {
+    "contextuality", "baseline", "temporal", "language", "mechanisms", "layer"
+};
+
+/** Findings as static messages; turned into JSON once, at the end. No allocation while checking. */
+struct Findings {
+    std::array<const char*, 8> errors{};
+    std::array<const char*, 4> warnings{};
+    size_t errorCount = 0;
+    size_t warningCount = 0;
+    std::array<const char*, CheckCount> checks{};
+
+    void error(const char* message) { errors[errorCount++] = message; }
+    void warning(const char* message) { warnings[warningCount++] = message; }
+    void set(Check check, const char* status) { checks[check] = status; }
+};
+
+const nlohmann::json* Member(const nlohmann::json& j, const char* key) {
+    if (!j.is_object()) return nullptr;
+    auto it = j.find(key);
+    return it == j.end() ? nullptr : &*it;
 }
 
-bool IsUnknownOrEmpty(const nlohmann::json& j, const char* key) {
-    if (!j.contains(key) || !j[key].is_string()) return true;
-    std::string value = j[key].get<std::string>();
-    if (value.empty()) return true;
-    std::string lowered = Normalize(value);
-    return lowered == "unknown";
+const nlohmann::json* ArrayMember(const nlohmann::json& j, const char* key) {
+    const nlohmann::json* member = Member(j, key);
+    return member && member->is_array() ? member : nullptr;
 }
 
-bool ArrayHasContent(const nlohmann::json& j, const char* key) {
-    return j.contains(key) && j[key].is_array() && !j[key].empty();
+const std::string* StringMember(const nlohmann::json& j, const char* key) {
+    const nlohmann::json* member = Member(j, key);
+    return member && member->is_string() ? member->get_ptr<const std::string*>() : nullptr;
 }
 
-std::string DetectTemporalVagueness(const std::string& timeWindow) {
-    const std::string norm = Normalize(timeWindow);
-    const bool hasDigits = std::any_of(timeWindow.begin(), timeWindow.end(), [](unsigned char c){ return std::isdigit(c); });
-    if (!hasDigits && (norm.find("decade") != std::string::npos || norm.find("long") != std::string::npos ||
-                       norm.find("years") != std::string::npos || norm.find("anos") != std::string::npos)) {
-        return "timeWindow vago (sem números)";
+/** Case-insensitive comparison against a lowercase literal, without building a lowered copy. */
+bool EqualsLower(std::string_view value, std::string_view lowerLiteral) {
+    if (value.size() != lowerLiteral.size()) return false;
+    for (size_t i = 0; i < value.size(); ++i) {
+        if (std::tolower(static_cast<unsigned char>(value[i])) != static_cast<unsigned char>(lowerLiteral[i])) return false;
     }
-    return {};
+    return true;
 }
 
-} // namespace
+bool IsNonEmptyString(const nlohmann::json& j, const char* key) {
+    const std::string* value = StringMember(j, key);
+    return value && !value->empty();
+}
+
+bool IsUnknownOrEmpty(const nlohmann::json& j, const char* key) {
+    const std::string* value = StringMember(j, key);
+    return !value || value->empty() || EqualsLower(*value, "unknown");
+}
 
-void EpistemicValidator::AddError(nlohmann::json& report, const std::string& message) const {
-    report["errors"].push_back(message);
+bool ArrayHasContent(const nlohmann::json& j, const char* key) {
+    const nlohmann::json* array = ArrayMember(j, key);
+    return array && !array->empty();
 }
 
-void EpistemicValidator::AddWarning(nlohmann::json& report, const std::string& message) const {
-    report["warnings"].push_back(message);
+/** Lowercases a field into the caller's buffer (reused across fields) and scans it once. */
+bool Matches(const domain::MentionMatcher& matcher, const std::string& text, std::string& scratch) {
+    scratch.resize(text.size());
+    std::transform(text.begin(), text.end(), scratch.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return matcher.containsAny(scratch);
 }
 
-void EpistemicValidator::SetCheck(nlohmann::json& report, const std::string& key, const std::string& status) const {
-    report["checks"][key] = status;
+nlohmann::json ToArray(const char* const* messages, size_t count) {
+    nlohmann::json array = nlohmann::json::array();
+    for (size_t i = 0; i < count; ++i) array.push_back(messages[i]);
+    return array;
 }
 
+} // namespace
+
 EpistemicValidator::Result EpistemicValidator::Validate(const nlohmann::json& bundle) const {
-    Result result;
-    nlohmann::json report = {
-        {"status", "pass"},
-        {"errors", nlohmann::json::array()},
-        {"warnings", nlohmann::json::array()},
-        {"checks", nlohmann::json::object()}
-    };
+    const CompiledRules& rules = Rules();
+    Findings findings;
+    std::string scratch;
 
     // A) Contextuality check
     bool contextOk = true;
-    if (bundle.contains("narrativeObservations") && bundle["narrativeObservations"].is_array()) {
-        for (const auto& obs : bundle["narrativeObservations"]) {
+    if (const auto* observations = ArrayMember(bundle, "narrativeObservations")) {
+        for (const auto& obs : *observations) {
             if (IsUnknownOrEmpty(obs, "contextuality")) {
                 contextOk = false;
-                AddError(report, "NarrativeObservation sem contextuality.");
+                findings.error("NarrativeObservation sem contextuality.");
                 break;
             }
         }
     }
-    if (bundle.contains("allegedMechanisms") && bundle["allegedMechanisms"].is_array()) {
-        for (const auto& mech : bundle["allegedMechanisms"]) {
+    const nlohmann::json* mechanisms = ArrayMember(bundle, "allegedMechanisms");
+    if (mechanisms) {
+        for (const auto& mech : *mechanisms) {
             if (IsUnknownOrEmpty(mech, "contextuality")) {
                 contextOk = false;
-                AddError(report, "AllegedMechanism sem contextuality.");
+                findings.error("AllegedMechanism sem contextuality.");
                 break;
             }
         }
     }
-    SetCheck(report, "contextuality", contextOk ? "ok" : "error");
+    findings.set(Contextuality, contextOk ? "ok" : "error");
 
     // B) Baseline check
-    bool baselineOk = true;
-    bool baselineWarning = false;
-    if (!bundle.contains("baselineAssumptions") || !bundle["baselineAssumptions"].is_array() || bundle["baselineAssumptions"].empty()) {
-        baselineOk = false;
-        AddError(report, "baselineAssumptions ausente.");
+    const nlohmann::json* baselines = ArrayMember(bundle, "baselineAssumptions");
+    if (!baselines || baselines->empty()) {
+        findings.error("baselineAssumptions ausente.");
+        findings.set(Baseline, "error");
     } else {
-        bool hasDynamic = false;
-        bool hasMultiple = false;
-        for (const auto& baseline : bundle["baselineAssumptions"]) {
-            if (baseline.contains("baselineType") && baseline["baselineType"].is_string()) {
-                const std::string bt = Normalize(baseline["baselineType"].get<std::string>());
-                if (bt == "dynamic") hasDynamic = true;
-                if (bt == "multiple") hasMultiple = true;
+        bool hasDynamicOrMultiple = false;
+        for (const auto& baseline : *baselines) {
+            if (const std::string* type = StringMember(baseline, "baselineType")) {
+                if (EqualsLower(*type, "dynamic") || EqualsLower(*type, "multiple")) hasDynamicOrMultiple = true;
             }
         }
-        if (!hasDynamic && !hasMultiple) {
-            if (bundle.contains("sourceProfile") && bundle["sourceProfile"].is_object()) {
-                if (bundle["sourceProfile"].contains("temporalScale") && bundle["sourceProfile"]["temporalScale"].is_string()) {
-                    std::string scale = Normalize(bundle["sourceProfile"]["temporalScale"].get<std::string>());
-                    if (scale == "long" || scale == "multi") {
-                        baselineWarning = true;
-                        AddWarning(report, "Baseline fixo em estudo de longa duração pode exigir baseline múltiplo/dinâmico.");
-                    }
-                }
+        bool baselineWarning = false;
+        if (!hasDynamicOrMultiple) {
+            const nlohmann::json* profile = Member(bundle, "sourceProfile");
+            const std::string* scale = profile ? StringMember(*profile, "temporalScale") : nullptr;
+            if (scale && (EqualsLower(*scale, "long") || EqualsLower(*scale, "multi"))) {
+                baselineWarning = true;
+                findings.warning("Baseline fixo em estudo de longa duração pode exigir baseline múltiplo/dinâmico.");
             }
         }
-    }
-    if (!baselineOk) {
-        SetCheck(report, "baseline", "error");
-    } else if (baselineWarning) {
-        SetCheck(report, "baseline", "warning");
-    } else {
-        SetCheck(report, "baseline", "ok");
+        findings.set(Baseline, baselineWarning ? "warning" : "ok");
     }
 
     // C) Temporal check
     bool temporalOk = true;
     bool temporalWarning = false;
-    if (!bundle.contains("temporalWindowReferences") || !bundle["temporalWindowReferences"].is_array() || bundle["temporalWindowReferences"].empty()) {
+    const nlohmann::json* windows = ArrayMember(bundle, "temporalWindowReferences");
+    if (!windows || windows->empty()) {
         // Relaxed: treated as warning instead of blocking error
         temporalWarning = true;
-        AddWarning(report, "temporalWindowReferences ausente (Validation Relaxed).");
+        findings.warning("temporalWindowReferences ausente (Validation Relaxed).");
     } else {
-        for (const auto& tw : bundle["temporalWindowReferences"]) {
+        for (const auto& tw : *windows) {
             if (!IsNonEmptyString(tw, "timeWindow") || !IsNonEmptyString(tw, "changeRhythm") || !IsNonEmptyString(tw, "delaysOrHysteresis")) {
                 temporalOk = false;
-                AddError(report, "TemporalWindowReference incompleto.");
+                findings.error("TemporalWindowReference incompleto.");
                 break;
             }
-            if (tw.contains("timeWindow") && tw["timeWindow"].is_string()) {
-                auto warning = DetectTemporalVagueness(tw["timeWindow"].get<std::string>());
-                if (!warning.empty()) temporalWarning = true;
-            }
+            // Vague windows ("long", "decades") only downgrade the check; there is no message for them.
+            const std::string& timeWindow = *StringMember(tw, "timeWindow");
+            const bool hasDigits = std::any_of(timeWindow.begin(), timeWindow.end(), [](unsigned char c) { return std::isdigit(c); });
+            if (!hasDigits && Matches(rules.vagueTime, timeWindow, scratch)) temporalWarning = true;
         }
     }
-    if (!temporalOk) {
-        SetCheck(report, "temporal", "error");
-    } else if (temporalWarning) {
-        SetCheck(report, "temporal", "warning");
-    } else {
-        SetCheck(report, "temporal", "ok");
-    }
+    findings.set(Temporal, !temporalOk ? "error" : (temporalWarning ? "warning" : "ok"));
 
     // D) Language check (normative verbs)
-    const std::vector<std::string> banned = {
-        "permite", "garante", "leva a", "ideal", "deve", "should", "must", "recommend"
-    };
     bool languageOk = true;
-    auto scanObjectArrayField = [&](const nlohmann::json& arr, const char* field, bool isError) {
-        if (!arr.is_array()) return;
-        for (const auto& item : arr) {
-            if (!item.is_object() || !item.contains(field) || !item[field].is_string()) continue;
-            if (ContainsAny(item[field].get<std::string>(), banned)) {
-                if (isError) {
-                    languageOk = false;
-                    AddError(report, std::string("Linguagem normativa detectada em ") + field + ".");
-                } else {
-                    AddWarning(report, std::string("Linguagem normativa detectada em ") + field + ".");
-                }
-                break;
+    auto scanField = [&](const nlohmann::json* array, const char* field, const char* message, bool isError) {
+        if (!array) return;
+        for (const auto& item : *array) {
+            const std::string* text = field ? StringMember(item, field)
+                                            : (item.is_string() ? item.get_ptr<const std::string*>() : nullptr);
+            if (!text || !Matches(rules.normative, *text, scratch)) continue;
+            if (isError) {
+                languageOk = false;
+                findings.error(message);
+            } else {
+                findings.warning(message);
             }
+            break;
         }
     };
-    auto scanStringArray = [&](const nlohmann::json& arr, const char* label, bool isError) {
-        if (!arr.is_array()) return;
-        for (const auto& item : arr) {
-            if (!item.is_string()) continue;
-            if (ContainsAny(item.get<std::string>(), banned)) {
-                if (isError) {
-                    languageOk = false;
-                    AddError(report, std::string("Linguagem normativa detectada em ") + label + ".");
-                } else {
-                    AddWarning(report, std::string("Linguagem normativa detectada em ") + label + ".");
-                }
-                break;
-            }
-        }
-    };
-    if (bundle.contains("narrativeObservations")) {
-        scanObjectArrayField(bundle["narrativeObservations"], "observation", true);
+    scanField(ArrayMember(bundle, "narrativeObservations"), "observation",
+              "Linguagem normativa detectada em observation.", true);
+    scanField(mechanisms, "mechanism", "Linguagem normativa detectada em mechanism.", true);
+    const nlohmann::json* layers = Member(bundle, "interpretationLayers");
+    if (layers && layers->is_object()) {
+        scanField(ArrayMember(*layers, "authorInterpretations"), nullptr,
+                  "Linguagem normativa detectada em authorInterpretations.", false);
     }
-    if (bundle.contains("allegedMechanisms")) {
-        scanObjectArrayField(bundle["allegedMechanisms"], "mechanism", true);
-    }
-    if (bundle.contains("interpretationLayers") && bundle["interpretationLayers"].is_object()) {
-        if (bundle["interpretationLayers"].contains("authorInterpretations")) {
-            scanStringArray(bundle["interpretationLayers"]["authorInterpretations"], "authorInterpretations", false);
-        }
-    }
-    SetCheck(report, "language", languageOk ? "ok" : "error");
+    findings.set(Language, languageOk ? "ok" : "error");
 
     // E) Mechanisms check
     bool mechanismsOk = true;
-    if (bundle.contains("allegedMechanisms") && bundle["allegedMechanisms"].is_array()) {
-        for (const auto& mech : bundle["allegedMechanisms"]) {
+    if (mechanisms) {
+        for (const auto& mech : *mechanisms) {
             if (IsUnknownOrEmpty(mech, "status")) {
                 mechanismsOk = false;
-                AddError(report, "AllegedMechanism sem status.");
+                findings.error("AllegedMechanism sem status.");
                 break;
             }
             if (IsUnknownOrEmpty(mech, "limitations")) {
                 mechanismsOk = false;
-                AddError(report, "AllegedMechanism sem limitations.");
+                findings.error("AllegedMechanism sem limitations.");
                 break;
             }
-            if (mech.contains("status") && mech["status"].is_string()) {
-                std::string status = Normalize(mech["status"].get<std::string>());
-                if (status == "tested" && IsUnknownOrEmpty(mech, "evidenceSnippet")) {
-                    mechanismsOk = false;
-                    AddError(report, "AllegedMechanism marcado como tested sem evidenceSnippet.");
-                    break;
-                }
+            if (EqualsLower(*StringMember(mech, "status"), "tested") && IsUnknownOrEmpty(mech, "evidenceSnippet")) {
+                mechanismsOk = false;
+                findings.error("AllegedMechanism marcado como tested sem evidenceSnippet.");
+                break;
             }
         }
     }
-    SetCheck(report, "mechanisms", mechanismsOk ? "ok" : "error");
+    findings.set(Mechanisms, mechanismsOk ? "ok" : "error");
 
     // F) Layer targeting check
     bool layerOk = true;
     bool hasInterpretation = false;
-    if (bundle.contains("interpretationLayers") && bundle["interpretationLayers"].is_object()) {
-        hasInterpretation = ArrayHasContent(bundle["interpretationLayers"], "observedStatements") ||
-                            ArrayHasContent(bundle["interpretationLayers"], "authorInterpretations") ||
-                            ArrayHasContent(bundle["interpretationLayers"], "possibleReadings");
+    if (layers && layers->is_object()) {
+        hasInterpretation = ArrayHasContent(*layers, "observedStatements") ||
+                            ArrayHasContent(*layers, "authorInterpretations") ||
+                            ArrayHasContent(*layers, "possibleReadings");
     }
-    if (bundle.contains("requestedTargets") && bundle["requestedTargets"].is_array()) {
-        for (const auto& tgt : bundle["requestedTargets"]) {
-            if (tgt.is_string() && Normalize(tgt.get<std::string>()) == "strata-core" && hasInterpretation) {
+    if (const auto* targets = ArrayMember(bundle, "requestedTargets"); targets && hasInterpretation) {
+        for (const auto& tgt : *targets) {
+            if (tgt.is_string() && EqualsLower(tgt.get_ref<const std::string&>(), "strata-core")) {
                 layerOk = false;
-                AddError(report, "InterpretationLayers presentes: STRATA-Core não permitido.");
+                findings.error("InterpretationLayers presentes: STRATA-Core não permitido.");
                 break;
             }
         }
     }
-    SetCheck(report, "layer", layerOk ? "ok" : "error");
+    findings.set(Layer, layerOk ? "ok" : "error");
 
     // Status aggregation
-    const bool hasErrors = !report["errors"].empty();
-    const bool hasWarnings = !report["warnings"].empty();
-    report["status"] = hasErrors ? "block" : (hasWarnings ? "pass-with-warnings" : "pass");
+    const bool hasErrors = findings.errorCount > 0;
+    const bool hasWarnings = findings.warningCount > 0;
+    nlohmann::json checks = nlohmann::json::object();
+    for (size_t i = 0; i < CheckCount; ++i) checks[kCheckNames[i]] = findings.checks[i];
+
+    Result result;
+    result.report = {
+        {"status", hasErrors ? "block" : (hasWarnings ? "pass-with-warnings" : "pass")},
+        {"errors", ToArray(findings.errors.data(), findings.errorCount)},
+        {"warnings", ToArray(findings.warnings.data(), findings.warningCount)},
+        {"checks", std::move(checks)}
+    };
 
     // Seal
     nlohmann::json seal = {
@@ -277,9 +280,24 @@ EpistemicValidator::Result EpistemicValidator::Validate(const nlohmann::json& bu
     }
 
     result.exportAllowed = !hasErrors;
-    result.report = std::move(report);
     result.seal = std::move(seal);
     return result;
 }
 
+std::vector<EpistemicValidator::Result> EpistemicValidator::ValidateBatch(const std::vector<nlohmann::json>& bundles,
+                                                                          AsyncTaskManager* taskManager,
+                                                                          size_t workers) const {
+    std::vector<Result> results(bundles.size());
+    if (workers == 0) workers = std::max(1u, std::thread::hardware_concurrency());
+    workers = std::min(workers, bundles.size());
+    if (!taskManager || workers <= 1) {
+        for (size_t i = 0; i < bundles.size(); ++i) results[i] = Validate(bundles[i]);
+        return results;
+    }
+
+    taskManager->RunParallel(TaskType::Indexing, "Validação epistemológica em lote", bundles.size(), workers,
+                             [&](size_t i) { results[i] = Validate(bundles[i]); });
+    return results;
+}
+
 } // namespace ideawalker::application::scientific
@@ -10,11 +10,21 @@
 
 #include <nlohmann/json.hpp>
 
+namespace ideawalker::application {
+class AsyncTaskManager;
+}
+
 namespace ideawalker::application::scientific {
 
 /**
  * @class EpistemicValidator
  * @brief Validates epistemic integrity before STRATA export.
+ *
+ * The rule set is compiled once per process: the normative-language and vague-time
+ * needles live in two Aho–Corasick automata (domain::MentionMatcher), each text field
+ * is lowercased once into a reused buffer and scanned in a single pass, and findings
+ * are collected as static messages that become JSON only when the report is built.
+ * The validator is stateless, so one instance may be shared across threads.
  */
 class EpistemicValidator {
 public:
@@ -31,10 +41,16 @@ public:
      */
     Result Validate(const nlohmann::json& bundle) const;
 
-private:
-    void AddError(nlohmann::json& report, const std::string& message) const;
-    void AddWarning(nlohmann::json& report, const std::string& message) const;
-    void SetCheck(nlohmann::json& report, const std::string& key, const std::string& status) const;
+    /**
+     * @brief Validates many bundles (e.g. the whole corpus after a rule change).
+     * @param bundles Bundles to validate; results come back in the same order.
+     * @param taskManager Optional; when set, the batch is split across `workers` tasks
+     *        (ADR-010). It must outlive the call's tasks, which finish before this returns.
+     * @param workers Parallel tasks; 0 = one per hardware thread.
+     */
+    std::vector<Result> ValidateBatch(const std::vector<nlohmann::json>& bundles,
+                                      AsyncTaskManager* taskManager = nullptr,
+                                      size_t workers = 0) const;
 };
 
 } // namespace ideawalker::application::scientific
@@ -0,0 +1,336 @@
+/**
+ * @file IngestionCatalog.cpp
+ * @brief Implementation of IngestionCatalog.
+ */
+
+#include "application/scientific/IngestionCatalog.hpp"
+#include "infrastructure/JsonScanner.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+namespace fs = std::filesystem;
+using ideawalker::infrastructure::JsonScanner;
+
+namespace ideawalker::application::scientific {
+
+namespace {
+
+constexpr size_t kCompactionSlack = 256; // Dead records tolerated before the log is rewritten.
+
+std::optional<nlohmann::json> ReadJson(const fs::path& path) {
+    std::ifstream in(path);
+    if (!in.is_open()) return std::nullopt;
+    try {
+        nlohmann::json value;
+        in >> value;
+        return value;
+    } catch (...) {
+        return std::nullopt;
+    }
+}
+
+} // namespace
+
+IngestionCatalog::IngestionCatalog(std::string observationsPath, std::string consumablesPath)
+    : m_observationsPath(std::move(observationsPath)), m_consumablesPath(std::move(consumablesPath)) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!load()) {
+        rebuildLocked();
+    } else if (m_logRecords > 2 * (m_bundles.size() + m_validations.size() + m_exported.size()) + kCompactionSlack) {
+        compactLocked();
+    }
+}
+
+std::string IngestionCatalog::logPath() const {
+    return (fs::path(m_observationsPath) / "catalog" / "ingestion.ndjson").string();
+}
+
+void IngestionCatalog::recordBundle(const std::string& artifactId) {
+    Record record;
+    record.op = "bundle";
+    record.artifactId = artifactId;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    apply(record);
+    appendLocked(record);
+}
+
+void IngestionCatalog::recordValidation(const std::string& artifactId, const std::string& path,
+                                        const nlohmann::json& report) {
+    const Record record = MakeValidationRecord(artifactId, path, report);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    apply(record);
+    appendLocked(record);
+    m_latestReportId = artifactId;
+    m_latestReport = report.dump(2); // Same text the report file was written with.
+}
+
+void IngestionCatalog::recordSeal(const std::string& artifactId, bool exportAllowed) {
+    Record record;
+    record.op = "seal";
+    record.artifactId = artifactId;
+    record.exportAllowed = exportAllowed;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    apply(record);
+    appendLocked(record);
+}
+
+void IngestionCatalog::recordRemoved(const std::string& artifactId) {
+    Record record;
+    record.op = "removed";
+    record.artifactId = artifactId;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    apply(record);
+    appendLocked(record);
+}
+
+size_t IngestionCatalog::bundleCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_bundles.size();
+}
+
+size_t IngestionCatalog::exportedCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_exported.size();
+}
+
+std::optional<IngestionCatalog::ValidationEntry> IngestionCatalog::latestValidation() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_validations.find(m_latestId);
+    if (m_latestId.empty() || it == m_validations.end()) return std::nullopt;
+
+    if (m_latestReportId != m_latestId) {
+        // Replayed from the log: the report text is loaded once, not on every query.
+        std::ifstream file(it->second.path);
+        if (!file.is_open()) return std::nullopt;
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        m_latestReport = buffer.str();
+        m_latestReportId = m_latestId;
+    }
+
+    ValidationEntry entry;
+    entry.artifactId = m_latestId;
+    entry.path = it->second.path;
+    entry.status = it->second.status;
+    entry.exportAllowed = it->second.status != "block";
+    entry.errorCount = it->second.errorCount;
+    entry.warningCount = it->second.warningCount;
+    entry.reportJson = m_latestReport;
+    return entry;
+}
+
+size_t IngestionCatalog::rebuild() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    rebuildLocked();
+    return m_bundles.size();
+}
+
+bool IngestionCatalog::load() {
+    std::ifstream in(logPath());
+    if (!in.is_open()) return false;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty()) continue;
+        if (auto record = ParseRecord(line)) {
+            apply(*record);
+            ++m_logRecords;
+        } else {
+            // Torn write from a crash: the record is lost, the rest of the log is still valid.
+            std::cerr << "[IngestionCatalog] Skipping unreadable record in " << logPath() << std::endl;
+        }
+    }
+    return true;
+}
+
+IngestionCatalog::Record IngestionCatalog::MakeValidationRecord(const std::string& artifactId, const std::string& path,
+                                                                const nlohmann::json& report) {
+    Record record;
+    record.op = "validation";
+    record.artifactId = artifactId;
+    record.path = path;
+    if (report.contains("status") && report["status"].is_string()) record.status = report["status"];
+    if (report.contains("errors") && report["errors"].is_array()) record.errorCount = report["errors"].size();
+    if (report.contains("warnings") && report["warnings"].is_array()) record.warningCount = report["warnings"].size();
+    return record;
+}
+
+std::optional<IngestionCatalog::Record> IngestionCatalog::ParseRecord(std::string_view line) {
+    Record record;
+    const bool wellFormed = JsonScanner::forEachMember(line, [&record](std::string_view key, const JsonScanner::Value& value) {
+        if (key == "op") record.op = value.asString().value_or("");
+        else if (key == "artifactId") record.artifactId = value.asString().value_or("");
+        else if (key == "path") record.path = value.asString().value_or("");
+        else if (key == "status") record.status = value.asString().value_or("");
+        else if (key == "errorCount") record.errorCount = static_cast<size_t>(std::max<std::int64_t>(0, value.asInt().value_or(0)));
+        else if (key == "warningCount") record.warningCount = static_cast<size_t>(std::max<std::int64_t>(0, value.asInt().value_or(0)));
+        else if (key == "exportAllowed") record.exportAllowed = value.asBool().value_or(false);
+    });
+    if (!wellFormed) return std::nullopt;
+    return record;
+}
+
+std::string IngestionCatalog::FormatRecord(const Record& record) {
+    nlohmann::json line = {{"op", record.op}, {"artifactId", record.artifactId}};
+    if (record.op == "validation") {
+        line["path"] = record.path;
+        line["status"] = record.status;
+        line["errorCount"] = record.errorCount;
+        line["warningCount"] = record.warningCount;
+    } else if (record.op == "seal") {
+        line["exportAllowed"] = record.exportAllowed;
+    }
+    return line.dump();
+}
+
+void IngestionCatalog::apply(const Record& record) {
+    const std::string& op = record.op;
+    const std::string& artifactId = record.artifactId;
+    if (artifactId.empty()) return;
+
+    if (op == "bundle") {
+        m_bundles.insert(artifactId);
+    } else if (op == "validation") {
+        Validation& validation = m_validations[artifactId];
+        validation.path = record.path;
+        validation.status = record.status;
+        validation.errorCount = record.errorCount;
+        validation.warningCount = record.warningCount;
+        validation.sequence = ++m_sequence;
+        m_latestId = artifactId;
+    } else if (op == "seal") {
+        if (record.exportAllowed) {
+            m_exported.insert(artifactId);
+        } else {
+            m_exported.erase(artifactId);
+        }
+    } else if (op == "removed") {
+        m_bundles.erase(artifactId);
+        m_exported.erase(artifactId);
+        m_validations.erase(artifactId);
+        if (m_latestId == artifactId) {
+            // Rare (purge of the newest validation): fall back to the previous one.
+            m_latestId.clear();
+            std::uint64_t best = 0;
+            for (const auto& [id, validation] : m_validations) {
+                if (validation.sequence > best) {
+                    best = validation.sequence;
+                    m_latestId = id;
+                }
+            }
+        }
+    }
+}
+
+void IngestionCatalog::appendLocked(const Record& record) {
+    const fs::path path = logPath();
+    std::error_code ec;
+    fs::create_directories(path.parent_path(), ec);
+    std::ofstream out(path, std::ios::app);
+    if (!out.is_open()) {
+        std::cerr << "[IngestionCatalog] Failed to append to " << path << std::endl;
+        return;
+    }
+    out << FormatRecord(record) << '\n';
+    ++m_logRecords;
+}
+
+void IngestionCatalog::compactLocked() {
+    std::vector<std::pair<std::uint64_t, std::string>> validations;
+    validations.reserve(m_validations.size());
+    for (const auto& [id, validation] : m_validations) validations.emplace_back(validation.sequence, id);
+    std::sort(validations.begin(), validations.end());
+
+    std::ostringstream log;
+    Record record;
+    record.op = "bundle";
+    for (const auto& id : m_bundles) {
+        record.artifactId = id;
+        log << FormatRecord(record) << '\n';
+    }
+    record.op = "validation";
+    for (const auto& [sequence, id] : validations) {
+        const Validation& validation = m_validations[id];
+        record.artifactId = id;
+        record.path = validation.path;
+        record.status = validation.status;
+        record.errorCount = validation.errorCount;
+        record.warningCount = validation.warningCount;
+        log << FormatRecord(record) << '\n';
+    }
+    record.op = "seal";
+    record.exportAllowed = true;
+    for (const auto& id : m_exported) {
+        record.artifactId = id;
+        log << FormatRecord(record) << '\n';
+    }
+
+    const fs::path path = logPath();
+    fs::path temp = path;
+    temp += ".tmp";
+    std::error_code ec;
+    fs::create_directories(path.parent_path(), ec);
+    {
+        std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            std::cerr << "[IngestionCatalog] Failed to write " << temp << std::endl;
+            return;
+        }
+        out << log.str();
+    }
+    fs::rename(temp, path, ec);
+    if (ec) {
+        std::cerr << "[IngestionCatalog] Failed to replace " << path << ": " << ec.message() << std::endl;
+        return;
+    }
+    m_logRecords = m_bundles.size() + validations.size() + m_exported.size();
+}
+
+void IngestionCatalog::rebuildLocked() {
+    m_bundles.clear();
+    m_exported.clear();
+    m_validations.clear();
+    m_latestId.clear();
+    m_latestReportId.clear();
+    m_latestReport.clear();
+    m_sequence = 0;
+
+    const fs::path obsDir(m_observationsPath);
+    if (fs::exists(obsDir)) {
+        for (const auto& entry : fs::directory_iterator(obsDir)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".json") {
+                m_bundles.insert(entry.path().stem().string());
+            }
+        }
+    }
+
+    // Replayed oldest first, so the newest report ends up as the latest validation.
+    std::vector<std::pair<fs::file_time_type, fs::path>> reports;
+    const fs::path validationDir = obsDir / "validation";
+    if (fs::exists(validationDir)) {
+        for (const auto& entry : fs::directory_iterator(validationDir)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".json") {
+                reports.emplace_back(entry.last_write_time(), entry.path());
+            }
+        }
+    }
+    std::sort(reports.begin(), reports.end());
+    for (const auto& [time, path] : reports) {
+        if (auto report = ReadJson(path)) apply(MakeValidationRecord(path.stem().string(), path.string(), *report));
+    }
+
+    if (fs::exists(m_consumablesPath)) {
+        for (const auto& entry : fs::directory_iterator(m_consumablesPath)) {
+            if (!entry.is_directory()) continue;
+            auto seal = ReadJson(entry.path() / "ExportSeal.json");
+            if (seal && seal->value("exportAllowed", false)) m_exported.insert(entry.path().filename().string());
+        }
+    }
+    compactLocked();
+}
+
+} // namespace ideawalker::application::scientific
@@ -0,0 +1,105 @@
+/**
+ * @file IngestionCatalog.hpp
+ * @brief Append-only catalog of scientific bundles, validations and export seals.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <nlohmann/json.hpp>
+
+namespace ideawalker::application::scientific {
+
+/**
+ * @class IngestionCatalog
+ * @brief Answers the Scientific panel's queries without scanning the observation folders.
+ *
+ * Every bundle, validation report and export seal is appended to
+ * `<observationsPath>/catalog/ingestion.ndjson` as it is written (one JSON record per
+ * line); the log is replayed once at startup into in-memory sets, so counts and the
+ * latest validation are O(1). A missing log (projects from older versions) or a
+ * `rebuild()` call scans the folders once and rewrites the log compacted; a torn last
+ * line after a crash is skipped. Thread-safe.
+ */
+class IngestionCatalog {
+public:
+    /** @brief Latest validation as shown by the panel. */
+    struct ValidationEntry {
+        std::string artifactId;
+        std::string path;   ///< Report under `observations/.../validation/`.
+        std::string status;
+        bool exportAllowed = false;
+        size_t errorCount = 0;
+        size_t warningCount = 0;
+        std::string reportJson; ///< Report text, read from disk at most once per validation.
+    };
+
+    IngestionCatalog(std::string observationsPath, std::string consumablesPath);
+
+    void recordBundle(const std::string& artifactId);
+    void recordValidation(const std::string& artifactId, const std::string& path, const nlohmann::json& report);
+    void recordSeal(const std::string& artifactId, bool exportAllowed);
+    /** @brief All outputs of the artifact were removed (re-ingestion purge). */
+    void recordRemoved(const std::string& artifactId);
+
+    size_t bundleCount() const;
+    size_t exportedCount() const;
+    std::optional<ValidationEntry> latestValidation() const;
+
+    /**
+     * @brief Rescans bundles, validation reports and seals on disk and rewrites the log.
+     * @return Number of bundles found.
+     */
+    size_t rebuild();
+
+private:
+    /** @brief One log line; replayed from text without building a JSON DOM. */
+    struct Record {
+        std::string op; ///< bundle | validation | seal | removed
+        std::string artifactId;
+        std::string path;
+        std::string status;
+        size_t errorCount = 0;
+        size_t warningCount = 0;
+        bool exportAllowed = false;
+    };
+
+    struct Validation {
+        std::string path;
+        std::string status;
+        size_t errorCount = 0;
+        size_t warningCount = 0;
+        std::uint64_t sequence = 0;
+    };
+
+    std::string logPath() const;
+    bool load();
+    static Record MakeValidationRecord(const std::string& artifactId, const std::string& path, const nlohmann::json& report);
+    static std::optional<Record> ParseRecord(std::string_view line);
+    static std::string FormatRecord(const Record& record);
+    void apply(const Record& record);
+    void appendLocked(const Record& record);
+    void compactLocked();
+    void rebuildLocked();
+
+    std::string m_observationsPath;
+    std::string m_consumablesPath;
+    mutable std::mutex m_mutex;
+    std::unordered_set<std::string> m_bundles;
+    std::unordered_set<std::string> m_exported;
+    std::unordered_map<std::string, Validation> m_validations;
+    std::string m_latestId;          ///< Artifact of the most recent validation.
+    std::uint64_t m_sequence = 0;
+    size_t m_logRecords = 0;         ///< Lines in the log, to decide when to compact.
+    mutable std::string m_latestReportId;
+    mutable std::string m_latestReport;
+};
+
+} // namespace ideawalker::application::scientific
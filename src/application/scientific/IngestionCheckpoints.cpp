@@ -0,0 +1,280 @@
+/**
+ * @file IngestionCheckpoints.cpp
+ * @brief Implementation of IngestionCheckpoints.
+ */
+
+#include "application/scientific/IngestionCheckpoints.hpp"
+
+#include <chrono>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+namespace ideawalker::application::scientific {
+
+namespace {
+
+constexpr IngestionStage kStages[] = {IngestionStage::Extracted, IngestionStage::Narrative,
+                                      IngestionStage::Discursive, IngestionStage::Validated,
+                                      IngestionStage::Exported};
+
+constexpr size_t kCompactionSlack = 256; // Superseded records tolerated before the log is rewritten.
+
+std::string Key(const std::string& sourceSha256, const std::string& filename) {
+    return sourceSha256 + "_" + filename;
+}
+
+std::string NowIso() {
+    std::time_t tt = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    std::tm tm = {};
+#if defined(_WIN32)
+    gmtime_s(&tm, &tt);
+#else
+    gmtime_r(&tt, &tm);
+#endif
+    std::ostringstream oss;
+    oss << std::put_time(&tm, "%Y-%m-%dT%H:%M:%SZ");
+    return oss.str();
+}
+
+bool WriteAtomically(const fs::path& path, const std::string& content) {
+    std::error_code ec;
+    fs::create_directories(path.parent_path(), ec);
+    fs::path temp = path;
+    temp += ".tmp";
+    {
+        std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) return false;
+        out << content;
+        if (!out.good()) return false;
+    }
+    fs::rename(temp, path, ec);
+    return !ec;
+}
+
+IngestionCheckpoint ParseEntry(const nlohmann::json& item) {
+    IngestionCheckpoint entry;
+    entry.sourceSha256 = item.value("sourceSha256", "");
+    entry.filename = item.value("filename", "");
+    entry.pipelineVersion = item.value("pipelineVersion", "");
+    entry.artifactId = item.value("artifactId", "");
+    entry.exportBlocked = item.value("exportBlocked", false);
+    entry.updatedAt = item.value("updatedAt", "");
+    for (const auto& name : item.value("stages", nlohmann::json::array())) {
+        for (IngestionStage stage : kStages) {
+            if (name == IngestionCheckpoints::StageName(stage)) entry.stages |= 1u << static_cast<unsigned>(stage);
+        }
+    }
+    return entry;
+}
+
+} // namespace
+
+IngestionCheckpoints::IngestionCheckpoints(std::string directory) : m_directory(std::move(directory)) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!load()) {
+        // Directories from older versions kept one JSON manifest rewritten on every stage.
+        if (loadLegacyManifest()) compactLocked();
+    } else if (m_logRecords > 2 * m_entries.size() + kCompactionSlack) {
+        compactLocked();
+    }
+}
+
+const char* IngestionCheckpoints::StageName(IngestionStage stage) {
+    switch (stage) {
+        case IngestionStage::Extracted: return "extracted";
+        case IngestionStage::Narrative: return "narrative";
+        case IngestionStage::Discursive: return "discursive";
+        case IngestionStage::Validated: return "validated";
+        case IngestionStage::Exported: return "exported";
+    }
+    return "unknown";
+}
+
+std::optional<IngestionCheckpoint> IngestionCheckpoints::find(const std::string& sourceSha256,
+                                                              const std::string& filename,
+                                                              const std::string& pipelineVersion) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_entries.find(Key(sourceSha256, filename));
+    if (it == m_entries.end() || it->second.pipelineVersion != pipelineVersion) return std::nullopt;
+    return it->second;
+}
+
+IngestionCheckpoint IngestionCheckpoints::begin(const std::string& sourceSha256,
+                                                const std::string& filename,
+                                                const std::string& pipelineVersion,
+                                                const std::string& artifactId) {
+    const std::string key = Key(sourceSha256, filename);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_entries.find(key);
+    if (it != m_entries.end() && it->second.pipelineVersion == pipelineVersion) return it->second;
+
+    // Stale (other prompts/schema) or new: results from another version must not be reused.
+    std::error_code ec;
+    fs::remove_all(payloadDir(key), ec);
+    IngestionCheckpoint entry;
+    entry.sourceSha256 = sourceSha256;
+    entry.filename = filename;
+    entry.pipelineVersion = pipelineVersion;
+    entry.artifactId = artifactId;
+    entry.updatedAt = NowIso();
+    m_entries[key] = entry;
+    appendLocked(FormatEntry(entry));
+    return entry;
+}
+
+void IngestionCheckpoints::mark(const std::string& sourceSha256, const std::string& filename,
+                                IngestionStage stage, bool exportBlocked) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_entries.find(Key(sourceSha256, filename));
+    if (it == m_entries.end()) return;
+    it->second.stages |= 1u << static_cast<unsigned>(stage);
+    if (stage == IngestionStage::Validated) it->second.exportBlocked = exportBlocked;
+    it->second.updatedAt = NowIso();
+    appendLocked(FormatEntry(it->second));
+}
+
+void IngestionCheckpoints::discard(const std::string& sourceSha256, const std::string& filename,
+                                   IngestionStage stage) {
+    const std::string key = Key(sourceSha256, filename);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::error_code ec;
+    fs::remove(fs::path(payloadDir(key)) / (std::string(StageName(stage)) + ".json"), ec);
+    auto it = m_entries.find(key);
+    if (it == m_entries.end() || !it->second.has(stage)) return;
+    it->second.stages &= ~(1u << static_cast<unsigned>(stage));
+    it->second.updatedAt = NowIso();
+    appendLocked(FormatEntry(it->second));
+}
+
+void IngestionCheckpoints::remove(const std::string& sourceSha256, const std::string& filename) {
+    const std::string key = Key(sourceSha256, filename);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::error_code ec;
+    fs::remove_all(payloadDir(key), ec);
+    if (m_entries.erase(key) == 0) return;
+    appendLocked({{"op", "removed"}, {"sourceSha256", sourceSha256}, {"filename", filename}});
+}
+
+bool IngestionCheckpoints::savePayload(const std::string& sourceSha256, const std::string& filename,
+                                       IngestionStage stage, const nlohmann::json& payload) const {
+    const fs::path path = fs::path(payloadDir(Key(sourceSha256, filename))) / (std::string(StageName(stage)) + ".json");
+    if (!WriteAtomically(path, payload.dump())) {
+        std::cerr << "[IngestionCheckpoints] Failed to write " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+std::optional<nlohmann::json> IngestionCheckpoints::loadPayload(const std::string& sourceSha256,
+                                                                const std::string& filename,
+                                                                IngestionStage stage) const {
+    const fs::path path = fs::path(payloadDir(Key(sourceSha256, filename))) / (std::string(StageName(stage)) + ".json");
+    std::ifstream in(path);
+    if (!in.is_open()) return std::nullopt;
+    try {
+        return nlohmann::json::parse(in);
+    } catch (const std::exception& e) {
+        std::cerr << "[IngestionCheckpoints] Discarding unreadable " << path << ": " << e.what() << std::endl;
+        return std::nullopt;
+    }
+}
+
+std::string IngestionCheckpoints::payloadDir(const std::string& key) const {
+    return (fs::path(m_directory) / key).string();
+}
+
+std::string IngestionCheckpoints::logPath() const {
+    return (fs::path(m_directory) / "checkpoints.ndjson").string();
+}
+
+bool IngestionCheckpoints::load() {
+    std::ifstream in(logPath());
+    if (!in.is_open()) return false;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty()) continue;
+        nlohmann::json record;
+        try {
+            record = nlohmann::json::parse(line);
+        } catch (const std::exception&) {
+            // Torn write from a crash: that stage is redone, the rest of the log is still valid.
+            std::cerr << "[IngestionCheckpoints] Skipping unreadable record in " << logPath() << std::endl;
+            continue;
+        }
+        if (!record.is_object()) continue;
+        ++m_logRecords;
+        const std::string key = Key(record.value("sourceSha256", ""), record.value("filename", ""));
+        if (record.value("op", "") == "removed") {
+            m_entries.erase(key);
+        } else {
+            m_entries[key] = ParseEntry(record);
+        }
+    }
+    return true;
+}
+
+bool IngestionCheckpoints::loadLegacyManifest() {
+    std::ifstream in(fs::path(m_directory) / "manifest.json");
+    if (!in.is_open()) return false;
+    try {
+        const nlohmann::json manifest = nlohmann::json::parse(in);
+        const nlohmann::json artifacts = manifest.value("artifacts", nlohmann::json::object());
+        for (const auto& [key, item] : artifacts.items()) m_entries[key] = ParseEntry(item);
+    } catch (const std::exception& e) {
+        // A damaged manifest only costs a full re-run.
+        std::cerr << "[IngestionCheckpoints] Ignoring unreadable manifest: " << e.what() << std::endl;
+        m_entries.clear();
+    }
+    return true;
+}
+
+nlohmann::json IngestionCheckpoints::FormatEntry(const IngestionCheckpoint& entry) {
+    nlohmann::json stages = nlohmann::json::array();
+    for (IngestionStage stage : kStages) {
+        if (entry.has(stage)) stages.push_back(StageName(stage));
+    }
+    return {
+        {"op", "entry"},
+        {"sourceSha256", entry.sourceSha256},
+        {"filename", entry.filename},
+        {"pipelineVersion", entry.pipelineVersion},
+        {"artifactId", entry.artifactId},
+        {"stages", stages},
+        {"exportBlocked", entry.exportBlocked},
+        {"updatedAt", entry.updatedAt}
+    };
+}
+
+void IngestionCheckpoints::appendLocked(const nlohmann::json& record) {
+    const fs::path path = logPath();
+    std::error_code ec;
+    fs::create_directories(path.parent_path(), ec);
+    std::ofstream out(path, std::ios::app);
+    if (!out.is_open()) {
+        std::cerr << "[IngestionCheckpoints] Failed to append to " << path << std::endl;
+        return;
+    }
+    out << record.dump() << '\n';
+    ++m_logRecords;
+}
+
+void IngestionCheckpoints::compactLocked() {
+    std::ostringstream log;
+    for (const auto& [key, entry] : m_entries) log << FormatEntry(entry).dump() << '\n';
+    const fs::path path = logPath();
+    if (!WriteAtomically(path, log.str())) {
+        std::cerr << "[IngestionCheckpoints] Failed to write " << path << std::endl;
+        return;
+    }
+    m_logRecords = m_entries.size();
+    std::error_code ec;
+    fs::remove(fs::path(m_directory) / "manifest.json", ec);
+}
+
+} // namespace ideawalker::application::scientific
@@ -0,0 +1,120 @@
+/**
+ * @file IngestionCheckpoints.hpp
+ * @brief Stage checkpoints that let scientific ingestion resume after a crash.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include <nlohmann/json.hpp>
+
+namespace ideawalker::application::scientific {
+
+/**
+ * @enum IngestionStage
+ * @brief Stages an article goes through during scientific ingestion.
+ */
+enum class IngestionStage : std::uint8_t {
+    Extracted,
+    Narrative,
+    Discursive,
+    Validated,
+    Exported
+};
+
+/**
+ * @struct IngestionCheckpoint
+ * @brief Progress recorded for one source file under one pipeline version.
+ */
+struct IngestionCheckpoint {
+    std::string sourceSha256;
+    std::string filename;
+    std::string pipelineVersion;  ///< Schema version + hash of the prompts and model.
+    std::string artifactId;       ///< Reused on resume so outputs keep the same id.
+    std::uint32_t stages = 0;     ///< Bit per IngestionStage.
+    bool exportBlocked = false;   ///< Validated, but the epistemic validator blocked the export.
+    std::string updatedAt;
+
+    bool has(IngestionStage stage) const { return (stages & (1u << static_cast<unsigned>(stage))) != 0; }
+    /**
+     * @brief Nothing left to do: both LLM phases done and the bundle exported (or validated
+     *        with the export blocked). A partial bundle from a failed discursive call is not finished.
+     */
+    bool finished() const {
+        return has(IngestionStage::Narrative) && has(IngestionStage::Discursive) &&
+               (has(IngestionStage::Exported) || (has(IngestionStage::Validated) && exportBlocked));
+    }
+};
+
+/**
+ * @class IngestionCheckpoints
+ * @brief Manifest of per-article stages plus the LLM stage outputs, under one directory.
+ *
+ * Entries are keyed by the source SHA-256 and file name; an entry recorded under another
+ * pipeline version is stale and restarts from scratch. Every change appends the entry's
+ * new state to `checkpoints.ndjson` (one JSON record per line), so a stage costs one
+ * line whatever the size of the manifest; the log is replayed and, once it holds mostly
+ * superseded records, compacted when the directory is opened. A torn last line after a
+ * crash loses at most the stage in progress. Narrative and discursive results are stored
+ * next to it, so a resumed run does not call the LLM again for them. Thread-safe.
+ */
+class IngestionCheckpoints {
+public:
+    /** @param directory Checkpoint directory (created on first write). */
+    explicit IngestionCheckpoints(std::string directory);
+
+    /** @brief Checkpoint for this source under this version, if any. */
+    std::optional<IngestionCheckpoint> find(const std::string& sourceSha256,
+                                            const std::string& filename,
+                                            const std::string& pipelineVersion) const;
+
+    /**
+     * @brief Starts or resumes the entry; a stale or missing entry is reset (payloads dropped).
+     * @return The entry as it stands after the call.
+     */
+    IngestionCheckpoint begin(const std::string& sourceSha256,
+                              const std::string& filename,
+                              const std::string& pipelineVersion,
+                              const std::string& artifactId);
+
+    /** @brief Records a finished stage (and whether validation blocked the export). */
+    void mark(const std::string& sourceSha256, const std::string& filename,
+              IngestionStage stage, bool exportBlocked = false);
+
+    /** @brief Un-marks a stage and deletes its stored payload (the next run redoes it). */
+    void discard(const std::string& sourceSha256, const std::string& filename, IngestionStage stage);
+
+    /** @brief Forgets the entry and its payloads (forced re-ingestion). */
+    void remove(const std::string& sourceSha256, const std::string& filename);
+
+    /** @brief Stores the output of an LLM stage for later resumes. */
+    bool savePayload(const std::string& sourceSha256, const std::string& filename,
+                     IngestionStage stage, const nlohmann::json& payload) const;
+
+    /** @brief Output stored by savePayload, if present and readable. */
+    std::optional<nlohmann::json> loadPayload(const std::string& sourceSha256, const std::string& filename,
+                                              IngestionStage stage) const;
+
+    static const char* StageName(IngestionStage stage);
+
+private:
+    std::string payloadDir(const std::string& key) const;
+    std::string logPath() const;
+    bool load();
+    bool loadLegacyManifest();
+    static nlohmann::json FormatEntry(const IngestionCheckpoint& entry);
+    void appendLocked(const nlohmann::json& record);
+    void compactLocked();
+
+    std::string m_directory;
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, IngestionCheckpoint> m_entries; // "<sha256>_<filename>" -> entry
+    size_t m_logRecords = 0; ///< Lines in the log, to decide when to compact.
+};
+
+} // namespace ideawalker::application::scientific
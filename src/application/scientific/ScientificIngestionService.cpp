@@ -5,20 +5,27 @@
 
 #include "application/scientific/ScientificIngestionService.hpp"
 #include "application/scientific/EpistemicValidator.hpp"
+#include "application/scientific/SnippetAnchorIndex.hpp"
+#include "application/AsyncTaskManager.hpp"
 
 #include <chrono>
 #include <algorithm>
+#include <condition_variable>
 #include <filesystem>
 #include <fstream>
+#include <future>
 #include <iomanip>
+#include <mutex>
+#include <set>
 #include <sstream>
 #include <cctype>
-#include <numeric>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include "infrastructure/ContentExtractor.hpp"
+#include "infrastructure/JsonScanner.hpp"
+#include "infrastructure/PersistenceService.hpp"
 
 namespace fs = std::filesystem;
 
@@ -57,6 +64,14 @@ bool WriteJsonFile(const fs::path& path, const nlohmann::json& payload, std::str
     return true;
 }
 
+// Consumables only written when the bundle carries them; a re-export drops stale copies.
+constexpr const char* kOptionalConsumables[] = {
+    "NarrativeObservation.json", "DiscursiveContext.json", "DiscursiveSystem.json"
+};
+
+// Export writes wait on fsync, not on the CPU, so a few writers pay off even on one core.
+constexpr size_t kExportWriters = 4;
+
 const char* SourceTypeToString(domain::SourceType type) {
     switch (type) {
         case domain::SourceType::PlainText: return "text";
@@ -72,29 +87,20 @@ bool EndsWith(const std::string& value, const std::string& suffix) {
     return std::equal(suffix.rbegin(), suffix.rend(), value.rbegin());
 }
 
-std::string StripErrorSuffix(const std::string& artifactId) {
-    if (EndsWith(artifactId, "_narrative_err")) {
-        return artifactId.substr(0, artifactId.size() - std::string("_narrative_err").size());
-    }
-    if (EndsWith(artifactId, "_discursive_err")) {
-        return artifactId.substr(0, artifactId.size() - std::string("_discursive_err").size());
-    }
-    return artifactId;
-}
-
-std::string InferErrorStage(const std::string& artifactId) {
-    if (EndsWith(artifactId, "_narrative_err")) return "narrative_json_invalid";
-    if (EndsWith(artifactId, "_discursive_err")) return "discursive_json_invalid";
-    return "unknown";
+const std::string* StringField(const nlohmann::json& obj, const char* key) {
+    auto it = obj.find(key);
+    return it != obj.end() && it->is_string() ? it->get_ptr<const std::string*>() : nullptr;
 }
 
 bool HasAnchoredField(const nlohmann::json& obj, const char* key) {
-    if (!obj.contains(key) || !obj[key].is_string()) return false;
-    std::string value = obj[key].get<std::string>();
-    if (value.empty()) return false;
-    std::string lowered = value;
-    std::transform(lowered.begin(), lowered.end(), lowered.begin(), [](unsigned char c){ return std::tolower(c); });
-    return lowered != "unknown";
+    const std::string* value = StringField(obj, key);
+    if (!value || value->empty()) return false;
+    static constexpr std::string_view kUnknown = "unknown";
+    if (value->size() != kUnknown.size()) return true;
+    for (size_t i = 0; i < kUnknown.size(); ++i) {
+        if (std::tolower(static_cast<unsigned char>((*value)[i])) != kUnknown[i]) return true;
+    }
+    return false;
 }
 
 std::string NormalizeForSearch(const std::string& input) {
@@ -251,8 +257,11 @@ std::string ExtractFocusedNarrativeText(const std::string& content) {
 
 void NormalizeBundleEnums(nlohmann::json& bundle) {
     auto sanitizeEnum = [](nlohmann::json& obj, const char* key, const auto& allowed) {
-        if (!obj.contains(key) || !obj[key].is_string()) return;
-        const std::string raw = obj[key].get<std::string>();
+        const std::string* value = StringField(obj, key);
+        if (!value) return;
+        // Common case: the model already answered with a canonical value.
+        if (IsAllowedValue(*value, allowed)) return;
+        const std::string raw = *value;
         const bool hasPipe = raw.find('|') != std::string::npos;
         const std::string normalized = NormalizeEnumToken(raw);
         const std::string candidatesKey = std::string(key) + "Candidates";
@@ -298,138 +307,74 @@ void NormalizeBundleEnums(nlohmann::json& bundle) {
     }
 }
 
-// Tokenizer helper
-std::vector<std::string> Tokenize(const std::string& input) {
-    std::vector<std::string> tokens;
-    std::string current;
-    for (char c : input) {
-        if (std::isspace(static_cast<unsigned char>(c))) {
-            if (!current.empty()) {
-                tokens.push_back(current);
-                current.clear();
-            }
-        } else {
-            current.push_back(std::tolower(static_cast<unsigned char>(c)));
-        }
+bool IsAnchoredItem(const nlohmann::json& item,
+                    const std::vector<const char*>& requiredKeys,
+                    SnippetAnchorIndex& anchors) {
+    if (!item.is_object()) return false;
+    for (const auto& key : requiredKeys) {
+        if (!HasAnchoredField(item, key)) return false;
     }
-    if (!current.empty()) tokens.push_back(current);
-    return tokens;
-}
-
-// Levenshtein distance for tokens
-size_t LevenshteinDistance(const std::string& s1, const std::string& s2) {
-    const size_t m = s1.size();
-    const size_t n = s2.size();
-    if (m == 0) return n;
-    if (n == 0) return m;
-    std::vector<size_t> row(n + 1);
-    std::iota(row.begin(), row.end(), 0);
-    for (size_t i = 1; i <= m; ++i) {
-        row[0] = i;
-        size_t previous = i - 1;
-        for (size_t j = 1; j <= n; ++j) {
-            size_t old_row = row[j];
-            row[j] = std::min({old_row + 1, row[j - 1] + 1, previous + (s1[i - 1] == s2[j - 1] ? 0 : 1)});
-            previous = old_row;
-        }
-    }
-    return row[n];
+    const std::string* snippet = StringField(item, "evidenceSnippet");
+    return !snippet || anchors.contains(*snippet);
 }
 
-bool IsTokenMatch(const std::string& t1, const std::string& t2) {
-    if (t1 == t2) return true;
-    if (t1.size() < 4 || t2.size() < 4) return false; // Strict for short words
-    size_t dist = LevenshteinDistance(t1, t2);
-    // Allow 1 edit for medium words, 2 for long
-    size_t threshold = (t1.size() > 6) ? 2 : 1;
-    return dist <= threshold;
+void FilterByAnchoring(nlohmann::json& array,
+                       const std::vector<const char*>& requiredKeys,
+                       SnippetAnchorIndex& anchors) {
+    if (!array.is_array()) return;
+    // In place: kept items are moved, not copied into a new array.
+    auto& items = array.get_ref<nlohmann::json::array_t&>();
+    items.erase(std::remove_if(items.begin(), items.end(), [&](const nlohmann::json& item) {
+        return !IsAnchoredItem(item, requiredKeys, anchors);
+    }), items.end());
 }
 
-bool SnippetAppearsInContent(const std::string& snippet, const std::string& content) {
-    if (snippet.empty()) return false;
-    
-    // 1. Fast Path: Exact Substring Search (Normalized)
-    const std::string normSnippet = NormalizeForSearch(snippet);
-    const std::string normContent = NormalizeForSearch(content);
-    if (normContent.find(normSnippet) != std::string::npos) return true;
-
-    // 2. Robust Path: Token-Based Sliding Window
-    auto sTokens = Tokenize(normSnippet);
-    if (sTokens.empty()) return false;
-    auto cTokens = Tokenize(normContent);
-    if (cTokens.size() < sTokens.size()) return false;
-
-    // Sliding window
-    size_t windowSize = sTokens.size();
-    size_t maxErrors = std::max((size_t)1, windowSize / 4); // Allow 25% token mismatch
-    
-    for (size_t i = 0; i <= cTokens.size() - windowSize; ++i) {
-        size_t errors = 0;
-        for (size_t j = 0; j < windowSize; ++j) {
-            if (!IsTokenMatch(sTokens[j], cTokens[i + j])) {
-                errors++;
-                if (errors > maxErrors) break;
-            }
-        }
-        if (errors <= maxErrors) return true;
-    }
-
-    return false;
+/** Items of obj[key] that would survive FilterByAnchoring, without copying or changing the bundle. */
+size_t CountAnchored(const nlohmann::json& obj, const char* key, SnippetAnchorIndex& anchors) {
+    if (!obj.is_object()) return 0;
+    auto it = obj.find(key);
+    if (it == obj.end() || !it->is_array()) return 0;
+    return static_cast<size_t>(std::count_if(it->begin(), it->end(), [&](const nlohmann::json& item) {
+        return IsAnchoredItem(item, {"evidenceSnippet"}, anchors);
+    }));
 }
 
-void FilterByAnchoring(nlohmann::json& array,
-                       const std::vector<const char*>& requiredKeys,
-                       const std::string& content) {
-    if (!array.is_array()) return;
-    nlohmann::json filtered = nlohmann::json::array();
-    for (const auto& item : array) {
-        if (!item.is_object()) continue;
-        bool ok = true;
-        for (const auto& key : requiredKeys) {
-            if (!HasAnchoredField(item, key)) {
-                ok = false;
-                break;
-            }
-        }
-        if (ok && item.contains("evidenceSnippet") && item["evidenceSnippet"].is_string()) {
-            if (!SnippetAppearsInContent(item["evidenceSnippet"].get<std::string>(), content)) {
-                ok = false;
-            }
-        }
-        if (ok) filtered.push_back(item);
-    }
-    array = std::move(filtered);
+/** Same as CountAnchored, one level down (e.g. discursiveSystem.declaredProblems). */
+size_t CountAnchored(const nlohmann::json& obj, const char* parent, const char* key, SnippetAnchorIndex& anchors) {
+    if (!obj.is_object()) return 0;
+    auto it = obj.find(parent);
+    return it == obj.end() ? 0 : CountAnchored(*it, key, anchors);
 }
 
-void SanitizeBundleAnchoring(nlohmann::json& bundle, const std::string& content) {
+void SanitizeBundleAnchoring(nlohmann::json& bundle, SnippetAnchorIndex& anchors) {
     // Narrative Anchoring
     if (bundle.contains("narrativeObservations")) {
-        FilterByAnchoring(bundle["narrativeObservations"], {"evidenceSnippet"}, content);
+        FilterByAnchoring(bundle["narrativeObservations"], {"evidenceSnippet"}, anchors);
     }
     if (bundle.contains("allegedMechanisms")) {
-        FilterByAnchoring(bundle["allegedMechanisms"], {"evidenceSnippet"}, content);
+        FilterByAnchoring(bundle["allegedMechanisms"], {"evidenceSnippet"}, anchors);
     }
     if (bundle.contains("temporalWindowReferences")) {
-        FilterByAnchoring(bundle["temporalWindowReferences"], {"evidenceSnippet"}, content);
+        FilterByAnchoring(bundle["temporalWindowReferences"], {"evidenceSnippet"}, anchors);
     }
 
     // Discursive Anchoring (Hallucination Mitigation)
     if (bundle.contains("discursiveContext") && bundle["discursiveContext"].is_object()) {
         auto& dc = bundle["discursiveContext"];
         if (dc.contains("frames")) {
-            FilterByAnchoring(dc["frames"], {"evidenceSnippet"}, content);
+            FilterByAnchoring(dc["frames"], {"evidenceSnippet"}, anchors);
         }
     }
     if (bundle.contains("discursiveSystem") && bundle["discursiveSystem"].is_object()) {
         auto& ds = bundle["discursiveSystem"];
         if (ds.contains("declaredProblems")) {
-            FilterByAnchoring(ds["declaredProblems"], {"evidenceSnippet"}, content);
+            FilterByAnchoring(ds["declaredProblems"], {"evidenceSnippet"}, anchors);
         }
         if (ds.contains("declaredActions")) {
-            FilterByAnchoring(ds["declaredActions"], {"evidenceSnippet"}, content);
+            FilterByAnchoring(ds["declaredActions"], {"evidenceSnippet"}, anchors);
         }
         if (ds.contains("expectedEffects")) {
-             FilterByAnchoring(ds["expectedEffects"], {"evidenceSnippet"}, content);
+             FilterByAnchoring(ds["expectedEffects"], {"evidenceSnippet"}, anchors);
         }
     }
 }
@@ -537,6 +482,48 @@ bool ValidateStrataDiscursiveEnvelope(const nlohmann::json& envelope, std::strin
 
 constexpr bool kEnableBifasicFallback = false;
 
+/**
+ * @brief Counting semaphore bounding the generateJson calls in flight across a batch.
+ */
+class ConcurrencyGate {
+public:
+    explicit ConcurrencyGate(size_t limit) : m_available(std::max<size_t>(1, limit)) {}
+
+    void acquire() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [this] { return m_available > 0; });
+        --m_available;
+    }
+
+    void release() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_available;
+        }
+        m_cv.notify_one();
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    size_t m_available;
+};
+
+std::optional<std::string> GenerateJsonLimited(domain::AIService& ai,
+                                               ConcurrencyGate& gate,
+                                               const std::string& systemPrompt,
+                                               const std::string& userPrompt) {
+    gate.acquire();
+    try {
+        auto response = ai.generateJson(systemPrompt, userPrompt);
+        gate.release();
+        return response;
+    } catch (...) {
+        gate.release();
+        throw;
+    }
+}
+
 void EnsureArrayField(nlohmann::json& obj, const char* key) {
     if (!obj.contains(key) || !obj[key].is_array()) {
         obj[key] = nlohmann::json::array();
@@ -591,17 +578,69 @@ void EnsureBundleMinimumStructure(nlohmann::json& bundle,
     }
 }
 
+fs::path ErrorPayloadPath(const std::string& observationsPath, const std::string& artifactId) {
+    fs::path errorDir = fs::path(observationsPath) / "errors";
+    if (!fs::exists(errorDir)) {
+        fs::create_directories(errorDir);
+    }
+    return errorDir / (artifactId + ".json");
+}
+
+nlohmann::json MakeErrorEnvelope(const std::string& artifactId) {
+    nlohmann::json envelope;
+    envelope["schemaVersion"] = domain::scientific::ScientificSchema::SchemaVersion;
+    envelope["artifactId"] = artifactId;
+    envelope["artifactIdBase"] = StrataManifestIndex::ErrorBaseId(artifactId);
+    envelope["stage"] = StrataManifestIndex::ErrorStage(artifactId);
+    envelope["createdAt"] = ToIsoTimestamp(std::chrono::system_clock::now());
+    return envelope;
+}
+
 } // namespace
 
+/**
+ * @brief Per-article state carried through the pipeline stages.
+ *
+ * Narrative and discursive phases run concurrently and write disjoint fields; they
+ * only share the anchoring index, whose memo is guarded by anchorsMutex.
+ */
+struct ScientificIngestionService::ArticleWork {
+    domain::SourceArtifact artifact;
+    std::string sourceSha256;
+    std::string pipelineVersion;      // Taken when the run started
+    IngestionCheckpoint checkpoint;   // Stages finished by earlier runs
+    std::string artifactId;
+    infrastructure::ContentExtractor::ExtractionResult extraction;
+    std::unique_ptr<SnippetAnchorIndex> anchors;
+    std::mutex anchorsMutex;
+    ConcurrencyGate* llmGate = nullptr;
+
+    nlohmann::json narrativeBundle;
+    bool narrativeOk = false;
+    std::vector<std::string> narrativeErrors;
+
+    nlohmann::json discursiveBundle = nlohmann::json::object();
+    bool discursiveFailed = false;
+    std::vector<std::string> discursiveErrors;
+
+    nlohmann::json bundle;
+    std::vector<std::string> errors;
+    bool bundleGenerated = false;
+};
+
 ScientificIngestionService::ScientificIngestionService(
     std::unique_ptr<infrastructure::FileSystemArtifactScanner> scanner,
     std::shared_ptr<domain::AIService> aiService,
     const std::string& observationsPath,
-    const std::string& consumablesPath)
+    const std::string& consumablesPath,
+    std::shared_ptr<AsyncTaskManager> taskManager,
+    IngestionConcurrency concurrency)
     : m_scanner(std::move(scanner)),
       m_aiService(std::move(aiService)),
       m_observationsPath(observationsPath),
-      m_consumablesPath(consumablesPath) {
+      m_consumablesPath(consumablesPath),
+      m_taskManager(std::move(taskManager)),
+      m_concurrency(concurrency) {
     if (!fs::exists(m_observationsPath)) {
         fs::create_directories(m_observationsPath);
     }
@@ -611,6 +650,9 @@ ScientificIngestionService::ScientificIngestionService(
     if (!fs::exists(m_consumablesPath)) {
         fs::create_directories(m_consumablesPath);
     }
+    m_checkpoints = std::make_unique<IngestionCheckpoints>((fs::path(m_observationsPath) / "checkpoints").string());
+    m_manifestIndex = std::make_unique<StrataManifestIndex>(m_consumablesPath, m_observationsPath);
+    m_catalog = std::make_unique<IngestionCatalog>(m_observationsPath, m_consumablesPath);
 }
 
 bool ScientificIngestionService::ingestScientificBundle(const std::string& jsonContent, const std::string& artifactId) {
@@ -647,15 +689,15 @@ bool ScientificIngestionService::ingestScientificBundle(const std::string& jsonC
     fs::path validationDir = fs::path(m_observationsPath) / "validation";
     if (!fs::exists(validationDir)) fs::create_directories(validationDir);
     
-    WriteJsonFile(validationDir / (artifactId + ".json"), validation.report, validationError);
+    const fs::path validationPath = validationDir / (artifactId + ".json");
+    if (WriteJsonFile(validationPath, validation.report, validationError)) {
+        m_catalog->recordValidation(artifactId, validationPath.string(), validation.report);
+    }
 
     if (!validation.exportAllowed) return true; // Successfully processed, even if blocked
 
-    if (!exportConsumables(bundle, artifactId, saveError)) return false;
-
-    fs::path consumableDir = fs::path(m_consumablesPath) / artifactId;
-    WriteJsonFile(consumableDir / "EpistemicValidationReport.json", validation.report, saveError);
-    WriteJsonFile(consumableDir / "ExportSeal.json", validation.seal, saveError);
+    if (!exportConsumables(bundle, artifactId, validation, saveError)) return false;
+    m_catalog->recordSeal(artifactId, validation.exportAllowed);
 
     return true;
 }
@@ -690,291 +732,480 @@ ScientificIngestionService::IngestionResult ScientificIngestionService::processA
     IngestionResult result{0, 0, {}};
     result.artifactsDetected = static_cast<int>(artifacts.size());
 
-    bool purgePerformed = false;
+    // Taken per run: the model may have been switched since the service was built.
+    const std::string pipelineVersion = computePipelineVersion();
+
+    // Articles finished by an earlier run (same bytes, same prompts/schema/model, outputs
+    // still on disk) are skipped. A purge asks for a fresh run: checkpoints are dropped instead.
+    std::vector<domain::SourceArtifact> pending;
+    std::vector<std::string> pendingSha256;
+    for (const auto& artifact : artifacts) {
+        std::string sha256 = infrastructure::ContentExtractor::ComputeFileSha256(artifact.path);
+        if (!sha256.empty() && purgeExisting) {
+            m_checkpoints->remove(sha256, artifact.filename);
+        } else if (!sha256.empty()) {
+            auto checkpoint = m_checkpoints->find(sha256, artifact.filename, pipelineVersion);
+            if (checkpoint && checkpoint->finished() &&
+                fs::exists(fs::path(m_observationsPath) / (checkpoint->artifactId + ".json"))) {
+                if (statusCallback) statusCallback("Inalterado desde a última ingestão, ignorando: " + artifact.filename);
+                result.artifactsSkipped++;
+                continue;
+            }
+        }
+        pending.push_back(artifact);
+        pendingSha256.push_back(std::move(sha256));
+    }
+
+    // Artifacts whose outputs this run wrote or removed: only these are refreshed in the global manifest.
+    std::vector<std::string> touchedArtifactIds;
     if (purgeExisting) {
-        for (const auto& artifact : artifacts) {
+        for (const auto& artifact : pending) {
             std::string purgeError;
-            if (!purgeExistingArtifacts(artifact.filename, purgeError)) {
+            if (!purgeExistingArtifacts(artifact.filename, purgeError, touchedArtifactIds)) {
                 if (!purgeError.empty()) {
                     result.errors.push_back(purgeError);
                 }
-            } else {
-                purgePerformed = true;
             }
         }
     }
 
-    for (const auto& artifact : artifacts) {
-        if (!m_aiService) {
-            result.errors.push_back("Serviço de IA não configurado para ingestão científica.");
-            break;
-        }
-        if (statusCallback) statusCallback("Processando artigo: " + artifact.filename);
-
-        auto resultData = infrastructure::ContentExtractor::Extract(artifact.path, statusCallback);
+    if (!m_aiService) {
+        if (!pending.empty()) result.errors.push_back("Serviço de IA não configurado para ingestão científica.");
+    } else {
+        const bool pipelined = m_taskManager != nullptr;
+        ConcurrencyGate llmGate(pipelined ? m_concurrency.llmCalls : 1);
+
+        // Status lines may now come from several articles at once: serialize them and say which article.
+        auto statusMutex = std::make_shared<std::mutex>();
+        auto statusFor = [&](const domain::SourceArtifact& artifact) -> StatusFn {
+            if (!statusCallback) return nullptr;
+            if (!pipelined) return statusCallback;
+            return [statusCallback, statusMutex, prefix = "[" + artifact.filename + "] "](std::string message) {
+                std::lock_guard<std::mutex> lock(*statusMutex);
+                statusCallback(prefix + message);
+            };
+        };
 
-        if (!resultData.success || resultData.content.empty()) {
-            std::string err = "Falha na extração de texto para " + artifact.filename + ": Conteúdo vazio ou ilegível.";
-            result.errors.push_back(err);
-            std::string saveError;
-            saveErrorPayload(buildArtifactId(artifact), err, saveError);
-            continue;
+        std::vector<std::unique_ptr<ArticleWork>> works;
+        works.reserve(pending.size());
+        for (size_t i = 0; i < pending.size(); ++i) {
+            auto work = std::make_unique<ArticleWork>();
+            work->artifact = pending[i];
+            work->sourceSha256 = pendingSha256[i];
+            work->pipelineVersion = pipelineVersion;
+            work->llmGate = &llmGate;
+            works.push_back(std::move(work));
         }
 
-        if (statusCallback) {
-             std::string msg = "Extraído via " + resultData.method;
-             if (!resultData.warnings.empty()) msg += " (com avisos)";
-             statusCallback(msg);
+        if (!pipelined) {
+            for (auto& work : works) processArticle(*work, statusFor(work->artifact));
+        } else {
+            // Up to articlesInFlight articles move through the stages at once (one extracting while
+            // another waits on the LLM or exports); the LLM gate bounds the calls across all of them.
+            m_taskManager->RunParallel(TaskType::AI_Processing, "Ingestão científica", works.size(),
+                                       std::max<size_t>(1, m_concurrency.articlesInFlight), [&](size_t i) {
+                ArticleWork& article = *works[i];
+                try {
+                    processArticle(article, statusFor(article.artifact));
+                } catch (const std::exception& e) {
+                    article.errors.push_back("Falha inesperada ao processar " + article.artifact.filename + ": " + e.what());
+                }
+            });
         }
 
-        std::string content = resultData.content;
-        const std::string artifactId = buildArtifactId(artifact);
-
-        // --- F1.B2: Logging de Exclusão Estrutural ---
-        if (!resultData.structuralExclusions.empty()) {
-            std::string exclusionError;
-            if (!WriteStructuralExclusionAuditLog(
-                    m_observationsPath,
-                    artifactId,
-                    resultData.structuralExclusions,
-                    &exclusionError)) {
-                result.errors.push_back(exclusionError);
-            }
+        // Errors are reported in input order, whatever order the articles finished in.
+        for (const auto& work : works) {
+            result.errors.insert(result.errors.end(), work->errors.begin(), work->errors.end());
+            if (work->bundleGenerated) result.bundlesGenerated++;
+            if (!work->artifactId.empty()) touchedArtifactIds.push_back(work->artifactId);
         }
+    }
 
-        // --- Phase 1: Narrative Extraction ---
-        if (statusCallback) statusCallback("Extraindo Narrativa (1/2)...");
-        const std::string narrativeSystemPrompt = buildNarrativeSystemPrompt();
-        const std::string narrativeUserPrompt = buildNarrativeUserPrompt(artifact, content);
-        
-        auto narrativeResponse = m_aiService->generateJson(narrativeSystemPrompt, narrativeUserPrompt);
-        if (!narrativeResponse) {
-            result.errors.push_back("Falha na IA (Narrativa) para: " + artifact.filename);
-            continue;
+    if (!touchedArtifactIds.empty()) {
+        m_manifestIndex->update(touchedArtifactIds);
+    }
+
+    return result;
+}
+
+void ScientificIngestionService::processArticle(ArticleWork& work, const StatusFn& status) {
+    if (status) status("Processando artigo: " + work.artifact.filename);
+    if (!work.sourceSha256.empty()) {
+        work.checkpoint = m_checkpoints->begin(work.sourceSha256, work.artifact.filename, work.pipelineVersion,
+                                               buildArtifactId(work.artifact));
+        work.artifactId = work.checkpoint.artifactId;
+        if (status && (work.checkpoint.has(IngestionStage::Narrative) || work.checkpoint.has(IngestionStage::Discursive))) {
+            status("Retomando ingestão interrompida (etapas de IA já concluídas serão reaproveitadas).");
+        }
+    }
+    if (!extractStage(work, status)) return;
+    llmStage(work, status);
+    if (!work.narrativeOk) {
+        // Without the narrative there is no bundle; discursive messages would only be noise.
+        work.errors.insert(work.errors.end(), work.narrativeErrors.begin(), work.narrativeErrors.end());
+        return;
+    }
+    work.errors.insert(work.errors.end(), work.narrativeErrors.begin(), work.narrativeErrors.end());
+    work.errors.insert(work.errors.end(), work.discursiveErrors.begin(), work.discursiveErrors.end());
+    if (!assembleStage(work, status)) {
+        // These LLM outputs make an invalid bundle: a re-run must ask again, not reload them.
+        if (!work.sourceSha256.empty()) {
+            m_checkpoints->discard(work.sourceSha256, work.artifact.filename, IngestionStage::Narrative);
+            m_checkpoints->discard(work.sourceSha256, work.artifact.filename, IngestionStage::Discursive);
         }
+        return;
+    }
+    exportStage(work);
+}
 
-        nlohmann::json narrativeBundle;
-        try {
-            narrativeBundle = nlohmann::json::parse(*narrativeResponse);
-        } catch (...) {
-            std::string saveError;
-            saveErrorPayload(artifactId + "_narrative_err", *narrativeResponse, saveError);
-            result.errors.push_back("JSON inválido (Narrativa) para " + artifact.filename);
-            continue;
+bool ScientificIngestionService::extractStage(ArticleWork& work, const StatusFn& status) const {
+    work.extraction = infrastructure::ContentExtractor::Extract(work.artifact.path, status);
+    if (work.artifactId.empty()) work.artifactId = buildArtifactId(work.artifact);
+
+    if (!work.extraction.success || work.extraction.content.empty()) {
+        std::string err = "Falha na extração de texto para " + work.artifact.filename + ": Conteúdo vazio ou ilegível.";
+        work.errors.push_back(err);
+        std::string saveError;
+        saveErrorPayload(work.artifactId, err, saveError);
+        return false;
+    }
+
+    if (status) {
+        std::string msg = "Extraído via " + work.extraction.method;
+        if (!work.extraction.warnings.empty()) msg += " (com avisos)";
+        status(msg);
+    }
+
+    // Built once: every evidence snippet of both probes and the final bundle is anchored against it.
+    work.anchors = std::make_unique<SnippetAnchorIndex>(work.extraction.content);
+
+    // --- F1.B2: Logging de Exclusão Estrutural ---
+    if (!work.extraction.structuralExclusions.empty()) {
+        std::string exclusionError;
+        if (!WriteStructuralExclusionAuditLog(
+                m_observationsPath,
+                work.artifactId,
+                work.extraction.structuralExclusions,
+                &exclusionError)) {
+            work.errors.push_back(exclusionError);
         }
-        SanitizeSourceProfileKeys(narrativeBundle);
-
-        // Quick anchoring check to decide fallback
-        nlohmann::json narrativeProbe = narrativeBundle;
-        SanitizeBundleAnchoring(narrativeProbe, content);
-        size_t probeObs = CountArraySafe(narrativeProbe, "narrativeObservations");
-        size_t probeMech = CountArraySafe(narrativeProbe, "allegedMechanisms");
-        if (kEnableBifasicFallback && (probeObs == 0 || probeMech == 0)) {
-            if (statusCallback) statusCallback("Narrativa vazia após ancoragem. Tentando fallback (Abstract/Introduction)...");
-            const std::string focusedContent = ExtractFocusedNarrativeText(content);
-            std::string fallbackSystem = buildNarrativeSystemPrompt();
-            fallbackSystem += "FOCO: você está vendo apenas um recorte (Abstract/Introduction). Use apenas trechos literais.\n";
-            const std::string fallbackUser = buildNarrativeUserPrompt(artifact, focusedContent);
-            auto fallbackResponse = m_aiService->generateJson(fallbackSystem, fallbackUser);
-            if (fallbackResponse) {
-                try {
-                    narrativeBundle = nlohmann::json::parse(*fallbackResponse);
-                    SanitizeSourceProfileKeys(narrativeBundle);
-                } catch (...) {
-                    std::string saveError;
-                    saveErrorPayload(artifactId + "_narrative_err", *fallbackResponse, saveError);
-                    result.errors.push_back("JSON inválido (Narrativa Fallback) para " + artifact.filename);
-                }
+    }
+    recordStage(work, IngestionStage::Extracted);
+    return true;
+}
+
+void ScientificIngestionService::llmStage(ArticleWork& work, const StatusFn& status) {
+    if (!m_taskManager) {
+        narrativePhase(work, status);
+        if (work.narrativeOk) discursivePhase(work, status);
+        return;
+    }
+
+    // Both phases read the same extracted text, so the discursive call does not wait for the narrative one.
+    auto done = std::make_shared<std::promise<void>>();
+    std::future<void> discursiveDone = done->get_future();
+    m_taskManager->SubmitTask(TaskType::AI_Processing, "Ingestão científica (discursiva): " + work.artifact.filename,
+        [this, &work, status, done](std::shared_ptr<TaskStatus>) {
+            try {
+                discursivePhase(work, status);
+            } catch (const std::exception& e) {
+                work.discursiveErrors.push_back("Falha na IA (Discursiva) para: " + work.artifact.filename + " (" + e.what() + ")");
+                work.discursiveFailed = true;
             }
-        }
+            done->set_value();
+        });
+    try {
+        narrativePhase(work, status);
+    } catch (...) {
+        discursiveDone.wait();
+        throw;
+    }
+    discursiveDone.wait();
+}
 
-        // --- Phase 2: Discursive Extraction ---
-        if (statusCallback) statusCallback("Extraindo Discursiva (2/2)...");
-        const std::string discursiveSystemPrompt = buildDiscursiveSystemPrompt();
-        const std::string discursiveUserPrompt = buildDiscursiveUserPrompt(artifact, content);
-
-        auto discursiveResponse = m_aiService->generateJson(discursiveSystemPrompt, discursiveUserPrompt);
-        nlohmann::json discursiveBundle = nlohmann::json::object();
-        bool discursiveFailed = false;
-
-        if (discursiveResponse) {
-             try {
-                discursiveBundle = nlohmann::json::parse(*discursiveResponse);
-             } catch (...) {
-                 std::string saveError;
-                 saveErrorPayload(artifactId + "_discursive_err", *discursiveResponse, saveError);
-                 result.errors.push_back("JSON inválido (Discursiva) para " + artifact.filename + " (prosseguindo parcial)");
-                 discursiveFailed = true;
-             }
-        } else {
-             result.errors.push_back("Falha na IA (Discursiva) para: " + artifact.filename + " (prosseguindo parcial)");
-             discursiveFailed = true;
-        }
+void ScientificIngestionService::narrativePhase(ArticleWork& work, const StatusFn& status) {
+    const std::string& content = work.extraction.content;
+    const domain::SourceArtifact& artifact = work.artifact;
 
-        // Discursive fallback when everything is empty after anchoring
-        nlohmann::json discursiveProbe = discursiveBundle;
-        SanitizeBundleAnchoring(discursiveProbe, content);
-        size_t probeFrames = 0, probeProb = 0, probeAct = 0, probeEff = 0;
-        if (discursiveProbe.contains("discursiveContext") && discursiveProbe["discursiveContext"].is_object()) {
-            probeFrames = CountArraySafe(discursiveProbe["discursiveContext"], "frames");
-        }
-        if (discursiveProbe.contains("discursiveSystem") && discursiveProbe["discursiveSystem"].is_object()) {
-            probeProb = CountArraySafe(discursiveProbe["discursiveSystem"], "declaredProblems");
-            probeAct = CountArraySafe(discursiveProbe["discursiveSystem"], "declaredActions");
-            probeEff = CountArraySafe(discursiveProbe["discursiveSystem"], "expectedEffects");
+    if (work.checkpoint.has(IngestionStage::Narrative)) {
+        if (auto saved = m_checkpoints->loadPayload(work.sourceSha256, artifact.filename, IngestionStage::Narrative)) {
+            work.narrativeBundle = std::move(*saved);
+            work.narrativeOk = true;
+            if (status) status("Narrativa (1/2) recuperada do checkpoint.");
+            return;
         }
-        if (kEnableBifasicFallback && (probeFrames + probeProb + probeAct + probeEff == 0)) {
-            if (statusCallback) statusCallback("Discursiva vazia após ancoragem. Tentando fallback (Abstract/Introduction)...");
-            const std::string focusedContent = ExtractFocusedNarrativeText(content);
-            std::string fallbackSystem = buildDiscursiveSystemPrompt();
-            fallbackSystem += "FOCO: você está vendo apenas um recorte (Abstract/Introduction). Use apenas trechos literais.\n";
-            const std::string fallbackUser = buildDiscursiveUserPrompt(artifact, focusedContent);
-            auto fallbackResponse = m_aiService->generateJson(fallbackSystem, fallbackUser);
-            if (fallbackResponse) {
-                try {
-                    discursiveBundle = nlohmann::json::parse(*fallbackResponse);
-                } catch (...) {
-                    std::string saveError;
-                    saveErrorPayload(artifactId + "_discursive_err", *fallbackResponse, saveError);
-                    result.errors.push_back("JSON inválido (Discursiva Fallback) para " + artifact.filename + " (ignorando parcial)");
-                }
+    }
+
+    // --- Phase 1: Narrative Extraction ---
+    if (status) status("Extraindo Narrativa (1/2)...");
+    const std::string narrativeSystemPrompt = buildNarrativeSystemPrompt();
+    const std::string narrativeUserPrompt = buildNarrativeUserPrompt(artifact, content);
+
+    auto narrativeResponse = GenerateJsonLimited(*m_aiService, *work.llmGate, narrativeSystemPrompt, narrativeUserPrompt);
+    if (!narrativeResponse) {
+        work.narrativeErrors.push_back("Falha na IA (Narrativa) para: " + artifact.filename);
+        return;
+    }
+
+    try {
+        work.narrativeBundle = nlohmann::json::parse(*narrativeResponse);
+    } catch (...) {
+        std::string saveError;
+        saveErrorPayload(work.artifactId + "_narrative_err", *narrativeResponse, saveError);
+        work.narrativeErrors.push_back("JSON inválido (Narrativa) para " + artifact.filename);
+        return;
+    }
+    SanitizeSourceProfileKeys(work.narrativeBundle);
+    work.narrativeOk = true;
+
+    // Quick anchoring check to decide fallback (counts only; the bundle is filtered at assembly)
+    size_t probeObs = 0, probeMech = 0;
+    {
+        std::lock_guard<std::mutex> lock(work.anchorsMutex);
+        probeObs = CountAnchored(work.narrativeBundle, "narrativeObservations", *work.anchors);
+        probeMech = CountAnchored(work.narrativeBundle, "allegedMechanisms", *work.anchors);
+    }
+    if (kEnableBifasicFallback && (probeObs == 0 || probeMech == 0)) {
+        if (status) status("Narrativa vazia após ancoragem. Tentando fallback (Abstract/Introduction)...");
+        const std::string focusedContent = ExtractFocusedNarrativeText(content);
+        std::string fallbackSystem = buildNarrativeSystemPrompt();
+        fallbackSystem += "FOCO: você está vendo apenas um recorte (Abstract/Introduction). Use apenas trechos literais.\n";
+        const std::string fallbackUser = buildNarrativeUserPrompt(artifact, focusedContent);
+        auto fallbackResponse = GenerateJsonLimited(*m_aiService, *work.llmGate, fallbackSystem, fallbackUser);
+        if (fallbackResponse) {
+            try {
+                work.narrativeBundle = nlohmann::json::parse(*fallbackResponse);
+                SanitizeSourceProfileKeys(work.narrativeBundle);
+            } catch (...) {
+                std::string saveError;
+                saveErrorPayload(work.artifactId + "_narrative_err", *fallbackResponse, saveError);
+                work.narrativeErrors.push_back("JSON inválido (Narrativa Fallback) para " + artifact.filename);
             }
         }
+    }
 
-        // --- Merge Bundles ---
-        nlohmann::json bundle = narrativeBundle;
-        std::string extractionStatus = discursiveFailed ? "partial-narrative" : "complete";
-        bool isPartial = discursiveFailed;
-        
-        // Merge Discursive Context
-        if (discursiveBundle.contains("discursiveContext")) {
-            bundle["discursiveContext"] = discursiveBundle["discursiveContext"];
-        }
-        // Merge Discursive System
-        if (discursiveBundle.contains("discursiveSystem")) {
-            bundle["discursiveSystem"] = discursiveBundle["discursiveSystem"];
-        }
-        // Merge Interpretation Layers (combine if both exist, prefer discursive for author interpretations)
-        if (discursiveBundle.contains("interpretationLayers")) {
-             if (!bundle.contains("interpretationLayers")) {
-                 bundle["interpretationLayers"] = discursiveBundle["interpretationLayers"];
-             } else {
-                 auto& target = bundle["interpretationLayers"];
-                 const auto& source = discursiveBundle["interpretationLayers"];
-                 if (source.contains("authorInterpretations")) target["authorInterpretations"] = source["authorInterpretations"];
-                 if (source.contains("possibleReadings")) target["possibleReadings"] = source["possibleReadings"];
-             }
-        }
+    if (!work.sourceSha256.empty() &&
+        m_checkpoints->savePayload(work.sourceSha256, artifact.filename, IngestionStage::Narrative, work.narrativeBundle)) {
+        recordStage(work, IngestionStage::Narrative);
+    }
+}
 
-        NormalizeBundleEnums(bundle);
-        SanitizeSourceProfileKeys(bundle);
-        EnsureBundleMinimumStructure(
-            bundle,
-            artifactId,
-            m_aiService ? m_aiService->getCurrentModel() : std::string("unknown"));
-
-        size_t preNarr = CountArraySafe(bundle, "narrativeObservations");
-        size_t preMech = CountArraySafe(bundle, "allegedMechanisms");
-        size_t preTemp = CountArraySafe(bundle, "temporalWindowReferences");
-        size_t preFrames = 0, preProb = 0, preAct = 0, preEff = 0;
-        if (bundle.contains("discursiveContext") && bundle["discursiveContext"].is_object()) {
-            preFrames = CountArraySafe(bundle["discursiveContext"], "frames");
-        }
-        if (bundle.contains("discursiveSystem") && bundle["discursiveSystem"].is_object()) {
-            preProb = CountArraySafe(bundle["discursiveSystem"], "declaredProblems");
-            preAct = CountArraySafe(bundle["discursiveSystem"], "declaredActions");
-            preEff = CountArraySafe(bundle["discursiveSystem"], "expectedEffects");
+void ScientificIngestionService::discursivePhase(ArticleWork& work, const StatusFn& status) {
+    const std::string& content = work.extraction.content;
+    const domain::SourceArtifact& artifact = work.artifact;
+
+    if (work.checkpoint.has(IngestionStage::Discursive)) {
+        if (auto saved = m_checkpoints->loadPayload(work.sourceSha256, artifact.filename, IngestionStage::Discursive)) {
+            work.discursiveBundle = std::move(*saved);
+            if (status) status("Discursiva (2/2) recuperada do checkpoint.");
+            return;
         }
+    }
 
-        SanitizeBundleAnchoring(bundle, content);
+    // --- Phase 2: Discursive Extraction ---
+    if (status) status("Extraindo Discursiva (2/2)...");
+    const std::string discursiveSystemPrompt = buildDiscursiveSystemPrompt();
+    const std::string discursiveUserPrompt = buildDiscursiveUserPrompt(artifact, content);
 
-        size_t postNarr = CountArraySafe(bundle, "narrativeObservations");
-        size_t postMech = CountArraySafe(bundle, "allegedMechanisms");
-        size_t postTemp = CountArraySafe(bundle, "temporalWindowReferences");
-        size_t postFrames = 0, postProb = 0, postAct = 0, postEff = 0;
-        if (bundle.contains("discursiveContext") && bundle["discursiveContext"].is_object()) {
-            postFrames = CountArraySafe(bundle["discursiveContext"], "frames");
-        }
-        if (bundle.contains("discursiveSystem") && bundle["discursiveSystem"].is_object()) {
-            postProb = CountArraySafe(bundle["discursiveSystem"], "declaredProblems");
-            postAct = CountArraySafe(bundle["discursiveSystem"], "declaredActions");
-            postEff = CountArraySafe(bundle["discursiveSystem"], "expectedEffects");
-        }
-        if (statusCallback) {
-            std::ostringstream oss;
-            oss << "Anchoring: narr " << preNarr << "->" << postNarr
-                << " | mech " << preMech << "->" << postMech
-                << " | temp " << preTemp << "->" << postTemp
-                << " | frames " << preFrames << "->" << postFrames
-                << " | problems " << preProb << "->" << postProb
-                << " | actions " << preAct << "->" << postAct
-                << " | effects " << preEff << "->" << postEff;
-            statusCallback(oss.str());
-        }
+    auto discursiveResponse = GenerateJsonLimited(*m_aiService, *work.llmGate, discursiveSystemPrompt, discursiveUserPrompt);
+    work.discursiveBundle = nlohmann::json::object();
 
-        std::vector<std::string> validationErrors;
-        if (!validateBundleJson(bundle, validationErrors)) {
-            std::ostringstream oss;
-            oss << "Falha de validação para " << artifact.filename << ": ";
-            for (size_t i = 0; i < validationErrors.size(); ++i) {
-                if (i > 0) oss << "; ";
-                oss << validationErrors[i];
+    if (discursiveResponse) {
+         try {
+            work.discursiveBundle = nlohmann::json::parse(*discursiveResponse);
+         } catch (...) {
+             std::string saveError;
+             saveErrorPayload(work.artifactId + "_discursive_err", *discursiveResponse, saveError);
+             work.discursiveErrors.push_back("JSON inválido (Discursiva) para " + artifact.filename + " (prosseguindo parcial)");
+             work.discursiveFailed = true;
+         }
+    } else {
+         work.discursiveErrors.push_back("Falha na IA (Discursiva) para: " + artifact.filename + " (prosseguindo parcial)");
+         work.discursiveFailed = true;
+    }
+
+    // Discursive fallback when everything is empty after anchoring
+    size_t probeFrames = 0, probeProb = 0, probeAct = 0, probeEff = 0;
+    {
+        const nlohmann::json& probe = work.discursiveBundle;
+        std::lock_guard<std::mutex> lock(work.anchorsMutex);
+        probeFrames = CountAnchored(probe, "discursiveContext", "frames", *work.anchors);
+        probeProb = CountAnchored(probe, "discursiveSystem", "declaredProblems", *work.anchors);
+        probeAct = CountAnchored(probe, "discursiveSystem", "declaredActions", *work.anchors);
+        probeEff = CountAnchored(probe, "discursiveSystem", "expectedEffects", *work.anchors);
+    }
+    if (kEnableBifasicFallback && (probeFrames + probeProb + probeAct + probeEff == 0)) {
+        if (status) status("Discursiva vazia após ancoragem. Tentando fallback (Abstract/Introduction)...");
+        const std::string focusedContent = ExtractFocusedNarrativeText(content);
+        std::string fallbackSystem = buildDiscursiveSystemPrompt();
+        fallbackSystem += "FOCO: você está vendo apenas um recorte (Abstract/Introduction). Use apenas trechos literais.\n";
+        const std::string fallbackUser = buildDiscursiveUserPrompt(artifact, focusedContent);
+        auto fallbackResponse = GenerateJsonLimited(*m_aiService, *work.llmGate, fallbackSystem, fallbackUser);
+        if (fallbackResponse) {
+            try {
+                work.discursiveBundle = nlohmann::json::parse(*fallbackResponse);
+            } catch (...) {
+                std::string saveError;
+                saveErrorPayload(work.artifactId + "_discursive_err", *fallbackResponse, saveError);
+                work.discursiveErrors.push_back("JSON inválido (Discursiva Fallback) para " + artifact.filename + " (ignorando parcial)");
             }
-            result.errors.push_back(oss.str());
-            std::string saveError;
-            saveErrorPayload(artifactId, bundle.dump(2), saveError);
-            continue;
         }
+    }
 
-        attachSourceMetadata(bundle, artifact, artifactId, resultData.method, resultData.sourceSha256, extractionStatus, isPartial);
+    // A failed discursive phase is not checkpointed: the next run tries it again.
+    if (!work.discursiveFailed && !work.sourceSha256.empty() &&
+        m_checkpoints->savePayload(work.sourceSha256, artifact.filename, IngestionStage::Discursive, work.discursiveBundle)) {
+        recordStage(work, IngestionStage::Discursive);
+    }
+}
 
-        std::string saveError;
-        if (!saveRawBundle(bundle, artifactId, saveError)) {
-            result.errors.push_back(saveError);
-            continue;
-        }
-        result.bundlesGenerated++;
-
-        EpistemicValidator validator;
-        auto validation = validator.Validate(bundle);
-        std::string validationError;
-        fs::path validationDir = fs::path(m_observationsPath) / "validation";
-        if (!fs::exists(validationDir)) {
-            fs::create_directories(validationDir);
-        }
-        WriteJsonFile(validationDir / (artifactId + ".json"), validation.report, validationError);
+bool ScientificIngestionService::assembleStage(ArticleWork& work, const StatusFn& status) const {
+    const domain::SourceArtifact& artifact = work.artifact;
+    const std::string& artifactId = work.artifactId;
+    const nlohmann::json& discursiveBundle = work.discursiveBundle;
 
-        if (!validation.exportAllowed) {
-            result.errors.push_back("Exportação bloqueada pelo Validador Epistemológico: " + artifact.filename);
-            continue;
-        }
+    // --- Merge Bundles ---
+    nlohmann::json& bundle = work.bundle;
+    bundle = std::move(work.narrativeBundle);
 
-        if (!exportConsumables(bundle, artifactId, saveError)) {
-            result.errors.push_back(saveError);
-            continue;
+    // Merge Discursive Context
+    if (discursiveBundle.contains("discursiveContext")) {
+        bundle["discursiveContext"] = discursiveBundle["discursiveContext"];
+    }
+    // Merge Discursive System
+    if (discursiveBundle.contains("discursiveSystem")) {
+        bundle["discursiveSystem"] = discursiveBundle["discursiveSystem"];
+    }
+    // Merge Interpretation Layers (combine if both exist, prefer discursive for author interpretations)
+    if (discursiveBundle.contains("interpretationLayers")) {
+         if (!bundle.contains("interpretationLayers")) {
+             bundle["interpretationLayers"] = discursiveBundle["interpretationLayers"];
+         } else {
+             auto& target = bundle["interpretationLayers"];
+             const auto& source = discursiveBundle["interpretationLayers"];
+             if (source.contains("authorInterpretations")) target["authorInterpretations"] = source["authorInterpretations"];
+             if (source.contains("possibleReadings")) target["possibleReadings"] = source["possibleReadings"];
+         }
+    }
+
+    NormalizeBundleEnums(bundle);
+    SanitizeSourceProfileKeys(bundle);
+    EnsureBundleMinimumStructure(
+        bundle,
+        artifactId,
+        m_aiService ? m_aiService->getCurrentModel() : std::string("unknown"));
+
+    size_t preNarr = CountArraySafe(bundle, "narrativeObservations");
+    size_t preMech = CountArraySafe(bundle, "allegedMechanisms");
+    size_t preTemp = CountArraySafe(bundle, "temporalWindowReferences");
+    size_t preFrames = 0, preProb = 0, preAct = 0, preEff = 0;
+    if (bundle.contains("discursiveContext") && bundle["discursiveContext"].is_object()) {
+        preFrames = CountArraySafe(bundle["discursiveContext"], "frames");
+    }
+    if (bundle.contains("discursiveSystem") && bundle["discursiveSystem"].is_object()) {
+        preProb = CountArraySafe(bundle["discursiveSystem"], "declaredProblems");
+        preAct = CountArraySafe(bundle["discursiveSystem"], "declaredActions");
+        preEff = CountArraySafe(bundle["discursiveSystem"], "expectedEffects");
+    }
+
+    SanitizeBundleAnchoring(bundle, *work.anchors);
+
+    size_t postNarr = CountArraySafe(bundle, "narrativeObservations");
+    size_t postMech = CountArraySafe(bundle, "allegedMechanisms");
+    size_t postTemp = CountArraySafe(bundle, "temporalWindowReferences");
+    size_t postFrames = 0, postProb = 0, postAct = 0, postEff = 0;
+    if (bundle.contains("discursiveContext") && bundle["discursiveContext"].is_object()) {
+        postFrames = CountArraySafe(bundle["discursiveContext"], "frames");
+    }
+    if (bundle.contains("discursiveSystem") && bundle["discursiveSystem"].is_object()) {
+        postProb = CountArraySafe(bundle["discursiveSystem"], "declaredProblems");
+        postAct = CountArraySafe(bundle["discursiveSystem"], "declaredActions");
+        postEff = CountArraySafe(bundle["discursiveSystem"], "expectedEffects");
+    }
+    if (status) {
+        std::ostringstream oss;
+        oss << "Anchoring: narr " << preNarr << "->" << postNarr
+            << " | mech " << preMech << "->" << postMech
+            << " | temp " << preTemp << "->" << postTemp
+            << " | frames " << preFrames << "->" << postFrames
+            << " | problems " << preProb << "->" << postProb
+            << " | actions " << preAct << "->" << postAct
+            << " | effects " << preEff << "->" << postEff;
+        status(oss.str());
+    }
+
+    std::vector<std::string> validationErrors;
+    if (!validateBundleJson(bundle, validationErrors)) {
+        std::ostringstream oss;
+        oss << "Falha de validação para " << artifact.filename << ": ";
+        for (size_t i = 0; i < validationErrors.size(); ++i) {
+            if (i > 0) oss << "; ";
+            oss << validationErrors[i];
         }
+        work.errors.push_back(oss.str());
+        std::string saveError;
+        saveErrorPayload(artifactId, bundle, saveError);
+        return false;
+    }
+
+    const std::string extractionStatus = work.discursiveFailed ? "partial-narrative" : "complete";
+    attachSourceMetadata(bundle, artifact, artifactId, work.extraction.method, work.extraction.sourceSha256,
+                         extractionStatus, work.discursiveFailed);
+    return true;
+}
+
+void ScientificIngestionService::exportStage(ArticleWork& work) const {
+    const nlohmann::json& bundle = work.bundle;
+    const std::string& artifactId = work.artifactId;
+
+    std::string saveError;
+    if (!saveRawBundle(bundle, artifactId, saveError)) {
+        work.errors.push_back(saveError);
+        return;
+    }
+    work.bundleGenerated = true;
 
-        fs::path consumableDir = fs::path(m_consumablesPath) / artifactId;
-        WriteJsonFile(consumableDir / "EpistemicValidationReport.json", validation.report, saveError);
-        WriteJsonFile(consumableDir / "ExportSeal.json", validation.seal, saveError);
+    EpistemicValidator validator;
+    auto validation = validator.Validate(bundle);
+    std::string validationError;
+    fs::path validationDir = fs::path(m_observationsPath) / "validation";
+    if (!fs::exists(validationDir)) {
+        fs::create_directories(validationDir);
+    }
+    const fs::path validationPath = validationDir / (artifactId + ".json");
+    if (WriteJsonFile(validationPath, validation.report, validationError)) {
+        m_catalog->recordValidation(artifactId, validationPath.string(), validation.report);
+    }
+    recordStage(work, IngestionStage::Validated, !validation.exportAllowed);
 
+    if (!validation.exportAllowed) {
+        work.errors.push_back("Exportação bloqueada pelo Validador Epistemológico: " + work.artifact.filename);
+        return;
     }
 
-    if (result.bundlesGenerated > 0 || purgePerformed) {
-        generateIngestionReport();
+    if (!exportConsumables(bundle, artifactId, validation, saveError)) {
+        work.errors.push_back(saveError);
+        return;
     }
+    m_catalog->recordSeal(artifactId, validation.exportAllowed);
+    recordStage(work, IngestionStage::Exported);
+}
 
-    return result;
+void ScientificIngestionService::recordStage(const ArticleWork& work, IngestionStage stage, bool exportBlocked) const {
+    if (work.sourceSha256.empty()) return;
+    m_checkpoints->mark(work.sourceSha256, work.artifact.filename, stage, exportBlocked);
 }
 
-bool ScientificIngestionService::purgeExistingArtifacts(const std::string& filename, std::string& error) const {
+bool ScientificIngestionService::purgeExistingArtifacts(const std::string& filename, std::string& error,
+                                                        std::vector<std::string>& removedArtifactIds) const {
     bool removed = false;
+    std::set<std::string> removedIds;
     std::string suffix = "_" + filename;
 
     auto removeFileIfMatch = [&](const fs::path& path) {
         if (!path.has_filename()) return;
         const std::string stem = path.stem().string();
-        const std::string base = StripErrorSuffix(stem);
+        const std::string base = StrataManifestIndex::ErrorBaseId(stem);
         if (EndsWith(base, suffix)) {
             std::error_code ec;
             fs::remove(path, ec);
@@ -983,6 +1214,7 @@ bool ScientificIngestionService::purgeExistingArtifacts(const std::string& filen
                 error += "Falha ao remover " + path.string() + ": " + ec.message();
             } else {
                 removed = true;
+                removedIds.insert(base);
             }
         }
     };
@@ -1025,78 +1257,46 @@ bool ScientificIngestionService::purgeExistingArtifacts(const std::string& filen
                     error += "Falha ao remover " + entry.path().string() + ": " + ec.message();
                 } else {
                     removed = true;
+                    removedIds.insert(dirName);
                 }
             }
         }
     }
 
+    for (const auto& id : removedIds) {
+        m_catalog->recordRemoved(id);
+        removedArtifactIds.push_back(id);
+    }
     return removed;
 }
 
 size_t ScientificIngestionService::getBundlesCount() const {
-    if (!fs::exists(m_observationsPath)) return 0;
-    size_t count = 0;
-    for (const auto& entry : fs::directory_iterator(m_observationsPath)) {
-        if (entry.is_regular_file() && entry.path().extension() == ".json") {
-            ++count;
-        }
-    }
-    return count;
+    return m_catalog->bundleCount();
 }
 
-std::optional<ScientificIngestionService::ValidationSummary> ScientificIngestionService::getLatestValidationSummary() const {
-    fs::path validationDir = fs::path(m_observationsPath) / "validation";
-    if (!fs::exists(validationDir) || !fs::is_directory(validationDir)) {
-        return std::nullopt;
-    }
-
-    fs::path latestFile;
-    std::chrono::system_clock::time_point latestTime;
-    bool hasFile = false;
-
-    for (const auto& entry : fs::directory_iterator(validationDir)) {
-        if (!entry.is_regular_file() || entry.path().extension() != ".json") continue;
-        auto ftime = fs::last_write_time(entry);
-        auto sysTime = std::chrono::time_point_cast<std::chrono::system_clock::duration>(
-            ftime - fs::file_time_type::clock::now() + std::chrono::system_clock::now()
-        );
-        if (!hasFile || sysTime > latestTime) {
-            latestTime = sysTime;
-            latestFile = entry.path();
-            hasFile = true;
-        }
-    }
-
-    if (!hasFile) return std::nullopt;
+size_t ScientificIngestionService::getExportedCount() const {
+    return m_catalog->exportedCount();
+}
 
-    std::ifstream file(latestFile);
-    if (!file.is_open()) return std::nullopt;
+size_t ScientificIngestionService::rebuildGlobalManifest() {
+    return m_manifestIndex->rebuild();
+}
 
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    const std::string reportJson = buffer.str();
+size_t ScientificIngestionService::rebuildIngestionCatalog() {
+    return m_catalog->rebuild();
+}
 
-    nlohmann::json report;
-    try {
-        report = nlohmann::json::parse(reportJson);
-    } catch (...) {
-        return std::nullopt;
-    }
+std::optional<ScientificIngestionService::ValidationSummary> ScientificIngestionService::getLatestValidationSummary() const {
+    auto latest = m_catalog->latestValidation();
+    if (!latest) return std::nullopt;
 
     ValidationSummary summary;
-    summary.path = latestFile.string();
-    summary.reportJson = reportJson;
-    if (report.contains("status") && report["status"].is_string()) {
-        summary.status = report["status"].get<std::string>();
-    }
-    if (report.contains("errors") && report["errors"].is_array()) {
-        summary.errorCount = report["errors"].size();
-    }
-    if (report.contains("warnings") && report["warnings"].is_array()) {
-        summary.warningCount = report["warnings"].size();
-    }
-    summary.exportAllowed = (summary.status != "block");
-
+    summary.path = latest->path;
+    summary.status = latest->status;
+    summary.exportAllowed = latest->exportAllowed;
+    summary.errorCount = latest->errorCount;
+    summary.warningCount = latest->warningCount;
+    summary.reportJson = std::move(latest->reportJson);
     return summary;
 }
 
@@ -1271,11 +1471,36 @@ std::string ScientificIngestionService::buildDiscursiveUserPrompt(
 std::string ScientificIngestionService::buildArtifactId(const domain::SourceArtifact& artifact) const {
     auto now = std::chrono::system_clock::now();
     auto tt = std::chrono::system_clock::to_time_t(now);
+    std::tm tm = {};
+#if defined(_WIN32)
+    localtime_s(&tm, &tt);
+#else
+    localtime_r(&tt, &tm); // Articles are processed concurrently: no shared std::localtime buffer
+#endif
     std::stringstream idss;
-    idss << std::put_time(std::localtime(&tt), "%Y%m%d_%H%M%S") << "_" << artifact.filename;
+    idss << std::put_time(&tm, "%Y%m%d_%H%M%S") << "_" << artifact.filename;
     return idss.str();
 }
 
+std::string ScientificIngestionService::computePipelineVersion() const {
+    // Any change to the prompts, the schema or the model invalidates checkpoints from earlier runs.
+    domain::SourceArtifact probe;
+    probe.filename = "{filename}";
+    const std::string model = m_aiService ? m_aiService->getCurrentModel() : std::string("none");
+    const std::string prompts = buildNarrativeSystemPrompt() + buildNarrativeUserPrompt(probe, "") +
+                                buildDiscursiveSystemPrompt() + buildDiscursiveUserPrompt(probe, "") +
+                                '\0' + model;
+    std::uint64_t h = 14695981039346656037ull;
+    for (unsigned char c : prompts) {
+        h ^= c;
+        h *= 1099511628211ull;
+    }
+    std::ostringstream oss;
+    oss << "schema" << domain::scientific::ScientificSchema::SchemaVersion << "-prompts-"
+        << std::hex << std::setw(16) << std::setfill('0') << h;
+    return oss.str();
+}
+
 bool ScientificIngestionService::validateBundleJson(const nlohmann::json& bundle, std::vector<std::string>& errors) const {
     if (!bundle.contains("schemaVersion") || !bundle["schemaVersion"].is_number_integer()) {
         errors.push_back("schemaVersion ausente ou inválido");
@@ -1445,12 +1670,15 @@ bool ScientificIngestionService::saveRawBundle(
     const std::string& artifactId,
     std::string& error) const {
     fs::path outPath = fs::path(m_observationsPath) / (artifactId + ".json");
-    return WriteJsonFile(outPath, bundle, error);
+    if (!WriteJsonFile(outPath, bundle, error)) return false;
+    m_catalog->recordBundle(artifactId);
+    return true;
 }
 
 bool ScientificIngestionService::exportConsumables(
     const nlohmann::json& bundle,
     const std::string& artifactId,
+    const EpistemicValidator::Result& validation,
     std::string& error) const {
     if (!bundle.contains("source") || !bundle["source"].is_object()) {
         error = "Bundle sem metadados de fonte para exportação.";
@@ -1462,6 +1690,15 @@ bool ScientificIngestionService::exportConsumables(
         fs::create_directories(baseDir);
     }
 
+    // Every payload is serialized before anything touches the disk; a validation
+    // failure below leaves the previous export untouched.
+    std::vector<infrastructure::SaveTask> payloads;
+    std::vector<std::string> files;
+    auto addPayload = [&](const std::string& name, const nlohmann::json& payload) {
+        payloads.push_back({(baseDir / name).string(), payload.dump(2)});
+        files.push_back(name);
+    };
+
     nlohmann::json baseEnvelope = {
         {"schemaVersion", domain::scientific::ScientificSchema::SchemaVersion},
         {"source", bundle["source"]}
@@ -1469,28 +1706,28 @@ bool ScientificIngestionService::exportConsumables(
 
     nlohmann::json sourceProfile = baseEnvelope;
     sourceProfile["sourceProfile"] = bundle["sourceProfile"];
-    if (!WriteJsonFile(baseDir / "SourceProfile.json", sourceProfile, error)) return false;
-    if (!WriteJsonFile(baseDir / "IWBundle.json", bundle, error)) return false;
+    addPayload("SourceProfile.json", sourceProfile);
+    addPayload("IWBundle.json", bundle);
 
     nlohmann::json allegedMechanisms = baseEnvelope;
     allegedMechanisms["allegedMechanisms"] = bundle["allegedMechanisms"];
-    if (!WriteJsonFile(baseDir / "AllegedMechanisms.json", allegedMechanisms, error)) return false;
+    addPayload("AllegedMechanisms.json", allegedMechanisms);
 
     nlohmann::json temporalWindows = baseEnvelope;
     temporalWindows["temporalWindowReferences"] = bundle["temporalWindowReferences"];
-    if (!WriteJsonFile(baseDir / "TemporalWindowReference.json", temporalWindows, error)) return false;
+    addPayload("TemporalWindowReference.json", temporalWindows);
 
     nlohmann::json baselineAssumptions = baseEnvelope;
     baselineAssumptions["baselineAssumptions"] = bundle["baselineAssumptions"];
-    if (!WriteJsonFile(baseDir / "BaselineAssumptions.json", baselineAssumptions, error)) return false;
+    addPayload("BaselineAssumptions.json", baselineAssumptions);
 
     nlohmann::json trajectoryAnalogies = baseEnvelope;
     trajectoryAnalogies["trajectoryAnalogies"] = bundle["trajectoryAnalogies"];
-    if (!WriteJsonFile(baseDir / "TrajectoryAnalogies.json", trajectoryAnalogies, error)) return false;
+    addPayload("TrajectoryAnalogies.json", trajectoryAnalogies);
 
     nlohmann::json interpretationLayers = baseEnvelope;
     interpretationLayers["interpretationLayers"] = bundle["interpretationLayers"];
-    if (!WriteJsonFile(baseDir / "InterpretationLayers.json", interpretationLayers, error)) return false;
+    addPayload("InterpretationLayers.json", interpretationLayers);
 
     // Export NarrativeState Candidate Objects
     if (bundle.contains("narrativeObservations")) {
@@ -1563,14 +1800,14 @@ bool ScientificIngestionService::exportConsumables(
             error = validateError;
             return false;
         }
-        if (!WriteJsonFile(baseDir / "NarrativeObservation.json", narrativeEnvelope, error)) return false;
+        addPayload("NarrativeObservation.json", narrativeEnvelope);
     }
     }
 
     if (bundle.contains("discursiveContext")) {
         nlohmann::json discursiveEnvelope;
         discursiveEnvelope["discursiveContext"] = bundle["discursiveContext"];
-        if (!WriteJsonFile(baseDir / "DiscursiveContext.json", discursiveEnvelope, error)) return false;
+        addPayload("DiscursiveContext.json", discursiveEnvelope);
     }
 
     // Export DiscursiveSystem Candidate Object
@@ -1667,29 +1904,10 @@ bool ScientificIngestionService::exportConsumables(
             error = validateError;
             return false;
         }
-        if (!WriteJsonFile(baseDir / "DiscursiveSystem.json", dsEnvelope, error)) return false;
+        addPayload("DiscursiveSystem.json", dsEnvelope);
     }
 
     nlohmann::json manifest = baseEnvelope;
-    std::vector<std::string> files = {
-        "SourceProfile.json",
-        "IWBundle.json",
-        "AllegedMechanisms.json",
-        "TemporalWindowReference.json",
-        "BaselineAssumptions.json",
-        "TrajectoryAnalogies.json",
-        "InterpretationLayers.json"
-    };
-    if (fs::exists(baseDir / "NarrativeObservation.json")) {
-        files.push_back("NarrativeObservation.json");
-    }
-    if (bundle.contains("discursiveContext")) {
-        files.push_back("DiscursiveContext.json");
-    }
-    // Check if we created DiscursiveSystem.json
-    if (fs::exists(baseDir / "DiscursiveSystem.json")) {
-        files.push_back("DiscursiveSystem.json");
-    }
     // Light metadata for quick indexing
     if (bundle.contains("source") && bundle["source"].is_object()) {
         const auto& src = bundle["source"];
@@ -1707,19 +1925,43 @@ bool ScientificIngestionService::exportConsumables(
     }
     manifest["files"] = files;
     nlohmann::json fileIndex = nlohmann::json::array();
-    for (const auto& name : files) {
+    for (size_t i = 0; i < files.size(); ++i) {
         nlohmann::json entry;
-        entry["name"] = name;
-        entry["path"] = "./" + name;
-        fs::path p = baseDir / name;
-        entry["exists"] = fs::exists(p);
-        if (fs::exists(p)) {
-            entry["sizeBytes"] = static_cast<long long>(fs::file_size(p));
-        }
+        entry["name"] = files[i];
+        entry["path"] = "./" + files[i];
+        entry["exists"] = true;
+        entry["sizeBytes"] = static_cast<long long>(payloads[i].content.size());
         fileIndex.push_back(entry);
     }
     manifest["file_index"] = fileIndex;
-    if (!WriteJsonFile(baseDir / "Manifest.json", manifest, error)) return false;
+
+    // Validation report and seal travel with the payloads but stay out of the manifest's file list.
+    payloads.push_back({(baseDir / "EpistemicValidationReport.json").string(), validation.report.dump(2)});
+    payloads.push_back({(baseDir / "ExportSeal.json").string(), validation.seal.dump(2)});
+
+    // Manifest.json is the commit marker readers look for: withdraw it while the
+    // payloads are replaced, write them all in parallel (one directory fsync for
+    // the batch) and publish the new manifest only after they are durable.
+    std::error_code ec;
+    fs::remove(baseDir / "Manifest.json", ec);
+    for (const char* optional : kOptionalConsumables) {
+        if (std::find(files.begin(), files.end(), optional) == files.end()) {
+            fs::remove(baseDir / optional, ec);
+        }
+    }
+
+    std::string writeError;
+    if (!infrastructure::PersistenceService::WriteGroup(payloads, infrastructure::FsyncPolicy::Rename,
+                                                         kExportWriters, writeError)) {
+        error = "Falha ao gravar consumíveis: " + writeError;
+        return false;
+    }
+    const infrastructure::SaveTask manifestTask{(baseDir / "Manifest.json").string(), manifest.dump(2)};
+    if (!infrastructure::PersistenceService::WriteGroup({manifestTask}, infrastructure::FsyncPolicy::Rename, 1,
+                                                        writeError)) {
+        error = "Falha ao publicar manifesto: " + writeError;
+        return false;
+    }
 
     return true;
 }
@@ -1728,233 +1970,28 @@ bool ScientificIngestionService::saveErrorPayload(
     const std::string& artifactId,
     const std::string& payload,
     std::string& error) const {
-    fs::path errorDir = fs::path(m_observationsPath) / "errors";
-    if (!fs::exists(errorDir)) {
-        fs::create_directories(errorDir);
-    }
-    fs::path outPath = errorDir / (artifactId + ".json");
-
-    nlohmann::json envelope;
-    envelope["schemaVersion"] = domain::scientific::ScientificSchema::SchemaVersion;
-    envelope["artifactId"] = artifactId;
-    envelope["artifactIdBase"] = StripErrorSuffix(artifactId);
-    envelope["stage"] = InferErrorStage(artifactId);
-    envelope["createdAt"] = ToIsoTimestamp(std::chrono::system_clock::now());
-
-    try {
-        nlohmann::json parsed = nlohmann::json::parse(payload);
+    nlohmann::json envelope = MakeErrorEnvelope(artifactId);
+    // Most payloads here are LLM responses that already failed to parse: a DOM-free scan rejects
+    // them without building (and throwing away) a partial tree.
+    if (infrastructure::JsonScanner::parse(payload)) {
         envelope["payloadType"] = "json";
-        envelope["payload"] = parsed;
-    } catch (...) {
+        envelope["payload"] = nlohmann::json::parse(payload);
+    } else {
         envelope["payloadType"] = "text";
         envelope["payload"] = payload;
     }
-
-    return WriteJsonFile(outPath, envelope, error);
+    return WriteJsonFile(ErrorPayloadPath(m_observationsPath, artifactId), envelope, error);
 }
 
-
-void ScientificIngestionService::generateIngestionReport() const {
-    if (!fs::exists(m_consumablesPath)) return;
-
-    nlohmann::json manifest;
-    auto now = std::chrono::system_clock::now();
-    const std::string nowIso = ToIsoTimestamp(now);
-    manifest["project_ingestion_id"] = nowIso;
-    manifest["generatedAt"] = nowIso;
-    manifest["schema_version"] = domain::scientific::ScientificSchema::SchemaVersion;
-    manifest["schemaVersion"] = domain::scientific::ScientificSchema::SchemaVersion;
-
-    nlohmann::json layout;
-    layout["consumables_root"] = fs::path(m_consumablesPath).string();
-    layout["observations_root"] = fs::path(m_observationsPath).string();
-    layout["errors_root"] = (fs::path(m_observationsPath) / "errors").string();
-    layout["validation_root"] = (fs::path(m_observationsPath) / "validation").string();
-    layout["article_dir_pattern"] = "<artifactId>/";
-    layout["per_article_files"] = {
-        {"required", {
-            "SourceProfile.json",
-            "IWBundle.json",
-            "AllegedMechanisms.json",
-            "TemporalWindowReference.json",
-            "BaselineAssumptions.json",
-            "TrajectoryAnalogies.json",
-            "InterpretationLayers.json",
-            "Manifest.json"
-        }},
-        {"optional", {
-            "NarrativeObservation.json",
-            "DiscursiveContext.json",
-            "DiscursiveSystem.json",
-            "EpistemicValidationReport.json",
-            "ExportSeal.json"
-        }}
-    };
-    manifest["layout"] = layout;
-
-    // Collect error payloads (observations/scientific/errors)
-    std::unordered_map<std::string, nlohmann::json> errorsByArtifact;
-    nlohmann::json allErrors = nlohmann::json::array();
-    fs::path errorDir = fs::path(m_observationsPath) / "errors";
-    if (fs::exists(errorDir)) {
-        for (const auto& entry : fs::directory_iterator(errorDir)) {
-            if (!entry.is_regular_file()) continue;
-            const std::string filename = entry.path().filename().string();
-            const std::string errId = entry.path().stem().string();
-            const std::string baseId = StripErrorSuffix(errId);
-
-            nlohmann::json err;
-            err["artifactId"] = errId;
-            err["artifactIdBase"] = baseId;
-            err["stage"] = InferErrorStage(errId);
-            err["path"] = entry.path().string();
-
-            try {
-                std::ifstream ef(entry.path());
-                nlohmann::json ej;
-                ef >> ej;
-                if (ej.contains("createdAt")) err["createdAt"] = ej["createdAt"];
-                if (ej.contains("payloadType")) err["payloadType"] = ej["payloadType"];
-            } catch (...) {
-                err["payloadType"] = "unknown";
-            }
-
-            allErrors.push_back(err);
-            auto& arr = errorsByArtifact[baseId];
-            if (!arr.is_array()) arr = nlohmann::json::array();
-            arr.push_back(err);
-        }
-    }
-    manifest["errors"] = allErrors;
-    
-    nlohmann::json articles = nlohmann::json::array();
-    
-    for (const auto& entry : fs::directory_iterator(m_consumablesPath)) {
-        if (!entry.is_directory()) continue;
-        
-        fs::path dir = entry.path();
-        fs::path manifestPath = dir / "Manifest.json";
-        
-        if (!fs::exists(manifestPath)) continue;
-
-        std::ifstream mf(manifestPath);
-        if (!mf.is_open()) continue;
-        nlohmann::json artManifest;
-        try {
-            mf >> artManifest;
-        } catch (...) { continue; }
-
-        nlohmann::json articleEntry;
-        const std::string dirName = dir.filename().string();
-        std::string artifactId = dirName;
-        if (artManifest.contains("artifactId") && artManifest["artifactId"].is_string()) {
-            artifactId = artManifest["artifactId"].get<std::string>();
-        } else if (artManifest.contains("source") && artManifest["source"].is_object()) {
-            const auto& src = artManifest["source"];
-            if (src.contains("artifactId") && src["artifactId"].is_string()) {
-                artifactId = src["artifactId"].get<std::string>();
-            }
-        }
-
-        articleEntry["artifactId"] = artifactId;
-        articleEntry["relative_path"] = "./" + dirName + "/";
-        articleEntry["manifest_path"] = "./" + dirName + "/Manifest.json";
-
-        if (artManifest.contains("files")) articleEntry["files"] = artManifest["files"];
-        if (artManifest.contains("file_index")) articleEntry["file_index"] = artManifest["file_index"];
-        if (artManifest.contains("source") && artManifest["source"].is_object()) {
-            articleEntry["source"] = artManifest["source"];
-            if (artManifest["source"].contains("filename")) {
-                articleEntry["filename"] = artManifest["source"]["filename"];
-            }
-        }
-        if (artManifest.contains("filename")) articleEntry["filename"] = artManifest["filename"];
-
-        // Enrich from SourceProfile.json (nested schema)
-        fs::path sourceProfilePath = dir / "SourceProfile.json";
-        if (fs::exists(sourceProfilePath)) {
-            try {
-                std::ifstream spf(sourceProfilePath);
-                nlohmann::json sourceProfile;
-                spf >> sourceProfile;
-
-                if (!articleEntry.contains("source") && sourceProfile.contains("source") && sourceProfile["source"].is_object()) {
-                    articleEntry["source"] = sourceProfile["source"];
-                    if (sourceProfile["source"].contains("filename")) {
-                        articleEntry["filename"] = sourceProfile["source"]["filename"];
-                    }
-                }
-
-                if (sourceProfile.contains("sourceProfile") && sourceProfile["sourceProfile"].is_object()) {
-                    const auto& sp = sourceProfile["sourceProfile"];
-                    if (sp.contains("studyType")) articleEntry["studyType"] = sp["studyType"];
-                    if (sp.contains("temporalScale")) articleEntry["temporalScale"] = sp["temporalScale"];
-                    if (sp.contains("ecosystemType")) articleEntry["ecosystemType"] = sp["ecosystemType"];
-                    if (sp.contains("evidenceType")) articleEntry["evidenceType"] = sp["evidenceType"];
-                    if (sp.contains("transferability")) articleEntry["transferability"] = sp["transferability"];
-                }
-            } catch (...) {}
-        }
-
-        // Validation Status + Export Seal
-        fs::path validationPath = dir / "EpistemicValidationReport.json";
-        if (fs::exists(validationPath)) {
-            try {
-                std::ifstream vf(validationPath);
-                nlohmann::json validation;
-                vf >> validation;
-                if (validation.contains("status")) {
-                    articleEntry["validationStatus"] = validation["status"];
-                } else {
-                    articleEntry["validationStatus"] = "unknown";
-                }
-                articleEntry["validationReportPath"] = "./" + dirName + "/EpistemicValidationReport.json";
-            } catch (...) {
-                articleEntry["validationStatus"] = "error";
-            }
-        } else {
-            articleEntry["validationStatus"] = "pending";
-        }
-
-        fs::path sealPath = dir / "ExportSeal.json";
-        if (fs::exists(sealPath)) {
-            try {
-                std::ifstream sf(sealPath);
-                nlohmann::json seal;
-                sf >> seal;
-                if (seal.contains("exportAllowed")) articleEntry["exportAllowed"] = seal["exportAllowed"];
-                articleEntry["exportSealPath"] = "./" + dirName + "/ExportSeal.json";
-            } catch (...) {}
-        }
-
-        // Observation bundle + validation paths (if present)
-        fs::path rawBundlePath = fs::path(m_observationsPath) / (artifactId + ".json");
-        if (fs::exists(rawBundlePath)) {
-            articleEntry["rawBundlePath"] = rawBundlePath.string();
-        }
-        fs::path obsValidationPath = fs::path(m_observationsPath) / "validation" / (artifactId + ".json");
-        if (fs::exists(obsValidationPath)) {
-            articleEntry["rawValidationPath"] = obsValidationPath.string();
-        }
-
-        // Attach error payloads if any
-        auto it = errorsByArtifact.find(artifactId);
-        if (it != errorsByArtifact.end()) {
-            articleEntry["errors"] = it->second;
-        }
-
-        articles.push_back(articleEntry);
-    }
-    
-    manifest["total_articles"] = articles.size();
-    manifest["articles"] = articles;
-    
-    // Write STRATA_Manifest.json
-    fs::path outPath = fs::path(m_consumablesPath) / "STRATA_Manifest.json";
-    std::ofstream outFile(outPath);
-    if (outFile.is_open()) {
-        outFile << manifest.dump(4);
-    }
+bool ScientificIngestionService::saveErrorPayload(
+    const std::string& artifactId,
+    const nlohmann::json& payload,
+    std::string& error) const {
+    nlohmann::json envelope = MakeErrorEnvelope(artifactId);
+    envelope["payloadType"] = "json";
+    envelope["payload"] = payload;
+    return WriteJsonFile(ErrorPayloadPath(m_observationsPath, artifactId), envelope, error);
 }
 
+
 } // namespace ideawalker::application::scientific
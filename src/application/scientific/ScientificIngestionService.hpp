@@ -15,10 +15,27 @@
 #include "domain/AIService.hpp"
 #include "domain/SourceArtifact.hpp"
 #include "domain/scientific/ScientificSchema.hpp"
+#include "application/scientific/EpistemicValidator.hpp"
+#include "application/scientific/IngestionCatalog.hpp"
+#include "application/scientific/IngestionCheckpoints.hpp"
+#include "application/scientific/StrataManifestIndex.hpp"
 #include "infrastructure/FileSystemArtifactScanner.hpp"
 
+namespace ideawalker::application {
+class AsyncTaskManager;
+}
+
 namespace ideawalker::application::scientific {
 
+/**
+ * @struct IngestionConcurrency
+ * @brief Limits for pipelined batch ingestion (used only with a task manager).
+ */
+struct IngestionConcurrency {
+    size_t llmCalls = 2;         ///< generateJson calls in flight across the whole batch.
+    size_t articlesInFlight = 3; ///< Articles between extraction and export at the same time.
+};
+
 /**
  * @class ScientificIngestionService
  * @brief Orchestrates ingestion of scientific sources and exports STRATA consumables.
@@ -32,6 +49,7 @@ public:
         int artifactsDetected;
         int bundlesGenerated;
         std::vector<std::string> errors;
+        int artifactsSkipped = 0; ///< Unchanged since a finished run under the same prompts/schema.
     };
 
     /**
@@ -52,11 +70,21 @@ public:
      * @param aiService AI service used to generate structured artifacts.
      * @param observationsPath Path where raw bundles are stored.
      * @param consumablesPath Path where STRATA consumables are exported.
+     * @param taskManager Optional; when set, batches run as a pipeline (extraction, LLM,
+     *        anchoring/validation, export) with both LLM phases of an article issued concurrently.
+     *        Without it articles are processed one at a time, phases in order.
+     * @param concurrency Pipeline limits.
+     *
+     * Progress is checkpointed per article under `<observationsPath>/checkpoints`: a re-run
+     * skips unchanged articles and resumes unfinished ones after their last finished stage.
+     * Checkpoints are tied to the schema, the prompts and the model in use when a run starts.
      */
     ScientificIngestionService(std::unique_ptr<infrastructure::FileSystemArtifactScanner> scanner,
                                std::shared_ptr<domain::AIService> aiService,
                                const std::string& observationsPath,
-                               const std::string& consumablesPath);
+                               const std::string& consumablesPath,
+                               std::shared_ptr<AsyncTaskManager> taskManager = nullptr,
+                               IngestionConcurrency concurrency = {});
 
     /**
      * @brief Ingests a direct JSON bundle (Candidate) from an external source (e.g. PersonaOrchestrator).
@@ -82,7 +110,8 @@ public:
     /**
      * @brief Processes a specific list of scientific artifacts.
      * @param artifacts List of artifacts to process.
-     * @param purgeExisting Whether to remove previous outputs for the same filenames.
+     * @param purgeExisting Whether to remove previous outputs for the same filenames; also drops
+     *        their checkpoints, so every selected article is processed again from scratch.
      * @param statusCallback Optional UI feedback callback.
      * @return Summary of the operation.
      */
@@ -91,17 +120,33 @@ public:
                                    std::function<void(std::string)> statusCallback = nullptr);
 
     /**
-     * @brief Counts stored scientific bundles.
+     * @brief Counts stored scientific bundles (from the ingestion catalog, no directory scan).
      * @return Number of raw scientific bundle files on disk.
      */
     size_t getBundlesCount() const;
 
+    /** @brief Number of artifacts exported to STRATA with an allowing seal. */
+    size_t getExportedCount() const;
+
     /**
      * @brief Retrieves the most recent epistemic validation summary, if available.
      * @return Optional summary with report status and location.
      */
     std::optional<ValidationSummary> getLatestValidationSummary() const;
 
+    /**
+     * @brief Rebuilds the ingestion catalog from the files on disk (maintenance).
+     * @return Number of bundles found.
+     */
+    size_t rebuildIngestionCatalog();
+
+    /**
+     * @brief Rebuilds `STRATA_Manifest.json` from a full scan of the consumables (maintenance).
+     *        Ingestion runs only refresh the articles they touched.
+     * @return Number of articles in the manifest.
+     */
+    size_t rebuildGlobalManifest();
+
     /**
      * @brief Writes the structural exclusion audit log for a processed artifact.
      * @param observationsPath Base path for scientific observation artifacts.
@@ -120,6 +165,14 @@ private:
     std::shared_ptr<domain::AIService> m_aiService;
     std::string m_observationsPath;
     std::string m_consumablesPath;
+    std::shared_ptr<AsyncTaskManager> m_taskManager;
+    IngestionConcurrency m_concurrency;
+    std::unique_ptr<IngestionCheckpoints> m_checkpoints;
+    std::unique_ptr<StrataManifestIndex> m_manifestIndex;
+    std::unique_ptr<IngestionCatalog> m_catalog; ///< Bundles, validations and seals as they are written.
+
+    struct ArticleWork;
+    using StatusFn = std::function<void(std::string)>;
 
     std::string buildNarrativeSystemPrompt() const;
     std::string buildNarrativeUserPrompt(const domain::SourceArtifact& artifact, const std::string& content) const;
@@ -127,13 +180,24 @@ private:
     std::string buildDiscursiveSystemPrompt() const;
     std::string buildDiscursiveUserPrompt(const domain::SourceArtifact& artifact, const std::string& content) const;
     std::string buildArtifactId(const domain::SourceArtifact& artifact) const;
+    /** @brief Schema version + hash of the prompts and the current model. */
+    std::string computePipelineVersion() const;
 
     bool validateBundleJson(const nlohmann::json& bundle, std::vector<std::string>& errors) const;
     IngestionResult processArtifacts(const std::vector<domain::SourceArtifact>& artifacts,
                                      bool purgeExisting,
                                      std::function<void(std::string)> statusCallback);
-    bool purgeExistingArtifacts(const std::string& filename, std::string& error) const;
-    void generateIngestionReport() const; // New method for Global Manifest
+    // Pipeline stages, run per article (see processArtifacts).
+    void processArticle(ArticleWork& work, const StatusFn& status);
+    bool extractStage(ArticleWork& work, const StatusFn& status) const;
+    void llmStage(ArticleWork& work, const StatusFn& status);
+    void narrativePhase(ArticleWork& work, const StatusFn& status);
+    void discursivePhase(ArticleWork& work, const StatusFn& status);
+    bool assembleStage(ArticleWork& work, const StatusFn& status) const;
+    void exportStage(ArticleWork& work) const;
+    void recordStage(const ArticleWork& work, IngestionStage stage, bool exportBlocked = false) const;
+    bool purgeExistingArtifacts(const std::string& filename, std::string& error,
+                                std::vector<std::string>& removedArtifactIds) const;
     void attachSourceMetadata(nlohmann::json& bundle,
                               const domain::SourceArtifact& artifact,
                               const std::string& artifactId,
@@ -142,8 +206,14 @@ private:
                               const std::string& extractionStatus,
                               bool isPartial) const;
     bool saveRawBundle(const nlohmann::json& bundle, const std::string& artifactId, std::string& error) const;
-    bool exportConsumables(const nlohmann::json& bundle, const std::string& artifactId, std::string& error) const;
+    /**
+     * @brief Writes the per-article STRATA consumables as one group and publishes Manifest.json last.
+     */
+    bool exportConsumables(const nlohmann::json& bundle, const std::string& artifactId,
+                           const EpistemicValidator::Result& validation, std::string& error) const;
     bool saveErrorPayload(const std::string& artifactId, const std::string& payload, std::string& error) const;
+    /** @brief Same envelope for a payload that is already a DOM (no dump/re-parse round trip). */
+    bool saveErrorPayload(const std::string& artifactId, const nlohmann::json& payload, std::string& error) const;
 };
 
 } // namespace ideawalker::application::scientific
@@ -0,0 +1,232 @@
+/**
+ * @file SnippetAnchorIndex.cpp
+ * @brief Implementation of SnippetAnchorIndex.
+ */
+
+#include "application/scientific/SnippetAnchorIndex.hpp"
+#include <algorithm>
+#include <cctype>
+#include <functional>
+#include <numeric>
+
+namespace ideawalker::application::scientific {
+
+namespace {
+
+std::vector<std::string_view> SplitSpaces(std::string_view text) {
+    std::vector<std::string_view> tokens;
+    std::size_t begin = 0;
+    while (begin < text.size()) {
+        if (text[begin] == ' ') {
+            ++begin;
+            continue;
+        }
+        std::size_t end = text.find(' ', begin);
+        if (end == std::string_view::npos) end = text.size();
+        tokens.push_back(text.substr(begin, end - begin));
+        begin = end;
+    }
+    return tokens;
+}
+
+std::uint16_t Bigram(std::string_view text, std::size_t i) {
+    return static_cast<std::uint16_t>((static_cast<unsigned char>(text[i]) << 8) | static_cast<unsigned char>(text[i + 1]));
+}
+
+std::size_t MaxTokenEdits(std::string_view snippetToken) {
+    return snippetToken.size() > 6 ? 2 : 1;
+}
+
+std::size_t DynamicDistance(std::string_view a, std::string_view b) {
+    std::vector<std::size_t> row(b.size() + 1);
+    std::iota(row.begin(), row.end(), 0);
+    for (std::size_t i = 1; i <= a.size(); ++i) {
+        std::size_t previous = row[0];
+        row[0] = i;
+        for (std::size_t j = 1; j <= b.size(); ++j) {
+            const std::size_t old = row[j];
+            row[j] = std::min({old + 1, row[j - 1] + 1, previous + (a[i - 1] == b[j - 1] ? 0 : 1)});
+            previous = old;
+        }
+    }
+    return row[b.size()];
+}
+
+} // namespace
+
+std::string SnippetAnchorIndex::Normalize(const std::string& input) {
+    std::string out;
+    out.reserve(input.size());
+    bool lastWasSpace = false;
+    for (unsigned char c : input) {
+        if (std::isspace(c)) {
+            if (!lastWasSpace) {
+                out.push_back(' ');
+                lastWasSpace = true;
+            }
+            continue;
+        }
+        out.push_back(static_cast<char>(std::tolower(c)));
+        lastWasSpace = false;
+    }
+    return out;
+}
+
+std::size_t SnippetAnchorIndex::EditDistance(std::string_view a, std::string_view b) {
+    if (a.size() > b.size()) std::swap(a, b);
+    if (a.empty()) return b.size();
+    if (a.size() > 64) return DynamicDistance(a, b);
+
+    // Myers/Hyyrö: one 64-bit column of the DP matrix per text byte, the pattern
+    // (the shorter string) in bit positions; the score tracks the last row.
+    std::uint64_t peq[256];
+    for (unsigned char c : a) peq[c] = 0;
+    for (unsigned char c : b) peq[c] = 0;
+    for (std::size_t i = 0; i < a.size(); ++i) peq[static_cast<unsigned char>(a[i])] |= std::uint64_t{1} << i;
+
+    const std::uint64_t high = std::uint64_t{1} << (a.size() - 1);
+    std::uint64_t vp = ~std::uint64_t{0};
+    std::uint64_t vn = 0;
+    std::size_t score = a.size();
+    for (unsigned char c : b) {
+        const std::uint64_t eq = peq[c];
+        const std::uint64_t xv = eq | vn;
+        const std::uint64_t xh = (((eq & vp) + vp) ^ vp) | eq;
+        std::uint64_t ph = vn | ~(xh | vp);
+        std::uint64_t mh = vp & xh;
+        if (ph & high) {
+            ++score;
+        } else if (mh & high) {
+            --score;
+        }
+        ph = (ph << 1) | 1;
+        mh <<= 1;
+        vp = mh | ~(xv | ph);
+        vn = ph & xv;
+    }
+    return score;
+}
+
+bool SnippetAnchorIndex::TokensMatch(std::string_view snippetToken, std::string_view contentToken) {
+    if (snippetToken == contentToken) return true;
+    if (snippetToken.size() < 4 || contentToken.size() < 4) return false; // Strict for short words
+    const std::size_t k = MaxTokenEdits(snippetToken);
+    const std::size_t diff = snippetToken.size() > contentToken.size() ? snippetToken.size() - contentToken.size()
+                                                                         : contentToken.size() - snippetToken.size();
+    return diff <= k && EditDistance(snippetToken, contentToken) <= k;
+}
+
+SnippetAnchorIndex::SnippetAnchorIndex(const std::string& content) : m_normalized(Normalize(content)) {
+    const std::vector<std::string_view> tokens = SplitSpaces(m_normalized);
+    m_tokens.reserve(tokens.size());
+    for (std::string_view token : tokens) {
+        auto [it, inserted] = m_wordIds.try_emplace(token, static_cast<std::uint32_t>(m_words.size()));
+        if (inserted) {
+            m_words.push_back(token);
+            m_postings.emplace_back();
+        }
+        m_postings[it->second].push_back(static_cast<std::uint32_t>(m_tokens.size()));
+        m_tokens.push_back(it->second);
+    }
+
+    for (std::uint32_t id = 0; id < m_words.size(); ++id) {
+        const std::string_view word = m_words[id];
+        if (word.size() < 4) continue;
+        for (std::size_t i = 0; i + 1 < word.size(); ++i) {
+            auto& list = m_bigrams[Bigram(word, i)];
+            if (list.empty() || list.back() != id) list.push_back(id);
+        }
+    }
+    m_votes.assign(m_words.size(), 0);
+    m_stamp.assign(m_tokens.size(), 0);
+}
+
+const std::vector<std::uint32_t>& SnippetAnchorIndex::matchesFor(std::string_view token) {
+    auto memo = m_matchMemo.find(std::string(token));
+    if (memo != m_matchMemo.end()) return memo->second;
+
+    std::vector<std::uint32_t> matches;
+    auto exact = m_wordIds.find(token);
+    if (exact != m_wordIds.end()) matches.push_back(exact->second);
+
+    if (token.size() >= 4) {
+        // q-gram lemma (q = 2): a word within k edits shares at least (m - 1) - 2k of the
+        // token's bigram positions, so words below that count cannot match.
+        const std::size_t k = MaxTokenEdits(token);
+        const std::size_t required = (token.size() - 1) - 2 * k;
+        std::vector<std::uint32_t> touched;
+        for (std::size_t i = 0; i + 1 < token.size(); ++i) {
+            auto list = m_bigrams.find(Bigram(token, i));
+            if (list == m_bigrams.end()) continue;
+            for (std::uint32_t id : list->second) {
+                if (m_votes[id]++ == 0) touched.push_back(id);
+            }
+        }
+        for (std::uint32_t id : touched) {
+            const std::string_view word = m_words[id];
+            if (m_votes[id] >= required && (exact == m_wordIds.end() || id != exact->second) &&
+                TokensMatch(token, word)) {
+                matches.push_back(id);
+            }
+            m_votes[id] = 0;
+        }
+    }
+    std::sort(matches.begin(), matches.end());
+    return m_matchMemo.emplace(std::string(token), std::move(matches)).first->second;
+}
+
+bool SnippetAnchorIndex::contains(const std::string& snippet) {
+    if (snippet.empty()) return false;
+
+    // 1. Fast path: exact substring of the normalized text.
+    const std::string normSnippet = Normalize(snippet);
+    if (std::search(m_normalized.begin(), m_normalized.end(),
+                    std::boyer_moore_horspool_searcher(normSnippet.begin(), normSnippet.end())) != m_normalized.end()) {
+        return true;
+    }
+
+    // 2. Token windows with at most maxErrors mismatching tokens.
+    const std::vector<std::string_view> sTokens = SplitSpaces(normSnippet);
+    if (sTokens.empty() || m_tokens.size() < sTokens.size()) return false;
+    const std::size_t window = sTokens.size();
+    const std::size_t maxErrors = std::max<std::size_t>(1, window / 4); // Allow 25% token mismatch
+    if (maxErrors >= window) return true;
+
+    std::vector<const std::vector<std::uint32_t>*> matches(window);
+    std::vector<std::pair<std::size_t, std::size_t>> rarity(window); // (occurrences, snippet position)
+    for (std::size_t j = 0; j < window; ++j) {
+        matches[j] = &matchesFor(sTokens[j]);
+        std::size_t occurrences = 0;
+        for (std::uint32_t id : *matches[j]) occurrences += m_postings[id].size();
+        rarity[j] = {occurrences, j};
+    }
+
+    // A window with at most maxErrors mismatches matches at least one of any
+    // maxErrors + 1 snippet tokens: the rarest ones seed the candidate windows.
+    std::partial_sort(rarity.begin(), rarity.begin() + maxErrors + 1, rarity.end());
+    if (++m_epoch == 0) {
+        std::fill(m_stamp.begin(), m_stamp.end(), 0);
+        m_epoch = 1;
+    }
+    const std::size_t lastStart = m_tokens.size() - window;
+    for (std::size_t r = 0; r <= maxErrors; ++r) {
+        const std::size_t seed = rarity[r].second;
+        for (std::uint32_t id : *matches[seed]) {
+            for (std::uint32_t position : m_postings[id]) {
+                if (position < seed || position - seed > lastStart) continue;
+                const std::size_t start = position - seed;
+                if (m_stamp[start] == m_epoch) continue;
+                m_stamp[start] = m_epoch;
+
+                std::size_t errors = 0;
+                for (std::size_t j = 0; j < window && errors <= maxErrors; ++j) {
+                    if (!std::binary_search(matches[j]->begin(), matches[j]->end(), m_tokens[start + j])) ++errors;
+                }
+                if (errors <= maxErrors) return true;
+            }
+        }
+    }
+    return false;
+}
+
+} // namespace ideawalker::application::scientific
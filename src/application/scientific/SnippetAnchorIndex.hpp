@@ -0,0 +1,66 @@
+/**
+ * @file SnippetAnchorIndex.hpp
+ * @brief Per-article index answering "does this evidence snippet appear in the text?".
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace ideawalker::application::scientific {
+
+/**
+ * @class SnippetAnchorIndex
+ * @brief Anchors LLM evidence snippets against one article, built once per article.
+ *
+ * A snippet is anchored if its normalized form (lowercase, collapsed whitespace) is a
+ * substring of the normalized article, or if some window of article tokens matches the
+ * snippet's tokens with at most max(1, n/4) mismatching tokens. Two tokens match when
+ * equal, or when both have 4+ bytes and their edit distance is at most 1 (2 if the
+ * snippet token is longer than 6 bytes).
+ *
+ * The article is normalized and tokenized once. Each distinct snippet token is matched
+ * against the article's vocabulary through a bigram filter and Myers' bit-parallel
+ * edit distance (results are memoized per index). Candidate windows come from the
+ * posting lists of the e+1 rarest snippet tokens (e = allowed mismatches): a matching
+ * window contains at least one of them, so only those windows are verified.
+ */
+class SnippetAnchorIndex {
+public:
+    explicit SnippetAnchorIndex(const std::string& content);
+
+    /** @brief True if @p snippet is anchored in the article. Not thread-safe (memo). */
+    bool contains(const std::string& snippet);
+
+    /** @brief Lowercase, whitespace runs collapsed to one space (as the index sees text). */
+    static std::string Normalize(const std::string& input);
+
+    /** @brief Levenshtein distance with Myers' algorithm (any length; >64 bytes falls back to DP). */
+    static std::size_t EditDistance(std::string_view a, std::string_view b);
+
+    /** @brief Token match rule described above. */
+    static bool TokensMatch(std::string_view snippetToken, std::string_view contentToken);
+
+    std::size_t tokenCount() const { return m_tokens.size(); }
+    std::size_t vocabularySize() const { return m_words.size(); }
+
+private:
+    const std::vector<std::uint32_t>& matchesFor(std::string_view token);
+
+    std::string m_normalized;
+    std::vector<std::uint32_t> m_tokens;                  // Article tokens as vocabulary ids
+    std::vector<std::string_view> m_words;                // Vocabulary (views into m_normalized)
+    std::unordered_map<std::string_view, std::uint32_t> m_wordIds;
+    std::vector<std::vector<std::uint32_t>> m_postings;   // Word id -> token positions
+    std::unordered_map<std::uint16_t, std::vector<std::uint32_t>> m_bigrams; // Bigram -> ids of words of 4+ bytes
+    std::unordered_map<std::string, std::vector<std::uint32_t>> m_matchMemo; // Snippet token -> matching ids (sorted)
+    std::vector<std::uint32_t> m_votes;                   // Scratch, per word id
+    std::vector<std::uint32_t> m_stamp;                   // Scratch, per token position
+    std::uint32_t m_epoch = 0;
+};
+
+} // namespace ideawalker::application::scientific
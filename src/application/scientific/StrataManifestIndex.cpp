@@ -0,0 +1,388 @@
+/**
+ * @file StrataManifestIndex.cpp
+ * @brief Implementation of StrataManifestIndex.
+ */
+
+#include "application/scientific/StrataManifestIndex.hpp"
+#include "domain/scientific/ScientificSchema.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+namespace ideawalker::application::scientific {
+
+namespace {
+
+constexpr int kIndexSchemaVersion = 1;
+constexpr const char* kIndexFile = ".strata_index.json";
+constexpr const char* kManifestFile = "STRATA_Manifest.json";
+constexpr const char* kNarrativeErrSuffix = "_narrative_err";
+constexpr const char* kDiscursiveErrSuffix = "_discursive_err";
+
+bool EndsWith(const std::string& value, const std::string& suffix) {
+    if (suffix.size() > value.size()) return false;
+    return std::equal(suffix.rbegin(), suffix.rend(), value.rbegin());
+}
+
+std::string NowIso() {
+    std::time_t tt = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    std::tm tm = {};
+#if defined(_WIN32)
+    gmtime_s(&tm, &tt);
+#else
+    gmtime_r(&tt, &tm);
+#endif
+    std::ostringstream oss;
+    oss << std::put_time(&tm, "%Y-%m-%dT%H:%M:%SZ");
+    return oss.str();
+}
+
+void HashBytes(std::uint64_t& hash, const void* data, size_t size) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+}
+
+/** FNV-1a over name, size and mtime of each file: changes whenever one is rewritten, added or removed. */
+std::string DigestFiles(const std::vector<fs::path>& files) {
+    std::uint64_t hash = 1469598103934665603ull;
+    for (const auto& path : files) {
+        const std::string name = path.filename().string();
+        HashBytes(hash, name.data(), name.size());
+        std::error_code ec;
+        const auto size = fs::file_size(path, ec);
+        if (ec) {
+            const char missing = 0;
+            HashBytes(hash, &missing, 1);
+            continue;
+        }
+        const auto mtime = fs::last_write_time(path, ec).time_since_epoch().count();
+        HashBytes(hash, &size, sizeof(size));
+        HashBytes(hash, &mtime, sizeof(mtime));
+    }
+    std::ostringstream oss;
+    oss << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return oss.str();
+}
+
+std::optional<nlohmann::json> ReadJson(const fs::path& path) {
+    std::ifstream in(path);
+    if (!in.is_open()) return std::nullopt;
+    try {
+        nlohmann::json value;
+        in >> value;
+        return value;
+    } catch (...) {
+        return std::nullopt;
+    }
+}
+
+bool WriteAtomically(const fs::path& path, const std::string& content) {
+    fs::path temp = path;
+    temp += ".tmp";
+    {
+        std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) return false;
+        out << content;
+        if (!out.good()) return false;
+    }
+    std::error_code ec;
+    fs::rename(temp, path, ec);
+    return !ec;
+}
+
+} // namespace
+
+StrataManifestIndex::StrataManifestIndex(std::string consumablesPath, std::string observationsPath)
+    : m_consumablesPath(std::move(consumablesPath)), m_observationsPath(std::move(observationsPath)) {}
+
+std::string StrataManifestIndex::ErrorBaseId(const std::string& errorId) {
+    for (const std::string suffix : {kNarrativeErrSuffix, kDiscursiveErrSuffix}) {
+        if (EndsWith(errorId, suffix)) return errorId.substr(0, errorId.size() - suffix.size());
+    }
+    return errorId;
+}
+
+std::string StrataManifestIndex::ErrorStage(const std::string& errorId) {
+    if (EndsWith(errorId, kNarrativeErrSuffix)) return "narrative_json_invalid";
+    if (EndsWith(errorId, kDiscursiveErrSuffix)) return "discursive_json_invalid";
+    return "unknown";
+}
+
+bool StrataManifestIndex::update(const std::vector<std::string>& artifactIds) {
+    if (!fs::exists(m_consumablesPath)) return false;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!ensureLoadedLocked()) {
+        // First run on an existing project (or a damaged index): the full scan builds it.
+        rebuildLocked();
+    } else {
+        for (const auto& id : artifactIds) {
+            refreshArticleLocked(id, false);
+            for (const std::string suffix : {"", kNarrativeErrSuffix, kDiscursiveErrSuffix}) {
+                refreshErrorLocked(id + suffix, false);
+            }
+        }
+    }
+    const bool indexed = persistLocked();
+    return writeManifestLocked() && indexed;
+}
+
+size_t StrataManifestIndex::rebuild() {
+    if (!fs::exists(m_consumablesPath)) return 0;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    rebuildLocked();
+    m_loaded = true;
+    persistLocked();
+    writeManifestLocked();
+    return m_articles.size();
+}
+
+bool StrataManifestIndex::ensureLoadedLocked() {
+    if (m_loaded) return true;
+    m_loaded = true;
+    auto index = ReadJson(fs::path(m_consumablesPath) / kIndexFile);
+    if (!index || !index->is_object() || index->value("schemaVersion", 0) != kIndexSchemaVersion) return false;
+
+    auto loadEntries = [](const nlohmann::json& items, std::map<std::string, Entry>& out) {
+        if (!items.is_object()) return;
+        for (const auto& [key, item] : items.items()) {
+            if (!item.is_object() || !item.contains("entry")) continue;
+            out[key] = Entry{item.value("digest", ""), item["entry"]};
+        }
+    };
+    loadEntries(index->value("articles", nlohmann::json::object()), m_articles);
+    loadEntries(index->value("errors", nlohmann::json::object()), m_errors);
+    return true;
+}
+
+void StrataManifestIndex::rebuildLocked() {
+    m_articles.clear();
+    m_errors.clear();
+    for (const auto& entry : fs::directory_iterator(m_consumablesPath)) {
+        if (entry.is_directory()) refreshArticleLocked(entry.path().filename().string(), true);
+    }
+    const fs::path errorDir = fs::path(m_observationsPath) / "errors";
+    if (fs::exists(errorDir)) {
+        for (const auto& entry : fs::directory_iterator(errorDir)) {
+            if (entry.is_regular_file()) refreshErrorLocked(entry.path().stem().string(), true);
+        }
+    }
+}
+
+void StrataManifestIndex::refreshArticleLocked(const std::string& dirName, bool force) {
+    const fs::path dir = fs::path(m_consumablesPath) / dirName;
+    if (!fs::exists(dir / "Manifest.json")) {
+        m_articles.erase(dirName);
+        return;
+    }
+    const fs::path obsDir = fs::path(m_observationsPath);
+    const std::string digest = DigestFiles({
+        dir / "Manifest.json", dir / "SourceProfile.json", dir / "EpistemicValidationReport.json",
+        dir / "ExportSeal.json", obsDir / (dirName + ".json"), obsDir / "validation" / (dirName + ".json")
+    });
+    auto it = m_articles.find(dirName);
+    if (!force && it != m_articles.end() && it->second.digest == digest) return;
+
+    nlohmann::json data = buildArticleEntry(dirName);
+    if (data.is_null()) {
+        m_articles.erase(dirName);
+        return;
+    }
+    m_articles[dirName] = Entry{digest, std::move(data)};
+}
+
+void StrataManifestIndex::refreshErrorLocked(const std::string& errorId, bool force) {
+    const fs::path path = fs::path(m_observationsPath) / "errors" / (errorId + ".json");
+    if (!fs::exists(path)) {
+        m_errors.erase(errorId);
+        return;
+    }
+    const std::string digest = DigestFiles({path});
+    auto it = m_errors.find(errorId);
+    if (!force && it != m_errors.end() && it->second.digest == digest) return;
+    m_errors[errorId] = Entry{digest, buildErrorEntry(errorId)};
+}
+
+nlohmann::json StrataManifestIndex::buildArticleEntry(const std::string& dirName) const {
+    const fs::path dir = fs::path(m_consumablesPath) / dirName;
+    auto artManifest = ReadJson(dir / "Manifest.json");
+    if (!artManifest) return nullptr;
+
+    nlohmann::json articleEntry;
+    std::string artifactId = dirName;
+    if (artManifest->contains("artifactId") && (*artManifest)["artifactId"].is_string()) {
+        artifactId = (*artManifest)["artifactId"].get<std::string>();
+    } else if (artManifest->contains("source") && (*artManifest)["source"].is_object()) {
+        const auto& src = (*artManifest)["source"];
+        if (src.contains("artifactId") && src["artifactId"].is_string()) {
+            artifactId = src["artifactId"].get<std::string>();
+        }
+    }
+
+    articleEntry["artifactId"] = artifactId;
+    articleEntry["relative_path"] = "./" + dirName + "/";
+    articleEntry["manifest_path"] = "./" + dirName + "/Manifest.json";
+
+    if (artManifest->contains("files")) articleEntry["files"] = (*artManifest)["files"];
+    if (artManifest->contains("file_index")) articleEntry["file_index"] = (*artManifest)["file_index"];
+    if (artManifest->contains("source") && (*artManifest)["source"].is_object()) {
+        articleEntry["source"] = (*artManifest)["source"];
+        if ((*artManifest)["source"].contains("filename")) {
+            articleEntry["filename"] = (*artManifest)["source"]["filename"];
+        }
+    }
+    if (artManifest->contains("filename")) articleEntry["filename"] = (*artManifest)["filename"];
+
+    // Enrich from SourceProfile.json (nested schema)
+    if (auto sourceProfile = ReadJson(dir / "SourceProfile.json")) {
+        if (!articleEntry.contains("source") && sourceProfile->contains("source") && (*sourceProfile)["source"].is_object()) {
+            articleEntry["source"] = (*sourceProfile)["source"];
+            if ((*sourceProfile)["source"].contains("filename")) {
+                articleEntry["filename"] = (*sourceProfile)["source"]["filename"];
+            }
+        }
+        if (sourceProfile->contains("sourceProfile") && (*sourceProfile)["sourceProfile"].is_object()) {
+            const auto& sp = (*sourceProfile)["sourceProfile"];
+            for (const char* key : {"studyType", "temporalScale", "ecosystemType", "evidenceType", "transferability"}) {
+                if (sp.contains(key)) articleEntry[key] = sp[key];
+            }
+        }
+    }
+
+    // Validation Status + Export Seal
+    const fs::path validationPath = dir / "EpistemicValidationReport.json";
+    if (fs::exists(validationPath)) {
+        if (auto validation = ReadJson(validationPath)) {
+            articleEntry["validationStatus"] = validation->contains("status") ? (*validation)["status"] : nlohmann::json("unknown");
+            articleEntry["validationReportPath"] = "./" + dirName + "/EpistemicValidationReport.json";
+        } else {
+            articleEntry["validationStatus"] = "error";
+        }
+    } else {
+        articleEntry["validationStatus"] = "pending";
+    }
+
+    if (auto seal = ReadJson(dir / "ExportSeal.json")) {
+        if (seal->contains("exportAllowed")) articleEntry["exportAllowed"] = (*seal)["exportAllowed"];
+        articleEntry["exportSealPath"] = "./" + dirName + "/ExportSeal.json";
+    }
+
+    // Observation bundle + validation paths (if present)
+    const fs::path rawBundlePath = fs::path(m_observationsPath) / (artifactId + ".json");
+    if (fs::exists(rawBundlePath)) {
+        articleEntry["rawBundlePath"] = rawBundlePath.string();
+    }
+    const fs::path obsValidationPath = fs::path(m_observationsPath) / "validation" / (artifactId + ".json");
+    if (fs::exists(obsValidationPath)) {
+        articleEntry["rawValidationPath"] = obsValidationPath.string();
+    }
+    return articleEntry;
+}
+
+nlohmann::json StrataManifestIndex::buildErrorEntry(const std::string& errorId) const {
+    const fs::path path = fs::path(m_observationsPath) / "errors" / (errorId + ".json");
+    nlohmann::json err;
+    err["artifactId"] = errorId;
+    err["artifactIdBase"] = ErrorBaseId(errorId);
+    err["stage"] = ErrorStage(errorId);
+    err["path"] = path.string();
+    if (auto payload = ReadJson(path)) {
+        if (payload->contains("createdAt")) err["createdAt"] = (*payload)["createdAt"];
+        if (payload->contains("payloadType")) err["payloadType"] = (*payload)["payloadType"];
+    } else {
+        err["payloadType"] = "unknown";
+    }
+    return err;
+}
+
+bool StrataManifestIndex::persistLocked() const {
+    nlohmann::json articles = nlohmann::json::object();
+    for (const auto& [key, entry] : m_articles) articles[key] = {{"digest", entry.digest}, {"entry", entry.data}};
+    nlohmann::json errors = nlohmann::json::object();
+    for (const auto& [key, entry] : m_errors) errors[key] = {{"digest", entry.digest}, {"entry", entry.data}};
+    const nlohmann::json index = {{"schemaVersion", kIndexSchemaVersion}, {"articles", articles}, {"errors", errors}};
+
+    const fs::path path = fs::path(m_consumablesPath) / kIndexFile;
+    if (!WriteAtomically(path, index.dump())) {
+        std::cerr << "[StrataManifestIndex] Failed to write " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool StrataManifestIndex::writeManifestLocked() const {
+    nlohmann::json manifest;
+    const std::string nowIso = NowIso();
+    manifest["project_ingestion_id"] = nowIso;
+    manifest["generatedAt"] = nowIso;
+    manifest["schema_version"] = domain::scientific::ScientificSchema::SchemaVersion;
+    manifest["schemaVersion"] = domain::scientific::ScientificSchema::SchemaVersion;
+
+    nlohmann::json layout;
+    layout["consumables_root"] = fs::path(m_consumablesPath).string();
+    layout["observations_root"] = fs::path(m_observationsPath).string();
+    layout["errors_root"] = (fs::path(m_observationsPath) / "errors").string();
+    layout["validation_root"] = (fs::path(m_observationsPath) / "validation").string();
+    layout["article_dir_pattern"] = "<artifactId>/";
+    layout["per_article_files"] = {
+        {"required", {
+            "SourceProfile.json",
+            "IWBundle.json",
+            "AllegedMechanisms.json",
+            "TemporalWindowReference.json",
+            "BaselineAssumptions.json",
+            "TrajectoryAnalogies.json",
+            "InterpretationLayers.json",
+            "Manifest.json"
+        }},
+        {"optional", {
+            "NarrativeObservation.json",
+            "DiscursiveContext.json",
+            "DiscursiveSystem.json",
+            "EpistemicValidationReport.json",
+            "ExportSeal.json"
+        }}
+    };
+    manifest["layout"] = layout;
+
+    std::map<std::string, nlohmann::json> errorsByArtifact;
+    nlohmann::json allErrors = nlohmann::json::array();
+    for (const auto& [id, entry] : m_errors) {
+        allErrors.push_back(entry.data);
+        auto& list = errorsByArtifact[ErrorBaseId(id)];
+        if (!list.is_array()) list = nlohmann::json::array();
+        list.push_back(entry.data);
+    }
+    manifest["errors"] = allErrors;
+
+    nlohmann::json articles = nlohmann::json::array();
+    for (const auto& [dirName, entry] : m_articles) {
+        nlohmann::json articleEntry = entry.data;
+        auto it = errorsByArtifact.find(articleEntry.value("artifactId", dirName));
+        if (it != errorsByArtifact.end()) articleEntry["errors"] = it->second;
+        articles.push_back(std::move(articleEntry));
+    }
+    manifest["total_articles"] = articles.size();
+    manifest["articles"] = articles;
+
+    const fs::path path = fs::path(m_consumablesPath) / kManifestFile;
+    if (!WriteAtomically(path, manifest.dump(4))) {
+        std::cerr << "[StrataManifestIndex] Failed to write " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+} // namespace ideawalker::application::scientific
@@ -0,0 +1,73 @@
+/**
+ * @file StrataManifestIndex.hpp
+ * @brief Incremental index behind the global STRATA manifest.
+ */
+
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+namespace ideawalker::application::scientific {
+
+/**
+ * @class StrataManifestIndex
+ * @brief Keeps `STRATA_Manifest.json` up to date without rescanning every article.
+ *
+ * The manifest entries of each article directory and error payload are cached in
+ * `<consumablesPath>/.strata_index.json`, each with a digest of the files it was built
+ * from (names, sizes, modification times). An ingestion run refreshes only the
+ * artifacts it touched and rewrites the manifest from the cache; an entry whose digest
+ * still matches is not parsed again. A missing or unreadable index triggers one full
+ * rebuild, which is also available explicitly as a maintenance command. Thread-safe.
+ */
+class StrataManifestIndex {
+public:
+    StrataManifestIndex(std::string consumablesPath, std::string observationsPath);
+
+    /**
+     * @brief Refreshes the given artifacts (article directory and error payloads, dropped
+     *        when gone from disk) and rewrites the manifest.
+     */
+    bool update(const std::vector<std::string>& artifactIds);
+
+    /**
+     * @brief Rescans every article directory and error payload, parsing all of them again,
+     *        and rewrites the index and the manifest.
+     * @return Number of articles in the rebuilt manifest.
+     */
+    size_t rebuild();
+
+    /** @brief Base artifact id of an error payload id (strips `_narrative_err`/`_discursive_err`). */
+    static std::string ErrorBaseId(const std::string& errorId);
+    /** @brief Pipeline stage inferred from an error payload id. */
+    static std::string ErrorStage(const std::string& errorId);
+
+private:
+    struct Entry {
+        std::string digest;
+        nlohmann::json data;
+    };
+
+    bool ensureLoadedLocked();
+    void rebuildLocked();
+    void refreshArticleLocked(const std::string& dirName, bool force);
+    void refreshErrorLocked(const std::string& errorId, bool force);
+    nlohmann::json buildArticleEntry(const std::string& dirName) const;
+    nlohmann::json buildErrorEntry(const std::string& errorId) const;
+    bool persistLocked() const;
+    bool writeManifestLocked() const;
+
+    std::string m_consumablesPath;
+    std::string m_observationsPath;
+    std::mutex m_mutex;
+    bool m_loaded = false;
+    std::map<std::string, Entry> m_articles; // article directory name -> manifest entry (sorted for stable output)
+    std::map<std::string, Entry> m_errors;   // error payload id -> manifest entry
+};
+
+} // namespace ideawalker::application::scientific
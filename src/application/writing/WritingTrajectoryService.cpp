@@ -44,82 +44,101 @@ std::string WritingTrajectoryService::createTrajectory(const std::string& purpos
     std::string id = generateId();
     WritingIntent intent(purpose, audience, coreClaim, constraints);
     
-    WritingTrajectory traj(id, intent);
-    m_repository->save(traj);
-    
-    // Eagerly update cache
-    if (m_cacheValid) {
-        m_trajectoryCache.push_back(traj);
-    } // If cache invalid, next read will load everything including this new one
-    
+    auto traj = std::make_shared<WritingTrajectory>(id, intent);
+    m_repository->save(*traj);
+    traj->markPersisted(traj->getUncommittedEvents().size());
+    recordSummary(*traj);
+
+    std::lock_guard<std::mutex> lock(m_liveMutex);
+    m_live[id] = std::move(traj);
     return id;
 }
 
-void WritingTrajectoryService::addSegment(const std::string& trajectoryId, 
-                                        const std::string& title, 
-                                        const std::string& initialContent, 
-                                        SourceTag source) {
-    auto trajOpt = m_repository->findById(trajectoryId);
-    if (!trajOpt) {
-        throw std::runtime_error("Trajectory not found: " + trajectoryId);
+std::shared_ptr<const WritingTrajectory> WritingTrajectoryService::loadLive(const std::string& id) const {
+    {
+        std::lock_guard<std::mutex> lock(m_liveMutex);
+        auto it = m_live.find(id);
+        if (it != m_live.end()) return it->second;
     }
 
-    // Since findById returns optional<WritingTrajectory> (by value due to optional), 
-    // we have a copy. We modify it and update.
-    WritingTrajectory traj = std::move(*trajOpt);
-    traj.addSegment(title, initialContent, source);
-    m_repository->update(traj);
-    
-    // Update cache if valid
-    if (m_cacheValid) {
-        auto it = std::find_if(m_trajectoryCache.begin(), m_trajectoryCache.end(), 
-            [&](const WritingTrajectory& t) { return t.getId() == trajectoryId; });
-        if (it != m_trajectoryCache.end()) {
-            *it = traj;
-        } else {
-             // Should not happen if cache was valid and contained it, but just in case
-             m_trajectoryCache.push_back(traj);
+    // Replay without the map lock, so cached trajectories stay readable meanwhile.
+    auto trajOpt = m_repository->findById(id);
+    if (!trajOpt) return nullptr;
+    auto traj = std::make_shared<const WritingTrajectory>(std::move(*trajOpt));
+
+    // A concurrent load or command may have got there first; theirs is at least as recent.
+    std::lock_guard<std::mutex> lock(m_liveMutex);
+    return m_live.emplace(id, std::move(traj)).first->second;
+}
+
+std::shared_ptr<std::mutex> WritingTrajectoryService::commandMutex(const std::string& id) {
+    std::lock_guard<std::mutex> lock(m_liveMutex);
+    auto& mutex = m_commandMutexes[id];
+    if (!mutex) mutex = std::make_shared<std::mutex>();
+    return mutex;
+}
+
+void WritingTrajectoryService::applyCommand(const std::string& trajectoryId,
+                                            const std::function<void(WritingTrajectory&)>& command) {
+    auto evict = [&]() {
+        std::lock_guard<std::mutex> lock(m_liveMutex);
+        m_live.erase(trajectoryId);
+    };
+
+    const auto serial = commandMutex(trajectoryId);
+    std::lock_guard<std::mutex> commandLock(*serial);
+    for (int attempt = 0;; ++attempt) {
+        auto current = loadLive(trajectoryId);
+        if (!current) {
+            throw std::runtime_error("Trajectory not found: " + trajectoryId);
+        }
+        // Readers keep the current version until the new one is stored.
+        auto next = std::make_shared<WritingTrajectory>(*current);
+        command(*next);
+        try {
+            m_repository->update(*next);
+        } catch (const ConcurrencyError& e) {
+            // Someone else appended: drop our stale copy and replay the command on fresh state.
+            evict();
+            if (attempt > 0) throw;
+            std::cerr << "[WritingTrajectoryService] " << e.what() << " (reloading)" << std::endl;
+            continue;
+        } catch (...) {
+            // Unknown partial append: the store is the source of truth.
+            evict();
+            throw;
         }
+        recordSummary(*next);
+        std::lock_guard<std::mutex> lock(m_liveMutex);
+        m_live[trajectoryId] = std::move(next);
+        return;
     }
 }
 
+void WritingTrajectoryService::addSegment(const std::string& trajectoryId, 
+                                        const std::string& title, 
+                                        const std::string& initialContent, 
+                                        SourceTag source) {
+    applyCommand(trajectoryId, [&](WritingTrajectory& traj) {
+        traj.addSegment(title, initialContent, source);
+    });
+}
+
 void WritingTrajectoryService::reviseSegment(const std::string& trajectoryId, 
                                            const std::string& segmentId, 
                                            const std::string& newContent, 
                                            RevisionOperation op, 
                                            const std::string& rationale,
                                            SourceTag source) {
-    auto trajOpt = m_repository->findById(trajectoryId);
-    if (!trajOpt) {
-        throw std::runtime_error("Trajectory not found: " + trajectoryId);
-    }
-
-    WritingTrajectory traj = std::move(*trajOpt);
-    traj.reviseSegment(segmentId, newContent, op, rationale, source);
-    m_repository->update(traj);
-    
-    if (m_cacheValid) {
-        auto it = std::find_if(m_trajectoryCache.begin(), m_trajectoryCache.end(), 
-            [&](const WritingTrajectory& t) { return t.getId() == trajectoryId; });
-        if (it != m_trajectoryCache.end()) *it = traj;
-    }
+    applyCommand(trajectoryId, [&](WritingTrajectory& traj) {
+        traj.reviseSegment(segmentId, newContent, op, rationale, source);
+    });
 }
 
 void WritingTrajectoryService::advanceStage(const std::string& trajectoryId, TrajectoryStage newStage) {
-    auto trajOpt = m_repository->findById(trajectoryId);
-    if (!trajOpt) {
-        throw std::runtime_error("Trajectory not found: " + trajectoryId);
-    }
-
-    WritingTrajectory traj = std::move(*trajOpt);
-    traj.advanceStage(newStage);
-    m_repository->update(traj);
-    
-    if (m_cacheValid) {
-        auto it = std::find_if(m_trajectoryCache.begin(), m_trajectoryCache.end(), 
-            [&](const WritingTrajectory& t) { return t.getId() == trajectoryId; });
-        if (it != m_trajectoryCache.end()) *it = traj;
-    }
+    applyCommand(trajectoryId, [&](WritingTrajectory& traj) {
+        traj.advanceStage(newStage);
+    });
 }
 
 void WritingTrajectoryService::addDefenseCard(const std::string& trajectoryId, 
@@ -127,62 +146,82 @@ void WritingTrajectoryService::addDefenseCard(const std::string& trajectoryId,
                                             const std::string& segmentId, 
                                             const std::string& prompt, 
                                             const std::vector<std::string>& points) {
-    auto trajOpt = m_repository->findById(trajectoryId);
-    if (!trajOpt) throw std::runtime_error("Trajectory not found");
-    
-    WritingTrajectory traj = std::move(*trajOpt);
-    traj.addDefenseCard(cardId, segmentId, prompt, points);
-    m_repository->update(traj);
-    
-    if (m_cacheValid) {
-        auto it = std::find_if(m_trajectoryCache.begin(), m_trajectoryCache.end(), 
-            [&](const WritingTrajectory& t) { return t.getId() == trajectoryId; });
-        if (it != m_trajectoryCache.end()) *it = traj;
-    }
+    applyCommand(trajectoryId, [&](WritingTrajectory& traj) {
+        traj.addDefenseCard(cardId, segmentId, prompt, points);
+    });
 }
 
 void WritingTrajectoryService::updateDefenseStatus(const std::string& trajectoryId, 
                                                  const std::string& cardId, 
                                                  DefenseStatus newStatus, 
                                                  const std::string& response) {
-    auto trajOpt = m_repository->findById(trajectoryId);
-    if (!trajOpt) throw std::runtime_error("Trajectory not found");
+    applyCommand(trajectoryId, [&](WritingTrajectory& traj) {
+        traj.updateDefenseStatus(cardId, newStatus, response);
+    });
+}
 
-    WritingTrajectory traj = std::move(*trajOpt);
-    traj.updateDefenseStatus(cardId, newStatus, response);
-    m_repository->update(traj);
-    
-    if (m_cacheValid) {
-        auto it = std::find_if(m_trajectoryCache.begin(), m_trajectoryCache.end(), 
-            [&](const WritingTrajectory& t) { return t.getId() == trajectoryId; });
-        if (it != m_trajectoryCache.end()) *it = traj;
+void WritingTrajectoryService::loadSummariesLocked() const {
+    if (m_summariesLoaded) return;
+    m_summaries.clear();
+    for (auto& summary : m_repository->listSummaries()) {
+        m_summaries[summary.id] = std::move(summary);
     }
+    m_summariesLoaded = true;
+}
+
+void WritingTrajectoryService::recordSummary(const WritingTrajectory& trajectory) {
+    TrajectorySummary summary;
+    summary.id = trajectory.getId();
+    summary.intent = trajectory.getIntent();
+    summary.stage = trajectory.getStage();
+    summary.segmentCount = trajectory.getSegments().size();
+    summary.revisionCount = trajectory.getHistory().size();
+    summary.eventCount = trajectory.getPersistedVersion();
+
+    std::lock_guard<std::mutex> lock(m_summaryMutex);
+    // Not loaded yet: the first listing reads the repository, which already has this write.
+    if (m_summariesLoaded) m_summaries[summary.id] = std::move(summary);
 }
 
 size_t WritingTrajectoryService::getTrajectoryCount() const {
-    if (!m_cacheValid) updateCache();
-    return m_trajectoryCache.size();
+    std::lock_guard<std::mutex> lock(m_summaryMutex);
+    loadSummariesLocked();
+    return m_summaries.size();
+}
+
+std::vector<TrajectorySummary> WritingTrajectoryService::listTrajectories() const {
+    std::lock_guard<std::mutex> lock(m_summaryMutex);
+    loadSummariesLocked();
+    std::vector<TrajectorySummary> result;
+    result.reserve(m_summaries.size());
+    for (const auto& [id, summary] : m_summaries) result.push_back(summary);
+    return result;
 }
 
 std::vector<WritingTrajectory> WritingTrajectoryService::getAllTrajectories() const {
-    if (!m_cacheValid) updateCache();
-    return m_trajectoryCache;
+    std::vector<WritingTrajectory> trajectories;
+    for (const auto& summary : listTrajectories()) {
+        if (auto traj = loadLive(summary.id)) trajectories.push_back(*traj);
+    }
+    return trajectories;
 }
 
 void WritingTrajectoryService::refreshCache() {
-    m_cacheValid = false;
-    updateCache();
+    {
+        std::lock_guard<std::mutex> lock(m_liveMutex);
+        m_live.clear();
+    }
+    std::lock_guard<std::mutex> lock(m_summaryMutex);
+    m_summariesLoaded = false;
 }
 
-void WritingTrajectoryService::updateCache() const {
-    m_trajectoryCache = m_repository->findAll();
-    m_cacheValid = true;
+std::shared_ptr<const WritingTrajectory> WritingTrajectoryService::getLiveTrajectory(const std::string& id) const {
+    return loadLive(id);
 }
 
 std::unique_ptr<WritingTrajectory> WritingTrajectoryService::getTrajectory(const std::string& id) const {
-    auto trajOpt = m_repository->findById(id);
-    if (trajOpt) {
-        return std::make_unique<WritingTrajectory>(std::move(*trajOpt));
+    if (auto traj = loadLive(id)) {
+        return std::make_unique<WritingTrajectory>(*traj);
     }
     return nullptr;
 }
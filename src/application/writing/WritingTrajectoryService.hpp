@@ -5,8 +5,12 @@
 
 #pragma once
 
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include "domain/writing/WritingTrajectory.hpp"
 #include "domain/writing/repositories/IWritingTrajectoryRepository.hpp"
@@ -59,17 +63,39 @@ public:
     std::vector<WritingTrajectory> getAllTrajectories() const;
     std::unique_ptr<WritingTrajectory> getTrajectory(const std::string& id) const;
 
+    // Live aggregate from the identity map (loaded once, no copy). Commands never mutate it: they
+    // swap in a new version, so a held pointer stays consistent; fetch again to see later commands.
+    std::shared_ptr<const WritingTrajectory> getLiveTrajectory(const std::string& id) const;
 
-    void refreshCache(); // Force reload from disk
+    // Listing entries, cached from the repository's summary index and kept current by commands
+    std::vector<TrajectorySummary> listTrajectories() const;
+
+    void refreshCache(); // Force reload from disk (live aggregates and summaries)
 
 private:
     std::shared_ptr<IWritingTrajectoryRepository> m_repository;
     
-    // Cache
-    mutable std::vector<WritingTrajectory> m_trajectoryCache;
-    mutable bool m_cacheValid = false;
-    
-    void updateCache() const;
+    // Identity map: one immutable aggregate per id, replaced (copy-on-write) by each command
+    mutable std::mutex m_liveMutex;
+    mutable std::unordered_map<std::string, std::shared_ptr<const WritingTrajectory>> m_live;
+    // One command at a time per trajectory (guarded by m_liveMutex; entries are never dropped)
+    std::unordered_map<std::string, std::shared_ptr<std::mutex>> m_commandMutexes;
+
+    // Summaries served to listings; the repository (directory scan + stat per log) is only
+    // consulted on first use and after refreshCache()
+    mutable std::mutex m_summaryMutex;
+    mutable std::map<std::string, TrajectorySummary> m_summaries;
+    mutable bool m_summariesLoaded = false;
+
+    std::shared_ptr<const WritingTrajectory> loadLive(const std::string& id) const;
+    std::shared_ptr<std::mutex> commandMutex(const std::string& id);
+    void loadSummariesLocked() const;
+    void recordSummary(const WritingTrajectory& trajectory);
+
+    // Runs a command on a copy of the live aggregate, appends its events and then swaps the copy
+    // in. On a version conflict the aggregate is reloaded and the command retried once; a failed
+    // append evicts it from the map, while a rejected command leaves it untouched.
+    void applyCommand(const std::string& trajectoryId, const std::function<void(WritingTrajectory&)>& command);
 };
 
 } // namespace ideawalker::application::writing
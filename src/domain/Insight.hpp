@@ -7,6 +7,7 @@
 #include <string>
 #include <vector>
 #include <chrono>
+#include <cstdint>
 #include <sstream>
 #include "Actionable.hpp"
 #include "CognitiveModel.hpp"
@@ -28,6 +29,8 @@ public:
         std::string title; ///< Human-readable title.
         std::string date; ///< Creation/modification date.
         std::vector<std::string> tags; ///< Categorization tags.
+        std::vector<std::string> aliases; ///< Alternative names (front matter "aliases:").
+        std::uint64_t revision = 0; ///< Repository stamp (mtime, size, head/tail hash); 0 when the source has none.
     };
 
     /**
@@ -182,20 +185,26 @@ public:
      * @brief Parses wikilinks [[Target]] from the content.
      */
     void parseReferencesFromContent() {
-        m_references.clear();
+        m_references = extractReferences(m_content);
+    }
+
+    /**
+     * @brief Returns the wikilink targets [[Target]] of a text without touching any insight.
+     * @param content Markdown text.
+     * @return Raw targets in order of appearance (may repeat).
+     */
+    static std::vector<std::string> extractReferences(const std::string& content) {
+        std::vector<std::string> references;
         std::string::size_type pos = 0;
-        while ((pos = m_content.find("[[", pos)) != std::string::npos) {
-            std::string::size_type end = m_content.find("]]", pos + 2);
-            if (end != std::string::npos) {
-                std::string ref = m_content.substr(pos + 2, end - (pos + 2));
-                if (!ref.empty()) {
-                    m_references.push_back(ref);
-                }
-                pos = end + 2;
-            } else {
-                break;
+        while ((pos = content.find("[[", pos)) != std::string::npos) {
+            std::string::size_type end = content.find("]]", pos + 2);
+            if (end == std::string::npos) break;
+            if (end > pos + 2) {
+                references.push_back(content.substr(pos + 2, end - (pos + 2)));
             }
+            pos = end + 2;
         }
+        return references;
     }
 
     /** @brief Returns list of parsed wikilinks. */
@@ -0,0 +1,175 @@
+/**
+ * @file MentionMatcher.cpp
+ * @brief Implementation of MentionMatcher (Aho–Corasick automaton).
+ */
+
+#include "domain/MentionMatcher.hpp"
+#include <algorithm>
+#include <unordered_set>
+
+namespace ideawalker::domain {
+
+bool MentionMatcher::setPatterns(const std::string& key, std::vector<std::string> patterns, int payload) {
+    patterns.erase(std::remove(patterns.begin(), patterns.end(), std::string()), patterns.end());
+    if (patterns.empty()) return removePatterns(key);
+    auto it = m_dictionary.find(key);
+    if (it != m_dictionary.end() && it->second.payload == payload && it->second.patterns == patterns) return false;
+    m_dictionary[key] = Entry{payload, std::move(patterns)};
+    m_dirty = true;
+    return true;
+}
+
+bool MentionMatcher::removePatterns(const std::string& key) {
+    if (m_dictionary.erase(key) == 0) return false;
+    m_dirty = true;
+    return true;
+}
+
+bool MentionMatcher::compile() {
+    if (!m_dirty) return false;
+    std::vector<std::pair<std::string, int>> patterns;
+    for (const auto& [key, entry] : m_dictionary) {
+        for (const auto& pattern : entry.patterns) patterns.emplace_back(pattern, entry.payload);
+    }
+    auto dictionary = std::move(m_dictionary);
+    build(patterns);
+    m_dictionary = std::move(dictionary);
+    return true;
+}
+
+void MentionMatcher::build(const std::vector<std::pair<std::string, int>>& patterns) {
+    m_dictionary.clear();
+    m_dirty = false;
+
+    // 1. Plain trie with per-node edge lists.
+    std::vector<std::vector<std::pair<unsigned char, std::int32_t>>> edges(1);
+    std::vector<std::vector<int>> outputs(1);
+    m_patternCount = 0;
+
+    for (const auto& [pattern, payload] : patterns) {
+        if (pattern.empty()) continue;
+        std::int32_t state = 0;
+        for (unsigned char byte : pattern) {
+            auto& out = edges[state];
+            auto it = std::find_if(out.begin(), out.end(), [byte](const auto& e) { return e.first == byte; });
+            if (it != out.end()) {
+                state = it->second;
+                continue;
+            }
+            const auto child = static_cast<std::int32_t>(edges.size());
+            out.emplace_back(byte, child);
+            edges.emplace_back();
+            outputs.emplace_back();
+            state = child;
+        }
+        outputs[state].push_back(payload);
+        ++m_patternCount;
+    }
+
+    // 2. Flatten into sorted edge arrays so lookups are a binary search.
+    m_states.assign(edges.size(), State{});
+    m_edgeBytes.clear();
+    m_edgeTargets.clear();
+    m_outputs.clear();
+    for (std::size_t s = 0; s < edges.size(); ++s) {
+        auto& out = edges[s];
+        std::sort(out.begin(), out.end());
+        m_states[s].edgeBegin = static_cast<std::uint32_t>(m_edgeBytes.size());
+        m_states[s].edgeCount = static_cast<std::uint32_t>(out.size());
+        for (const auto& [byte, target] : out) {
+            m_edgeBytes.push_back(byte);
+            m_edgeTargets.push_back(target);
+        }
+        m_states[s].outBegin = static_cast<std::uint32_t>(m_outputs.size());
+        m_states[s].outCount = static_cast<std::uint32_t>(outputs[s].size());
+        m_outputs.insert(m_outputs.end(), outputs[s].begin(), outputs[s].end());
+    }
+
+    m_startsPattern.fill(false);
+    for (std::uint32_t e = 0; e < m_states[0].edgeCount; ++e) {
+        m_startsPattern[m_edgeBytes[m_states[0].edgeBegin + e]] = true;
+    }
+
+    // 3. Failure and dictionary links, breadth first.
+    std::vector<std::int32_t> queue;
+    queue.reserve(m_states.size());
+    for (std::uint32_t e = 0; e < m_states[0].edgeCount; ++e) {
+        queue.push_back(m_edgeTargets[m_states[0].edgeBegin + e]);
+    }
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+        const std::int32_t state = queue[head];
+        const State& current = m_states[state];
+        for (std::uint32_t e = 0; e < current.edgeCount; ++e) {
+            const unsigned char byte = m_edgeBytes[current.edgeBegin + e];
+            const std::int32_t child = m_edgeTargets[current.edgeBegin + e];
+            State& target = m_states[child];
+            target.fail = next(current.fail, byte);
+            const State& fail = m_states[target.fail];
+            target.dictLink = fail.outCount > 0 ? target.fail : fail.dictLink;
+            queue.push_back(child);
+        }
+    }
+}
+
+std::int32_t MentionMatcher::next(std::int32_t state, unsigned char byte) const {
+    for (;;) {
+        const State& s = m_states[state];
+        const auto begin = m_edgeBytes.begin() + s.edgeBegin;
+        const auto end = begin + s.edgeCount;
+        const auto it = std::lower_bound(begin, end, byte);
+        if (it != end && *it == byte) {
+            return m_edgeTargets[static_cast<std::size_t>(it - m_edgeBytes.begin())];
+        }
+        if (state == 0) return 0;
+        state = s.fail;
+    }
+}
+
+template <typename OnMatch>
+void MentionMatcher::scan(std::string_view text, OnMatch&& onMatch) const {
+    if (m_patternCount == 0) return;
+    std::int32_t state = 0;
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        if (state == 0) {
+            // At the root only a pattern's first byte matters: skip everything else cheaply.
+            while (i < text.size() && !m_startsPattern[static_cast<unsigned char>(text[i])]) ++i;
+            if (i == text.size()) break;
+        }
+        state = next(state, static_cast<unsigned char>(text[i]));
+        for (std::int32_t hit = m_states[state].outCount > 0 ? state : m_states[state].dictLink;
+             hit >= 0; hit = m_states[hit].dictLink) {
+            const State& s = m_states[hit];
+            for (std::uint32_t o = 0; o < s.outCount; ++o) {
+                if (!onMatch(m_outputs[s.outBegin + o], i + 1)) return;
+            }
+        }
+    }
+}
+
+void MentionMatcher::forEachMatch(std::string_view text, const std::function<void(int, std::size_t)>& onMatch) const {
+    scan(text, [&onMatch](int payload, std::size_t end) {
+        onMatch(payload, end);
+        return true;
+    });
+}
+
+std::vector<int> MentionMatcher::findPayloads(std::string_view text) const {
+    std::vector<int> found;
+    std::unordered_set<int> seen;
+    scan(text, [&](int payload, std::size_t) {
+        if (seen.insert(payload).second) found.push_back(payload);
+        return true;
+    });
+    return found;
+}
+
+bool MentionMatcher::containsAny(std::string_view text) const {
+    bool found = false;
+    scan(text, [&found](int, std::size_t) {
+        found = true;
+        return false;
+    });
+    return found;
+}
+
+} // namespace ideawalker::domain
@@ -0,0 +1,95 @@
+/**
+ * @file MentionMatcher.hpp
+ * @brief Multi-pattern (Aho–Corasick) matcher shared by graph title/alias mentions, coherence
+ *        checks and the epistemic validator's term rules.
+ *
+ * Backlinks do not use it: [[wikilinks]] are explicit targets, so BacklinkIndex keeps them in a
+ * reverse index keyed by target instead of scanning note text for every name.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace ideawalker::domain {
+
+/**
+ * @class MentionMatcher
+ * @brief Finds every occurrence of a set of patterns in one linear pass over the text.
+ *
+ * Each pattern carries an integer payload (e.g. a note index); several patterns may
+ * share a payload and the same pattern may be registered with several payloads.
+ * Matching is byte-wise and case-sensitive.
+ *
+ * Patterns are either given all at once (build) or kept in a keyed dictionary
+ * (setPatterns/removePatterns, e.g. one key per note with its title and aliases)
+ * that is edited incrementally and recompiled by compile() once per batch of edits.
+ */
+class MentionMatcher {
+public:
+    /** @brief Replaces the pattern set (and clears the dictionary). Empty patterns are ignored. O(total pattern length). */
+    void build(const std::vector<std::pair<std::string, int>>& patterns);
+
+    /**
+     * @brief Sets the patterns registered under a key (replacing previous ones).
+     * @return True if the dictionary changed (compile() is then needed).
+     */
+    bool setPatterns(const std::string& key, std::vector<std::string> patterns, int payload);
+    /** @brief Drops a key from the dictionary. Returns true if it was present. */
+    bool removePatterns(const std::string& key);
+    /** @brief Recompiles the automaton from the dictionary if it changed. Returns true if it did. */
+    bool compile();
+    bool isDirty() const { return m_dirty; }
+
+    bool empty() const { return m_patternCount == 0; }
+    std::size_t patternCount() const { return m_patternCount; }
+
+    /**
+     * @brief Reports every match as (payload, end offset one past the last byte).
+     * Overlapping matches are all reported. O(text length + matches).
+     */
+    void forEachMatch(std::string_view text, const std::function<void(int payload, std::size_t end)>& onMatch) const;
+
+    /** @brief Distinct payloads found in the text, in order of first occurrence. */
+    std::vector<int> findPayloads(std::string_view text) const;
+
+    /** @brief True if any pattern occurs in the text (stops at the first match). */
+    bool containsAny(std::string_view text) const;
+
+private:
+    struct State {
+        std::int32_t fail = 0;        // Longest proper suffix that is also a trie prefix
+        std::int32_t dictLink = -1;   // Nearest suffix state that ends a pattern
+        std::uint32_t edgeBegin = 0, edgeCount = 0; // Sorted outgoing edges
+        std::uint32_t outBegin = 0, outCount = 0;   // Payloads of patterns ending here
+    };
+
+    struct Entry {
+        int payload = 0;
+        std::vector<std::string> patterns;
+    };
+
+    std::int32_t next(std::int32_t state, unsigned char byte) const;
+    /** Walks the text; onMatch(payload, end) returns false to stop early. */
+    template <typename OnMatch>
+    void scan(std::string_view text, OnMatch&& onMatch) const;
+
+    std::map<std::string, Entry> m_dictionary;
+    bool m_dirty = false;
+
+    std::vector<State> m_states;
+    std::array<bool, 256> m_startsPattern{}; ///< Bytes that leave the root state (skip scan).
+    std::vector<unsigned char> m_edgeBytes;
+    std::vector<std::int32_t> m_edgeTargets;
+    std::vector<int> m_outputs;
+    std::size_t m_patternCount = 0;
+};
+
+} // namespace ideawalker::domain
@@ -55,11 +55,11 @@ public:
     virtual std::vector<Insight> fetchHistory() = 0;
 
     /**
-     * @brief Identifies all files that reference the specified file.
-     * @param filename Target file.
-     * @return List of filenames.
+     * @brief Fetches a single insight, parsed exactly like fetchHistory() does.
+     * @param filename Note file (e.g. "Nota_ID.md").
+     * @return The insight, or nullopt if the note does not exist.
      */
-    virtual std::vector<std::string> getBacklinks(const std::string& filename) = 0;
+    virtual std::optional<Insight> fetchInsight(const std::string& filename) = 0;
 
     /**
      * @brief Retrieves activity data for visualization.
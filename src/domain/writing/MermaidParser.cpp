@@ -1,9 +1,10 @@
 #include "domain/writing/MermaidParser.hpp"
 #include <sstream>
 #include <unordered_map>
-#include <unordered_set>
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <vector>
 
 namespace ideawalker::domain::writing {
 
@@ -58,6 +59,148 @@ namespace {
         Trim(idOut);
         Trim(labelOut);
     }
+
+    constexpr float SIBLING_GAP = 60.0f;
+    constexpr float FOREST_GAP = 120.0f;
+
+    // The three passes below walk the graph depth-first with an explicit stack (a deep
+    // mind map used to recurse once per level). Children are skipped if they were
+    // visited when their turn comes, as in the recursive version, so DAGs and cycles
+    // lay out exactly as before. Nodes are addressed by index, not by id.
+    void LayoutGraph(PreviewGraphState& graph) {
+        const std::size_t n = graph.nodes.size();
+        graph.childrenNodes.clear();
+        graph.roots.clear();
+        graph.nodeById.clear();
+        graph.nodeById.reserve(n);
+
+        std::vector<std::vector<int>> kids(n);
+        std::vector<int> inDegree(n, 0);
+        for (size_t i = 0; i < n; ++i) graph.nodeById[graph.nodes[i].id] = static_cast<int>(i);
+        for (const auto& link : graph.links) {
+            const int from = graph.nodeById.at(link.startNode);
+            const int to = graph.nodeById.at(link.endNode);
+            graph.childrenNodes[link.startNode].push_back(link.endNode);
+            kids[from].push_back(to);
+            inDegree[to]++;
+        }
+        std::vector<int> roots;
+        for (size_t i = 0; i < n; ++i) {
+            if (inDegree[i] == 0) roots.push_back(static_cast<int>(i));
+        }
+        if (roots.empty() && n > 0) roots.push_back(0);
+        for (int r : roots) graph.roots.push_back(graph.nodes[r].id);
+
+        std::vector<std::uint8_t> visited;
+
+        // Heuristics: deep trees read better top-down, wide ones left-right.
+        {
+            struct Frame { int u; std::size_t next; int depth; };
+            std::vector<Frame> stack;
+            std::vector<int> countPerDepth;
+            int maxDepth = 0;
+            int maxBreadth = 0;
+            visited.assign(n, 0);
+            auto visit = [&](int u, int d) {
+                visited[u] = 1;
+                if (countPerDepth.size() <= static_cast<std::size_t>(d)) countPerDepth.resize(d + 1, 0);
+                countPerDepth[d]++;
+                maxDepth = std::max(maxDepth, d);
+                maxBreadth = std::max(maxBreadth, countPerDepth[d]);
+                stack.push_back({u, 0, d});
+            };
+            for (int r : roots) {
+                visit(r, 0);
+                while (!stack.empty()) {
+                    Frame& top = stack.back();
+                    if (top.next == kids[top.u].size()) { stack.pop_back(); continue; }
+                    const int v = kids[top.u][top.next++];
+                    if (!visited[v]) visit(v, top.depth + 1);
+                }
+            }
+            graph.orientation = (maxDepth > maxBreadth) ? LayoutOrientation::TopDown : LayoutOrientation::LeftRight;
+        }
+        const bool topDown = graph.orientation == LayoutOrientation::TopDown;
+
+        // Breadth of every subtree (post-order).
+        std::vector<float> subtreeBreadth(n, 0.0f);
+        {
+            struct Frame { int u; std::size_t next; float childrenB; int childCount; };
+            std::vector<Frame> stack;
+            visited.assign(n, 0);
+            auto visit = [&](int u) {
+                visited[u] = 1;
+                stack.push_back({u, 0, 0.0f, 0});
+            };
+            for (int r : roots) {
+                visit(r);
+                while (!stack.empty()) {
+                    Frame& top = stack.back();
+                    if (top.next < kids[top.u].size()) {
+                        const int v = kids[top.u][top.next++];
+                        if (!visited[v]) {
+                            if (top.childCount > 0) top.childrenB += SIBLING_GAP;
+                            visit(v);
+                        }
+                        continue;
+                    }
+                    const GraphNode& node = graph.nodes[top.u];
+                    const float breadth = std::max(topDown ? node.w : node.h, top.childrenB);
+                    subtreeBreadth[top.u] = breadth;
+                    stack.pop_back();
+                    if (!stack.empty()) {
+                        stack.back().childrenB += breadth;
+                        stack.back().childCount++;
+                    }
+                }
+            }
+        }
+
+        // Placement (pre-order): children are centred on their parent's span.
+        {
+            struct Frame { int u; std::size_t next; float childPrimary; float cursor; };
+            std::vector<Frame> stack;
+            visited.assign(n, 0);
+            auto visit = [&](int u, float primary, float secondaryStart) {
+                visited[u] = 1;
+                GraphNode& node = graph.nodes[u];
+                const float totalB = subtreeBreadth[u];
+                float childPrimary;
+                if (!topDown) {
+                    node.x = primary;
+                    node.y = (secondaryStart + totalB * 0.5f) - (node.h * 0.5f);
+                    childPrimary = primary + node.w + std::clamp(node.w * 0.6f, 80.0f, 200.0f);
+                } else {
+                    node.y = primary;
+                    node.x = (secondaryStart + totalB * 0.5f) - (node.w * 0.5f);
+                    childPrimary = primary + node.h + std::clamp(node.h * 0.6f, 60.0f, 160.0f);
+                }
+                float childrenTotalB = 0;
+                int childCount = 0;
+                for (int v : kids[u]) {
+                    if (visited[v]) continue;
+                    if (childCount > 0) childrenTotalB += SIBLING_GAP;
+                    childrenTotalB += subtreeBreadth[v];
+                    childCount++;
+                }
+                stack.push_back({u, 0, childPrimary, secondaryStart + (totalB - childrenTotalB) * 0.5f});
+            };
+            float secondaryCursor = 50.0f;
+            for (int r : roots) {
+                visit(r, 50.0f, secondaryCursor);
+                while (!stack.empty()) {
+                    Frame& top = stack.back();
+                    if (top.next == kids[top.u].size()) { stack.pop_back(); continue; }
+                    const int v = kids[top.u][top.next++];
+                    if (visited[v]) continue;
+                    const float at = top.cursor;
+                    top.cursor += subtreeBreadth[v] + SIBLING_GAP;
+                    visit(v, top.childPrimary, at);
+                }
+                secondaryCursor += subtreeBreadth[r] + FOREST_GAP;
+            }
+        }
+    }
 }
 
 bool MermaidParser::Parse(const std::string& content, PreviewGraphState& graph, SizeCalculator calculator, int baseId) {
@@ -83,6 +226,7 @@ bool MermaidParser::Parse(const std::string& content, PreviewGraphState& graph,
             node.id = nextId++;
             node.title = label.empty() ? name : label;
             node.x = 0; node.y = 0;
+            node.w = node.h = 0;
             node.vx = node.vy = 0;
             node.type = NodeType::INSIGHT; 
             node.shape = shape;
@@ -156,119 +300,7 @@ bool MermaidParser::Parse(const std::string& content, PreviewGraphState& graph,
         }
     }
 
-    // --- Layout Logic ---
-    graph.childrenNodes.clear();
-    graph.roots.clear();
-    graph.nodeById.clear();
-    std::unordered_map<int, int> inDegree;
-
-    for (size_t i = 0; i < graph.nodes.size(); ++i) {
-        graph.nodeById[graph.nodes[i].id] = static_cast<int>(i);
-        inDegree[graph.nodes[i].id] = 0;
-    }
-    for (const auto& link : graph.links) {
-        graph.childrenNodes[link.startNode].push_back(link.endNode);
-        inDegree[link.endNode]++;
-    }
-    for (const auto& node : graph.nodes) {
-        if (inDegree[node.id] == 0) graph.roots.push_back(node.id);
-    }
-    if (graph.roots.empty() && !graph.nodes.empty()) graph.roots.push_back(graph.nodes[0].id);
-
-    // Heuristics
-    std::unordered_map<int, int> countPerDepth;
-    int maxDepth = 0;
-    int maxBreadth = 0;
-    std::function<void(int, int, std::unordered_set<int>&)> WalkTopology = [&](int u, int d, std::unordered_set<int>& visited) {
-        visited.insert(u);
-        countPerDepth[d]++;
-        maxDepth = std::max(maxDepth, d);
-        maxBreadth = std::max(maxBreadth, countPerDepth[d]);
-        for (int v : graph.childrenNodes[u]) if (visited.find(v) == visited.end()) WalkTopology(v, d + 1, visited);
-    };
-
-    std::unordered_set<int> visitedTopology;
-    for (int r : graph.roots) WalkTopology(r, 0, visitedTopology);
-    graph.orientation = (maxDepth > maxBreadth) ? LayoutOrientation::TopDown : LayoutOrientation::LeftRight;
-
-    // Breadth Calculation
-    std::unordered_map<int, float> subtreeBreadth;
-    const float SIBLING_GAP = 60.0f; 
-    std::function<float(int, std::unordered_set<int>&)> CalcBreadth = [&](int u, std::unordered_set<int>& visited) -> float {
-        visited.insert(u);
-        float childrenB = 0;
-        int childCount = 0;
-        float myB = (graph.orientation == LayoutOrientation::TopDown) ? graph.nodes[graph.nodeById[u]].w : graph.nodes[graph.nodeById[u]].h;
-
-        for (int v : graph.childrenNodes[u]) {
-            if (visited.find(v) == visited.end()) {
-                if (childCount > 0) childrenB += SIBLING_GAP;
-                childrenB += CalcBreadth(v, visited);
-                childCount++;
-            }
-        }
-        subtreeBreadth[u] = std::max(myB, childrenB);
-        return subtreeBreadth[u];
-    };
-
-    std::unordered_set<int> visitedBreadth;
-    for(int root : graph.roots) CalcBreadth(root, visitedBreadth);
-
-    // Recursive Layout
-    std::function<void(int, float, float, std::unordered_set<int>&)> LayoutRecursive = 
-        [&](int u, float primary, float secondaryStart, std::unordered_set<int>& visited) {
-        visited.insert(u);
-        GraphNode& uNode = graph.nodes[graph.nodeById[u]];
-        float totalB = subtreeBreadth[u];
-
-        if (graph.orientation == LayoutOrientation::LeftRight) {
-            uNode.x = primary;
-            uNode.y = (secondaryStart + totalB * 0.5f) - (uNode.h * 0.5f);
-            float hGap = std::clamp(uNode.w * 0.6f, 80.0f, 200.0f);
-            float childX = primary + uNode.w + hGap;
-            float childrenTotalB = 0; int childCount = 0;
-            for(int v : graph.childrenNodes[u]) {
-                if(visited.find(v) == visited.end()) {
-                    if(childCount > 0) childrenTotalB += SIBLING_GAP;
-                    childrenTotalB += subtreeBreadth[v]; childCount++;
-                }
-            }
-            float childY = secondaryStart + (totalB - childrenTotalB) * 0.5f;
-            for (int v : graph.childrenNodes[u]) {
-                if (visited.find(v) == visited.end()) {
-                    LayoutRecursive(v, childX, childY, visited);
-                    childY += subtreeBreadth[v] + SIBLING_GAP;
-                }
-            }
-        } else { // TopDown
-            uNode.y = primary;
-            uNode.x = (secondaryStart + totalB * 0.5f) - (uNode.w * 0.5f);
-            float vGap = std::clamp(uNode.h * 0.6f, 60.0f, 160.0f);
-            float childY = primary + uNode.h + vGap;
-            float childrenTotalB = 0; int childCount = 0;
-            for(int v : graph.childrenNodes[u]) {
-                if(visited.find(v) == visited.end()) {
-                    if(childCount > 0) childrenTotalB += SIBLING_GAP;
-                    childrenTotalB += subtreeBreadth[v]; childCount++;
-                }
-            }
-            float childX = secondaryStart + (totalB - childrenTotalB) * 0.5f;
-            for (int v : graph.childrenNodes[u]) {
-                if (visited.find(v) == visited.end()) {
-                    LayoutRecursive(v, childY, childX, visited);
-                    childX += subtreeBreadth[v] + SIBLING_GAP;
-                }
-            }
-        }
-    };
-
-    std::unordered_set<int> visitedLayout;
-    float FOREST_GAP = 120.0f;
-    float secondaryCursor = 50.0f;
-    for (int root : graph.roots) {
-         LayoutRecursive(root, 50.0f, secondaryCursor, visitedLayout);
-         secondaryCursor += subtreeBreadth[root] + FOREST_GAP; 
-    }
+    LayoutGraph(graph);
 
     return true;
 }
@@ -40,6 +40,9 @@ private:
     // Uncommitted events (new changes)
     std::vector<WritingDomainEvent> uncommittedEvents;
 
+    // Events already in the store (optimistic concurrency token)
+    std::size_t persistedVersion = 0;
+
 public:
     WritingTrajectory(std::string id, WritingIntent i)
         : trajectoryId(std::move(id)), intent(std::move(i)) {
@@ -63,6 +66,14 @@ public:
         uncommittedEvents.clear();
     }
 
+    std::size_t getPersistedVersion() const { return persistedVersion; }
+
+    // Called by the repository once the store holds `version` events for this aggregate
+    void markPersisted(std::size_t version) {
+        persistedVersion = version;
+        uncommittedEvents.clear();
+    }
+
     // --- Accessors ---
     const std::string& getId() const { return trajectoryId; }
     const WritingIntent& getIntent() const { return intent; }
@@ -202,6 +213,23 @@ public:
         return t;
     }
     
+    // Factory method to restore an aggregate from a persisted snapshot.
+    // The snapshot must reflect a state reachable by replaying events; no event is recorded.
+    static WritingTrajectory restore(std::string id,
+                                     WritingIntent restoredIntent,
+                                     TrajectoryStage restoredStage,
+                                     std::map<std::string, DraftSegment> restoredSegments,
+                                     std::vector<RevisionDecision> restoredHistory,
+                                     std::vector<DefenseCard> restoredCards) {
+        WritingTrajectory t = createEmpty(std::move(id));
+        t.intent = std::move(restoredIntent);
+        t.stage = restoredStage;
+        t.segments = std::move(restoredSegments);
+        t.revisionHistory = std::move(restoredHistory);
+        t.defenseCards = std::move(restoredCards);
+        return t;
+    }
+    
     // Helper to apply any event variant
     void applyEvent(const WritingDomainEvent& event) {
         std::visit([this](auto&& arg) {
@@ -8,10 +8,27 @@
 #include <vector>
 #include <optional>
 #include <string>
+#include <stdexcept>
 #include "../WritingTrajectory.hpp"
 
 namespace ideawalker::domain::writing {
 
+// Raised when the stored stream moved past the version the aggregate was loaded at
+class ConcurrencyError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+// Lightweight listing entry, served without replaying the trajectory
+struct TrajectorySummary {
+    std::string id;
+    WritingIntent intent;
+    TrajectoryStage stage = TrajectoryStage::Intent;
+    std::size_t segmentCount = 0;
+    std::size_t revisionCount = 0;
+    std::size_t eventCount = 0;
+};
+
 class IWritingTrajectoryRepository {
 public:
     virtual ~IWritingTrajectoryRepository() = default;
@@ -27,7 +44,11 @@ public:
 
     // Update existing (append events)
     // Note: In strict ES, we might just append events. Here passing the Aggregate is convenient.
+    // Throws ConcurrencyError if the stream no longer matches trajectory.getPersistedVersion().
     virtual void update(WritingTrajectory& trajectory) = 0;
+
+    // Summaries of every stored trajectory (from an index, no full replay)
+    virtual std::vector<TrajectorySummary> listSummaries() = 0;
 };
 
 } // namespace ideawalker::domain::writing
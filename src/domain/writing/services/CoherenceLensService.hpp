@@ -9,6 +9,7 @@
 #include <string>
 #include <sstream>
 #include "../WritingTrajectory.hpp"
+#include "domain/MentionMatcher.hpp"
 
 namespace ideawalker::domain::writing {
 
@@ -32,21 +33,24 @@ public:
         // Check 2: Segment Alignment (Naive keyword check for MVP)
         // In a real implementation, this would use the AI Adapter to compute semantic similarity.
         if (!intent.coreClaim.empty()) {
-            std::stringstream ss(intent.coreClaim);
-            std::string word;
-            std::vector<std::string> keywords;
-            while (ss >> word) {
-                if (word.length() > 4) keywords.push_back(word);
+            // The keyword automaton only changes with the core claim: compile it once per claim.
+            thread_local std::string compiledClaim;
+            thread_local MentionMatcher matcher;
+            if (compiledClaim != intent.coreClaim || matcher.empty()) {
+                std::stringstream ss(intent.coreClaim);
+                std::string word;
+                std::vector<std::pair<std::string, int>> keywords;
+                while (ss >> word) {
+                    if (word.length() > 4) keywords.emplace_back(word, static_cast<int>(keywords.size()));
+                }
+                matcher.build(keywords);
+                compiledClaim = intent.coreClaim;
             }
 
-            int matchCount = 0;
+            // All keywords in one pass per segment; a keyword counts once per segment.
+            std::size_t matchCount = 0;
             for (const auto& pair : trajectory.getSegments()) {
-                const auto& content = pair.second.content;
-                for (const auto& kw : keywords) {
-                    if (content.find(kw) != std::string::npos) {
-                        matchCount++;
-                    }
-                }
+                matchCount += matcher.findPayloads(pair.second.content).size();
             }
 
             if (matchCount == 0 && !trajectory.getSegments().empty()) {
@@ -53,6 +53,27 @@ std::optional<std::string> ConfigLoader::GetAIModelPreference(const std::string&
     return std::nullopt;
 }
 
+std::optional<int> ConfigLoader::GetLLMConcurrencyPreference(const std::string& projectRoot) {
+    std::filesystem::path configPath = std::filesystem::path(projectRoot) / "settings.json";
+    if (!std::filesystem::exists(configPath)) {
+        return std::nullopt;
+    }
+
+    try {
+        std::ifstream f(configPath);
+        nlohmann::json j;
+        f >> j;
+
+        if (j.contains("llm_concurrency") && j["llm_concurrency"].is_number_integer()) {
+            return j["llm_concurrency"].get<int>();
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "[ConfigLoader] Error reading settings.json: " << e.what() << std::endl;
+    }
+
+    return std::nullopt;
+}
+
 void ConfigLoader::SaveVideoDriverPreference(const std::string& projectRoot, const std::string& driver) {
     std::filesystem::path configPath = std::filesystem::path(projectRoot) / "settings.json";
     nlohmann::json j;
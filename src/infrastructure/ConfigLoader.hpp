@@ -32,6 +32,11 @@ public:
      * @brief Saves the 'ai_model' key to settings.json.
      */
     static void SaveAIModelPreference(const std::string& projectRoot, const std::string& modelName);
+
+    /**
+     * @brief Reads the 'llm_concurrency' key from settings.json (LLM calls in flight during batch ingestion).
+     */
+    static std::optional<int> GetLLMConcurrencyPreference(const std::string& projectRoot);
 };
 
 } // namespace ideawalker::infrastructure
@@ -11,6 +11,7 @@
 #include <sstream>
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstdio>
 #include <cstdint>
 #include <cstring>
@@ -226,6 +227,8 @@ private:
         }
     };
 
+public:
+    /** @brief Hex SHA-256 of a file's bytes ("" if unreadable). */
     static std::string ComputeFileSha256(const std::string& path) {
         std::ifstream file(path, std::ios::binary);
         if (!file.is_open()) return "";
@@ -248,6 +251,7 @@ private:
         return oss.str();
     }
 
+private:
     static std::string NowIso() {
         auto now = std::chrono::system_clock::now();
         std::time_t tt = std::chrono::system_clock::to_time_t(now);
@@ -350,8 +354,10 @@ private:
     }
 
     static std::string GetTempFilePath(const std::string& suffix) {
+        // Articles may be extracted concurrently: the counter keeps same-tick names apart.
+        static std::atomic<unsigned> sequence{0};
         auto now = std::chrono::high_resolution_clock::now().time_since_epoch().count();
-        std::string name = "ideawalker_" + std::to_string(now) + suffix;
+        std::string name = "ideawalker_" + std::to_string(now) + "_" + std::to_string(sequence++) + suffix;
         return (std::filesystem::temp_directory_path() / name).string();
     }
 
@@ -9,6 +9,8 @@
 #include <chrono>
 #include <ctime>
 #include <algorithm>
+#include <functional>
+#include <string_view>
 #include "infrastructure/ContentExtractor.hpp"
 #include <nlohmann/json.hpp>
 
@@ -18,6 +20,102 @@ namespace ideawalker::infrastructure {
 
 namespace {
 
+std::string TrimCopy(std::string value) {
+    value.erase(0, value.find_first_not_of(" \t\r\"'"));
+    const size_t end = value.find_last_not_of(" \t\r\"'");
+    value.erase(end == std::string::npos ? 0 : end + 1);
+    return value;
+}
+
+// "aliases:" from a leading YAML front matter block, inline ([a, b] / a, b) or as a "- item" list.
+std::vector<std::string> ParseAliases(const std::string& content) {
+    std::vector<std::string> aliases;
+    if (content.rfind("---", 0) != 0) return aliases;
+    const size_t close = content.find("\n---", 3);
+    if (close == std::string::npos) return aliases;
+
+    std::istringstream block(content.substr(3, close - 3));
+    std::string line;
+    bool inList = false;
+    while (std::getline(block, line)) {
+        if (inList) {
+            const size_t dash = line.find_first_not_of(" \t");
+            if (dash != std::string::npos && line[dash] == '-') {
+                std::string alias = TrimCopy(line.substr(dash + 1));
+                if (!alias.empty()) aliases.push_back(alias);
+                continue;
+            }
+            inList = false;
+        }
+        if (line.rfind("aliases:", 0) != 0) continue;
+        std::string value = TrimCopy(line.substr(8));
+        if (value.empty()) {
+            inList = true;
+            continue;
+        }
+        if (value.front() == '[') value.erase(0, 1);
+        if (!value.empty() && value.back() == ']') value.pop_back();
+        std::istringstream items(value);
+        std::string item;
+        while (std::getline(items, item, ',')) {
+            item = TrimCopy(item);
+            if (!item.empty()) aliases.push_back(item);
+        }
+    }
+    return aliases;
+}
+
+domain::Insight LoadInsight(const fs::path& path) {
+    std::ifstream file(path);
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+
+    domain::Insight::Metadata meta;
+    meta.id = path.filename().string();
+    std::string content = buffer.str();
+
+    // Try to extract title from "# Título: [Title]"
+    std::string title;
+    size_t titlePos = content.find("# Título:");
+    if (titlePos != std::string::npos) {
+        size_t start = titlePos + 10; // "# Título: " length
+        size_t end = content.find("\n", start);
+        if (end != std::string::npos) {
+            title = content.substr(start, end - start);
+            // Trim brackets if present: [Title]
+            if (!title.empty() && title.front() == '[') title.erase(0, 1);
+            if (!title.empty() && title.back() == ']') title.pop_back();
+            // Basic trim
+            title.erase(0, title.find_first_not_of(" \t"));
+            title.erase(title.find_last_not_of(" \t") + 1);
+        }
+    }
+    meta.title = title;
+    meta.aliases = ParseAliases(content);
+
+    // Cheap change stamp: consumers diff notes by it instead of rehashing the content.
+    // mtime alone misses same-size edits within one tick and syncs that preserve it, so the
+    // head and tail of the content (whole notes up to 8 KB) are hashed in as well.
+    std::error_code ec;
+    const auto mtime = fs::last_write_time(path, ec);
+    if (!ec) {
+        constexpr std::size_t kSampleBytes = 4096;
+        const std::string_view text(content);
+        const auto sample = [](std::string_view part) {
+            return static_cast<std::uint64_t>(std::hash<std::string_view>{}(part));
+        };
+        std::uint64_t contentSignal = sample(text.substr(0, kSampleBytes));
+        if (text.size() > kSampleBytes) {
+            contentSignal = contentSignal * 31 + sample(text.substr(std::max(kSampleBytes, text.size() - kSampleBytes)));
+        }
+        const auto ticks = static_cast<std::uint64_t>(mtime.time_since_epoch().count());
+        meta.revision = (ticks * 0x9e3779b97f4a7c15ull) ^ (contentSignal * 0xff51afd7ed558ccdull) ^
+                        static_cast<std::uint64_t>(content.size());
+        if (meta.revision == 0) meta.revision = 1;
+    }
+    return domain::Insight(meta, content);
+}
+
 std::tm ToLocalTime(std::time_t tt) {
     std::tm tm = {};
 #if defined(_WIN32)
@@ -167,91 +265,17 @@ std::vector<domain::Insight> FileRepository::fetchHistory() {
     for (const auto& entry : fs::directory_iterator(m_notesPath)) {
         std::string ext = entry.path().extension().string();
         if (entry.is_regular_file() && (ext == ".md" || ext == ".txt")) {
-            std::ifstream file(entry.path());
-            std::stringstream buffer;
-            buffer << file.rdbuf();
-            
-            domain::Insight::Metadata meta;
-            meta.id = entry.path().filename().string();
-            std::string content = buffer.str();
-            
-            // Try to extract title from "# Título: [Title]"
-            std::string title;
-            size_t titlePos = content.find("# Título:");
-            if (titlePos != std::string::npos) {
-                size_t start = titlePos + 10; // "# Título: " length
-                size_t end = content.find("\n", start);
-                if (end != std::string::npos) {
-                    title = content.substr(start, end - start);
-                    // Trim brackets if present: [Title]
-                    if (!title.empty() && title.front() == '[') title.erase(0, 1);
-                    if (!title.empty() && title.back() == ']') title.pop_back();
-                    // Basic trim
-                    title.erase(0, title.find_first_not_of(" \t"));
-                    title.erase(title.find_last_not_of(" \t") + 1);
-                }
-            }
-            meta.title = title;
-            
-            history.emplace_back(meta, content); 
+            history.push_back(LoadInsight(entry.path()));
         }
     }
     return history;
 }
 
-std::vector<std::string> FileRepository::getBacklinks(const std::string& filename) {
-    std::vector<std::string> backlinks;
-    if (!fs::exists(m_notesPath)) return backlinks;
-
-    // 1. Get ID-based search string
-    std::string idTarget = filename;
-    size_t lastDot = idTarget.find_last_of(".");
-    if (lastDot != std::string::npos) idTarget = idTarget.substr(0, lastDot);
-    std::string searchId = "[[" + idTarget + "]]";
-
-    // 2. Try to get Title-based search string from the file itself
-    std::string searchTitle;
-    {
-        fs::path p = fs::path(m_notesPath) / filename;
-        if (fs::exists(p)) {
-            std::ifstream f(p);
-            std::string line;
-            while (std::getline(f, line)) {
-                if (line.rfind("# Título: ", 0) == 0) {
-                    searchTitle = "[[" + line.substr(10) + "]]";
-                    // Trim trailing CR
-                    if (!searchTitle.empty() && searchTitle.back() == '\r') searchTitle.pop_back();
-                    break;
-                }
-            }
-        }
-    }
-
-    // 3. Scan all notes
-    for (const auto& entry : fs::directory_iterator(m_notesPath)) {
-        std::string ext = entry.path().extension().string();
-        if (entry.is_regular_file() && (ext == ".md" || ext == ".txt")) {
-            if (entry.path().filename().string() == filename) continue;
-
-            std::ifstream file(entry.path());
-            std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
-            
-            bool found = (content.find(searchId) != std::string::npos);
-            if (!found) {
-                // Also try with the full filename (with extension) e.g. [[Note.md]]
-                std::string searchFull = "[[" + filename + "]]";
-                found = (content.find(searchFull) != std::string::npos);
-            }
-            if (!found && !searchTitle.empty()) {
-                found = (content.find(searchTitle) != std::string::npos);
-            }
-
-            if (found) {
-                backlinks.push_back(entry.path().filename().string());
-            }
-        }
-    }
-    return backlinks;
+std::optional<domain::Insight> FileRepository::fetchInsight(const std::string& filename) {
+    const fs::path path = fs::path(m_notesPath) / filename;
+    std::error_code ec;
+    if (!fs::is_regular_file(path, ec)) return std::nullopt;
+    return LoadInsight(path);
 }
 
 std::map<std::string, int> FileRepository::getActivityHistory() {
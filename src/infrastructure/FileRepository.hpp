@@ -37,8 +37,8 @@ public:
     /** @brief Loads all markdown files from the notes directory. @see domain::ThoughtRepository::fetchHistory */
     std::vector<domain::Insight> fetchHistory() override;
 
-    /** @brief Identifies [[backlinks]] in notes. @see domain::ThoughtRepository::getBacklinks */
-    std::vector<std::string> getBacklinks(const std::string& filename) override;
+    /** @brief Loads one markdown file from the notes directory. @see domain::ThoughtRepository::fetchInsight */
+    std::optional<domain::Insight> fetchInsight(const std::string& filename) override;
 
     /** @brief Generates activity data based on file modification times. @see domain::ThoughtRepository::getActivityHistory */
     std::map<std::string, int> getActivityHistory() override;
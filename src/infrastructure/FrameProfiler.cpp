@@ -0,0 +1,288 @@
+/**
+ * @file FrameProfiler.cpp
+ * @brief Implementation of FrameProfiler, ProfileRing and ProfileZone.
+ */
+
+#include "infrastructure/FrameProfiler.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+namespace ideawalker::infrastructure {
+
+namespace {
+
+struct ThreadSlot {
+    std::shared_ptr<ProfileRing> ring;
+    std::uint32_t id = 0;
+    std::uint32_t depth = 0;
+    ~ThreadSlot() {
+        if (ring) ring->retire();
+    }
+};
+
+thread_local ThreadSlot t_slot;
+
+void WriteJsonString(std::ostream& out, const char* text) {
+    out << '"';
+    for (const char* c = text; *c; ++c) {
+        const unsigned char ch = static_cast<unsigned char>(*c);
+        if (ch == '"' || ch == '\\') {
+            out << '\\' << *c;
+        } else if (ch < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", ch);
+            out << escaped;
+        } else {
+            out << *c;
+        }
+    }
+    out << '"';
+}
+
+void WriteMicros(std::ostream& out, std::uint64_t ns) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%llu.%03llu",
+                  static_cast<unsigned long long>(ns / 1000), static_cast<unsigned long long>(ns % 1000));
+    out << buffer;
+}
+
+} // namespace
+
+bool ProfileRing::push(const ProfileEvent& event) {
+    const std::uint64_t head = m_head.load(std::memory_order_relaxed);
+    if (head - m_tail.load(std::memory_order_acquire) >= kCapacity) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    m_events[head % kCapacity] = event;
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+std::size_t ProfileRing::drain(std::vector<ProfileEvent>& out) {
+    const std::uint64_t tail = m_tail.load(std::memory_order_relaxed);
+    const std::uint64_t head = m_head.load(std::memory_order_acquire);
+    for (std::uint64_t i = tail; i < head; ++i) out.push_back(m_events[i % kCapacity]);
+    m_tail.store(head, std::memory_order_release);
+    return static_cast<std::size_t>(head - tail);
+}
+
+FrameProfiler& FrameProfiler::Instance() {
+    static FrameProfiler profiler;
+    return profiler;
+}
+
+std::uint64_t FrameProfiler::NowNs() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void FrameProfiler::setEnabled(bool enabled) {
+    m_enabled.store(enabled, std::memory_order_relaxed);
+    if (!enabled) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_capturing = false;
+    }
+}
+
+ProfileRing& FrameProfiler::ringForThisThread() {
+    if (!t_slot.ring) {
+        t_slot.ring = std::make_shared<ProfileRing>();
+        t_slot.id = m_nextThread.fetch_add(1, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(m_ringsMutex);
+        m_rings.push_back(t_slot.ring);
+    }
+    return *t_slot.ring;
+}
+
+void FrameProfiler::record(const ProfileEvent& event) {
+    ProfileRing& ring = ringForThisThread();
+    ProfileEvent stamped = event;
+    stamped.thread = t_slot.id;
+    ring.push(stamped);
+}
+
+std::size_t FrameProfiler::zoneIndex(const char* name) {
+    auto it = m_zoneByPointer.find(name);
+    if (it != m_zoneByPointer.end()) return it->second;
+    // The same name spelled in two translation units may be two literals: merge by text.
+    auto [byName, inserted] = m_zoneByName.try_emplace(name, m_zones.size());
+    if (inserted) {
+        m_zones.emplace_back();
+        m_zones.back().name = name;
+    }
+    m_zoneByPointer.emplace(name, byName->second);
+    return byName->second;
+}
+
+void FrameProfiler::endFrame() {
+    const std::uint64_t now = NowNs();
+    if (!enabled()) {
+        m_frameStart = now;
+        return;
+    }
+
+    m_scratch.clear();
+    {
+        std::lock_guard<std::mutex> lock(m_ringsMutex);
+        for (auto& ring : m_rings) {
+            const bool retired = ring->retired(); // Checked before draining: nothing follows the retire
+            ring->drain(m_scratch);
+            if (retired) {
+                m_retiredDropped += ring->dropped();
+                ring.reset();
+            }
+        }
+        m_rings.erase(std::remove(m_rings.begin(), m_rings.end(), nullptr), m_rings.end());
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const ProfileEvent& event : m_scratch) {
+        Zone& zone = m_zones[zoneIndex(event.name)];
+        zone.current += static_cast<float>(event.endNs - event.beginNs) * 1e-6f;
+        zone.calls++;
+    }
+    if (m_capturing) {
+        const std::size_t room = kMaxCapture - std::min(kMaxCapture, m_capture.size());
+        m_capture.insert(m_capture.end(), m_scratch.begin(), m_scratch.begin() + std::min(room, m_scratch.size()));
+    }
+
+    for (Zone& zone : m_zones) {
+        zone.samples[m_cursor] = zone.current;
+        zone.lastCalls = zone.calls;
+        zone.current = 0.0f;
+        zone.calls = 0;
+    }
+    m_frames[m_cursor] = m_frameStart ? static_cast<float>(now - m_frameStart) * 1e-6f : 0.0f;
+    m_cursor = (m_cursor + 1) % kHistory;
+    m_filled = std::min(m_filled + 1, kHistory);
+    m_frameStart = now;
+}
+
+std::vector<float> FrameProfiler::ordered(const std::array<float, kHistory>& samples) const {
+    std::vector<float> out;
+    out.reserve(m_filled);
+    const std::size_t first = (m_cursor + kHistory - m_filled) % kHistory;
+    for (std::size_t i = 0; i < m_filled; ++i) out.push_back(samples[(first + i) % kHistory]);
+    return out;
+}
+
+std::vector<ZoneStats> FrameProfiler::zones() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<ZoneStats> out;
+    out.reserve(m_zones.size());
+    for (const Zone& zone : m_zones) {
+        ZoneStats stats;
+        stats.name = zone.name;
+        stats.history = ordered(zone.samples);
+        stats.lastCalls = zone.lastCalls;
+        if (!stats.history.empty()) {
+            stats.lastMs = stats.history.back();
+            float sum = 0.0f;
+            for (float ms : stats.history) {
+                sum += ms;
+                stats.maxMs = std::max(stats.maxMs, ms);
+            }
+            stats.avgMs = sum / static_cast<float>(stats.history.size());
+        }
+        out.push_back(std::move(stats));
+    }
+    std::sort(out.begin(), out.end(), [](const ZoneStats& a, const ZoneStats& b) { return a.avgMs > b.avgMs; });
+    return out;
+}
+
+std::vector<float> FrameProfiler::frameHistory() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return ordered(m_frames);
+}
+
+std::uint64_t FrameProfiler::droppedEvents() const {
+    std::lock_guard<std::mutex> lock(m_ringsMutex);
+    std::uint64_t dropped = m_retiredDropped;
+    for (const auto& ring : m_rings) dropped += ring->dropped();
+    return dropped;
+}
+
+void FrameProfiler::startCapture() {
+    setEnabled(true);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_capture.clear();
+    m_captureStart = NowNs();
+    m_capturing = true;
+}
+
+void FrameProfiler::stopCapture() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_capturing = false;
+}
+
+bool FrameProfiler::capturing() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_capturing;
+}
+
+std::size_t FrameProfiler::capturedEvents() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_capture.size();
+}
+
+bool FrameProfiler::exportChromeTrace(const std::string& path) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        std::cerr << "[FrameProfiler] Cannot write trace: " << path << std::endl;
+        return false;
+    }
+
+    // "X" (complete) events, timestamps in microseconds from the start of the capture.
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (const ProfileEvent& event : m_capture) {
+        if (!first) out << ',';
+        first = false;
+        out << "\n{\"name\":";
+        WriteJsonString(out, event.name);
+        out << ",\"cat\":\"ideawalker\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.thread << ",\"ts\":";
+        WriteMicros(out, event.beginNs >= m_captureStart ? event.beginNs - m_captureStart : 0);
+        out << ",\"dur\":";
+        WriteMicros(out, event.endNs - event.beginNs);
+        out << ",\"args\":{\"depth\":" << event.depth << "}}";
+    }
+    out << "\n]}\n";
+    out.flush();
+    return static_cast<bool>(out);
+}
+
+void FrameProfiler::reset() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_zones.clear();
+    m_zoneByPointer.clear();
+    m_zoneByName.clear();
+    m_frames.fill(0.0f);
+    m_cursor = 0;
+    m_filled = 0;
+    m_capture.clear();
+    m_capturing = false;
+}
+
+ProfileZone::ProfileZone(const char* name) : m_name(name) {
+    if (!FrameProfiler::Instance().enabled()) return;
+    m_active = true;
+    ++t_slot.depth;
+    m_begin = FrameProfiler::NowNs();
+}
+
+ProfileZone::~ProfileZone() {
+    if (!m_active) return;
+    ProfileEvent event;
+    event.name = m_name;
+    event.beginNs = m_begin;
+    event.endNs = FrameProfiler::NowNs();
+    event.depth = --t_slot.depth;
+    FrameProfiler::Instance().record(event);
+}
+
+} // namespace ideawalker::infrastructure
@@ -0,0 +1,178 @@
+/**
+ * @file FrameProfiler.hpp
+ * @brief Scoped timing zones aggregated per frame, with history and Chrome trace export.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ideawalker::infrastructure {
+
+/**
+ * @struct ProfileEvent
+ * @brief One closed zone.
+ */
+struct ProfileEvent {
+    const char* name = nullptr; ///< Zone name; a string literal (never copied).
+    std::uint64_t beginNs = 0;  ///< steady_clock time.
+    std::uint64_t endNs = 0;
+    std::uint32_t thread = 0;   ///< Small id of the recording thread (1 = first thread to record).
+    std::uint32_t depth = 0;    ///< Nesting level on that thread.
+};
+
+/**
+ * @class ProfileRing
+ * @brief Single-producer/single-consumer ring of events, one per recording thread.
+ *
+ * The owning thread pushes without locks; the profiler drains it once per frame.
+ * When the ring is full new events are dropped (and counted) instead of
+ * overwriting ones the reader has not seen.
+ */
+class ProfileRing {
+public:
+    static constexpr std::size_t kCapacity = 4096;
+
+    /** @brief Producer side. Returns false if the event was dropped. */
+    bool push(const ProfileEvent& event);
+    /** @brief Consumer side: appends every pending event to @p out. */
+    std::size_t drain(std::vector<ProfileEvent>& out);
+
+    std::uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    /** @brief Marks the ring as belonging to a finished thread; it is released once drained. */
+    void retire() { m_retired.store(true, std::memory_order_release); }
+    bool retired() const { return m_retired.load(std::memory_order_acquire); }
+
+private:
+    std::array<ProfileEvent, kCapacity> m_events{};
+    std::atomic<std::uint64_t> m_head{0}; // Next write (producer)
+    std::atomic<std::uint64_t> m_tail{0}; // Next read (consumer)
+    std::atomic<std::uint64_t> m_dropped{0};
+    std::atomic<bool> m_retired{false};
+};
+
+/**
+ * @struct ZoneStats
+ * @brief Timings of one zone name over the recent frames (summed over calls and threads).
+ */
+struct ZoneStats {
+    std::string name;
+    float lastMs = 0.0f;
+    float avgMs = 0.0f;
+    float maxMs = 0.0f;
+    std::uint32_t lastCalls = 0;
+    std::vector<float> history; ///< Milliseconds per frame, oldest first.
+};
+
+/**
+ * @class FrameProfiler
+ * @brief Collects ProfileZone events from every thread and folds them into per-frame history.
+ *
+ * Disabled by default: a zone then costs one relaxed atomic load. The render thread
+ * calls endFrame() once per frame; zones recorded by background tasks land in the
+ * frame during which they closed.
+ */
+class FrameProfiler {
+public:
+    static constexpr std::size_t kHistory = 240;          ///< Frames kept for the graphs.
+    static constexpr std::size_t kMaxCapture = 1u << 20;  ///< Events kept while capturing a trace.
+
+    static FrameProfiler& Instance();
+
+    void setEnabled(bool enabled);
+    bool enabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    /** @brief Closes the current frame: drains every thread's ring and updates the history. */
+    void endFrame();
+
+    /** @brief Zones seen in the history, slowest (by average) first. */
+    std::vector<ZoneStats> zones() const;
+    /** @brief Frame times in milliseconds, oldest first. */
+    std::vector<float> frameHistory() const;
+    /** @brief Events dropped because a ring was full. */
+    std::uint64_t droppedEvents() const;
+
+    /** @brief Keeps raw events (up to kMaxCapture) for exportChromeTrace(). Enables the profiler. */
+    void startCapture();
+    void stopCapture();
+    bool capturing() const;
+    std::size_t capturedEvents() const;
+
+    /**
+     * @brief Writes the captured events in the Chrome trace event format (chrome://tracing, Perfetto).
+     * @return False if the file could not be written.
+     */
+    bool exportChromeTrace(const std::string& path) const;
+
+    /** @brief Forgets history and capture (rings are kept). */
+    void reset();
+
+    static std::uint64_t NowNs();
+
+    /** @brief Records a closed zone on the calling thread's ring (ProfileZone calls this). */
+    void record(const ProfileEvent& event);
+
+private:
+    FrameProfiler() = default;
+
+    struct Zone {
+        std::string name;
+        std::array<float, kHistory> samples{};
+        float current = 0.0f;       // Milliseconds accumulated in the open frame
+        std::uint32_t calls = 0;    // Calls in the open frame
+        std::uint32_t lastCalls = 0;
+    };
+
+    ProfileRing& ringForThisThread();
+    std::size_t zoneIndex(const char* name);
+    std::vector<float> ordered(const std::array<float, kHistory>& samples) const;
+
+    std::atomic<bool> m_enabled{false};
+
+    mutable std::mutex m_ringsMutex;
+    std::vector<std::shared_ptr<ProfileRing>> m_rings;
+    std::uint64_t m_retiredDropped = 0; // Drops of rings already released
+    std::atomic<std::uint32_t> m_nextThread{1};
+
+    mutable std::mutex m_mutex;
+    std::vector<Zone> m_zones;
+    std::unordered_map<const char*, std::size_t> m_zoneByPointer;
+    std::unordered_map<std::string, std::size_t> m_zoneByName;
+    std::array<float, kHistory> m_frames{};
+    std::size_t m_cursor = 0;      // Next history slot
+    std::size_t m_filled = 0;      // Valid history slots
+    std::uint64_t m_frameStart = 0;
+    std::vector<ProfileEvent> m_scratch;
+    std::vector<ProfileEvent> m_capture;
+    std::uint64_t m_captureStart = 0;
+    bool m_capturing = false;
+};
+
+/**
+ * @class ProfileZone
+ * @brief Times the enclosing scope: `infrastructure::ProfileZone zone("DrawNodeGraph");`.
+ * @param name Must outlive the profiler (use a string literal).
+ */
+class ProfileZone {
+public:
+    explicit ProfileZone(const char* name);
+    ~ProfileZone();
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+private:
+    const char* m_name;
+    std::uint64_t m_begin = 0;
+    bool m_active = false;
+};
+
+} // namespace ideawalker::infrastructure
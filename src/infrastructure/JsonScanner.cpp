@@ -0,0 +1,329 @@
+/**
+ * @file JsonScanner.cpp
+ * @brief Implementation of JsonScanner.
+ */
+
+#include "infrastructure/JsonScanner.hpp"
+
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+
+namespace ideawalker::infrastructure {
+
+namespace {
+
+constexpr int kMaxDepth = 512; // Deeper input is rejected instead of risking the stack.
+
+bool IsHex(unsigned char c) {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+unsigned HexValue(unsigned char c) {
+    if (c <= '9') return c - '0';
+    return (c | 0x20) - 'a' + 10;
+}
+
+/** Reads the 4 hex digits of a \u escape starting at @p pos (just after "\u"). */
+bool ReadCodeUnit(std::string_view text, size_t pos, unsigned& unit) {
+    if (pos + 4 > text.size()) return false;
+    unit = 0;
+    for (size_t i = 0; i < 4; ++i) {
+        const auto c = static_cast<unsigned char>(text[pos + i]);
+        if (!IsHex(c)) return false;
+        unit = (unit << 4) | HexValue(c);
+    }
+    return true;
+}
+
+void AppendUtf8(std::string& out, unsigned codePoint) {
+    if (codePoint < 0x80) {
+        out.push_back(static_cast<char>(codePoint));
+    } else if (codePoint < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else if (codePoint < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+}
+
+/**
+ * Decodes the body of a validated string (without quotes). Escapes were checked
+ * by the scanner, so only well-formed input reaches this point.
+ */
+std::string DecodeString(std::string_view body) {
+    std::string out;
+    out.reserve(body.size());
+    for (size_t i = 0; i < body.size(); ++i) {
+        const char c = body[i];
+        if (c != '\\') {
+            out.push_back(c);
+            continue;
+        }
+        const char escape = body[++i];
+        switch (escape) {
+            case 'b': out.push_back('\b'); break;
+            case 'f': out.push_back('\f'); break;
+            case 'n': out.push_back('\n'); break;
+            case 'r': out.push_back('\r'); break;
+            case 't': out.push_back('\t'); break;
+            case 'u': {
+                unsigned unit = 0;
+                ReadCodeUnit(body, i + 1, unit);
+                i += 4;
+                if (unit >= 0xD800 && unit <= 0xDBFF) {
+                    unsigned low = 0;
+                    ReadCodeUnit(body, i + 3, low);
+                    i += 6;
+                    unit = 0x10000 + ((unit - 0xD800) << 10) + (low - 0xDC00);
+                }
+                AppendUtf8(out, unit);
+                break;
+            }
+            default: out.push_back(escape); break; // '"', '\\', '/'
+        }
+    }
+    return out;
+}
+
+/** Recursive-descent validator; each scan* leaves m_pos just past what it consumed. */
+class Cursor {
+public:
+    explicit Cursor(std::string_view text) : m_text(text) {
+        // Same as nlohmann::json: a leading UTF-8 byte order mark is ignored.
+        if (m_text.substr(0, 3) == "\xEF\xBB\xBF") m_pos = 3;
+    }
+
+    void skipWhitespace() {
+        while (m_pos < m_text.size()) {
+            const char c = m_text[m_pos];
+            if (c != ' ' && c != '\t' && c != '\n' && c != '\r') break;
+            ++m_pos;
+        }
+    }
+
+    bool atEnd() {
+        skipWhitespace();
+        return m_pos == m_text.size();
+    }
+
+    bool consume(char expected) {
+        skipWhitespace();
+        if (m_pos < m_text.size() && m_text[m_pos] == expected) {
+            ++m_pos;
+            return true;
+        }
+        return false;
+    }
+
+    /** Validates one value; @p onMember is only used for the outermost object. */
+    bool scanValue(JsonScanner::Value& value, int depth, const JsonScanner::MemberFn* onMember) {
+        skipWhitespace();
+        if (m_pos >= m_text.size()) return false;
+        const size_t begin = m_pos;
+        bool ok = false;
+        switch (m_text[m_pos]) {
+            case '{': value.kind = JsonScanner::Kind::Object; ok = scanObject(depth, onMember); break;
+            case '[': value.kind = JsonScanner::Kind::Array; ok = scanArray(depth); break;
+            case '"': value.kind = JsonScanner::Kind::String; ok = scanString(nullptr); break;
+            case 't': value.kind = JsonScanner::Kind::Boolean; ok = scanLiteral("true"); break;
+            case 'f': value.kind = JsonScanner::Kind::Boolean; ok = scanLiteral("false"); break;
+            case 'n': value.kind = JsonScanner::Kind::Null; ok = scanLiteral("null"); break;
+            default: value.kind = JsonScanner::Kind::Number; ok = scanNumber(); break;
+        }
+        value.raw = m_text.substr(begin, m_pos - begin);
+        return ok;
+    }
+
+private:
+    bool scanObject(int depth, const JsonScanner::MemberFn* onMember) {
+        if (depth >= kMaxDepth) return false;
+        ++m_pos; // '{'
+        if (consume('}')) return true;
+        std::string escapedKey;
+        for (;;) {
+            skipWhitespace();
+            if (m_pos >= m_text.size() || m_text[m_pos] != '"') return false;
+            const size_t keyBegin = m_pos + 1;
+            bool escaped = false;
+            if (!scanString(&escaped)) return false;
+            std::string_view key = m_text.substr(keyBegin, m_pos - 1 - keyBegin);
+            if (escaped && onMember) {
+                escapedKey = DecodeString(key);
+                key = escapedKey;
+            }
+            if (!consume(':')) return false;
+            JsonScanner::Value member;
+            if (!scanValue(member, depth + 1, nullptr)) return false;
+            if (onMember) (*onMember)(key, member);
+            if (consume(',')) continue;
+            return consume('}');
+        }
+    }
+
+    bool scanArray(int depth) {
+        if (depth >= kMaxDepth) return false;
+        ++m_pos; // '['
+        if (consume(']')) return true;
+        for (;;) {
+            JsonScanner::Value element;
+            if (!scanValue(element, depth + 1, nullptr)) return false;
+            if (consume(',')) continue;
+            return consume(']');
+        }
+    }
+
+    bool scanString(bool* escaped) {
+        ++m_pos; // opening quote
+        while (m_pos < m_text.size()) {
+            const auto c = static_cast<unsigned char>(m_text[m_pos]);
+            if (c == '"') {
+                ++m_pos;
+                return true;
+            }
+            if (c < 0x20) return false;
+            if (c == '\\') {
+                if (escaped) *escaped = true;
+                if (!scanEscape()) return false;
+            } else if (c < 0x80) {
+                ++m_pos;
+            } else if (!scanUtf8()) {
+                return false;
+            }
+        }
+        return false;
+    }
+
+    bool scanEscape() {
+        if (++m_pos >= m_text.size()) return false;
+        const char escape = m_text[m_pos++];
+        switch (escape) {
+            case '"': case '\\': case '/': case 'b': case 'f': case 'n': case 'r': case 't':
+                return true;
+            case 'u': {
+                unsigned unit = 0;
+                if (!ReadCodeUnit(m_text, m_pos, unit)) return false;
+                m_pos += 4;
+                if (unit >= 0xDC00 && unit <= 0xDFFF) return false; // Lone low surrogate
+                if (unit < 0xD800 || unit > 0xDBFF) return true;
+                unsigned low = 0;
+                if (m_text.substr(m_pos, 2) != "\\u" || !ReadCodeUnit(m_text, m_pos + 2, low)) return false;
+                if (low < 0xDC00 || low > 0xDFFF) return false;
+                m_pos += 6;
+                return true;
+            }
+            default:
+                return false;
+        }
+    }
+
+    /** Well-formed UTF-8 only (no overlongs, no encoded surrogates, nothing past U+10FFFF). */
+    bool scanUtf8() {
+        const auto lead = static_cast<unsigned char>(m_text[m_pos]);
+        size_t length = 0;
+        unsigned char low = 0x80, high = 0xBF; // Bounds of the first continuation byte
+        if (lead >= 0xC2 && lead <= 0xDF) {
+            length = 2;
+        } else if (lead >= 0xE0 && lead <= 0xEF) {
+            length = 3;
+            if (lead == 0xE0) low = 0xA0;
+            if (lead == 0xED) high = 0x9F;
+        } else if (lead >= 0xF0 && lead <= 0xF4) {
+            length = 4;
+            if (lead == 0xF0) low = 0x90;
+            if (lead == 0xF4) high = 0x8F;
+        } else {
+            return false;
+        }
+        if (m_pos + length > m_text.size()) return false;
+        for (size_t i = 1; i < length; ++i) {
+            const auto c = static_cast<unsigned char>(m_text[m_pos + i]);
+            if (c < (i == 1 ? low : 0x80) || c > (i == 1 ? high : 0xBF)) return false;
+        }
+        m_pos += length;
+        return true;
+    }
+
+    bool scanLiteral(std::string_view literal) {
+        if (m_text.substr(m_pos, literal.size()) != literal) return false;
+        m_pos += literal.size();
+        return true;
+    }
+
+    bool scanDigits() {
+        const size_t begin = m_pos;
+        while (m_pos < m_text.size() && m_text[m_pos] >= '0' && m_text[m_pos] <= '9') ++m_pos;
+        return m_pos > begin;
+    }
+
+    bool scanNumber() {
+        const size_t begin = m_pos;
+        if (m_text[m_pos] == '-') ++m_pos;
+        if (m_pos < m_text.size() && m_text[m_pos] == '0') {
+            ++m_pos;
+        } else if (!scanDigits()) {
+            return false;
+        }
+        bool integer = true;
+        if (m_pos < m_text.size() && m_text[m_pos] == '.') {
+            ++m_pos;
+            integer = false;
+            if (!scanDigits()) return false;
+        }
+        if (m_pos < m_text.size() && (m_text[m_pos] == 'e' || m_text[m_pos] == 'E')) {
+            ++m_pos;
+            integer = false;
+            if (m_pos < m_text.size() && (m_text[m_pos] == '+' || m_text[m_pos] == '-')) ++m_pos;
+            if (!scanDigits()) return false;
+        }
+        // Like nlohmann::json, reject numbers that do not fit a double (integers up to 64 bits always do).
+        if (integer && m_pos - begin <= 20) return true;
+        const std::string number(m_text.substr(begin, m_pos - begin));
+        return std::isfinite(std::strtod(number.c_str(), nullptr));
+    }
+
+    std::string_view m_text;
+    size_t m_pos = 0;
+};
+
+} // namespace
+
+std::optional<std::string> JsonScanner::Value::asString() const {
+    if (kind != Kind::String) return std::nullopt;
+    return DecodeString(raw.substr(1, raw.size() - 2));
+}
+
+std::optional<std::int64_t> JsonScanner::Value::asInt() const {
+    if (kind != Kind::Number || raw.find_first_of(".eE") != std::string_view::npos) return std::nullopt;
+    std::int64_t out = 0;
+    const auto result = std::from_chars(raw.data(), raw.data() + raw.size(), out);
+    if (result.ec != std::errc() || result.ptr != raw.data() + raw.size()) return std::nullopt;
+    return out;
+}
+
+std::optional<bool> JsonScanner::Value::asBool() const {
+    if (kind != Kind::Boolean) return std::nullopt;
+    return raw == "true";
+}
+
+bool JsonScanner::forEachMember(std::string_view text, const MemberFn& onMember) {
+    Cursor cursor(text);
+    Value value;
+    return cursor.scanValue(value, 0, &onMember) && value.kind == Kind::Object && cursor.atEnd();
+}
+
+std::optional<JsonScanner::Value> JsonScanner::parse(std::string_view text) {
+    Cursor cursor(text);
+    Value value;
+    if (!cursor.scanValue(value, 0, nullptr) || !cursor.atEnd()) return std::nullopt;
+    return value;
+}
+
+} // namespace ideawalker::infrastructure
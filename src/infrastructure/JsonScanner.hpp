@@ -0,0 +1,59 @@
+/**
+ * @file JsonScanner.hpp
+ * @brief On-demand JSON reading over raw text, for hot paths that only need a few fields.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace ideawalker::infrastructure {
+
+/**
+ * @class JsonScanner
+ * @brief Validating, zero-copy JSON scanner.
+ *
+ * The input is checked with the same grammar nlohmann::json accepts (strings,
+ * escapes and UTF-8 included), but no DOM is built: values come back as views
+ * into the input and are only decoded when a caller asks for them. Sub-trees a
+ * caller just stores or forwards (an event payload, a snapshot state) keep their
+ * original text instead of being parsed and dumped again.
+ */
+class JsonScanner {
+public:
+    enum class Kind { Object, Array, String, Number, Boolean, Null };
+
+    /**
+     * @struct Value
+     * @brief One JSON value, as a view into the scanned text.
+     */
+    struct Value {
+        Kind kind = Kind::Null;
+        std::string_view raw; ///< Exact JSON text of the value (quotes included for strings).
+
+        /** @brief Decoded string; nullopt unless the value is a string. */
+        std::optional<std::string> asString() const;
+        /** @brief Integer value; nullopt for non-numbers, fractions, exponents or overflow. */
+        std::optional<std::int64_t> asInt() const;
+        /** @brief Boolean value; nullopt unless the value is true/false. */
+        std::optional<bool> asBool() const;
+    };
+
+    using MemberFn = std::function<void(std::string_view key, const Value& value)>;
+
+    /**
+     * @brief Visits the members of the object that makes up @p text, in order.
+     * @return false if @p text is not exactly one well-formed JSON object. Members seen
+     *         before the error were already visited, so callers commit only on true.
+     */
+    static bool forEachMember(std::string_view text, const MemberFn& onMember);
+
+    /** @brief Scans @p text as exactly one JSON value; nullopt if it is malformed. */
+    static std::optional<Value> parse(std::string_view text);
+};
+
+} // namespace ideawalker::infrastructure
@@ -4,15 +4,111 @@
  */
 
 #include "infrastructure/PersistenceService.hpp"
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <set>
+#include <system_error>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 namespace ideawalker::infrastructure {
 
 namespace fs = std::filesystem;
 
-PersistenceService::PersistenceService() : m_running(true) {
+namespace {
+
+/**
+ * @brief fsync() on a path (file or directory). No-op on platforms without POSIX fsync.
+ */
+bool SyncPath(const fs::path& path, bool isDirectory) {
+#if !defined(_WIN32)
+    int flags = isDirectory ? O_RDONLY : O_WRONLY;
+#ifdef O_DIRECTORY
+    if (isDirectory) flags |= O_DIRECTORY;
+#endif
+    const int fd = ::open(path.c_str(), flags);
+    if (fd < 0) return false;
+    const bool ok = ::fsync(fd) == 0;
+    ::close(fd);
+    return ok;
+#else
+    (void)path;
+    (void)isDirectory;
+    return true;
+#endif
+}
+
+double ElapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief temp -> (fsync) -> rename for a single file.
+ */
+bool WriteAtomic(const SaveTask& task, FsyncPolicy fsyncPolicy) {
+    fs::path finalPath = task.filename;
+
+    // Create unique temp path: filename.<timestamp>.tmp
+    // We use a simplified timestamp here just to be unique per operation
+    auto timestamp = std::chrono::steady_clock::now().time_since_epoch().count();
+    fs::path tempPath = finalPath;
+    tempPath += "." + std::to_string(timestamp) + ".tmp";
+
+    // 1. Ensure directory exists
+    try {
+        if (finalPath.has_parent_path() && !fs::exists(finalPath.parent_path())) {
+            fs::create_directories(finalPath.parent_path());
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "[PersistenceService] Error creating directories: " << e.what() << std::endl;
+        return false;
+    }
+
+    // 2. Write to Temp
+    {
+        std::ofstream ofs(tempPath);
+        if (!ofs.is_open()) {
+            std::cerr << "[PersistenceService] Failed to open temp file: " << tempPath << std::endl;
+            return false;
+        }
+        ofs << task.content;
+        if (ofs.fail()) {
+            std::cerr << "[PersistenceService] Write failed during output: " << tempPath << std::endl;
+            try { fs::remove(tempPath); } catch (...) {}
+            return false;
+        }
+        ofs.flush();
+    } // Close happens here automatically
+
+    // 3. Make the content durable before it becomes visible under the final name
+    if (fsyncPolicy != FsyncPolicy::None && !SyncPath(tempPath, false)) {
+        std::cerr << "[PersistenceService] fsync failed: " << tempPath << std::endl;
+    }
+
+    // 4. Atomic Rename
+    try {
+        fs::rename(tempPath, finalPath);
+    } catch (const std::filesystem::filesystem_error& e) {
+        std::cerr << "[PersistenceService] Rename failed: " << e.what() << std::endl;
+        // Attempt cleanup
+        try { fs::remove(tempPath); } catch (...) {}
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+PersistenceService::PersistenceService(FsyncPolicy fsyncPolicy, std::size_t maxBatchSize)
+    : m_fsyncPolicy(fsyncPolicy),
+      m_maxBatchSize(std::max<std::size_t>(1, maxBatchSize)),
+      m_running(true) {
     m_worker = std::thread(&PersistenceService::workerLoop, this);
 }
 
@@ -27,7 +123,7 @@ void PersistenceService::stop() {
         m_running = false;
     }
     m_cv.notify_all();
-    
+
     if (m_worker.joinable()) {
         m_worker.join();
     }
@@ -36,81 +132,237 @@ void PersistenceService::stop() {
 void PersistenceService::saveTextAsync(const std::string& filename, const std::string& content) {
     {
         std::lock_guard<std::mutex> lock(m_mutex);
-        m_queue.push(SaveTask{filename, content});
+        enqueueLocked(filename, content, false);
     }
     m_cv.notify_one();
 }
 
+void PersistenceService::appendTextAsync(const std::string& filename, const std::string& content) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        enqueueLocked(filename, content, true);
+    }
+    m_cv.notify_one();
+}
+
+void PersistenceService::enqueueLocked(const std::string& filename, const std::string& content, bool append) {
+    const std::uint64_t sequence = ++m_submittedSequence;
+    ++m_metrics.enqueued;
+
+    auto it = m_pending.find(filename);
+    if (it != m_pending.end()) {
+        if (append) {
+            // Appends extend whatever is pending (a full save or earlier appends).
+            it->second.content += content;
+        } else {
+            // Last write wins: the older content never reaches the disk.
+            it->second.content = content;
+            it->second.append = false;
+        }
+        it->second.sequence = sequence;
+        ++m_metrics.coalesced;
+    } else {
+        m_pending.emplace(filename, PendingWrite{content, sequence, append});
+        m_order.push_back(filename);
+        m_metrics.peakQueueDepth = std::max(m_metrics.peakQueueDepth, m_pending.size());
+    }
+}
+
+void PersistenceService::flush() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    const std::uint64_t target = m_submittedSequence;
+    m_flushCv.wait(lock, [this, target] {
+        return m_durableSequence >= target || m_workerExited;
+    });
+}
+
+PersistenceMetrics PersistenceService::getMetrics() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    PersistenceMetrics snapshot = m_metrics;
+    snapshot.queueDepth = m_pending.size();
+    return snapshot;
+}
+
+std::uint64_t PersistenceService::computeDurableSequenceLocked() const {
+    if (m_pending.empty()) return m_submittedSequence;
+    std::uint64_t oldestPending = m_submittedSequence + 1;
+    for (const auto& [path, pending] : m_pending) {
+        oldestPending = std::min(oldestPending, pending.sequence);
+    }
+    return oldestPending - 1;
+}
+
 void PersistenceService::workerLoop() {
+    std::vector<SaveTask> batch;
+    batch.reserve(m_maxBatchSize);
+
     while (true) {
-        SaveTask task;
-        
+        batch.clear();
+
         {
             std::unique_lock<std::mutex> lock(m_mutex);
             m_cv.wait(lock, [this] {
-                return !m_queue.empty() || !m_running;
+                return !m_pending.empty() || !m_running;
             });
 
-            if (!m_running && m_queue.empty()) {
+            if (!m_running && m_pending.empty()) {
+                m_workerExited = true;
+                m_durableSequence = m_submittedSequence;
+                m_flushCv.notify_all();
                 return; // Exit point
             }
 
-            if (m_queue.empty()) {
+            if (m_pending.empty()) {
                 continue; // Spurious wake up
             }
 
-            task = m_queue.front();
-            m_queue.pop();
+            while (!m_order.empty() && batch.size() < m_maxBatchSize) {
+                auto it = m_pending.find(m_order.front());
+                m_order.pop_front();
+                if (it == m_pending.end()) continue;
+                batch.push_back(SaveTask{it->first, std::move(it->second.content), false, it->second.append});
+                m_pending.erase(it);
+            }
         }
 
-        // Process outside lock
-        performAtomicWrite(task);
+        // Group commit outside lock
+        const auto batchStart = std::chrono::steady_clock::now();
+        std::set<fs::path> touchedDirectories;
+        std::uint64_t written = 0;
+        std::uint64_t failed = 0;
+        double totalWriteMs = 0.0;
+        double maxWriteMs = 0.0;
+        double lastWriteMs = 0.0;
+
+        for (const auto& task : batch) {
+            const auto writeStart = std::chrono::steady_clock::now();
+            const bool ok = task.append ? performAppend(task) : performAtomicWrite(task);
+            lastWriteMs = ElapsedMs(writeStart);
+            totalWriteMs += lastWriteMs;
+            maxWriteMs = std::max(maxWriteMs, lastWriteMs);
+            if (ok) {
+                ++written;
+                if (m_fsyncPolicy == FsyncPolicy::Full) {
+                    fs::path parent = fs::path(task.filename).parent_path();
+                    touchedDirectories.insert(parent.empty() ? fs::path(".") : parent);
+                }
+            } else {
+                ++failed;
+            }
+        }
+
+        // One directory fsync per batch makes every rename above durable.
+        for (const auto& dir : touchedDirectories) {
+            if (!SyncPath(dir, true)) {
+                std::cerr << "[PersistenceService] Directory fsync failed: " << dir << std::endl;
+            }
+        }
+        const double batchMs = ElapsedMs(batchStart);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            const std::uint64_t previousWrites = m_metrics.written + m_metrics.failed;
+            const std::uint64_t totalWrites = previousWrites + written + failed;
+            if (totalWrites > 0) {
+                m_metrics.avgWriteMs = (m_metrics.avgWriteMs * static_cast<double>(previousWrites) + totalWriteMs) /
+                                       static_cast<double>(totalWrites);
+            }
+            m_metrics.written += written;
+            m_metrics.failed += failed;
+            m_metrics.lastWriteMs = lastWriteMs;
+            m_metrics.maxWriteMs = std::max(m_metrics.maxWriteMs, maxWriteMs);
+            m_metrics.lastBatchMs = batchMs;
+            ++m_metrics.batches;
+
+            m_durableSequence = std::max(m_durableSequence, computeDurableSequenceLocked());
+        }
+        m_flushCv.notify_all();
     }
 }
 
-void PersistenceService::performAtomicWrite(const SaveTask& task) {
+bool PersistenceService::performAtomicWrite(const SaveTask& task) {
+    return WriteAtomic(task, m_fsyncPolicy);
+}
+
+bool PersistenceService::WriteGroup(const std::vector<SaveTask>& files, FsyncPolicy policy, std::size_t workers,
+                                    std::string& error) {
+    std::vector<char> written(files.size(), 0);
+    std::atomic<std::size_t> next{0};
+    auto drain = [&] {
+        for (std::size_t i = next++; i < files.size(); i = next++) {
+            written[i] = WriteAtomic(files[i], policy) ? 1 : 0;
+        }
+    };
+
+    // The caller's thread takes a share of the files too, so one worker means no extra thread.
+    const std::size_t threadCount = std::min(std::max<std::size_t>(1, workers), files.size());
+    std::vector<std::thread> helpers;
+    for (std::size_t t = 1; t < threadCount; ++t) {
+        try {
+            helpers.emplace_back(drain);
+        } catch (const std::system_error&) {
+            break; // Out of threads: the ones already running (and this one) finish the group.
+        }
+    }
+    drain();
+    for (auto& helper : helpers) {
+        helper.join();
+    }
+
+    bool ok = true;
+    std::set<fs::path> touchedDirectories;
+    for (std::size_t i = 0; i < files.size(); ++i) {
+        const fs::path path = files[i].filename;
+        if (!written[i]) {
+            ok = false;
+            error += (error.empty() ? "" : ", ") + path.string();
+            continue;
+        }
+        const fs::path parent = path.parent_path();
+        touchedDirectories.insert(parent.empty() ? fs::path(".") : parent);
+    }
+
+    // One directory fsync for the whole group, after the last rename.
+    if (policy != FsyncPolicy::None) {
+        for (const auto& dir : touchedDirectories) {
+            if (!SyncPath(dir, true)) {
+                std::cerr << "[PersistenceService] Directory fsync failed: " << dir << std::endl;
+            }
+        }
+    }
+    return ok;
+}
+
+bool PersistenceService::performAppend(const SaveTask& task) {
     fs::path finalPath = task.filename;
-    
-    // Create unique temp path: filename.<timestamp>.tmp
-    // We use a simplified timestamp here just to be unique per operation
-    auto timestamp = std::chrono::steady_clock::now().time_since_epoch().count();
-    fs::path tempPath = finalPath;
-    tempPath += "." + std::to_string(timestamp) + ".tmp";
 
-    // 1. Ensure directory exists
     try {
         if (finalPath.has_parent_path() && !fs::exists(finalPath.parent_path())) {
             fs::create_directories(finalPath.parent_path());
         }
     } catch (const std::exception& e) {
         std::cerr << "[PersistenceService] Error creating directories: " << e.what() << std::endl;
-        return;
+        return false;
     }
 
-    // 2. Write to Temp
     {
-        std::ofstream ofs(tempPath);
+        std::ofstream ofs(finalPath, std::ios::app);
         if (!ofs.is_open()) {
-            std::cerr << "[PersistenceService] Failed to open temp file: " << tempPath << std::endl;
-            return;
+            std::cerr << "[PersistenceService] Failed to open file for append: " << finalPath << std::endl;
+            return false;
         }
         ofs << task.content;
+        ofs.flush();
         if (ofs.fail()) {
-            std::cerr << "[PersistenceService] Write failed during output: " << tempPath << std::endl;
-            try { fs::remove(tempPath); } catch (...) {}
-            return;
+            std::cerr << "[PersistenceService] Append failed: " << finalPath << std::endl;
+            return false;
         }
-        ofs.flush();
-    } // Close happens here automatically
+    }
 
-    // 3. Atomic Rename
-    try {
-        fs::rename(tempPath, finalPath);
-    } catch (const std::filesystem::filesystem_error& e) {
-        std::cerr << "[PersistenceService] Rename failed: " << e.what() << std::endl;
-        // Attempt cleanup
-        try { fs::remove(tempPath); } catch (...) {}
+    if (m_fsyncPolicy != FsyncPolicy::None && !SyncPath(finalPath, false)) {
+        std::cerr << "[PersistenceService] fsync failed: " << finalPath << std::endl;
     }
+    return true;
 }
 
 } // namespace ideawalker::infrastructure
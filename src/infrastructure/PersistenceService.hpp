@@ -6,13 +6,15 @@
 #pragma once
 #include <string>
 #include <vector>
-#include <queue>
+#include <deque>
+#include <unordered_map>
 #include <mutex>
 #include <condition_variable>
 #include <thread>
 #include <atomic>
 #include <optional>
 #include <functional>
+#include <cstdint>
 
 namespace ideawalker::infrastructure {
 
@@ -24,18 +26,53 @@ struct SaveTask {
     std::string filename;
     std::string content;
     bool isUrgent = false; // Could be used to prioritize (not implemented yet)
+    bool append = false;   ///< Append to the file instead of replacing it.
+};
+
+/**
+ * @enum FsyncPolicy
+ * @brief Durability level applied by the write-behind worker.
+ */
+enum class FsyncPolicy {
+    None,   ///< temp -> rename, no fsync (fastest, may lose data on power loss).
+    Rename, ///< fsync the temp file before rename (no torn files after a crash).
+    Full    ///< Rename + fsync of each touched directory once per batch.
+};
+
+/**
+ * @struct PersistenceMetrics
+ * @brief Snapshot of the write-behind queue counters.
+ */
+struct PersistenceMetrics {
+    std::size_t queueDepth = 0;      ///< Distinct paths currently pending.
+    std::size_t peakQueueDepth = 0;  ///< Highest queue depth observed.
+    std::uint64_t enqueued = 0;      ///< Total save/append requests.
+    std::uint64_t coalesced = 0;     ///< Saves merged into a pending write of the same path.
+    std::uint64_t written = 0;       ///< Files successfully written.
+    std::uint64_t failed = 0;        ///< Writes that failed.
+    std::uint64_t batches = 0;       ///< Group commits performed.
+    double lastWriteMs = 0.0;        ///< Latency of the last file write.
+    double avgWriteMs = 0.0;         ///< Mean latency per file write.
+    double maxWriteMs = 0.0;         ///< Worst latency per file write.
+    double lastBatchMs = 0.0;        ///< Duration of the last group commit.
 };
 
 /**
  * @class PersistenceService
  * @brief Manages a background thread that performs atomic file writes sequentially.
- * 
+ *
  * This service eliminates race conditions on file writing by ensuring that
- * all write operations pass through a single serialized queue.
+ * all write operations pass through a single serialized queue. Pending saves
+ * are coalesced by path (last write wins) and drained in batches, so a burst
+ * of saves to the same file costs a single temp -> rename.
  */
 class PersistenceService {
 public:
-    PersistenceService();
+    /**
+     * @param fsyncPolicy Durability level for each group commit.
+     * @param maxBatchSize Maximum number of files written per group commit.
+     */
+    explicit PersistenceService(FsyncPolicy fsyncPolicy = FsyncPolicy::Rename, std::size_t maxBatchSize = 64);
     ~PersistenceService();
 
     /**
@@ -45,12 +82,53 @@ public:
      */
     void saveTextAsync(const std::string& filename, const std::string& content);
 
+    /**
+     * @brief Asynchronously appends text to a file (created if missing).
+     *
+     * Appends queued for the same path are concatenated in call order; an
+     * append queued after a pending save extends that save's content.
+     * @param filename Absolute path to the file.
+     * @param content The string content to append.
+     */
+    void appendTextAsync(const std::string& filename, const std::string& content);
+
+    /**
+     * @brief Blocks until every save queued before this call is on disk.
+     */
+    void flush();
+
     /**
      * @brief Stops the worker thread and ensures all pending tasks are processed.
      */
     void stop();
 
+    /** @brief Returns a snapshot of queue depth and write latency counters. */
+    PersistenceMetrics getMetrics() const;
+
+    FsyncPolicy getFsyncPolicy() const { return m_fsyncPolicy; }
+
+    /**
+     * @brief Synchronously writes a group of files (temp -> rename each) with up to @p workers threads.
+     *
+     * Unlike the write-behind queue, the call returns only once the whole group is
+     * in place: each temp file is fsynced before its rename (unless @p policy is
+     * None) and every touched directory is fsynced once, after all renames. Callers
+     * that publish the group through a marker file (a manifest) write it afterwards,
+     * so the marker never points at files that may still be missing after a crash.
+     * @param files Files to write; `append` is ignored.
+     * @param error Receives the paths that failed.
+     * @return True when every file is in place.
+     */
+    static bool WriteGroup(const std::vector<SaveTask>& files, FsyncPolicy policy, std::size_t workers,
+                           std::string& error);
+
 private:
+    struct PendingWrite {
+        std::string content;
+        std::uint64_t sequence = 0;
+        bool append = false;
+    };
+
     /**
      * @brief The main loop running in the background thread.
      */
@@ -58,17 +136,42 @@ private:
 
     /**
      * @brief Performs the actual atomic write (temp -> rename).
+     * @return True when the final file is in place.
+     */
+    bool performAtomicWrite(const SaveTask& task);
+
+    /**
+     * @brief Appends to the target file, fsyncing it according to the policy.
+     * @return True when the content was appended.
      */
-    void performAtomicWrite(const SaveTask& task);
+    bool performAppend(const SaveTask& task);
+
+    /** @brief Queues a write for a path, merging with any pending one (lock held). */
+    void enqueueLocked(const std::string& filename, const std::string& content, bool append);
+
+    /** @brief Sequence number below which every save is durable (lock held). */
+    std::uint64_t computeDurableSequenceLocked() const;
+
+    FsyncPolicy m_fsyncPolicy;
+    std::size_t m_maxBatchSize;
 
     // Thread Safety
-    std::queue<SaveTask> m_queue;
-    std::mutex m_mutex;
+    std::unordered_map<std::string, PendingWrite> m_pending;
+    std::deque<std::string> m_order;
+    mutable std::mutex m_mutex;
     std::condition_variable m_cv;
-    
+    std::condition_variable m_flushCv;
+
+    // Barrier bookkeeping
+    std::uint64_t m_submittedSequence = 0;
+    std::uint64_t m_durableSequence = 0;
+
+    PersistenceMetrics m_metrics;
+
     // Worker Control
     std::thread m_worker;
     std::atomic<bool> m_running;
+    bool m_workerExited = false;
 };
 
 } // namespace ideawalker::infrastructure
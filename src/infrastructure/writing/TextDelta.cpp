@@ -0,0 +1,237 @@
+/**
+ * @file TextDelta.cpp
+ * @brief Implementation of TextDelta (Myers diff over word tokens).
+ */
+
+#include "TextDelta.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <string_view>
+#include <vector>
+
+namespace ideawalker::infrastructure::writing {
+
+using json = nlohmann::json;
+
+namespace {
+
+// Edit distance beyond which the middle section is replaced wholesale.
+constexpr int kMaxEditDistance = 2000;
+
+struct Token {
+    std::string_view text;
+    std::uint64_t hash;
+};
+
+std::uint64_t HashToken(std::string_view text) {
+    std::uint64_t h = 1469598103934665603ULL;
+    for (unsigned char c : text) {
+        h ^= c;
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+// A token is a run of non-space characters plus the whitespace that follows it,
+// so concatenating the tokens gives back the original text.
+std::vector<Token> Tokenize(const std::string& text) {
+    std::vector<Token> tokens;
+    const std::size_t n = text.size();
+    std::size_t i = 0;
+    while (i < n) {
+        const std::size_t start = i;
+        while (i < n && !std::isspace(static_cast<unsigned char>(text[i]))) ++i;
+        while (i < n && std::isspace(static_cast<unsigned char>(text[i]))) ++i;
+        std::string_view view(text.data() + start, i - start);
+        tokens.push_back({view, HashToken(view)});
+    }
+    return tokens;
+}
+
+bool SameToken(const Token& a, const Token& b) {
+    return a.hash == b.hash && a.text == b.text;
+}
+
+enum class EditKind { Equal, Delete, Insert };
+
+/**
+ * @brief Myers O((N+M)D) shortest edit script over a[aBegin,aEnd) / b[bBegin,bEnd).
+ * Appends token-level edits in order; returns false if D exceeds kMaxEditDistance.
+ */
+bool MyersDiff(const std::vector<Token>& a, std::size_t aBegin, std::size_t aEnd,
+               const std::vector<Token>& b, std::size_t bBegin, std::size_t bEnd,
+               std::vector<std::pair<EditKind, std::size_t>>& edits) {
+    const int n = static_cast<int>(aEnd - aBegin);
+    const int m = static_cast<int>(bEnd - bBegin);
+    const int maxD = std::min(n + m, kMaxEditDistance);
+
+    auto equalAt = [&](int x, int y) {
+        return SameToken(a[aBegin + x], b[bBegin + y]);
+    };
+
+    // trace[d][k + d] = furthest x reached on diagonal k after d edits.
+    std::vector<std::vector<int>> trace;
+    int finalD = -1;
+    for (int d = 0; d <= maxD && finalD < 0; ++d) {
+        std::vector<int> v(2 * d + 1, 0);
+        const std::vector<int>* prev = d > 0 ? &trace.back() : nullptr;
+        auto prevAt = [&](int k) { return (*prev)[k + d - 1]; };
+        for (int k = -d; k <= d; k += 2) {
+            int x;
+            if (d == 0) {
+                x = 0;
+            } else if (k == -d || (k != d && prevAt(k - 1) < prevAt(k + 1))) {
+                x = prevAt(k + 1);      // insertion (move down)
+            } else {
+                x = prevAt(k - 1) + 1;  // deletion (move right)
+            }
+            int y = x - k;
+            while (x < n && y < m && equalAt(x, y)) { ++x; ++y; }
+            v[k + d] = x;
+            if (x >= n && y >= m) { finalD = d; }
+        }
+        trace.push_back(std::move(v));
+    }
+    if (finalD < 0) return false;
+
+    std::vector<std::pair<EditKind, std::size_t>> reversed;
+    int x = n;
+    int y = m;
+    for (int d = finalD; d > 0; --d) {
+        const auto& prev = trace[d - 1];
+        auto prevAt = [&](int k) { return prev[k + d - 1]; };
+        const int k = x - y;
+        const bool insertion = (k == -d || (k != d && prevAt(k - 1) < prevAt(k + 1)));
+        const int prevK = insertion ? k + 1 : k - 1;
+        const int prevX = prevAt(prevK);
+        const int prevY = prevX - prevK;
+        while (x > prevX && y > prevY) {
+            reversed.push_back({EditKind::Equal, aBegin + x - 1});
+            --x; --y;
+        }
+        if (insertion) {
+            reversed.push_back({EditKind::Insert, bBegin + prevY});
+        } else {
+            reversed.push_back({EditKind::Delete, aBegin + prevX});
+        }
+        x = prevX;
+        y = prevY;
+    }
+    while (x > 0 && y > 0) {
+        reversed.push_back({EditKind::Equal, aBegin + x - 1});
+        --x; --y;
+    }
+    edits.insert(edits.end(), reversed.rbegin(), reversed.rend());
+    return true;
+}
+
+class OpsBuilder {
+public:
+    void copy(std::size_t n) {
+        if (n == 0) return;
+        flushPending(PendingKind::Copy);
+        m_count += n;
+    }
+    void remove(std::size_t n) {
+        if (n == 0) return;
+        flushPending(PendingKind::Delete);
+        m_count += n;
+    }
+    void insert(std::string_view text) {
+        if (text.empty()) return;
+        flushPending(PendingKind::Insert);
+        m_text.append(text.data(), text.size());
+    }
+    json finish() {
+        // A trailing copy is implicit.
+        if (m_kind != PendingKind::Copy) flushPending(PendingKind::None);
+        return std::move(m_ops);
+    }
+
+private:
+    enum class PendingKind { None, Copy, Delete, Insert };
+
+    void flushPending(PendingKind next) {
+        if (m_kind == next) return;
+        if (m_kind == PendingKind::Copy) m_ops.push_back(static_cast<long long>(m_count));
+        else if (m_kind == PendingKind::Delete) m_ops.push_back(-static_cast<long long>(m_count));
+        else if (m_kind == PendingKind::Insert) m_ops.push_back(m_text);
+        m_kind = next;
+        m_count = 0;
+        m_text.clear();
+    }
+
+    json m_ops = json::array();
+    PendingKind m_kind = PendingKind::None;
+    std::size_t m_count = 0;
+    std::string m_text;
+};
+
+} // namespace
+
+json TextDelta::Encode(const std::string& from, const std::string& to) {
+    const auto a = Tokenize(from);
+    const auto b = Tokenize(to);
+
+    // Common prefix/suffix keep the diff window small for typical local edits.
+    std::size_t prefix = 0;
+    while (prefix < a.size() && prefix < b.size() && SameToken(a[prefix], b[prefix])) ++prefix;
+    std::size_t suffix = 0;
+    while (suffix < a.size() - prefix && suffix < b.size() - prefix &&
+           SameToken(a[a.size() - 1 - suffix], b[b.size() - 1 - suffix])) {
+        ++suffix;
+    }
+
+    OpsBuilder ops;
+    for (std::size_t i = 0; i < prefix; ++i) ops.copy(a[i].text.size());
+
+    std::vector<std::pair<EditKind, std::size_t>> edits;
+    if (MyersDiff(a, prefix, a.size() - suffix, b, prefix, b.size() - suffix, edits)) {
+        for (const auto& [kind, index] : edits) {
+            if (kind == EditKind::Equal) ops.copy(a[index].text.size());
+            else if (kind == EditKind::Delete) ops.remove(a[index].text.size());
+            else ops.insert(b[index].text);
+        }
+    } else {
+        for (std::size_t i = prefix; i < a.size() - suffix; ++i) ops.remove(a[i].text.size());
+        for (std::size_t i = prefix; i < b.size() - suffix; ++i) ops.insert(b[i].text);
+    }
+
+    for (std::size_t i = a.size() - suffix; i < a.size(); ++i) ops.copy(a[i].text.size());
+    return ops.finish();
+}
+
+std::optional<std::string> TextDelta::Apply(const std::string& base, const json& ops) {
+    if (!ops.is_array()) return std::nullopt;
+
+    std::string out;
+    out.reserve(base.size());
+    std::size_t pos = 0;
+    for (const auto& op : ops) {
+        if (op.is_string()) {
+            out += op.get_ref<const std::string&>();
+        } else if (op.is_number_integer()) {
+            const long long n = op.get<long long>();
+            const std::size_t count = static_cast<std::size_t>(n < 0 ? -n : n);
+            if (pos + count > base.size()) return std::nullopt;
+            if (n > 0) out.append(base, pos, count);
+            pos += count;
+        } else {
+            return std::nullopt;
+        }
+    }
+    out.append(base, pos, std::string::npos);
+    return out;
+}
+
+std::uint32_t TextDelta::Checksum(const std::string& text) {
+    std::uint32_t h = 2166136261u;
+    for (unsigned char c : text) {
+        h ^= c;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+} // namespace ideawalker::infrastructure::writing
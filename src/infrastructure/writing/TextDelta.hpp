@@ -0,0 +1,37 @@
+/**
+ * @file TextDelta.hpp
+ * @brief Compact word-level text diffs for revision events.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include <nlohmann/json.hpp>
+
+namespace ideawalker::infrastructure::writing {
+
+/**
+ * @class TextDelta
+ * @brief Encodes the change between two texts as a word-level edit script.
+ *
+ * The script is a JSON array applied left to right over the base text:
+ * a positive integer copies that many characters, a negative integer skips
+ * (deletes) that many characters and a string inserts itself. Characters of
+ * the base left after the last op are copied implicitly.
+ */
+class TextDelta {
+public:
+    /** @brief Builds the edit script turning @p from into @p to. */
+    static nlohmann::json Encode(const std::string& from, const std::string& to);
+
+    /** @brief Applies an edit script; nullopt if it does not fit @p base. */
+    static std::optional<std::string> Apply(const std::string& base, const nlohmann::json& ops);
+
+    /** @brief FNV-1a checksum used to verify reconstructed content. */
+    static std::uint32_t Checksum(const std::string& text);
+};
+
+} // namespace ideawalker::infrastructure::writing
@@ -4,6 +4,8 @@
  */
 
 #include "WritingEventStoreFs.hpp"
+#include "domain/writing/repositories/IWritingTrajectoryRepository.hpp"
+#include "infrastructure/JsonScanner.hpp"
 #include <fstream>
 #include <sstream>
 #include <filesystem>
@@ -15,6 +17,47 @@ namespace ideawalker::infrastructure::writing {
 using json = nlohmann::json;
 namespace fs = std::filesystem;
 
+namespace {
+
+/** Payloads are stored JSON text; one that is valid and has no line break can be spliced in verbatim. */
+bool IsSplicable(std::string_view payload) {
+    return payload.find('\n') == std::string_view::npos && JsonScanner::parse(payload).has_value();
+}
+
+/**
+ * Reads an event line without building a DOM: only the envelope fields are decoded and the
+ * payload keeps its original text (the repository parses it when the event is applied).
+ */
+std::optional<StoredEvent> ParseEventLine(std::string_view line) {
+    StoredEvent evt;
+    std::optional<std::string> type;
+    std::string_view data = "null";
+    std::int64_t ts = 0;
+    bool typesOk = true;
+    const bool wellFormed = JsonScanner::forEachMember(line, [&](std::string_view key, const JsonScanner::Value& value) {
+        if (key == "type") {
+            type = value.asString();
+        } else if (key == "data") {
+            data = value.raw;
+        } else if (key == "schemaVersion") {
+            const auto version = value.asInt();
+            typesOk = typesOk && version.has_value();
+            evt.schemaVersion = static_cast<int>(version.value_or(1));
+        } else if (key == "ts") {
+            const auto millis = value.asInt();
+            typesOk = typesOk && millis.has_value();
+            ts = millis.value_or(0);
+        }
+    });
+    if (!wellFormed || !typesOk || !type) return std::nullopt;
+    evt.eventType = std::move(*type);
+    evt.eventDataJson = std::string(data);
+    evt.timestamp = std::chrono::time_point<std::chrono::system_clock>(std::chrono::milliseconds(ts));
+    return evt;
+}
+
+} // namespace
+
 WritingEventStoreFs::WritingEventStoreFs(std::string projectRoot, std::shared_ptr<PersistenceService> persistence)
     : m_projectRoot(std::move(projectRoot)), m_persistence(std::move(persistence)) {}
 
@@ -27,66 +70,248 @@ std::string WritingEventStoreFs::getEventsFilePath(const std::string& trajectory
     return (path / "events.ndjson").string();
 }
 
-void WritingEventStoreFs::append(const std::string& trajectoryId, const std::vector<StoredEvent>& events) {
-    if (events.empty()) return;
+std::size_t WritingEventStoreFs::append(const std::string& trajectoryId,
+                                       const std::vector<StoredEvent>& events,
+                                       std::optional<std::size_t> expectedEventCount) {
+    std::string filepath = getEventsFilePath(trajectoryId, !events.empty());
 
-    std::string filepath = getEventsFilePath(trajectoryId, true);
-    
+    std::lock_guard<std::mutex> lock(m_positionsMutex);
+    EventStreamPosition current;
+    std::error_code ec;
+    const auto fileSize = fs::exists(filepath) ? fs::file_size(filepath, ec) : 0;
+    auto cached = m_positions.find(trajectoryId);
+    if (cached != m_positions.end() && !ec && cached->second.byteOffset == fileSize) {
+        current = cached->second;
+    } else {
+        current = countEvents(filepath);
+    }
+
+    if (expectedEventCount && *expectedEventCount != current.eventCount) {
+        m_positions[trajectoryId] = current;
+        throw ConcurrencyError("Trajectory " + trajectoryId + " has " + std::to_string(current.eventCount) +
+                               " events, expected " + std::to_string(*expectedEventCount));
+    }
+    if (events.empty()) return current.eventCount;
+
+    std::string buffer;
+    for (const auto& evt : events) {
+        buffer += toLine(evt);
+        buffer += "\n";
+    }
 
-    
     // Use synchronous append for data integrity and immediate consistency.
     // This avoids race conditions between creation and subsequent reads, 
     // and ensures events are not lost if the application closes immediately.
-    std::ofstream outFile(filepath, std::ios::app);
+    std::ofstream outFile(filepath, std::ios::app | std::ios::binary);
     if (!outFile) {
         std::cerr << "[WritingEventStoreFs] Failed to open events file for append: " << filepath << std::endl;
-        return;
+        throw std::runtime_error("Failed to append events for trajectory " + trajectoryId);
     }
+    outFile << buffer;
+    outFile.flush();
+    if (!outFile) {
+        m_positions.erase(trajectoryId); // Unknown partial write: recount next time
+        throw std::runtime_error("Failed to append events for trajectory " + trajectoryId);
+    }
+
+    current.eventCount += events.size();
+    current.byteOffset += buffer.size();
+    m_positions[trajectoryId] = current;
+    return current.eventCount;
+}
+
+EventStreamPosition WritingEventStoreFs::position(const std::string& trajectoryId) {
+    std::string filepath = getEventsFilePath(trajectoryId, false);
+    std::lock_guard<std::mutex> lock(m_positionsMutex);
+    std::error_code ec;
+    const auto fileSize = fs::exists(filepath) ? fs::file_size(filepath, ec) : 0;
+    auto cached = m_positions.find(trajectoryId);
+    if (cached != m_positions.end() && !ec && cached->second.byteOffset == fileSize) {
+        return cached->second;
+    }
+    auto current = countEvents(filepath);
+    m_positions[trajectoryId] = current;
+    return current;
+}
+
+EventStreamPosition WritingEventStoreFs::countEvents(const std::string& filepath) {
+    // Same rule as readFrom: every non-empty line is one event, parsed or not.
+    EventStreamPosition position;
+    std::ifstream inFile(filepath, std::ios::binary);
+    std::string line;
+    while (std::getline(inFile, line)) {
+        position.byteOffset += line.size() + (inFile.eof() ? 0 : 1);
+        if (!line.empty() && line != "\r") ++position.eventCount;
+    }
+    return position;
+}
 
+std::string WritingEventStoreFs::toLine(const StoredEvent& evt) {
+    const long long ts = std::chrono::duration_cast<std::chrono::milliseconds>(evt.timestamp.time_since_epoch()).count();
+    if (IsSplicable(evt.eventDataJson)) {
+        // Same bytes as the DOM path (keys in nlohmann's sorted order), without re-parsing the payload.
+        std::string line = "{\"data\":";
+        line += evt.eventDataJson;
+        line += ",\"schemaVersion\":" + std::to_string(evt.schemaVersion);
+        line += ",\"ts\":" + std::to_string(ts);
+        line += ",\"type\":" + json(evt.eventType).dump() + "}";
+        return line;
+    }
+    json j;
+    j["schemaVersion"] = evt.schemaVersion;
+    j["type"] = evt.eventType;
+    j["data"] = json::parse(evt.eventDataJson);
+    j["ts"] = std::chrono::duration_cast<std::chrono::milliseconds>(
+        evt.timestamp.time_since_epoch()).count();
+    return j.dump();
+}
+
+bool WritingEventStoreFs::rewrite(const std::string& trajectoryId, const std::vector<StoredEvent>& events) {
+    const std::string filepath = getEventsFilePath(trajectoryId, true);
+    std::string content;
     for (const auto& evt : events) {
-        json j;
-        j["schemaVersion"] = 1;
-        j["type"] = evt.eventType;
-        j["data"] = json::parse(evt.eventDataJson);
-        j["ts"] = std::chrono::duration_cast<std::chrono::milliseconds>(
-            evt.timestamp.time_since_epoch()).count();
-        outFile << j.dump() << "\n";
+        content += toLine(evt);
+        content += "\n";
     }
-    // File closes automatically and flushes handles
+
+    // A queued write-behind snapshot must land now, or it would resurrect after being dropped below.
+    if (m_persistence) m_persistence->flush();
+
+    // The log is the only copy of the history: the temp file is fsynced before the rename.
+    std::string error;
+    const bool written = PersistenceService::WriteGroup({SaveTask{filepath, content}}, FsyncPolicy::Full, 1, error);
+    {
+        std::lock_guard<std::mutex> lock(m_positionsMutex);
+        m_positions.erase(trajectoryId);
+    }
+    if (!written) {
+        std::cerr << "[WritingEventStoreFs] Failed to replace events file: " << error << std::endl;
+        return false;
+    }
+
+    // The snapshot's offsets refer to the old log; drop it only once the new log is in place.
+    std::error_code ec;
+    fs::remove(getSnapshotFilePath(trajectoryId), ec);
+    if (ec) {
+        std::cerr << "[WritingEventStoreFs] Failed to drop stale snapshot: " << ec.message() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+std::uint64_t WritingEventStoreFs::logSize(const std::string& trajectoryId) {
+    std::error_code ec;
+    const auto size = fs::file_size(getEventsFilePath(trajectoryId, false), ec);
+    return ec ? 0 : size;
 }
 
 std::vector<StoredEvent> WritingEventStoreFs::readAll(const std::string& trajectoryId) {
+    auto events = readFrom(trajectoryId, EventStreamPosition{});
+    return events ? std::move(*events) : std::vector<StoredEvent>{};
+}
+
+std::optional<std::vector<StoredEvent>> WritingEventStoreFs::readFrom(const std::string& trajectoryId,
+                                                                      const EventStreamPosition& from,
+                                                                      EventStreamPosition* end) {
     std::vector<StoredEvent> results;
+    EventStreamPosition position = from;
     std::string filepath = getEventsFilePath(trajectoryId, false);
     
-    if (!fs::exists(filepath)) return results;
+    if (!fs::exists(filepath)) {
+        if (from.byteOffset > 0) return std::nullopt;
+        if (end) *end = position;
+        return results;
+    }
+
+    std::error_code ec;
+    const auto fileSize = fs::file_size(filepath, ec);
+    if (ec || from.byteOffset > fileSize) return std::nullopt;
 
-    std::ifstream inFile(filepath);
+    std::ifstream inFile(filepath, std::ios::binary);
     if (!inFile) {
         std::cerr << "[WritingEventStoreFs] Failed to open events file for read: " << filepath << std::endl;
-        return results;
+        return std::nullopt;
     }
+    inFile.seekg(static_cast<std::streamoff>(from.byteOffset));
+
     std::string line;
     while (std::getline(inFile, line)) {
-        if (line.empty()) continue;
-        try {
-            auto j = json::parse(line);
-            StoredEvent evt;
-            evt.eventType = j["type"].get<std::string>();
-            evt.eventDataJson = j["data"].dump(); // Keep as string for later parsing
-            
-            long long ts = j.value("ts", 0LL);
-            evt.timestamp = std::chrono::time_point<std::chrono::system_clock>(
-                std::chrono::milliseconds(ts));
-            
-            results.push_back(evt);
-        } catch (...) {
+        position.byteOffset += line.size() + (inFile.eof() ? 0 : 1);
+        if (line.empty() || line == "\r") continue;
+        ++position.eventCount;
+        if (auto evt = ParseEventLine(line)) {
+            results.push_back(std::move(*evt));
+        } else {
             std::cerr << "[WritingEventStoreFs] Ignoring malformed event line in: " << filepath << std::endl;
         }
     }
+    if (end) *end = position;
+    {
+        std::lock_guard<std::mutex> lock(m_positionsMutex);
+        m_positions[trajectoryId] = position;
+    }
     return results;
 }
 
+std::string WritingEventStoreFs::getSnapshotFilePath(const std::string& trajectoryId) const {
+    return (fs::path(m_projectRoot) / "writing" / "trajectories" / trajectoryId / "snapshot.json").string();
+}
+
+std::optional<StoredSnapshot> WritingEventStoreFs::loadSnapshot(const std::string& trajectoryId) {
+    std::string filepath = getSnapshotFilePath(trajectoryId);
+    if (!fs::exists(filepath)) return std::nullopt;
+
+    std::ifstream inFile(filepath, std::ios::binary);
+    if (!inFile) return std::nullopt;
+    std::stringstream buffer;
+    buffer << inFile.rdbuf();
+    const std::string raw = buffer.str();
+
+    // The state is handed over as text; only the small header is decoded here.
+    std::optional<std::int64_t> version, eventCount, byteOffset;
+    std::string_view state;
+    const bool wellFormed = JsonScanner::forEachMember(raw, [&](std::string_view key, const JsonScanner::Value& value) {
+        if (key == "snapshotVersion") version = value.asInt();
+        else if (key == "eventCount") eventCount = value.asInt();
+        else if (key == "byteOffset") byteOffset = value.asInt();
+        else if (key == "state") state = value.raw;
+    });
+    if (!wellFormed || !eventCount || !byteOffset || *eventCount < 0 || *byteOffset < 0) {
+        std::cerr << "[WritingEventStoreFs] Ignoring malformed snapshot: " << filepath << std::endl;
+        return std::nullopt;
+    }
+    if (version.value_or(0) != 1 || state.empty()) return std::nullopt;
+    StoredSnapshot snapshot;
+    snapshot.position.eventCount = static_cast<std::size_t>(*eventCount);
+    snapshot.position.byteOffset = static_cast<std::uint64_t>(*byteOffset);
+    snapshot.stateJson = std::string(state);
+    return snapshot;
+}
+
+void WritingEventStoreFs::saveSnapshot(const std::string& trajectoryId, const StoredSnapshot& snapshot) {
+    std::string text;
+    if (IsSplicable(snapshot.stateJson)) {
+        text = "{\"byteOffset\":" + std::to_string(snapshot.position.byteOffset) +
+               ",\"eventCount\":" + std::to_string(snapshot.position.eventCount) +
+               ",\"snapshotVersion\":1,\"state\":" + snapshot.stateJson + "}";
+    } else {
+        json j;
+        j["snapshotVersion"] = 1;
+        j["eventCount"] = snapshot.position.eventCount;
+        j["byteOffset"] = snapshot.position.byteOffset;
+        j["state"] = json::parse(snapshot.stateJson);
+        text = j.dump();
+    }
+
+    // A stale or missing snapshot only costs a longer replay, so write-behind is fine here.
+    if (m_persistence) {
+        m_persistence->saveTextAsync(getSnapshotFilePath(trajectoryId), text);
+        return;
+    }
+    std::ofstream outFile(getSnapshotFilePath(trajectoryId));
+    outFile << text;
+}
+
 std::vector<std::string> WritingEventStoreFs::getAllTrajectoryIds() {
     std::vector<std::string> ids;
     fs::path rootPath = fs::path(m_projectRoot) / "writing" / "trajectories";
@@ -104,4 +329,26 @@ std::vector<std::string> WritingEventStoreFs::getAllTrajectoryIds() {
     return ids;
 }
 
+std::string WritingEventStoreFs::getSummaryIndexPath() const {
+    return (fs::path(m_projectRoot) / "writing" / "trajectories" / "index.json").string();
+}
+
+std::optional<std::string> WritingEventStoreFs::loadSummaryIndex() {
+    std::ifstream inFile(getSummaryIndexPath());
+    if (!inFile) return std::nullopt;
+    std::stringstream ss;
+    ss << inFile.rdbuf();
+    return ss.str();
+}
+
+void WritingEventStoreFs::saveSummaryIndex(const std::string& indexJson) {
+    // Derived data: rebuilt from the logs if lost, so write-behind is enough.
+    if (m_persistence) {
+        m_persistence->saveTextAsync(getSummaryIndexPath(), indexJson);
+        return;
+    }
+    std::ofstream outFile(getSummaryIndexPath());
+    outFile << indexJson;
+}
+
 } // namespace ideawalker::infrastructure::writing
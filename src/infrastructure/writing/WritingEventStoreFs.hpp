@@ -8,6 +8,10 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <optional>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
 #include "domain/writing/events/WritingEvents.hpp"
 #include "infrastructure/PersistenceService.hpp"
 
@@ -19,26 +23,78 @@ struct StoredEvent {
     std::string eventType;
     std::string eventDataJson; // The payload
     std::chrono::system_clock::time_point timestamp;
+    int schemaVersion = 1;     // Payload layout version (2 = delta-encoded SegmentRevised)
+};
+
+// Position in an events.ndjson stream (events consumed and byte offset of the next line)
+struct EventStreamPosition {
+    std::size_t eventCount = 0;
+    std::uint64_t byteOffset = 0;
+};
+
+// Aggregate snapshot covering the first position.eventCount events of a stream
+struct StoredSnapshot {
+    EventStreamPosition position;
+    std::string stateJson;
 };
 
 class WritingEventStoreFs {
 public:
     explicit WritingEventStoreFs(std::string projectRoot, std::shared_ptr<PersistenceService> persistence);
 
-    // Appends new events to the log
-    void append(const std::string& trajectoryId, const std::vector<StoredEvent>& events);
+    // Appends new events to the log and returns the resulting event count.
+    // With expectedEventCount, throws ConcurrencyError if the stream holds a different number
+    // of events (another writer got there first). Throws std::runtime_error on I/O failure.
+    std::size_t append(const std::string& trajectoryId,
+                       const std::vector<StoredEvent>& events,
+                       std::optional<std::size_t> expectedEventCount = std::nullopt);
+
+    // Current end of the stream (cached; re-counted if the file changed behind our back)
+    EventStreamPosition position(const std::string& trajectoryId);
 
     // Reads all events for a trajectory
     std::vector<StoredEvent> readAll(const std::string& trajectoryId);
 
+    // Reads the events after `from`; nullopt if `from` lies beyond the stream (stale snapshot).
+    // When `end` is given it receives the position after the last event read.
+    std::optional<std::vector<StoredEvent>> readFrom(const std::string& trajectoryId,
+                                                     const EventStreamPosition& from,
+                                                     EventStreamPosition* end = nullptr);
+
+    // Latest aggregate snapshot (<id>/snapshot.json), if any
+    std::optional<StoredSnapshot> loadSnapshot(const std::string& trajectoryId);
+
+    // Replaces the snapshot of a trajectory (atomic write through PersistenceService)
+    void saveSnapshot(const std::string& trajectoryId, const StoredSnapshot& snapshot);
+
+    // Replaces the whole log (offline compaction) through a durable temp -> rename, then drops the
+    // snapshot, whose offsets no longer apply. Returns false if the new log could not be put in
+    // place (the old one is then left untouched) or the stale snapshot could not be removed.
+    bool rewrite(const std::string& trajectoryId, const std::vector<StoredEvent>& events);
+
+    // Size in bytes of the events log (0 if missing)
+    std::uint64_t logSize(const std::string& trajectoryId);
+
     // List all trajectory IDs found in storage
     std::vector<std::string> getAllTrajectoryIds();
 
+    // Trajectory summary index (writing/trajectories/index.json)
+    std::optional<std::string> loadSummaryIndex();
+    void saveSummaryIndex(const std::string& indexJson);
+
 private:
     std::string m_projectRoot;
     std::shared_ptr<PersistenceService> m_persistence;
+
+    std::mutex m_positionsMutex;
+    std::unordered_map<std::string, EventStreamPosition> m_positions;
+
+    EventStreamPosition countEvents(const std::string& filepath);
+    std::string getSummaryIndexPath() const;
     
     std::string getEventsFilePath(const std::string& trajectoryId, bool ensureDirectories);
+    std::string getSnapshotFilePath(const std::string& trajectoryId) const;
+    static std::string toLine(const StoredEvent& evt);
 };
 
 } // namespace ideawalker::infrastructure::writing
@@ -4,21 +4,229 @@
  */
 
 #include "WritingTrajectoryRepositoryFs.hpp"
+#include "TextDelta.hpp"
 #include <nlohmann/json.hpp>
 #include <iostream>
+#include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
 
 namespace ideawalker::infrastructure::writing {
 
 using json = nlohmann::json;
 
-WritingTrajectoryRepositoryFs::WritingTrajectoryRepositoryFs(std::unique_ptr<WritingEventStoreFs> eventStore)
-    : m_eventStore(std::move(eventStore)) {}
+namespace {
+
+constexpr int kDeltaRevisionSchemaVersion = 2;
+
+RevisionOperation OperationFromString(const std::string& opStr) {
+    if (opStr == "compress") return RevisionOperation::Compress;
+    if (opStr == "expand") return RevisionOperation::Expand;
+    if (opStr == "reorganize") return RevisionOperation::Reorganize;
+    if (opStr == "cite") return RevisionOperation::Cite;
+    if (opStr == "remove") return RevisionOperation::Remove;
+    if (opStr == "reframe") return RevisionOperation::Reframe;
+    if (opStr == "correction") return RevisionOperation::Correction;
+    return RevisionOperation::Clarify; // Default
+}
+
+TrajectoryStage StageFromString(const std::string& str) {
+    if (str == "Outline") return TrajectoryStage::Outline;
+    if (str == "Drafting") return TrajectoryStage::Drafting;
+    if (str == "Revising") return TrajectoryStage::Revising;
+    if (str == "Consolidating") return TrajectoryStage::Consolidating;
+    if (str == "ReadyForDefense") return TrajectoryStage::ReadyForDefense;
+    if (str == "Final") return TrajectoryStage::Final;
+    return TrajectoryStage::Intent;
+}
+
+std::string DefenseStatusToString(DefenseStatus status) {
+    switch (status) {
+        case DefenseStatus::Rehearsed: return "Rehearsed";
+        case DefenseStatus::Passed: return "Passed";
+        default: return "Pending";
+    }
+}
+
+DefenseStatus DefenseStatusFromString(const std::string& str) {
+    if (str == "Rehearsed") return DefenseStatus::Rehearsed;
+    if (str == "Passed") return DefenseStatus::Passed;
+    return DefenseStatus::Pending;
+}
+
+long long ToMillis(std::chrono::system_clock::time_point tp) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(tp.time_since_epoch()).count();
+}
+
+std::chrono::system_clock::time_point FromMillis(long long ms) {
+    return std::chrono::system_clock::time_point(std::chrono::milliseconds(ms));
+}
+
+// Full aggregate state, as it would result from replaying every covered event
+json SnapshotState(const WritingTrajectory& trajectory) {
+    const auto& intent = trajectory.getIntent();
+    json state;
+    state["intent"] = {
+        {"purpose", intent.purpose},
+        {"audience", intent.audience},
+        {"coreClaim", intent.coreClaim},
+        {"constraints", intent.constraints}
+    };
+    state["stage"] = StageToString(trajectory.getStage());
+
+    state["segments"] = json::array();
+    for (const auto& [segId, seg] : trajectory.getSegments()) {
+        state["segments"].push_back({
+            {"segmentId", seg.segmentId},
+            {"title", seg.title},
+            {"content", seg.content},
+            {"sourceTag", SourceTagToString(seg.source)},
+            {"version", seg.version},
+            {"lastModified", ToMillis(seg.lastModified)}
+        });
+    }
+
+    state["history"] = json::array();
+    for (const auto& dec : trajectory.getHistory()) {
+        state["history"].push_back({
+            {"decisionId", dec.decisionId},
+            {"segmentId", dec.targetSegmentId},
+            {"operation", OperationToString(dec.operation)},
+            {"rationale", dec.rationale},
+            {"ts", ToMillis(dec.timestamp)}
+        });
+    }
+
+    state["defenseCards"] = json::array();
+    for (const auto& card : trajectory.getDefenseCards()) {
+        state["defenseCards"].push_back({
+            {"cardId", card.cardId},
+            {"segmentId", card.segmentId},
+            {"prompt", card.prompt},
+            {"expectedPoints", card.expectedDefensePoints},
+            {"status", DefenseStatusToString(card.status)},
+            {"response", card.userDefenseResponse}
+        });
+    }
+    return state;
+}
+
+WritingTrajectory RestoreSnapshot(const std::string& id, const json& state) {
+    const auto& jIntent = state.at("intent");
+    WritingIntent intent;
+    intent.purpose = jIntent.value("purpose", "");
+    intent.audience = jIntent.value("audience", "");
+    intent.coreClaim = jIntent.value("coreClaim", "");
+    intent.constraints = jIntent.value("constraints", "");
+
+    std::map<std::string, DraftSegment> segments;
+    for (const auto& jSeg : state.at("segments")) {
+        DraftSegment seg(jSeg.at("segmentId").get<std::string>(),
+                         jSeg.value("title", ""),
+                         jSeg.value("content", ""),
+                         SourceTagFromString(jSeg.value("sourceTag", "human")));
+        seg.version = jSeg.value("version", 1);
+        seg.lastModified = FromMillis(jSeg.value("lastModified", 0LL));
+        segments.emplace(seg.segmentId, std::move(seg));
+    }
+
+    std::vector<RevisionDecision> history;
+    for (const auto& jDec : state.at("history")) {
+        RevisionDecision dec(jDec.at("decisionId").get<std::string>(),
+                             jDec.at("segmentId").get<std::string>(),
+                             OperationFromString(jDec.value("operation", "clarify")),
+                             jDec.at("rationale").get<std::string>());
+        dec.timestamp = FromMillis(jDec.value("ts", 0LL));
+        history.push_back(std::move(dec));
+    }
+
+    std::vector<DefenseCard> cards;
+    for (const auto& jCard : state.at("defenseCards")) {
+        DefenseCard card(jCard.at("cardId").get<std::string>(),
+                         jCard.value("segmentId", ""),
+                         jCard.value("prompt", ""));
+        card.expectedDefensePoints = jCard.value("expectedPoints", std::vector<std::string>{});
+        card.status = DefenseStatusFromString(jCard.value("status", "Pending"));
+        card.userDefenseResponse = jCard.value("response", "");
+        cards.push_back(std::move(card));
+    }
+
+    return WritingTrajectory::restore(id,
+                                      std::move(intent),
+                                      StageFromString(state.value("stage", "Intent")),
+                                      std::move(segments),
+                                      std::move(history),
+                                      std::move(cards));
+}
+
+// schemaVersion 2 payload: oldContent is implied by the segment state, newContent is
+// a word-level delta against it, or a full keyframe every kRevisionKeyframeInterval versions.
+StoredEvent EncodeRevision(const SegmentRevised& e, const std::string& oldContent, int versionAfter) {
+    json j = {
+        {"segmentId", e.segmentId},
+        {"decisionId", e.decisionId},
+        {"operation", OperationToString(e.operation)},
+        {"rationale", e.rationale},
+        {"sourceTag", e.sourceTag}
+    };
+
+    bool keyframe = versionAfter <= 0 || versionAfter % WritingTrajectoryRepositoryFs::kRevisionKeyframeInterval == 0;
+    if (!keyframe) {
+        json ops = TextDelta::Encode(oldContent, e.newContent);
+        // Only worth it when the script is smaller than the text it replaces.
+        if (ops.dump().size() < e.newContent.size()) {
+            j["encoding"] = "delta";
+            j["ops"] = std::move(ops);
+            j["len"] = e.newContent.size();
+            j["hash"] = TextDelta::Checksum(e.newContent);
+        } else {
+            keyframe = true;
+        }
+    }
+    if (keyframe) {
+        j["encoding"] = "keyframe";
+        j["newContent"] = e.newContent;
+    }
+    return {SegmentRevised::Type, j.dump(), e.timestamp, kDeltaRevisionSchemaVersion};
+}
+
+std::string DecodeRevisedContent(const json& j, const std::string& currentContent) {
+    if (j.value("encoding", "") == "keyframe") {
+        return j.at("newContent").get<std::string>();
+    }
+    auto content = TextDelta::Apply(currentContent, j.at("ops"));
+    if (!content || content->size() != j.at("len").get<std::size_t>() ||
+        TextDelta::Checksum(*content) != j.at("hash").get<std::uint32_t>()) {
+        throw std::runtime_error("Revision delta does not match segment " + j.value("segmentId", std::string()));
+    }
+    return *content;
+}
+
+} // namespace
+
+WritingTrajectoryRepositoryFs::WritingTrajectoryRepositoryFs(std::unique_ptr<WritingEventStoreFs> eventStore,
+                                                             std::size_t snapshotInterval)
+    : m_eventStore(std::move(eventStore)), m_snapshotInterval(snapshotInterval) {}
 
 // Serialization helper
-std::vector<StoredEvent> WritingTrajectoryRepositoryFs::serializeEvents(const std::string& trajectoryId, 
-                                       const std::vector<WritingDomainEvent>& domainEvents) {
+std::vector<StoredEvent> WritingTrajectoryRepositoryFs::serializeEvents(const WritingTrajectory& trajectory) {
+    const auto& domainEvents = trajectory.getUncommittedEvents();
+
+    // Segment version reached after each revision: the aggregate holds the final
+    // version, so walk the batch backwards discounting later revisions.
+    std::vector<int> versionAfter(domainEvents.size(), 0);
+    std::unordered_map<std::string, int> laterRevisions;
+    for (std::size_t i = domainEvents.size(); i-- > 0;) {
+        if (const auto* revised = std::get_if<SegmentRevised>(&domainEvents[i])) {
+            auto it = trajectory.getSegments().find(revised->segmentId);
+            if (it != trajectory.getSegments().end()) {
+                versionAfter[i] = it->second.version - laterRevisions[revised->segmentId]++;
+            }
+        }
+    }
+
     std::vector<StoredEvent> stored;
-    for (const auto& varEvent : domainEvents) {
+    for (std::size_t i = 0; i < domainEvents.size(); ++i) {
         std::visit([&](auto&& e) {
             using T = std::decay_t<decltype(e)>;
             json j;
@@ -42,15 +250,8 @@ std::vector<StoredEvent> WritingTrajectoryRepositoryFs::serializeEvents(const st
                 };
             }
             else if constexpr (std::is_same_v<T, SegmentRevised>) {
-                j = {
-                    {"segmentId", e.segmentId},
-                    {"oldContent", e.oldContent},
-                    {"newContent", e.newContent},
-                    {"decisionId", e.decisionId},
-                    {"operation", OperationToString(e.operation)},
-                    {"rationale", e.rationale},
-                    {"sourceTag", e.sourceTag}
-                };
+                stored.push_back(EncodeRevision(e, e.oldContent, versionAfter[i]));
+                return;
             }
             else if constexpr (std::is_same_v<T, StageAdvanced>) {
                 j = {
@@ -75,132 +276,230 @@ std::vector<StoredEvent> WritingTrajectoryRepositoryFs::serializeEvents(const st
             }
             
             stored.push_back({T::Type, j.dump(), e.timestamp});
-        }, varEvent);
+        }, domainEvents[i]);
     }
     return stored;
 }
 
 void WritingTrajectoryRepositoryFs::save(const WritingTrajectory& trajectory) {
-    // In save, we assume it's new, but logic is same as update: save uncommitted events.
-    auto storedEvents = serializeEvents(trajectory.getId(), trajectory.getUncommittedEvents());
-    m_eventStore->append(trajectory.getId(), storedEvents);
-    // Note: We can't clear uncommitted events on the const object passed here.
-    // The interface method signature `save(const ...)` implies we don't modify the object.
-    // However, clean Aggregate practice usually requires clearing events after save.
-    // For now, we just save. The object in memory will still have events, but if it dies, it's fine.
-    // If it lives, we should clear them.
+    // A new trajectory must start an empty stream. The object is const here,
+    // so the caller marks it persisted (markPersisted) once this returns.
+    appendEvents(trajectory, 0);
 }
 
 void WritingTrajectoryRepositoryFs::update(WritingTrajectory& trajectory) {
-    auto storedEvents = serializeEvents(trajectory.getId(), trajectory.getUncommittedEvents());
-    m_eventStore->append(trajectory.getId(), storedEvents);
-    trajectory.clearUncommittedEvents();
+    const std::size_t eventCount = appendEvents(trajectory, trajectory.getPersistedVersion());
+    trajectory.markPersisted(eventCount);
+}
+
+std::size_t WritingTrajectoryRepositoryFs::appendEvents(const WritingTrajectory& trajectory, std::size_t expectedVersion) {
+    const std::string& id = trajectory.getId();
+    auto storedEvents = serializeEvents(trajectory);
+    const std::size_t eventCount = m_eventStore->append(id, storedEvents, expectedVersion);
+    if (storedEvents.empty()) return eventCount;
+
+    // Write-through snapshot: the aggregate in hand already is the state at eventCount.
+    if (m_snapshotInterval > 0) {
+        bool due = false;
+        {
+            std::lock_guard<std::mutex> lock(m_snapshotMutex);
+            auto& last = m_lastSnapshot[id];
+            if (eventCount - std::min(last, eventCount) >= m_snapshotInterval) {
+                last = eventCount;
+                due = true;
+            }
+        }
+        if (due) {
+            m_eventStore->saveSnapshot(id, StoredSnapshot{m_eventStore->position(id), SnapshotState(trajectory).dump()});
+        }
+    }
+
+    recordSummary(trajectory, eventCount);
+    return eventCount;
+}
+
+void WritingTrajectoryRepositoryFs::applyStoredEvent(WritingTrajectory& trajectory, const StoredEvent& s) {
+    const std::string& id = trajectory.getId();
+    if (s.eventType == TrajectoryCreated::Type) {
+        auto j = json::parse(s.eventDataJson);
+        WritingIntent intent(
+            j["intent"]["purpose"],
+            j["intent"]["audience"],
+            j["intent"].value("coreClaim", ""),
+            j["intent"].value("constraints", "")
+        );
+        trajectory.applyEvent(TrajectoryCreated{id, intent, s.timestamp});
+    }
+    else if (s.eventType == SegmentAdded::Type) {
+        auto j = json::parse(s.eventDataJson);
+        trajectory.applyEvent(SegmentAdded{
+            id, 
+            j["segmentId"], 
+            j["title"], 
+            j["content"], 
+            j.value("sourceTag", "human"), 
+            s.timestamp
+        });
+    }
+    else if (s.eventType == SegmentRevised::Type) {
+        auto j = json::parse(s.eventDataJson);
+        std::string oldContent;
+        std::string newContent;
+        if (s.schemaVersion >= kDeltaRevisionSchemaVersion) {
+            auto it = trajectory.getSegments().find(j["segmentId"].get<std::string>());
+            if (it != trajectory.getSegments().end()) oldContent = it->second.content;
+            newContent = DecodeRevisedContent(j, oldContent);
+        } else {
+            oldContent = j["oldContent"];
+            newContent = j["newContent"];
+        }
+        trajectory.applyEvent(SegmentRevised{
+            id,
+            j["segmentId"],
+            oldContent,
+            newContent,
+            j["decisionId"],
+            OperationFromString(j["operation"]),
+            j["rationale"],
+            j.value("sourceTag", "human"),
+            s.timestamp
+        });
+    }
+    else if (s.eventType == DefenseCardAdded::Type) {
+        auto j = json::parse(s.eventDataJson);
+        trajectory.applyEvent(DefenseCardAdded{
+            id,
+            j["cardId"],
+            j["segmentId"],
+            j["prompt"],
+            j.value("expectedPoints", std::vector<std::string>{}),
+            s.timestamp
+        });
+    }
+    else if (s.eventType == DefenseStatusUpdated::Type) {
+        auto j = json::parse(s.eventDataJson);
+        trajectory.applyEvent(DefenseStatusUpdated{
+            id,
+            j["cardId"],
+            j["newStatus"],
+            j.value("response", ""),
+            s.timestamp
+        });
+    }
+    else if (s.eventType == StageAdvanced::Type) {
+        auto j = json::parse(s.eventDataJson);
+        trajectory.applyEvent(StageAdvanced{
+            id,
+            StageFromString(j["oldStage"]),
+            StageFromString(j["newStage"]),
+            s.timestamp
+        });
+    }
 }
 
 std::optional<WritingTrajectory> WritingTrajectoryRepositoryFs::findById(const std::string& id) {
-    auto stored = m_eventStore->readAll(id);
-    if (stored.empty()) return std::nullopt;
+    // Latest snapshot + tail events; full replay when there is no usable snapshot.
+    std::optional<WritingTrajectory> trajectory;
+    EventStreamPosition from;
+    if (m_snapshotInterval > 0) {
+        if (auto snapshot = m_eventStore->loadSnapshot(id)) {
+            try {
+                trajectory = RestoreSnapshot(id, json::parse(snapshot->stateJson));
+                from = snapshot->position;
+            } catch (const std::exception& e) {
+                std::cerr << "Ignoring snapshot of trajectory " << id << ": " << e.what() << std::endl;
+            }
+        }
+    }
+
+    EventStreamPosition end;
+    auto stored = m_eventStore->readFrom(id, from, &end);
+    if (!stored && trajectory) {
+        // Snapshot points past the stream (log rewritten): fall back to full replay.
+        trajectory.reset();
+        from = EventStreamPosition{};
+        stored = m_eventStore->readFrom(id, from, &end);
+    }
+    if (!stored || (!trajectory && stored->empty())) return std::nullopt;
 
     // Rehydrate
-    auto trajectory = WritingTrajectory::createEmpty(id);
+    if (!trajectory) trajectory = WritingTrajectory::createEmpty(id);
     
+    try {
+        for (const auto& s : *stored) {
+            applyStoredEvent(*trajectory, s);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error rehydrating trajectory " << id << ": " << e.what() << std::endl;
+        return std::nullopt;
+    }
+
+    if (m_snapshotInterval > 0) {
+        const bool due = end.eventCount - from.eventCount >= m_snapshotInterval;
+        if (due) {
+            m_eventStore->saveSnapshot(id, StoredSnapshot{end, SnapshotState(*trajectory).dump()});
+        }
+        std::lock_guard<std::mutex> lock(m_snapshotMutex);
+        m_lastSnapshot[id] = due ? end.eventCount : from.eventCount;
+    }
+
+    trajectory->markPersisted(end.eventCount);
+    return trajectory;
+}
+
+std::optional<WritingTrajectoryRepositoryFs::CompactionStats> WritingTrajectoryRepositoryFs::compactLog(const std::string& id) {
+    // Every line must parse: a skipped one would be dropped from the rewritten log for good.
+    EventStreamPosition end;
+    auto read = m_eventStore->readFrom(id, EventStreamPosition{}, &end);
+    if (!read || read->empty()) return std::nullopt;
+    if (read->size() != end.eventCount) {
+        std::cerr << "Not compacting trajectory " << id << ": " << end.eventCount - read->size()
+                  << " unreadable event line(s)" << std::endl;
+        return std::nullopt;
+    }
+    const auto stored = std::move(*read);
+
+    CompactionStats stats;
+    stats.events = stored.size();
+    stats.bytesBefore = m_eventStore->logSize(id);
+
+    // Replay while re-encoding every revision against the state it was applied to.
+    auto trajectory = WritingTrajectory::createEmpty(id);
+    std::vector<StoredEvent> rewritten;
+    rewritten.reserve(stored.size());
     try {
         for (const auto& s : stored) {
-            if (s.eventType == TrajectoryCreated::Type) {
-                auto j = json::parse(s.eventDataJson);
-                WritingIntent intent(
-                    j["intent"]["purpose"],
-                    j["intent"]["audience"],
-                    j["intent"].value("coreClaim", ""),
-                    j["intent"].value("constraints", "")
-                );
-                trajectory.applyEvent(TrajectoryCreated{id, intent, s.timestamp});
-            }
-            else if (s.eventType == SegmentAdded::Type) {
-                auto j = json::parse(s.eventDataJson);
-                trajectory.applyEvent(SegmentAdded{
-                    id, 
-                    j["segmentId"], 
-                    j["title"], 
-                    j["content"], 
-                    j.value("sourceTag", "human"), 
-                    s.timestamp
-                });
+            if (s.eventType != SegmentRevised::Type) {
+                applyStoredEvent(trajectory, s);
+                rewritten.push_back(s);
+                continue;
             }
-            else if (s.eventType == SegmentRevised::Type) {
-                auto j = json::parse(s.eventDataJson);
-                RevisionOperation op = RevisionOperation::Clarify; // Default
-                std::string opStr = j["operation"];
-                if (opStr == "clarify") op = RevisionOperation::Clarify;
-                else if (opStr == "compress") op = RevisionOperation::Compress;
-                else if (opStr == "expand") op = RevisionOperation::Expand;
-                else if (opStr == "reorganize") op = RevisionOperation::Reorganize;
-                else if (opStr == "cite") op = RevisionOperation::Cite;
-                else if (opStr == "remove") op = RevisionOperation::Remove;
-                else if (opStr == "reframe") op = RevisionOperation::Reframe;
-                else if (opStr == "correction") op = RevisionOperation::Correction;
-
-                trajectory.applyEvent(SegmentRevised{
-                    id,
-                    j["segmentId"],
-                    j["oldContent"],
-                    j["newContent"],
-                    j["decisionId"],
-                    op,
-                    j["rationale"],
-                    j.value("sourceTag", "human"),
-                    s.timestamp
-                });
-            }
-            else if (s.eventType == DefenseCardAdded::Type) {
-                auto j = json::parse(s.eventDataJson);
-                trajectory.applyEvent(DefenseCardAdded{
-                    id,
-                    j["cardId"],
-                    j["segmentId"],
-                    j["prompt"],
-                    j.value("expectedPoints", std::vector<std::string>{}),
-                    s.timestamp
-                });
-            }
-            else if (s.eventType == DefenseStatusUpdated::Type) {
-                auto j = json::parse(s.eventDataJson);
-                trajectory.applyEvent(DefenseStatusUpdated{
-                    id,
-                    j["cardId"],
-                    j["newStatus"],
-                    j.value("response", ""),
-                    s.timestamp
-                });
-            }
-            else if (s.eventType == StageAdvanced::Type) {
-                auto j = json::parse(s.eventDataJson);
-                // We need to parse string back to enum. 
-                // A helper would be better, but for now simple comparison:
-                auto stageFromString = [](const std::string& str) {
-                    if (str == "Outline") return TrajectoryStage::Outline;
-                    if (str == "Drafting") return TrajectoryStage::Drafting;
-                    if (str == "Revising") return TrajectoryStage::Revising;
-                    if (str == "Consolidating") return TrajectoryStage::Consolidating;
-                    if (str == "ReadyForDefense") return TrajectoryStage::ReadyForDefense;
-                    if (str == "Final") return TrajectoryStage::Final;
-                    return TrajectoryStage::Intent;
-                };
+            auto j = json::parse(s.eventDataJson);
+            const std::string segmentId = j["segmentId"];
+            auto before = trajectory.getSegments().find(segmentId);
+            const std::string oldContent = before != trajectory.getSegments().end() ? before->second.content : std::string();
 
-                trajectory.applyEvent(StageAdvanced{
-                    id,
-                    stageFromString(j["oldStage"]),
-                    stageFromString(j["newStage"]),
-                    s.timestamp
-                });
+            applyStoredEvent(trajectory, s);
+            auto after = trajectory.getSegments().find(segmentId);
+            if (after == trajectory.getSegments().end()) {
+                rewritten.push_back(s); // Orphan revision: keep verbatim
+                continue;
             }
+
+            SegmentRevised e{id, segmentId, oldContent, after->second.content, j["decisionId"],
+                             OperationFromString(j["operation"]), j["rationale"],
+                             j.value("sourceTag", "human"), s.timestamp};
+            rewritten.push_back(EncodeRevision(e, oldContent, after->second.version));
+            ++stats.revisionsReencoded;
         }
     } catch (const std::exception& e) {
-        std::cerr << "Error rehydrating trajectory " << id << ": " << e.what() << std::endl;
+        std::cerr << "Error compacting trajectory " << id << ": " << e.what() << std::endl;
         return std::nullopt;
     }
-    
-    return trajectory;
+
+    if (!m_eventStore->rewrite(id, rewritten)) return std::nullopt;
+    stats.bytesAfter = m_eventStore->logSize(id);
+    return stats;
 }
 
 std::vector<WritingTrajectory> WritingTrajectoryRepositoryFs::findAll() {
@@ -219,4 +518,121 @@ std::vector<WritingTrajectory> WritingTrajectoryRepositoryFs::findAll() {
     return trajectories; 
 }
 
+void WritingTrajectoryRepositoryFs::recordSummary(const WritingTrajectory& trajectory, std::size_t eventCount) {
+    TrajectorySummary summary;
+    summary.id = trajectory.getId();
+    summary.intent = trajectory.getIntent();
+    summary.stage = trajectory.getStage();
+    summary.segmentCount = trajectory.getSegments().size();
+    summary.revisionCount = trajectory.getHistory().size();
+    summary.eventCount = eventCount;
+
+    std::lock_guard<std::mutex> lock(m_summariesMutex);
+    loadSummariesLocked();
+    m_summaries[summary.id] = std::move(summary);
+    persistSummariesLocked();
+}
+
+void WritingTrajectoryRepositoryFs::loadSummariesLocked() {
+    if (m_summariesLoaded) return;
+    m_summariesLoaded = true;
+
+    auto raw = m_eventStore->loadSummaryIndex();
+    if (!raw) return;
+    try {
+        auto root = json::parse(*raw);
+        for (const auto& j : root.at("trajectories")) {
+            TrajectorySummary summary;
+            summary.id = j.at("id").get<std::string>();
+            const auto& intent = j.at("intent");
+            summary.intent.purpose = intent.value("purpose", "");
+            summary.intent.audience = intent.value("audience", "");
+            summary.intent.coreClaim = intent.value("coreClaim", "");
+            summary.intent.constraints = intent.value("constraints", "");
+            summary.stage = StageFromString(j.value("stage", "Intent"));
+            summary.segmentCount = j.value("segments", 0);
+            summary.revisionCount = j.value("revisions", 0);
+            summary.eventCount = j.value("eventCount", 0);
+            m_summaries[summary.id] = std::move(summary);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Ignoring trajectory summary index: " << e.what() << std::endl;
+        m_summaries.clear();
+    }
+}
+
+void WritingTrajectoryRepositoryFs::persistSummariesLocked() {
+    json list = json::array();
+    for (const auto& [id, summary] : m_summaries) {
+        list.push_back({
+            {"id", id},
+            {"intent", {
+                {"purpose", summary.intent.purpose},
+                {"audience", summary.intent.audience},
+                {"coreClaim", summary.intent.coreClaim},
+                {"constraints", summary.intent.constraints}
+            }},
+            {"stage", StageToString(summary.stage)},
+            {"segments", summary.segmentCount},
+            {"revisions", summary.revisionCount},
+            {"eventCount", summary.eventCount}
+        });
+    }
+    m_eventStore->saveSummaryIndex(json{{"indexVersion", 1}, {"trajectories", list}}.dump(2));
+}
+
+std::vector<TrajectorySummary> WritingTrajectoryRepositoryFs::listSummaries() {
+    const auto ids = m_eventStore->getAllTrajectoryIds();
+
+    std::vector<std::string> stale;
+    {
+        std::lock_guard<std::mutex> lock(m_summariesMutex);
+        loadSummariesLocked();
+        for (const auto& id : ids) {
+            auto it = m_summaries.find(id);
+            // The event count is the cheap staleness check (another instance may have appended).
+            if (it == m_summaries.end() || it->second.eventCount != m_eventStore->position(id).eventCount) {
+                stale.push_back(id);
+            }
+        }
+    }
+
+    // Rebuild missing/stale entries by replay (snapshot + tail); findById does not touch the index.
+    std::vector<std::pair<WritingTrajectory, std::size_t>> rebuilt;
+    for (const auto& id : stale) {
+        if (auto trajectory = findById(id)) {
+            const std::size_t version = trajectory->getPersistedVersion();
+            rebuilt.emplace_back(std::move(*trajectory), version);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_summariesMutex);
+    bool changed = !rebuilt.empty();
+    for (const auto& [trajectory, version] : rebuilt) {
+        TrajectorySummary summary;
+        summary.id = trajectory.getId();
+        summary.intent = trajectory.getIntent();
+        summary.stage = trajectory.getStage();
+        summary.segmentCount = trajectory.getSegments().size();
+        summary.revisionCount = trajectory.getHistory().size();
+        summary.eventCount = version;
+        m_summaries[summary.id] = std::move(summary);
+    }
+    const std::unordered_set<std::string> present(ids.begin(), ids.end());
+    for (auto it = m_summaries.begin(); it != m_summaries.end();) {
+        if (present.count(it->first) == 0) {
+            it = m_summaries.erase(it);
+            changed = true;
+        } else {
+            ++it;
+        }
+    }
+    if (changed) persistSummariesLocked();
+
+    std::vector<TrajectorySummary> result;
+    result.reserve(m_summaries.size());
+    for (const auto& [id, summary] : m_summaries) result.push_back(summary);
+    return result;
+}
+
 } // namespace ideawalker::infrastructure::writing
@@ -8,25 +8,65 @@
 #include "domain/writing/repositories/IWritingTrajectoryRepository.hpp"
 #include "WritingEventStoreFs.hpp"
 
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
 namespace ideawalker::infrastructure::writing {
 
 using namespace ideawalker::domain::writing;
 
 class WritingTrajectoryRepositoryFs : public IWritingTrajectoryRepository {
 public:
-    WritingTrajectoryRepositoryFs(std::unique_ptr<WritingEventStoreFs> eventStore);
+    static constexpr std::size_t kDefaultSnapshotInterval = 100;
+    // Every Nth version of a segment is stored as full text instead of a delta
+    static constexpr int kRevisionKeyframeInterval = 16;
+
+    struct CompactionStats {
+        std::size_t events = 0;
+        std::size_t revisionsReencoded = 0;
+        std::uint64_t bytesBefore = 0;
+        std::uint64_t bytesAfter = 0;
+    };
+
+    // snapshotInterval: tail events replayed before a new snapshot is taken (0 disables snapshots)
+    WritingTrajectoryRepositoryFs(std::unique_ptr<WritingEventStoreFs> eventStore,
+                                  std::size_t snapshotInterval = kDefaultSnapshotInterval);
 
     void save(const WritingTrajectory& trajectory) override;
     std::optional<WritingTrajectory> findById(const std::string& id) override;
     std::vector<WritingTrajectory> findAll() override;
     void update(WritingTrajectory& trajectory) override;
+    std::vector<TrajectorySummary> listSummaries() override;
+
+    // Offline: rewrites a log with delta-encoded revisions (schemaVersion 2). Returns nullopt on failure;
+    // a log with unreadable lines is refused and left untouched.
+    std::optional<CompactionStats> compactLog(const std::string& id);
 
 private:
     std::unique_ptr<WritingEventStoreFs> m_eventStore;
+    std::size_t m_snapshotInterval;
+
+    // Event count at the last snapshot written, per trajectory
+    std::mutex m_snapshotMutex;
+    std::unordered_map<std::string, std::size_t> m_lastSnapshot;
+
+    // Summary index mirror (writing/trajectories/index.json); loaded lazily
+    std::mutex m_summariesMutex;
+    std::map<std::string, TrajectorySummary> m_summaries;
+    bool m_summariesLoaded = false;
+
+    // Appends the aggregate's uncommitted events at expectedVersion; returns the new event count
+    std::size_t appendEvents(const WritingTrajectory& trajectory, std::size_t expectedVersion);
+    void recordSummary(const WritingTrajectory& trajectory, std::size_t eventCount);
+    void loadSummariesLocked();
+    void persistSummariesLocked();
+
+    // Applies one stored event to the aggregate (throws on malformed payloads)
+    void applyStoredEvent(WritingTrajectory& trajectory, const StoredEvent& stored);
     
-    // Helper to serialize events from the aggregate
-    std::vector<StoredEvent> serializeEvents(const std::string& trajectoryId, 
-                                           const std::vector<WritingDomainEvent>& domainEvents);
+    // Helper to serialize the uncommitted events of the aggregate
+    std::vector<StoredEvent> serializeEvents(const WritingTrajectory& trajectory);
 };
 
 } // namespace ideawalker::infrastructure::writing
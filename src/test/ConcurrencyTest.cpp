@@ -4,6 +4,7 @@
 #include <chrono>
 #include <atomic>
 #include <cassert>
+#include <fstream>
 #include "application/ConversationService.hpp"
 #include "domain/AIService.hpp"
 #include "infrastructure/PathUtils.hpp"
@@ -113,6 +114,20 @@ int main() {
          std::cout << "[WARN] History size mismatch. Expected 101, got " << history.size() << ". (Some might be still processing or lost)" << std::endl;
     }
 
+    // Barrier: every save queued so far must be on disk before we inspect it.
+    persistence->flush();
+    auto metrics = persistence->getMetrics();
+    std::cout << "[Test] Persistence: enqueued=" << metrics.enqueued
+              << " coalesced=" << metrics.coalesced
+              << " written=" << metrics.written
+              << " batches=" << metrics.batches
+              << " peakDepth=" << metrics.peakQueueDepth
+              << " avgWriteMs=" << metrics.avgWriteMs << std::endl;
+    if (metrics.queueDepth != 0 || metrics.written + metrics.coalesced + metrics.failed != metrics.enqueued) {
+        std::cout << "[FAIL] Persistence queue not drained after flush()." << std::endl;
+        return 1;
+    }
+
     // Check File
     auto dialogues = service.listDialogues();
     if (dialogues.empty()) {
@@ -121,7 +136,29 @@ int main() {
     }
 
     std::cout << "[PASS] Dialogue file created: " << dialogues[0] << std::endl;
-    
+
+    // Round-trip: the append-only log must restore every message
+    ideawalker::application::ConversationService reloaded(aiService, persistence, nullptr, testRoot);
+    if (!reloaded.loadSession(dialogues[0]) || reloaded.getHistory().size() != history.size()) {
+        std::cout << "[FAIL] Reloaded session has " << reloaded.getHistory().size()
+                  << " messages, expected " << history.size() << "." << std::endl;
+        return 1;
+    }
+    std::cout << "[PASS] Session log reloaded with " << history.size() << " messages." << std::endl;
+
+    // Reopening the project reconciles the index with logs deleted or added outside the app.
+    const auto dialoguesDir = std::filesystem::path(testRoot) / "dialogues";
+    std::filesystem::remove(dialoguesDir / dialogues[0]);
+    std::ofstream(dialoguesDir / "External_2026-01-01_00-00-00.ndjson") << "{\"type\":\"session\"}\n";
+    ideawalker::application::ConversationService reopened(aiService, persistence, nullptr, testRoot);
+    persistence->flush();
+    const auto reconciled = reopened.listDialogues();
+    if (reconciled.size() != 1 || reconciled[0] != "External_2026-01-01_00-00-00.ndjson") {
+        std::cout << "[FAIL] Dialogue index not reconciled on open (" << reconciled.size() << " entries)." << std::endl;
+        return 1;
+    }
+    std::cout << "[PASS] Dialogue index reconciled with the directory on open." << std::endl;
+
     // Clean up
     std::filesystem::remove_all(testRoot);
     std::cout << "[Test] Completed." << std::endl;
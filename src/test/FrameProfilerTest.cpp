@@ -0,0 +1,139 @@
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "infrastructure/FrameProfiler.hpp"
+
+using namespace ideawalker::infrastructure;
+
+// Unlike assert(), these checks also run under NDEBUG, which the Release CI build defines.
+#define IW_CHECK(condition)                                                     \
+    do {                                                                        \
+        if (!(condition)) {                                                     \
+            std::cerr << "[FAIL] " << #condition << "\n";                      \
+            std::cerr << "       at " << __FILE__ << ":" << __LINE__ << "\n";  \
+            return false;                                                       \
+        }                                                                       \
+    } while (false)
+
+static int g_passed = 0;
+static int g_failed = 0;
+
+#define RUN_TEST(fn)                                                            \
+    do {                                                                        \
+        if (fn()) {                                                             \
+            ++g_passed;                                                         \
+        } else {                                                                \
+            ++g_failed;                                                         \
+        }                                                                       \
+    } while (false)
+
+// The ring never overwrites unread events: overflow is dropped and counted.
+static bool TestRingOverflow() {
+    std::cout << "[Test] Starting Profile Ring Overflow Test..." << std::endl;
+    ProfileRing ring;
+    ProfileEvent event;
+    event.name = "x";
+    for (std::size_t i = 0; i < ProfileRing::kCapacity; ++i) {
+        event.beginNs = i;
+        const bool pushed = ring.push(event);
+        IW_CHECK(pushed);
+    }
+    const bool overflow = ring.push(event);
+    IW_CHECK(!overflow && ring.dropped() == 1);
+
+    std::vector<ProfileEvent> out;
+    const std::size_t drained = ring.drain(out);
+    IW_CHECK(drained == ProfileRing::kCapacity && out.front().beginNs == 0 && out.back().beginNs == ProfileRing::kCapacity - 1);
+    const bool again = ring.push(event);
+    IW_CHECK(again && ring.drain(out) == 1);
+    std::cout << "[PASS] Profile Ring Overflow Test." << std::endl;
+    return true;
+}
+
+// Zones from several threads are folded into the frame; nesting depth is per thread.
+static bool TestFrameAggregation() {
+    std::cout << "[Test] Starting Frame Aggregation Test..." << std::endl;
+    FrameProfiler& profiler = FrameProfiler::Instance();
+    profiler.reset();
+    {
+        ProfileZone disabled("Disabled");
+    }
+    profiler.setEnabled(true);
+    profiler.endFrame();
+
+    {
+        ProfileZone outer("Outer");
+        ProfileZone inner("Inner");
+    }
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([] {
+            for (int i = 0; i < 10; ++i) ProfileZone zone("Worker");
+        });
+    }
+    for (auto& worker : workers) worker.join();
+    profiler.endFrame();
+
+    const auto zones = profiler.zones();
+    auto find = [&zones](const std::string& name) -> const ZoneStats* {
+        for (const auto& zone : zones) {
+            if (zone.name == name) return &zone;
+        }
+        return nullptr;
+    };
+    IW_CHECK(!find("Disabled"));
+    const ZoneStats* worker = find("Worker");
+    IW_CHECK(worker && worker->lastCalls == 40 && worker->history.size() == 2);
+    const ZoneStats* outer = find("Outer");
+    const ZoneStats* inner = find("Inner");
+    IW_CHECK(outer && inner && outer->lastCalls == 1 && outer->lastMs >= inner->lastMs);
+    IW_CHECK(profiler.frameHistory().size() == 2);
+    std::cout << "[PASS] Frame Aggregation Test." << std::endl;
+    return true;
+}
+
+// The capture is exported as Chrome trace "X" events.
+static bool TestChromeTraceExport() {
+    std::cout << "[Test] Starting Chrome Trace Export Test..." << std::endl;
+    FrameProfiler& profiler = FrameProfiler::Instance();
+    profiler.reset();
+    profiler.startCapture();
+    {
+        ProfileZone outer("Quote\"Zone");
+        ProfileZone inner("Inner");
+    }
+    profiler.endFrame();
+    profiler.stopCapture();
+    IW_CHECK(profiler.capturedEvents() == 2);
+
+    const auto path = std::filesystem::temp_directory_path() / "ideawalker_profiler_test_trace.json";
+    const bool written = profiler.exportChromeTrace(path.string());
+    IW_CHECK(written);
+    std::ifstream in(path);
+    const auto trace = nlohmann::json::parse(in);
+    const auto& events = trace["traceEvents"];
+    IW_CHECK(events.size() == 2);
+    // Inner closes first.
+    IW_CHECK(events[0]["name"] == "Inner" && events[0]["ph"] == "X" && events[0]["args"]["depth"] == 1);
+    IW_CHECK(events[1]["name"] == "Quote\"Zone" && events[1]["args"]["depth"] == 0);
+    IW_CHECK(events[1]["ts"].get<double>() <= events[0]["ts"].get<double>());
+    std::filesystem::remove(path);
+    profiler.setEnabled(false);
+    std::cout << "[PASS] Chrome Trace Export Test." << std::endl;
+    return true;
+}
+
+int main() {
+    RUN_TEST(TestRingOverflow);
+    RUN_TEST(TestFrameAggregation);
+    RUN_TEST(TestChromeTraceExport);
+
+    std::cout << "\n=== Results: " << g_passed << " passed, " << g_failed << " failed ===\n";
+    return (g_failed == 0) ? 0 : 1;
+}
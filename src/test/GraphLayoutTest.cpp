@@ -0,0 +1,364 @@
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+
+#include "application/AsyncTaskManager.hpp"
+#include "application/BacklinkIndex.hpp"
+#include "application/ForceLayout.hpp"
+#include "application/GraphService.hpp"
+#include "application/GraphSimulation.hpp"
+#include "application/GraphViewport.hpp"
+#include "domain/MentionMatcher.hpp"
+
+using namespace ideawalker::application;
+using namespace ideawalker::domain::writing;
+
+// Explicit checks: CI builds Release (NDEBUG), where assert() would check nothing.
+#define IW_ASSERT(condition, message)                                           \
+    do {                                                                        \
+        if (!(condition)) {                                                     \
+            std::cerr << "[FAIL] " << message << "\n";                         \
+            std::cerr << "       at " << __FILE__ << ":" << __LINE__ << "\n";  \
+            return false;                                                       \
+        }                                                                       \
+        std::cout << "[PASS] " << message << "\n";                              \
+    } while (false)
+
+static int g_passed = 0;
+static int g_failed = 0;
+
+#define RUN_TEST(fn)                                                            \
+    do {                                                                        \
+        std::cout << "\n-- " << #fn << " --\n";                                \
+        if (fn()) {                                                             \
+            ++g_passed;                                                         \
+        } else {                                                                \
+            ++g_failed;                                                         \
+        }                                                                       \
+    } while (false)
+
+static void MakeGraph(int count, std::vector<GraphNode>& nodes, std::vector<GraphLink>& links) {
+    std::srand(7);
+    for (int i = 0; i < count; ++i) {
+        GraphNode node{};
+        node.id = i;
+        node.type = (i % 5 == 0) ? NodeType::INSIGHT : NodeType::TASK;
+        node.x = 800.0f + static_cast<float>(std::rand() % 600 - 300);
+        node.y = 450.0f + static_cast<float>(std::rand() % 400 - 200);
+        nodes.push_back(node);
+        if (i % 5 != 0) links.push_back({i, (i / 5) * 5, i});
+    }
+}
+
+// theta = 0 must reproduce the exact all-pairs layout; the default theta stays close to it.
+static bool TestBarnesHutMatchesExact() {
+    std::vector<GraphNode> nodes;
+    std::vector<GraphLink> links;
+    MakeGraph(600, nodes, links);
+
+    ForceLayoutConfig exactConfig;
+    exactConfig.theta = 0.0f;
+    ForceLayout exact(exactConfig);
+    ForceLayout approx;
+    exact.load(nodes, links);
+    approx.load(nodes, links);
+    for (int i = 0; i < 10; ++i) {
+        exact.step();
+        approx.step();
+    }
+
+    double error = 0.0;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        error += std::fabs(exact.xs()[i] - approx.xs()[i]) + std::fabs(exact.ys()[i] - approx.ys()[i]);
+    }
+    error /= nodes.size();
+    std::cout << "Mean drift vs exact after 10 steps: " << error << " px\n";
+    IW_ASSERT(error < 5.0, "Barnes-Hut stays within 5 px of the exact layout");
+    return true;
+}
+
+static bool TestLayoutFreezesAndPins() {
+    std::vector<GraphNode> nodes;
+    std::vector<GraphLink> links;
+    MakeGraph(300, nodes, links);
+
+    ForceLayout layout;
+    layout.load(nodes, links);
+    int steps = 0;
+    while (layout.step() && steps < 2000) ++steps;
+    IW_ASSERT(steps < 2000, "Layout converges (" << steps << " steps)");
+    IW_ASSERT(layout.isFrozen(), "Converged layout is frozen");
+    IW_ASSERT(!layout.step(), "A frozen layout does no work");
+
+    layout.pin(3, 100.0f, 120.0f);
+    IW_ASSERT(!layout.isFrozen(), "Pinning wakes the layout");
+    while (layout.step()) {}
+    IW_ASSERT(layout.xs()[3] == 100.0f && layout.ys()[3] == 120.0f, "Pinned node stays where it was dropped");
+    return true;
+}
+
+// The background simulation publishes snapshots of the latest load and honours pins.
+static bool TestBackgroundSimulation() {
+    std::vector<GraphNode> nodes;
+    std::vector<GraphLink> links;
+    MakeGraph(400, nodes, links);
+
+    auto taskManager = std::make_shared<AsyncTaskManager>();
+    GraphSimulation simulation(taskManager);
+    simulation.setStepsPerSecond(0); // Unthrottled for the test
+
+    simulation.load(nodes, links);
+    simulation.pin(0, 42.0f, 43.0f);
+    const auto generation = simulation.load(nodes, links); // Superseding load drops the pin
+    simulation.pin(1, 60.0f, 61.0f);
+    simulation.waitUntilIdle();
+
+    IW_ASSERT(simulation.acquireLatest(), "Settled simulation publishes a snapshot");
+    const auto& snapshot = simulation.latest();
+    IW_ASSERT(snapshot.generation == generation, "Snapshot belongs to the latest load");
+    IW_ASSERT(snapshot.settled, "Snapshot is marked settled");
+    IW_ASSERT(snapshot.x.size() == nodes.size(), "Snapshot covers every node");
+    IW_ASSERT(snapshot.x[1] == 60.0f && snapshot.y[1] == 61.0f, "Pin on the latest load is honoured");
+    IW_ASSERT(snapshot.x[0] != 42.0f, "Superseding load drops earlier pins");
+    IW_ASSERT(!simulation.acquireLatest(), "Nothing newer to acquire");
+
+    // A drag wakes the settled layout again.
+    simulation.pin(1, 300.0f, 300.0f);
+    simulation.waitUntilIdle();
+    const bool woke = simulation.acquireLatest();
+    IW_ASSERT(woke && simulation.latest().x[1] == 300.0f, "A drag wakes the settled layout");
+    return true;
+}
+
+static bool TestMentionMatcher() {
+    ideawalker::domain::MentionMatcher matcher;
+    matcher.build({{"he", 1}, {"she", 2}, {"hers", 3}, {"his", 4}, {"she", 5}});
+    int hits = 0;
+    matcher.forEachMatch("ushers", [&hits](int, std::size_t) { ++hits; });
+    IW_ASSERT(hits == 4, "Overlapping matches are all reported"); // she (x2 payloads), he, hers
+    IW_ASSERT((matcher.findPayloads("this ushers") == std::vector<int>{4, 2, 5, 1, 3}), "Payloads in text order");
+    IW_ASSERT((matcher.findPayloads("where") == std::vector<int>{1}), "Match inside a word");
+    IW_ASSERT(matcher.containsAny("hers") && !matcher.containsAny("xyz"), "containsAny");
+
+    // Keyed dictionary: edits are batched and compiled once.
+    ideawalker::domain::MentionMatcher keyed;
+    keyed.setPatterns("a.md", {"Alpha", "First"}, 1);
+    keyed.setPatterns("b.md", {"Beta"}, 2);
+    IW_ASSERT(keyed.compile(), "Keyed dictionary compiles");
+    IW_ASSERT((keyed.findPayloads("First then Beta") == std::vector<int>{1, 2}), "Keyed patterns match");
+    const bool unchanged = !keyed.setPatterns("b.md", {"Beta"}, 2);
+    IW_ASSERT(unchanged && !keyed.isDirty(), "Re-setting identical patterns is a no-op");
+    keyed.removePatterns("a.md");
+    keyed.setPatterns("b.md", {"Second"}, 2);
+    IW_ASSERT(keyed.compile(), "Edits trigger one recompile");
+    IW_ASSERT((keyed.findPayloads("First then Beta, Second") == std::vector<int>{2}), "Removed and replaced patterns");
+    return true;
+}
+
+static ideawalker::domain::Insight MakeNote(const std::string& id, const std::string& title, const std::string& content) {
+    ideawalker::domain::Insight::Metadata meta;
+    meta.id = id;
+    meta.title = title;
+    ideawalker::domain::Insight insight(meta, content);
+    insight.parseActionablesFromContent();
+    return insight;
+}
+
+static const GraphNode* FindNode(const std::vector<GraphNode>& nodes, const std::string& title) {
+    for (const auto& node : nodes) {
+        if (node.title == title) return &node;
+    }
+    return nullptr;
+}
+
+static bool HasLink(const std::vector<GraphLink>& links, const GraphNode* a, const GraphNode* b) {
+    for (const auto& link : links) {
+        if (link.startNode == a->id && link.endNode == b->id) return true;
+    }
+    return false;
+}
+
+// Editing one note only touches its own nodes and links; everything else keeps id and position.
+static bool TestIncrementalGraph() {
+    std::vector<ideawalker::domain::Insight> notes = {
+        MakeNote("a.md", "Alpha Note", "Links to [[b]] and [[Ghost]].\n- [ ] task one\n"),
+        MakeNote("b.md", "Beta Note", "Mentions Alpha Note inline."),
+        MakeNote("c.md", "", "Plain."),
+    };
+    GraphService graph;
+    std::vector<GraphNode> nodes;
+    std::vector<GraphLink> links;
+    graph.SyncGraph(notes, true, nodes, links);
+
+    const GraphNode* alpha = FindNode(nodes, "Alpha Note");
+    const GraphNode* beta = FindNode(nodes, "Beta Note");
+    const GraphNode* ghost = FindNode(nodes, "Ghost");
+    IW_ASSERT(alpha && beta && ghost && FindNode(nodes, "task one") && FindNode(nodes, "c.md"), "Notes, tasks and ghosts get nodes");
+    IW_ASSERT(ghost->type == NodeType::CONCEPT, "Unresolved wikilink becomes a concept");
+    IW_ASSERT(HasLink(links, alpha, beta) && HasLink(links, alpha, ghost) && HasLink(links, beta, alpha),
+              "Wikilinks and title mentions become links");
+    const std::size_t nodeCount = nodes.size();
+
+    // Pretend the layout moved things; an unchanged sync keeps the vectors as they are.
+    for (auto& node : nodes) node.x += 10.0f;
+    const int betaId = beta->id;
+    const float betaX = beta->x;
+    graph.SyncGraph(notes, true, nodes, links);
+    IW_ASSERT(nodes.size() == nodeCount, "Unchanged sync keeps the node set");
+
+    // Saving "c" with a mention of Beta adds exactly that link; nothing else moves.
+    notes[2] = MakeNote("c.md", "", "Now about Beta Note and [[Ghost]].");
+    graph.UpdateNote(notes, "c.md", nodes, links);
+    beta = FindNode(nodes, "Beta Note");
+    const GraphNode* c = FindNode(nodes, "c.md");
+    ghost = FindNode(nodes, "Ghost");
+    IW_ASSERT(beta->id == betaId && beta->x == betaX, "Untouched nodes keep id and position");
+    IW_ASSERT(HasLink(links, c, beta) && HasLink(links, c, ghost), "UpdateNote adds the edited note's links");
+    IW_ASSERT(nodes.size() == nodeCount, "UpdateNote adds no stray nodes");
+
+    // A note named like the ghost takes it over; the ghost disappears once nobody cites it.
+    notes.push_back(MakeNote("Ghost.md", "", "Now a real note."));
+    graph.SyncGraph(notes, true, nodes, links);
+    alpha = FindNode(nodes, "Alpha Note");
+    const GraphNode* real = FindNode(nodes, "Ghost.md");
+    IW_ASSERT(real && real->type == NodeType::INSIGHT, "Real note replaces the ghost");
+    IW_ASSERT(!FindNode(nodes, "Ghost"), "Uncited ghost disappears");
+    IW_ASSERT(HasLink(links, alpha, real), "Wikilink resolves to the real note");
+
+    // Aliases resolve wikilinks and count as mentions, like titles.
+    auto aliased = MakeNote("d.md", "Delta Note", "Plain.");
+    auto meta = aliased.getMetadata();
+    meta.aliases = {"Dee", "The Delta"};
+    notes.push_back(ideawalker::domain::Insight(meta, "Plain."));
+    notes.push_back(MakeNote("e.md", "", "Cites [[Dee]] and talks about The Delta."));
+    graph.SyncGraph(notes, true, nodes, links);
+    const GraphNode* delta = FindNode(nodes, "Delta Note");
+    const GraphNode* e = FindNode(nodes, "e.md");
+    IW_ASSERT(delta && e && !FindNode(nodes, "Dee"), "Alias wikilink creates no ghost");
+    IW_ASSERT(HasLink(links, e, delta), "Aliases resolve wikilinks and mentions");
+
+    // Removing a note drops its node, its tasks and every link touching it.
+    notes.erase(notes.begin());
+    graph.SyncGraph(notes, true, nodes, links);
+    IW_ASSERT(!FindNode(nodes, "Alpha Note") && !FindNode(nodes, "task one"), "Removed note drops its nodes");
+    bool dangling = false;
+    for (const auto& link : links) {
+        bool start = false, end = false;
+        for (const auto& node : nodes) {
+            start |= node.id == link.startNode;
+            end |= node.id == link.endNode;
+        }
+        dangling |= !(start && end);
+    }
+    IW_ASSERT(!dangling, "No link points at a removed node");
+
+    // Repository notes are diffed by their revision stamp, not by rehashing the content.
+    auto stamped = [](const std::string& id, const std::string& content, std::uint64_t revision) {
+        ideawalker::domain::Insight::Metadata m;
+        m.id = id;
+        m.title = id == "s.md" ? "Sigma Note" : "";
+        m.revision = revision;
+        return ideawalker::domain::Insight(m, content);
+    };
+    std::vector<ideawalker::domain::Insight> vault = {stamped("s.md", "Plain.", 1), stamped("t.md", "About Sigma Note.", 1)};
+    GraphService stampedGraph;
+    std::vector<GraphNode> vaultNodes;
+    std::vector<GraphLink> vaultLinks;
+    stampedGraph.SyncGraph(vault, true, vaultNodes, vaultLinks);
+    IW_ASSERT(vaultLinks.size() == 1, "Stamped notes are linked like any other");
+    vault[1] = stamped("t.md", "Nothing to see.", 1);
+    stampedGraph.SyncGraph(vault, true, vaultNodes, vaultLinks);
+    IW_ASSERT(vaultLinks.size() == 1, "Same stamp: the note is not re-read");
+    vault[1] = stamped("t.md", "Nothing to see.", 2);
+    stampedGraph.SyncGraph(vault, true, vaultNodes, vaultLinks);
+    IW_ASSERT(vaultLinks.empty(), "New stamp: the note is re-read");
+    return true;
+}
+
+// Backlinks come from the reverse wikilink index, edited note by note.
+static bool TestBacklinkIndex() {
+    auto note = [](const std::string& id, const std::string& title, const std::string& content, std::uint64_t revision) {
+        ideawalker::domain::Insight::Metadata m;
+        m.id = id;
+        m.title = title;
+        m.revision = revision;
+        if (id == "a.md") m.aliases = {"Alfa"};
+        return ideawalker::domain::Insight(m, content);
+    };
+    BacklinkIndex index;
+    index.sync({note("a.md", "Alpha Note", "Self [[a]].", 1),
+                note("b.md", "", "See [[ a ]] and [[Alpha Note]].", 1),
+                note("c.md", "", "See [[Alfa]].", 1),
+                note("d.md", "", "See [[a.md]] and [[b]].", 1)});
+    IW_ASSERT(index.isLoaded(), "sync() loads the index");
+    IW_ASSERT((index.backlinks("a.md") == std::vector<std::string>{"b.md", "c.md", "d.md"}),
+              "Id, stem, title and alias links all count; self links do not");
+    IW_ASSERT((index.backlinks("b.md") == std::vector<std::string>{"d.md"}), "Stem links resolve");
+
+    index.update(note("c.md", "", "No links now.", 2));
+    IW_ASSERT((index.backlinks("a.md") == std::vector<std::string>{"b.md", "d.md"}), "update() drops old links");
+    index.sync({note("a.md", "Alpha Note", "Self [[a]].", 1), note("c.md", "", "Back to [[Alpha Note]].", 3)});
+    IW_ASSERT((index.backlinks("a.md") == std::vector<std::string>{"c.md"}), "sync() drops missing notes and rereads new stamps");
+    IW_ASSERT(index.backlinks("b.md").empty(), "Removed notes cite nothing");
+    return true;
+}
+
+// Only nodes on the canvas are drawn; dense screen cells collapse into one super-node.
+static bool TestViewportCullingAndClusters() {
+    std::vector<GraphNode> nodes;
+    for (int i = 0; i < 100; ++i) { // 10x10 grid, 100 units apart, 40x20 nodes
+        GraphNode node{};
+        node.id = i * 2; // Sparse ids
+        node.x = static_cast<float>((i % 10) * 100);
+        node.y = static_cast<float>((i / 10) * 100);
+        node.w = 40.0f;
+        node.h = 20.0f;
+        nodes.push_back(node);
+    }
+    GraphLodConfig lod;
+    lod.cullMarginPixels = 0.0f;
+    GraphViewport viewport;
+
+    GraphCamera camera; // zoom 1: the 250x250 canvas sees grid columns/rows 0..2
+    viewport.update(nodes, camera, 250.0f, 250.0f, lod);
+    IW_ASSERT(viewport.visible().size() == 9, "Zoom 1 shows the 3x3 corner of the grid");
+    IW_ASSERT(viewport.indexOf(4) == 2 && viewport.indexOf(3) == -1, "Sparse ids map to visible slots");
+
+    camera.panX = -500.0f; // Panning follows ImNodes: canvas = grid + pan
+    viewport.update(nodes, camera, 250.0f, 250.0f, lod);
+    IW_ASSERT(viewport.visible().size() == 9 && viewport.isVisible(5) && !viewport.isVisible(0), "Panning moves the window");
+
+    // Zooming out around the canvas origin keeps it fixed and shows everything.
+    camera = GraphCamera{};
+    camera.zoomAt(0.1f, 0.0f, 0.0f);
+    IW_ASSERT(std::fabs(camera.zoom - 0.1f) < 1e-6f && camera.panX == 0.0f, "Zoom around the origin keeps it fixed");
+    IW_ASSERT(SelectDetail(camera.zoom, 16.0f, lod) == GraphDetail::Dots, "Far zoom draws dots");
+    IW_ASSERT(SelectDetail(0.6f, 16.0f, lod) == GraphDetail::Titles, "Mid zoom draws titles");
+    IW_ASSERT(SelectDetail(1.0f, 16.0f, lod) == GraphDetail::Full, "Close zoom draws full nodes");
+    viewport.update(nodes, camera, 250.0f, 250.0f, lod);
+    IW_ASSERT(viewport.visible().size() == 100, "Zoomed out, every node is visible");
+
+    // 10 canvas pixels between nodes: 40px cells hold 16 nodes each -> super-nodes.
+    lod.clusterCellPixels = 40.0f;
+    const auto& clusters = viewport.cluster(nodes, camera, lod);
+    std::uint32_t total = 0;
+    for (const auto& item : clusters) total += item.count;
+    IW_ASSERT(total == 100, "Clusters account for every node");
+    IW_ASSERT(clusters.size() < 20, "Dense cells collapse into super-nodes (" << clusters.size() << " items)");
+    IW_ASSERT(viewport.clusterOf(0) == viewport.clusterOf(1), "Neighbours share a cluster");
+    return true;
+}
+
+int main() {
+    RUN_TEST(TestBarnesHutMatchesExact);
+    RUN_TEST(TestLayoutFreezesAndPins);
+    RUN_TEST(TestBackgroundSimulation);
+    RUN_TEST(TestMentionMatcher);
+    RUN_TEST(TestIncrementalGraph);
+    RUN_TEST(TestBacklinkIndex);
+    RUN_TEST(TestViewportCullingAndClusters);
+
+    std::cout << "\n=== Results: " << g_passed << " passed, " << g_failed << " failed ===\n";
+    return (g_failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,252 @@
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "application/AsyncTaskManager.hpp"
+#include "application/MarkdownDocument.hpp"
+#include "application/MermaidLayoutCache.hpp"
+#include "application/UnifiedKnowledge.hpp"
+
+using namespace ideawalker::application;
+
+// Checks stay active in Release builds (NDEBUG), unlike assert(); a failure ends the test.
+#define IW_CHECK(condition)                                                     \
+    do {                                                                        \
+        if (!(condition)) {                                                     \
+            std::cerr << "[FAIL] " << #condition << "\n";                      \
+            std::cerr << "       at " << __FILE__ << ":" << __LINE__ << "\n";  \
+            return false;                                                       \
+        }                                                                       \
+    } while (false)
+
+static int g_passed = 0;
+static int g_failed = 0;
+
+#define RUN_TEST(fn)                                                            \
+    do {                                                                        \
+        if (fn()) {                                                             \
+            ++g_passed;                                                         \
+        } else {                                                                \
+            ++g_failed;                                                         \
+        }                                                                       \
+    } while (false)
+
+static std::string_view TextOf(const std::string& source, const MarkdownBlock& block) {
+    return MarkdownDocument::Slice(source, block.textBegin, block.textLength);
+}
+
+static bool TestBlockParsing() {
+    std::cout << "[Test] Starting Markdown Block Parsing Test..." << std::endl;
+    const std::string source =
+        "# Title\r\n"
+        "\n"
+        "  - [x] done\n"
+        "* [ ] todo\n"
+        "• bullet\n"
+        "> quote\n"
+        "see [[Alpha]] and [[Beta]] now\n"
+        "```cpp\n"
+        "int x;\n"
+        "```\n"
+        "```mermaid\n"
+        "graph TD\n"
+        "A-->B\n"
+        "```\n"
+        "```mermaid\n"
+        "unclosed\n";
+
+    const MarkdownDocument doc = MarkdownDocument::Parse(source);
+    const auto& blocks = doc.blocks();
+    IW_CHECK(blocks.size() == 9);
+
+    IW_CHECK(blocks[0].kind == MarkdownBlockKind::Heading && blocks[0].level == 1);
+    IW_CHECK(TextOf(source, blocks[0]) == "Title");
+    IW_CHECK(blocks[1].kind == MarkdownBlockKind::Blank);
+    IW_CHECK(blocks[2].kind == MarkdownBlockKind::Task && blocks[2].checked);
+    IW_CHECK(blocks[2].indentLength == 2 && TextOf(source, blocks[2]) == "done");
+    IW_CHECK(blocks[3].kind == MarkdownBlockKind::Task && !blocks[3].checked);
+    IW_CHECK(blocks[4].kind == MarkdownBlockKind::Bullet && TextOf(source, blocks[4]) == "bullet");
+    IW_CHECK(blocks[5].kind == MarkdownBlockKind::Quote && TextOf(source, blocks[5]) == "quote");
+
+    const MarkdownBlock& para = blocks[6];
+    IW_CHECK(para.kind == MarkdownBlockKind::Paragraph && para.spanCount == 5);
+    const auto& link = doc.spans()[para.spanBegin + 1];
+    IW_CHECK(link.link && MarkdownDocument::Slice(source, link.begin, link.length) == "Alpha");
+    const auto& tail = doc.spans()[para.spanBegin + 4];
+    IW_CHECK(!tail.link && MarkdownDocument::Slice(source, tail.begin, tail.length) == " now");
+
+    IW_CHECK(blocks[7].kind == MarkdownBlockKind::Code);
+    IW_CHECK(MarkdownDocument::Slice(source, blocks[7].langBegin, blocks[7].langLength) == "cpp");
+    IW_CHECK(TextOf(source, blocks[7]) == "int x;\n");
+    IW_CHECK(blocks[8].kind == MarkdownBlockKind::Mermaid && blocks[8].diagram == 0);
+    IW_CHECK(TextOf(source, blocks[8]) == "graph TD\nA-->B\n");
+    // The unclosed fence is dropped, as the line-based renderer did.
+    IW_CHECK(doc.diagramCount() == 1);
+    std::cout << "[PASS] Markdown Block Parsing Test." << std::endl;
+    return true;
+}
+
+static bool TestPreviewRevisions() {
+    std::cout << "[Test] Starting Markdown Preview Cache Test..." << std::endl;
+    std::string text = "# A\n```mermaid\ngraph TD\n```\n";
+    MarkdownPreview preview;
+
+    const bool first = preview.sync(text, 1);
+    IW_CHECK(first && preview.diagrams.size() == 1 && preview.diagramStale[0]);
+    preview.diagramStale[0] = 0;
+
+    // Same revision: idle frames do not reparse.
+    const bool idle = preview.sync(text, 1);
+    IW_CHECK(!idle && !preview.diagramStale[0]);
+
+    // A bumped revision reparses; so does a size change that forgot to bump it.
+    const bool bumped = preview.sync(text, 2);
+    IW_CHECK(bumped && preview.diagramStale[0]);
+    text += "more\n";
+    const bool resized = preview.sync(text, 2);
+    IW_CHECK(resized && preview.document.blocks().size() == 3);
+    std::cout << "[PASS] Markdown Preview Cache Test." << std::endl;
+    return true;
+}
+
+// Offsets and block lookup must stay consistent while measured heights replace estimates.
+static bool TestVirtualizedLayout() {
+    std::cout << "[Test] Starting Markdown Virtualized Layout Test..." << std::endl;
+    std::string text;
+    for (int i = 0; i < 1000; ++i) text += "line " + std::to_string(i) + "\n";
+    text += "```\na\nb\n```\n";
+
+    const MarkdownDocument doc = MarkdownDocument::Parse(text);
+    IW_CHECK(doc.blocks().size() == 1001 && doc.lines().size() == 1004);
+
+    MarkdownMetrics metrics;
+    metrics.lineHeight = 10.0f;
+    metrics.codeChrome = 5.0f;
+    MarkdownLayout layout;
+    layout.reset(doc, {text}, 800.0f, metrics);
+    IW_CHECK(layout.height(1000) == 25.0f);
+    IW_CHECK(layout.totalHeight() == 1000 * 10.0 + 25.0);
+    IW_CHECK(layout.blockAt(0.0) == 0 && layout.blockAt(9.9) == 0 && layout.blockAt(10.0) == 1);
+    IW_CHECK(layout.blockAt(5000.0) == 500 && layout.blockAt(1e9) == 1000);
+
+    // Wrapped text is estimated by width, then corrected by measurement.
+    layout.setHeight(10, 30.0f);
+    IW_CHECK(layout.measured(10) && !layout.measured(11));
+    IW_CHECK(layout.offsetOf(11) == 11 * 10.0 + 20.0);
+    IW_CHECK(layout.blockAt(100.0) == 10 && layout.blockAt(129.0) == 10 && layout.blockAt(130.0) == 11);
+    IW_CHECK(layout.totalHeight() == 1000 * 10.0 + 45.0);
+
+    MarkdownLayout narrow;
+    const std::string longLine(300, 'x');
+    narrow.reset(MarkdownDocument::Parse(longLine), {longLine}, 70.0f, metrics); // 10 chars per line
+    IW_CHECK(narrow.height(0) == 300.0f);
+    std::cout << "[PASS] Markdown Virtualized Layout Test." << std::endl;
+    return true;
+}
+
+// The unified view is a piece table: note contents are referenced, never copied.
+static bool TestUnifiedKnowledgePieces() {
+    std::cout << "[Test] Starting Unified Knowledge Pieces Test..." << std::endl;
+    std::vector<ideawalker::domain::Insight> insights;
+    insights.emplace_back(ideawalker::domain::Insight::Metadata{"a.md", "", "", {}, {}}, "```mermaid\ngraph TD\n");
+    insights.emplace_back(ideawalker::domain::Insight::Metadata{"b.md", "", "", {}, {}}, "- [ ] task\n");
+
+    UnifiedKnowledge unified;
+    const MarkdownPieces& pieces = unified.pieces(insights);
+    IW_CHECK(pieces.size() == 5);
+    IW_CHECK(pieces[1].data() == insights[0].getContent().data());
+    IW_CHECK(unified.assemble(insights) == "## a.md\n\n```mermaid\ngraph TD\n\n\n---\n\n## b.md\n\n- [ ] task\n");
+
+    // A fence left open in one note does not swallow the next one.
+    const MarkdownDocument doc = MarkdownDocument::Parse(pieces);
+    const auto& last = doc.blocks().back();
+    IW_CHECK(last.kind == MarkdownBlockKind::Task && last.piece == 4);
+    IW_CHECK(MarkdownDocument::Slice(pieces[last.piece], last.textBegin, last.textLength) == "task");
+
+    const std::uint64_t before = unified.revision();
+    unified.invalidate();
+    IW_CHECK(unified.revision() == before + 1);
+    insights.pop_back();
+    const bool shrunk = unified.pieces(insights).size() == 2;
+    IW_CHECK(shrunk);
+    std::cout << "[PASS] Unified Knowledge Pieces Test." << std::endl;
+    return true;
+}
+
+// A chain as deep as a long outline: layout walks it without recursion.
+static bool TestDeepMermaidLayout() {
+    std::cout << "[Test] Starting Deep Mermaid Layout Test..." << std::endl;
+    const int depth = 200000;
+    std::string content = "graph TD\n";
+    for (int i = 0; i < depth; ++i) content += "N" + std::to_string(i) + "-->N" + std::to_string(i + 1) + "\n";
+
+    ideawalker::domain::writing::PreviewGraphState graph;
+    auto size = [](const std::string&) { return ideawalker::domain::writing::MermaidParser::NodeSize{100.0f, 40.0f, 160.0f}; };
+    const bool parsed = ideawalker::domain::writing::MermaidParser::Parse(content, graph, size, 0);
+    IW_CHECK(parsed && graph.nodes.size() == static_cast<std::size_t>(depth + 1));
+    IW_CHECK(graph.orientation == ideawalker::domain::writing::LayoutOrientation::TopDown);
+    IW_CHECK(graph.roots.size() == 1 && graph.roots[0] == 0);
+    // Each level sits one node height plus the clamped gap (60) below its parent.
+    IW_CHECK(graph.nodes[0].y == 50.0f && graph.nodes[1].y == 150.0f);
+    IW_CHECK(graph.nodes[depth].y > graph.nodes[depth - 1].y && graph.nodes[depth].x == graph.nodes[0].x);
+    std::cout << "[PASS] Deep Mermaid Layout Test." << std::endl;
+    return true;
+}
+
+// Each distinct diagram is measured and laid out once; large ones off the calling thread.
+static bool TestMermaidLayoutCache() {
+    std::cout << "[Test] Starting Mermaid Layout Cache Test..." << std::endl;
+    std::atomic<int> measured{0};
+    auto size = [&measured](const std::string&) {
+        ++measured;
+        return ideawalker::domain::writing::MermaidParser::NodeSize{100.0f, 40.0f, 160.0f};
+    };
+
+    MermaidLayoutConfig config;
+    config.capacity = 2;
+    config.asyncLineThreshold = 3;
+    auto taskManager = std::make_shared<AsyncTaskManager>();
+    MermaidLayoutCache cache(taskManager, config);
+
+    const std::string small = "graph TD\nA-->B\n";
+    const auto smallKey = MermaidLayoutCache::Key(small, 10000, 1);
+    const MermaidLayout first = cache.acquire(smallKey, small, 10000, size);
+    IW_CHECK(first && first->nodes.size() == 2 && measured == 2);
+    const MermaidLayout again = cache.acquire(smallKey, small, 10000, size);
+    IW_CHECK(again == first && measured == 2);
+    // Same body in another slot or font is another layout.
+    IW_CHECK(MermaidLayoutCache::Key(small, 11000, 1) != smallKey && MermaidLayoutCache::Key(small, 10000, 2) != smallKey);
+
+    const std::string large = "mindmap\nroot\n  a\n  b\n    c\n";
+    const auto largeKey = MermaidLayoutCache::Key(large, 10000, 1);
+    const MermaidLayout deferred = cache.acquire(largeKey, large, 10000, size);
+    IW_CHECK(!deferred);
+    cache.waitUntilIdle();
+    const bool waiting = cache.pending(largeKey);
+    IW_CHECK(!waiting);
+    const MermaidLayout done = cache.find(largeKey);
+    IW_CHECK(done && done->nodes.size() == 4 && done->links.size() == 3);
+
+    // Least recently used goes first: the small diagram was touched before the large one.
+    const std::string other = "graph TD\nX-->Y\n";
+    const bool inserted = cache.acquire(MermaidLayoutCache::Key(other, 10000, 1), other, 10000, size) != nullptr;
+    IW_CHECK(inserted && cache.size() == 2);
+    IW_CHECK(!cache.find(smallKey) && cache.find(largeKey));
+    // Evicted graphs stay valid for the previews still holding them.
+    IW_CHECK(first->nodes.size() == 2);
+    std::cout << "[PASS] Mermaid Layout Cache Test." << std::endl;
+    return true;
+}
+
+int main() {
+    RUN_TEST(TestBlockParsing);
+    RUN_TEST(TestPreviewRevisions);
+    RUN_TEST(TestVirtualizedLayout);
+    RUN_TEST(TestUnifiedKnowledgePieces);
+    RUN_TEST(TestDeepMermaidLayout);
+    RUN_TEST(TestMermaidLayoutCache);
+
+    std::cout << "\n=== Results: " << g_passed << " passed, " << g_failed << " failed ===\n";
+    return (g_failed == 0) ? 0 : 1;
+}
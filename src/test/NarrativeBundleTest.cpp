@@ -8,10 +8,14 @@
  *   F1.A3 — source.model (toolchain) presente em todo bundle gerado
  *   F1.C1 — ScientificIngestionService realiza exatamente 2 invocações de IA
  *            por documento em condições normais (narrativa + discursiva)
+ *   STRATA — manifesto global atualizado apenas para os artigos tocados
+ *   Catálogo — contagens e última validação sem varrer diretórios
+ *   Validador — regras compiladas e validação em lote paralela
  *
  * Refs: ADR-002, ADR-003, ADR-004, ADR-007
  */
 
+#include <algorithm>
 #include <cassert>
 #include <filesystem>
 #include <fstream>
@@ -19,16 +23,25 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <thread>
 #include <vector>
 #include <atomic>
+#include <chrono>
+#include <random>
+#include <sstream>
 
 #include <nlohmann/json.hpp>
 
+#include "application/AsyncTaskManager.hpp"
+#include "application/scientific/EpistemicValidator.hpp"
 #include "application/scientific/ScientificIngestionService.hpp"
+#include "application/scientific/SnippetAnchorIndex.hpp"
+#include "application/scientific/StrataManifestIndex.hpp"
 #include "domain/AIService.hpp"
 #include "domain/SourceArtifact.hpp"
 #include "domain/scientific/ScientificSchema.hpp"
 #include "infrastructure/FileSystemArtifactScanner.hpp"
+#include "infrastructure/PersistenceService.hpp"
 
 namespace fs = std::filesystem;
 using namespace ideawalker;
@@ -178,19 +191,25 @@ static std::string MakeExportableBundle() {
 class MockAIService : public domain::AIService {
 public:
     std::atomic<int> generateJsonCallCount{0};
+    std::atomic<int> inFlight{0};
+    std::atomic<int> maxInFlight{0};
+    std::chrono::milliseconds latency{0};
 
-    // Retorna narrative response na 1ª chamada, discursive na 2ª (por documento).
+    // Responde conforme a fase do prompt de sistema (as fases podem chegar em qualquer ordem).
     std::optional<std::string> generateJson(
-        const std::string& /*system*/,
+        const std::string& system,
         const std::string& /*user*/) override
     {
-        int call = ++generateJsonCallCount;
-        // Odd calls → narrative; even → discursive
-        if (call % 2 == 1) {
-            return MakeNarrativeResponse();
-        } else {
+        ++generateJsonCallCount;
+        const int now = ++inFlight;
+        int seen = maxInFlight.load();
+        while (now > seen && !maxInFlight.compare_exchange_weak(seen, now)) {}
+        if (latency.count() > 0) std::this_thread::sleep_for(latency);
+        --inFlight;
+        if (system.find("DISCURSIVOS") != std::string::npos) {
             return MakeDiscursiveResponse();
         }
+        return MakeNarrativeResponse();
     }
 
     // Stubs para interface completa
@@ -254,13 +273,17 @@ struct TestFixture {
     }
 
     std::unique_ptr<application::scientific::ScientificIngestionService> makeService(
-        std::shared_ptr<domain::AIService> ai)
+        std::shared_ptr<domain::AIService> ai,
+        std::shared_ptr<application::AsyncTaskManager> taskManager = nullptr,
+        application::scientific::IngestionConcurrency concurrency = {})
     {
         auto scanner = std::make_unique<infrastructure::FileSystemArtifactScanner>(inboxPath.string());
         return std::make_unique<application::scientific::ScientificIngestionService>(
             std::move(scanner), ai,
             observationsPath.string(),
-            consumablesPath.string());
+            consumablesPath.string(),
+            std::move(taskManager),
+            concurrency);
     }
 };
 
@@ -496,6 +519,419 @@ bool Test_F1_C3_NarrativeAndDiscursiveArtifactsSeparated() {
     return true;
 }
 
+// ─────────────────────────────────────────────────────────────────────────────
+// Test: STRATA — manifesto global incremental (índice com digest por artigo)
+// ─────────────────────────────────────────────────────────────────────────────
+bool Test_StrataManifest_IncrementalUpdate() {
+    TestFixture fx;
+    auto service = fx.makeService(fx.makeMockAI());
+    IW_ASSERT(service->ingestScientificBundle(MakeExportableBundle(), "manifest_a") &&
+              service->ingestScientificBundle(MakeExportableBundle(), "manifest_b"),
+              "STRATA: dois artigos exportados");
+
+    IW_ASSERT(service->rebuildGlobalManifest() == 2, "STRATA: reconstrução completa indexa os dois artigos");
+    IW_ASSERT(fs::exists(fx.consumablesPath / ".strata_index.json"), "STRATA: índice compacto gravado");
+
+    auto readManifest = [&]() {
+        std::ifstream in(fx.consumablesPath / "STRATA_Manifest.json");
+        return nlohmann::json::parse(in);
+    };
+    auto filenameOf = [](const nlohmann::json& manifest, const std::string& dirName) {
+        for (const auto& article : manifest["articles"]) {
+            if (article.value("relative_path", "") == "./" + dirName + "/") return article.value("filename", "");
+        }
+        return std::string("<ausente>");
+    };
+    IW_ASSERT(readManifest()["total_articles"] == 2, "STRATA: manifesto lista os dois artigos");
+
+    // Edição fora do pipeline: só é lida quando o artigo é tocado (ou na reconstrução).
+    const fs::path manifestB = fx.consumablesPath / "manifest_b" / "Manifest.json";
+    nlohmann::json artManifest;
+    {
+        std::ifstream in(manifestB);
+        artManifest = nlohmann::json::parse(in);
+    }
+    artManifest["filename"] = "editado.pdf";
+    {
+        std::ofstream out(manifestB);
+        out << artManifest.dump(2);
+    }
+
+    application::scientific::StrataManifestIndex index(fx.consumablesPath.string(), fx.observationsPath.string());
+    IW_ASSERT(index.update({"manifest_a"}), "STRATA: atualização incremental grava o manifesto");
+    IW_ASSERT(filenameOf(readManifest(), "manifest_b") != "editado.pdf",
+              "STRATA: artigo não tocado vem do índice (sem reler Manifest.json)");
+
+    IW_ASSERT(index.update({"manifest_b"}), "STRATA: atualização do artigo alterado");
+    IW_ASSERT(filenameOf(readManifest(), "manifest_b") == "editado.pdf", "STRATA: artigo tocado é relido");
+
+    fs::remove_all(fx.consumablesPath / "manifest_a");
+    IW_ASSERT(index.update({"manifest_a"}), "STRATA: atualização após remoção");
+    const nlohmann::json incremental = readManifest();
+    IW_ASSERT(incremental["total_articles"] == 1 && filenameOf(incremental, "manifest_a") == "<ausente>",
+              "STRATA: artigo removido sai do manifesto");
+
+    IW_ASSERT(service->rebuildGlobalManifest() == 1, "STRATA: reconstrução completa");
+    IW_ASSERT(readManifest()["articles"] == incremental["articles"],
+              "STRATA: manifesto incremental idêntico ao da reconstrução completa");
+    return true;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Test: Catálogo de ingestão (log append-only, reconstruível do disco)
+// ─────────────────────────────────────────────────────────────────────────────
+bool Test_IngestionCatalog_TracksWritesAndRebuilds() {
+    TestFixture fx;
+    auto ai = fx.makeMockAI();
+    {
+        auto service = fx.makeService(ai);
+        IW_ASSERT(service->getBundlesCount() == 0 && !service->getLatestValidationSummary(),
+                  "Catálogo: projeto vazio");
+        IW_ASSERT(service->ingestScientificBundle(MakeExportableBundle(), "catalog_a") &&
+                  service->ingestScientificBundle(MakeExportableBundle(), "catalog_b"),
+                  "Catálogo: dois bundles ingeridos");
+        IW_ASSERT(service->getBundlesCount() == 2 && service->getExportedCount() == 2,
+                  "Catálogo: bundles e selos registrados na escrita");
+    }
+
+    const fs::path latestReport = fx.observationsPath / "validation" / "catalog_b.json";
+    auto readFile = [](const fs::path& path) {
+        std::ifstream in(path);
+        std::stringstream buffer;
+        buffer << in.rdbuf();
+        return buffer.str();
+    };
+    auto checkLatest = [&](application::scientific::ScientificIngestionService& service) {
+        auto summary = service.getLatestValidationSummary();
+        return summary && summary->path == latestReport.string() && summary->reportJson == readFile(latestReport) &&
+               summary->exportAllowed;
+    };
+
+    {
+        auto service = fx.makeService(ai); // Estado reconstituído pelo replay do log
+        IW_ASSERT(service->getBundlesCount() == 2 && service->getExportedCount() == 2, "Catálogo: replay do log");
+        IW_ASSERT(checkLatest(*service), "Catálogo: última validação vem do log (relatório lido do disco)");
+    }
+
+    fs::remove_all(fx.observationsPath / "catalog");
+    {
+        auto service = fx.makeService(ai); // Projeto sem catálogo: reconstrução a partir do disco
+        IW_ASSERT(service->getBundlesCount() == 2 && service->getExportedCount() == 2,
+                  "Catálogo: reconstruído a partir dos arquivos");
+        IW_ASSERT(fs::exists(fx.observationsPath / "catalog" / "ingestion.ndjson"), "Catálogo: log regravado");
+
+        fs::remove(fx.observationsPath / "catalog_a.json");
+        IW_ASSERT(service->getBundlesCount() == 2, "Catálogo: consulta não toca o disco");
+        IW_ASSERT(service->rebuildIngestionCatalog() == 1 && service->getBundlesCount() == 1,
+                  "Catálogo: reconstrução explícita reflete o disco");
+        IW_ASSERT(checkLatest(*service), "Catálogo: validação mais recente preservada na reconstrução");
+    }
+    return true;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Test: STRATA — exportação em grupo, Manifest.json publicado por último
+// ─────────────────────────────────────────────────────────────────────────────
+bool Test_StrataExport_GroupWriteAndManifestLast() {
+    TestFixture fx;
+    auto service = fx.makeService(fx.makeMockAI());
+    const fs::path outDir = fx.consumablesPath / "group_export";
+    auto readManifest = [&] {
+        std::ifstream in(outDir / "Manifest.json");
+        return nlohmann::json::parse(in, nullptr, false);
+    };
+
+    IW_ASSERT(service->ingestScientificBundle(MakeExportableBundle(), "group_export"), "Export: bundle exportado");
+    nlohmann::json manifest = readManifest();
+    IW_ASSERT(manifest.is_object() && manifest["files"].size() == manifest["file_index"].size(),
+              "Export: manifesto com índice de arquivos");
+    for (const auto& entry : manifest["file_index"]) {
+        const fs::path path = outDir / entry["name"].get<std::string>();
+        IW_ASSERT(fs::exists(path) && fs::file_size(path) == entry["sizeBytes"].get<std::uintmax_t>(),
+                  "Export: cada arquivo do manifesto existe com o tamanho registrado");
+    }
+    IW_ASSERT(fs::exists(outDir / "EpistemicValidationReport.json") && fs::exists(outDir / "ExportSeal.json"),
+              "Export: relatório e selo gravados no mesmo grupo");
+    for (const auto& entry : fs::directory_iterator(outDir)) {
+        IW_ASSERT(entry.path().extension() != ".tmp", "Export: nenhum arquivo temporário remanescente");
+    }
+
+    // Re-exportação sem contexto discursivo: a cópia antiga não pode continuar listada.
+    nlohmann::json bundle = nlohmann::json::parse(MakeExportableBundle());
+    bundle.erase("discursiveContext");
+    IW_ASSERT(service->ingestScientificBundle(bundle.dump(), "group_export"), "Export: re-exportação aceita");
+    manifest = readManifest();
+    const auto& files = manifest["files"];
+    IW_ASSERT(std::find(files.begin(), files.end(), "DiscursiveContext.json") == files.end() &&
+              !fs::exists(outDir / "DiscursiveContext.json"),
+              "Export: consumível opcional obsoleto removido na re-exportação");
+
+    std::string error;
+    const std::vector<infrastructure::SaveTask> group = {
+        {(fx.consumablesPath / "group" / "a.json").string(), "{}"},
+        {(fx.consumablesPath / "group" / "b.json").string(), "[]"},
+        {(fx.consumablesPath / "group" / "c.json").string(), "null"}
+    };
+    IW_ASSERT(infrastructure::PersistenceService::WriteGroup(group, infrastructure::FsyncPolicy::Full, 3, error) &&
+              error.empty() && fs::file_size(fx.consumablesPath / "group" / "c.json") == 4,
+              "Export: escrita em grupo com vários workers");
+    return true;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Test: F1.C1 pipeline — fases concorrentes, limite de chamadas simultâneas
+// ─────────────────────────────────────────────────────────────────────────────
+bool Test_F1_C1_PipelinedBatchRespectsLlmLimit() {
+    auto runBatch = [](std::shared_ptr<application::AsyncTaskManager> taskManager,
+                       application::scientific::IngestionConcurrency concurrency,
+                       MockAIService& ai) {
+        TestFixture fx;
+        for (int i = 0; i < 4; ++i) {
+            fx.createInboxFile("paper_pipe_" + std::to_string(i) + ".txt", "Abstract. Paper content with findings.");
+        }
+        auto service = fx.makeService(std::shared_ptr<domain::AIService>(&ai, [](domain::AIService*) {}),
+                                      std::move(taskManager), concurrency);
+        return service->ingestPending(nullptr);
+    };
+
+    MockAIService sequentialAI;
+    const auto sequential = runBatch(nullptr, {}, sequentialAI);
+
+    MockAIService pipelinedAI;
+    pipelinedAI.latency = std::chrono::milliseconds(40);
+    application::scientific::IngestionConcurrency concurrency;
+    concurrency.llmCalls = 3;
+    concurrency.articlesInFlight = 4;
+    auto taskManager = std::make_shared<application::AsyncTaskManager>();
+    const auto start = std::chrono::steady_clock::now();
+    const auto pipelined = runBatch(taskManager, concurrency, pipelinedAI);
+    const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    // Task threads deregister after the batch returns; the manager must outlive them.
+    while (!taskManager->GetActiveTasks().empty()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    std::cout << "[INFO] Pipeline: 8 chamadas de 40 ms em " << elapsed << " ms (máx. simultâneas: "
+              << pipelinedAI.maxInFlight.load() << ")\n";
+
+    IW_ASSERT(pipelinedAI.generateJsonCallCount.load() == 8, "F1.C1 (pipeline): 2 invocações por documento");
+    IW_ASSERT(pipelinedAI.maxInFlight.load() > 1, "F1.C1 (pipeline): chamadas de IA emitidas em paralelo");
+    IW_ASSERT(pipelinedAI.maxInFlight.load() <= 3, "F1.C1 (pipeline): limite de chamadas simultâneas respeitado");
+    IW_ASSERT(pipelined.artifactsDetected == 4 && pipelined.bundlesGenerated == sequential.bundlesGenerated &&
+              pipelined.errors.size() == sequential.errors.size(),
+              "F1.C1 (pipeline): mesmo resultado do processamento sequencial");
+    return true;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Test: Ancoragem de evidências — índice por artigo
+// ─────────────────────────────────────────────────────────────────────────────
+
+// Referência ingênua (janela deslizante sobre todos os tokens, DP completo).
+static std::vector<std::string> SplitTokens(const std::string& normalized) {
+    std::vector<std::string> tokens;
+    std::istringstream in(normalized);
+    std::string token;
+    while (in >> token) tokens.push_back(token);
+    return tokens;
+}
+
+static size_t ReferenceDistance(const std::string& a, const std::string& b) {
+    std::vector<std::vector<size_t>> d(a.size() + 1, std::vector<size_t>(b.size() + 1));
+    for (size_t i = 0; i <= a.size(); ++i) d[i][0] = i;
+    for (size_t j = 0; j <= b.size(); ++j) d[0][j] = j;
+    for (size_t i = 1; i <= a.size(); ++i) {
+        for (size_t j = 1; j <= b.size(); ++j) {
+            d[i][j] = std::min({d[i - 1][j] + 1, d[i][j - 1] + 1, d[i - 1][j - 1] + (a[i - 1] == b[j - 1] ? 0 : 1)});
+        }
+    }
+    return d[a.size()][b.size()];
+}
+
+static bool ReferenceAnchored(const std::string& snippet, const std::string& content) {
+    using application::scientific::SnippetAnchorIndex;
+    if (snippet.empty()) return false;
+    const std::string normSnippet = SnippetAnchorIndex::Normalize(snippet);
+    const std::string normContent = SnippetAnchorIndex::Normalize(content);
+    if (normContent.find(normSnippet) != std::string::npos) return true;
+    const auto sTokens = SplitTokens(normSnippet);
+    const auto cTokens = SplitTokens(normContent);
+    if (sTokens.empty() || cTokens.size() < sTokens.size()) return false;
+    const size_t maxErrors = std::max<size_t>(1, sTokens.size() / 4);
+    for (size_t i = 0; i + sTokens.size() <= cTokens.size(); ++i) {
+        size_t errors = 0;
+        for (size_t j = 0; j < sTokens.size(); ++j) {
+            const std::string& s = sTokens[j];
+            const std::string& c = cTokens[i + j];
+            const bool match = s == c || (s.size() >= 4 && c.size() >= 4 &&
+                                          ReferenceDistance(s, c) <= (s.size() > 6 ? 2u : 1u));
+            if (!match) ++errors;
+        }
+        if (errors <= maxErrors) return true;
+    }
+    return false;
+}
+
+bool Test_SnippetAnchorIndex_MatchesReference() {
+    using application::scientific::SnippetAnchorIndex;
+
+    std::mt19937 rng(42);
+    for (int i = 0; i < 20000; ++i) {
+        std::string a, b;
+        const int la = static_cast<int>(rng() % 70), lb = static_cast<int>(rng() % 70);
+        for (int k = 0; k < la; ++k) a.push_back(static_cast<char>('a' + rng() % 4));
+        for (int k = 0; k < lb; ++k) b.push_back(static_cast<char>('a' + rng() % 4));
+        if (SnippetAnchorIndex::EditDistance(a, b) != ReferenceDistance(a, b)) {
+            IW_ASSERT(false, "Ancoragem: distância de Myers igual à DP (" + a + ", " + b + ")");
+        }
+    }
+    std::cout << "[PASS] Ancoragem: distância de Myers igual à DP em 20000 pares\n";
+
+    const std::vector<std::string> vocabulary = {
+        "a", "de", "em", "solo", "fogo", "campo", "manejo", "pastejo", "regime", "queimada",
+        "biomassa", "sucessão", "vegetação", "gramíneas", "recuperação", "estrutura", "campos", "pastoreio"};
+    auto randomWord = [&](bool typo) {
+        std::string word = vocabulary[rng() % vocabulary.size()];
+        if (typo && word.size() >= 4) {
+            const size_t pos = rng() % word.size();
+            switch (rng() % 3) {
+                case 0: word[pos] = static_cast<char>('a' + rng() % 26); break;
+                case 1: word.erase(pos, 1); break;
+                default: word.insert(pos, 1, static_cast<char>('a' + rng() % 26)); break;
+            }
+        }
+        return word;
+    };
+
+    size_t anchored = 0;
+    for (int article = 0; article < 40; ++article) {
+        std::vector<std::string> words;
+        std::string content;
+        for (int k = 0; k < 400; ++k) {
+            words.push_back(randomWord(rng() % 10 == 0));
+            content += (k % 13 == 0 ? "\n  " : " ") + (rng() % 7 == 0 ? std::string("Título") : words.back());
+        }
+        SnippetAnchorIndex index(content);
+        for (int q = 0; q < 60; ++q) {
+            std::string snippet;
+            const size_t length = 1 + rng() % 12;
+            const size_t start = rng() % (words.size() - length);
+            for (size_t k = 0; k < length; ++k) {
+                snippet += (k ? " " : "") + (rng() % 4 == 0 ? randomWord(true) : words[start + k]);
+            }
+            const bool expected = ReferenceAnchored(snippet, content);
+            if (index.contains(snippet) != expected) {
+                IW_ASSERT(false, "Ancoragem: índice concorda com a referência para \"" + snippet + "\"");
+            }
+            if (expected) ++anchored;
+        }
+    }
+    IW_ASSERT(anchored > 0 && anchored < 2400, "Ancoragem: índice concorda com a referência em 2400 trechos");
+
+    SnippetAnchorIndex index("The   grazing REGIME\ncontrols biomass recovery in native grasslands.");
+    IW_ASSERT(index.contains("grazing regime controls"), "Ancoragem: substring normalizada aceita");
+    IW_ASSERT(index.contains("the grazing regimes control biomass recovery"), "Ancoragem: variação leve de tokens aceita");
+    IW_ASSERT(!index.contains("fire suppression increases woody encroachment"), "Ancoragem: trecho inventado rejeitado");
+    IW_ASSERT(!index.contains(""), "Ancoragem: trecho vazio rejeitado");
+    return true;
+}
+
+bool Test_SnippetAnchorIndex_LargeArticle() {
+    using application::scientific::SnippetAnchorIndex;
+
+    // ~60 páginas (~30k palavras) e um bundle de 100 itens, metade inventada.
+    std::mt19937 rng(7);
+    std::vector<std::string> words;
+    for (int i = 0; i < 5000; ++i) {
+        std::string word;
+        const int length = 2 + static_cast<int>(rng() % 9);
+        for (int k = 0; k < length; ++k) word.push_back(static_cast<char>('a' + rng() % 26));
+        words.push_back(word);
+    }
+    std::vector<std::string> text;
+    std::string content;
+    for (int i = 0; i < 30000; ++i) {
+        text.push_back(words[std::min<size_t>(words.size() - 1, static_cast<size_t>(std::exponential_distribution<>(0.01)(rng)))]);
+        content += text.back() + (i % 12 == 11 ? "\n" : " ");
+    }
+    std::vector<std::string> snippets;
+    for (int i = 0; i < 100; ++i) {
+        std::string snippet;
+        const size_t start = rng() % (text.size() - 30);
+        for (size_t k = 0; k < 20; ++k) {
+            std::string token = text[start + k];
+            if (i % 2 == 1) token = words[rng() % words.size()];
+            else if (k % 7 == 3 && token.size() > 4) token[1] = '#';
+            snippet += (k ? " " : "") + token;
+        }
+        snippets.push_back(snippet);
+    }
+
+    const auto begin = std::chrono::steady_clock::now();
+    SnippetAnchorIndex index(content);
+    size_t anchored = 0;
+    for (const auto& snippet : snippets) {
+        if (index.contains(snippet)) ++anchored;
+    }
+    const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    std::cout << "[INFO] Ancoragem: 100 trechos x 30000 tokens em " << elapsed << " ms\n";
+    IW_ASSERT(anchored == 50, "Ancoragem: trechos reais (com erros leves) aceitos e inventados rejeitados");
+    return true;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Test: Validador epistemológico — regras compiladas e validação em lote
+// ─────────────────────────────────────────────────────────────────────────────
+bool Test_EpistemicValidator_RulesAndBatch() {
+    using application::scientific::EpistemicValidator;
+    EpistemicValidator validator;
+
+    nlohmann::json clean = {
+        {"narrativeObservations", {{{"observation", "Cover declined after 2010."}, {"contextuality", "Pampa"}}}},
+        {"allegedMechanisms", {{{"mechanism", "Grazing shifts dominance."}, {"status", "Tested"},
+                                {"limitations", "One site."}, {"evidenceSnippet", "shifts dominance"}, {"contextuality", "Pampa"}}}},
+        {"baselineAssumptions", {{{"baselineType", "fixed"}}}},
+        {"temporalWindowReferences", {{{"timeWindow", "2001-2018"}, {"changeRhythm", "gradual"}, {"delaysOrHysteresis", "lag"}}}}
+    };
+    auto result = validator.Validate(clean);
+    IW_ASSERT(result.exportAllowed && result.report["status"] == "pass", "Validador: bundle limpo aprovado");
+    IW_ASSERT(result.seal["allowedTargets"].size() == 2, "Validador: sem camadas interpretativas, Core e CAC permitidos");
+
+    nlohmann::json normative = clean;
+    normative["narrativeObservations"][0]["observation"] = "Managers MUST reduce stocking.";
+    normative["interpretationLayers"] = {{"authorInterpretations", {"This Permite recovery."}}};
+    normative["requestedTargets"] = {"STRATA-CORE"};
+    normative["temporalWindowReferences"][0]["timeWindow"] = "several Decades";
+    result = validator.Validate(normative);
+    IW_ASSERT(!result.exportAllowed && result.report["status"] == "block", "Validador: linguagem normativa bloqueia");
+    IW_ASSERT(result.report["errors"] == nlohmann::json({"Linguagem normativa detectada em observation.",
+                                                         "InterpretationLayers presentes: STRATA-Core não permitido."}),
+              "Validador: erros na ordem das verificações, sem diferenciar maiúsculas");
+    IW_ASSERT(result.report["warnings"] == nlohmann::json({"Linguagem normativa detectada em authorInterpretations."}),
+              "Validador: interpretação do autor gera apenas aviso");
+    IW_ASSERT(result.report["checks"]["temporal"] == "warning", "Validador: janela temporal vaga sinalizada");
+
+    std::vector<nlohmann::json> bundles;
+    for (int i = 0; i < 64; ++i) {
+        nlohmann::json bundle = i % 2 ? clean : normative;
+        if (i % 3 == 0) bundle.erase("baselineAssumptions");
+        if (i % 5 == 0) bundle["allegedMechanisms"][0]["status"] = "unknown";
+        bundles.push_back(bundle);
+    }
+    auto taskManager = std::make_shared<application::AsyncTaskManager>();
+    const auto parallel = validator.ValidateBatch(bundles, taskManager.get(), 4);
+    const auto sequential = validator.ValidateBatch(bundles);
+    while (!taskManager->GetActiveTasks().empty()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    IW_ASSERT(parallel.size() == bundles.size() && sequential.size() == bundles.size(), "Validador (lote): um resultado por bundle");
+    for (size_t i = 0; i < bundles.size(); ++i) {
+        const auto single = validator.Validate(bundles[i]);
+        if (parallel[i].report != single.report || parallel[i].seal != single.seal ||
+            sequential[i].report != single.report) {
+            IW_ASSERT(false, "Validador (lote): resultado " + std::to_string(i) + " igual ao da validação individual");
+        }
+    }
+    IW_ASSERT(true, "Validador (lote): resultados paralelos e sequenciais idênticos e na ordem de entrada");
+    return true;
+}
+
 // ─────────────────────────────────────────────────────────────────────────────
 // Main
 // ─────────────────────────────────────────────────────────────────────────────
@@ -511,6 +947,13 @@ int main() {
     RUN_TEST(Test_F1_A1_BundleWithoutSchemaVersionRejected);
     RUN_TEST(Test_F1_A4_ExportOnlyStructuredBundleArtifacts);
     RUN_TEST(Test_F1_C3_NarrativeAndDiscursiveArtifactsSeparated);
+    RUN_TEST(Test_F1_C1_PipelinedBatchRespectsLlmLimit);
+    RUN_TEST(Test_SnippetAnchorIndex_MatchesReference);
+    RUN_TEST(Test_SnippetAnchorIndex_LargeArticle);
+    RUN_TEST(Test_StrataManifest_IncrementalUpdate);
+    RUN_TEST(Test_IngestionCatalog_TracksWritesAndRebuilds);
+    RUN_TEST(Test_StrataExport_GroupWriteAndManifestLast);
+    RUN_TEST(Test_EpistemicValidator_RulesAndBatch);
 
     std::cout << "\n=== Results: " << g_passed << " passed, " << g_failed << " failed ===\n";
     return (g_failed == 0) ? 0 : 1;
@@ -5,6 +5,7 @@
  * Covers:
  *   F1.B2 — Log de exclusão estrutural escrito em toda extração de PDF
  *   F1.C2 — Ausência de DiscursiveContext não bloqueia pipeline (Modo Parcial)
+ *   F1.C4 — Reexecução após interrupção refaz apenas as etapas pendentes
  *
  * Refs: ADR-007, ADR-008, ADR-011
  */
@@ -22,6 +23,7 @@
 
 #include <nlohmann/json.hpp>
 
+#include "application/scientific/IngestionCheckpoints.hpp"
 #include "application/scientific/ScientificIngestionService.hpp"
 #include "domain/AIService.hpp"
 #include "domain/SourceArtifact.hpp"
@@ -105,6 +107,49 @@ public:
     std::string getCurrentModel() const override { return "mock-fail-discursive"; }
 };
 
+// Responde conforme a fase do prompt; a discursiva pode ser desligada (Ollama caído).
+class ScriptedAIService : public domain::AIService {
+public:
+    std::atomic<int> narrativeCalls{0};
+    std::atomic<int> discursiveCalls{0};
+    std::atomic<bool> discursiveDown{false};
+    std::atomic<bool> narrativeOffSchema{false};
+
+    std::optional<std::string> generateJson(const std::string& system, const std::string&) override {
+        if (system.find("DISCURSIVOS") != std::string::npos) {
+            ++discursiveCalls;
+            if (discursiveDown) return std::nullopt;
+            nlohmann::json j;
+            j["discursiveContext"] = {{"frames", nlohmann::json::array()}};
+            j["discursiveSystem"] = {
+                {"declaredProblems", nlohmann::json::array()},
+                {"declaredActions", nlohmann::json::array()},
+                {"expectedEffects", nlohmann::json::array()}
+            };
+            return j.dump();
+        }
+        ++narrativeCalls;
+        FailingDiscursiveAIService narrative;
+        auto response = narrative.generateJson("", ""); // 1ª chamada do mock = narrativa válida
+        if (narrativeOffSchema && response) {
+            auto j = nlohmann::json::parse(*response);
+            j["schemaVersion"] = domain::scientific::ScientificSchema::SchemaVersion + 100;
+            return j.dump();
+        }
+        return response;
+    }
+
+    std::optional<domain::Insight> processRawThought(const std::string&, bool, std::function<void(std::string)>) override { return std::nullopt; }
+    std::optional<std::string> chat(const std::vector<ChatMessage>&, bool) override { return "mock"; }
+    std::optional<std::string> consolidateTasks(const std::string&) override { return std::nullopt; }
+    std::vector<float> getEmbedding(const std::string&) override { return {}; }
+    std::vector<std::string> getAvailableModels() override { return {"mock"}; }
+    void setModel(const std::string& name) override { model = name; }
+    std::string getCurrentModel() const override { return model; }
+
+    std::string model = "mock-scripted";
+};
+
 struct TestFixture {
     fs::path root;
     fs::path inboxPath;
@@ -216,11 +261,152 @@ bool Test_F1_B2_ExclusionLogging() {
     return true;
 }
 
+// ─────────────────────────────────────────────────────────────────────────────
+// Test: F1.C4 — Checkpoints: retomada sem refazer etapas concluídas
+// ─────────────────────────────────────────────────────────────────────────────
+bool Test_F1_C4_ResumeRedoesOnlyUnfinishedStages() {
+    TestFixture fx;
+    auto ai = std::make_shared<ScriptedAIService>();
+    auto makeService = [&]() {
+        auto scanner = std::make_unique<infrastructure::FileSystemArtifactScanner>(fx.inboxPath.string());
+        return std::make_unique<application::scientific::ScientificIngestionService>(
+            std::move(scanner), ai, fx.observationsPath.string(), fx.consumablesPath.string());
+    };
+    auto countBundles = [&]() {
+        size_t count = 0;
+        for (const auto& entry : fs::directory_iterator(fx.observationsPath)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".json") ++count;
+        }
+        return count;
+    };
+    {
+        std::ofstream f(fx.inboxPath / "resume_test.txt");
+        f << "Scientific content for resume testing.";
+    }
+
+    // 1ª execução: a discursiva cai no meio do lote.
+    ai->discursiveDown = true;
+    auto first = makeService()->ingestPending(nullptr);
+    IW_ASSERT(first.bundlesGenerated == 1 && ai->narrativeCalls == 1 && ai->discursiveCalls == 1,
+              "F1.C4: 1ª execução gera bundle parcial");
+    IW_ASSERT(fs::exists(fx.observationsPath / "checkpoints" / "checkpoints.ndjson"), "F1.C4: log de checkpoints gravado");
+
+    // 2ª execução (novo processo): só a discursiva é refeita, no mesmo artifactId.
+    ai->discursiveDown = false;
+    auto second = makeService()->ingestPending(nullptr);
+    IW_ASSERT(ai->narrativeCalls == 1, "F1.C4: narrativa recuperada do checkpoint (sem nova chamada de IA)");
+    IW_ASSERT(ai->discursiveCalls == 2, "F1.C4: discursiva pendente refeita");
+    IW_ASSERT(second.bundlesGenerated == 1, "F1.C4: bundle completo na retomada");
+    IW_ASSERT(countBundles() == 1, "F1.C4: retomada reaproveita o artifactId (sem bundle duplicado)");
+
+    // 3ª execução, sem mudanças: artigo concluído é ignorado sem chamadas de IA.
+    auto service = makeService();
+    auto third = service->ingestPending(nullptr);
+    IW_ASSERT(third.artifactsSkipped == 1 && ai->narrativeCalls == 1 && ai->discursiveCalls == 2,
+              "F1.C4: artigo inalterado ignorado sem chamadas de IA");
+
+    // Reingestão com purge: os checkpoints não valem, o artigo é refeito do zero.
+    auto purged = service->ingestSelected(service->listInboxArtifacts(), true, nullptr);
+    IW_ASSERT(purged.artifactsSkipped == 0 && ai->narrativeCalls == 2 && ai->discursiveCalls == 3,
+              "F1.C4: purge reprocessa o artigo mesmo concluído");
+    IW_ASSERT(countBundles() == 1, "F1.C4: purge substitui o bundle anterior");
+
+    // Outro modelo, no mesmo serviço: a versão do pipeline é tomada a cada execução.
+    ai->setModel("mock-scripted-v2");
+    auto otherModel = service->ingestPending(nullptr);
+    IW_ASSERT(otherModel.artifactsSkipped == 0 && ai->narrativeCalls == 3 && ai->discursiveCalls == 4,
+              "F1.C4: troca de modelo invalida o checkpoint");
+
+    // Conteúdo alterado: tudo é refeito.
+    {
+        std::ofstream f(fx.inboxPath / "resume_test.txt");
+        f << "Scientific content for resume testing, revised.";
+    }
+    auto fourth = makeService()->ingestPending(nullptr);
+    IW_ASSERT(fourth.artifactsSkipped == 0 && ai->narrativeCalls == 4 && ai->discursiveCalls == 5,
+              "F1.C4: artigo alterado reprocessado por completo");
+    return true;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Test: F1.C4 — Bundle inválido não é retomado a partir dos payloads salvos
+// ─────────────────────────────────────────────────────────────────────────────
+bool Test_F1_C4_InvalidBundleIsNotResumed() {
+    TestFixture fx;
+    auto ai = std::make_shared<ScriptedAIService>();
+    auto makeService = [&]() {
+        auto scanner = std::make_unique<infrastructure::FileSystemArtifactScanner>(fx.inboxPath.string());
+        return std::make_unique<application::scientific::ScientificIngestionService>(
+            std::move(scanner), ai, fx.observationsPath.string(), fx.consumablesPath.string());
+    };
+    {
+        std::ofstream f(fx.inboxPath / "invalid_test.txt");
+        f << "Scientific content whose first answer breaks the schema.";
+    }
+
+    ai->narrativeOffSchema = true;
+    auto first = makeService()->ingestPending(nullptr);
+    IW_ASSERT(first.bundlesGenerated == 0 && !first.errors.empty(), "F1.C4: bundle fora do schema é rejeitado");
+
+    ai->narrativeOffSchema = false;
+    auto second = makeService()->ingestPending(nullptr);
+    IW_ASSERT(ai->narrativeCalls == 2 && ai->discursiveCalls == 2,
+              "F1.C4: respostas que geraram bundle inválido são pedidas de novo");
+    IW_ASSERT(second.bundlesGenerated == 1, "F1.C4: nova tentativa gera o bundle");
+    return true;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Test: F1.C4 — Log de checkpoints: uma linha por etapa, tolerante a queda
+// ─────────────────────────────────────────────────────────────────────────────
+bool Test_F1_C4_CheckpointLogIsAppendOnly() {
+    using application::scientific::IngestionCheckpoints;
+    using application::scientific::IngestionStage;
+    TestFixture fx;
+    const fs::path dir = fx.observationsPath / "checkpoints";
+    auto countLines = [&]() {
+        std::ifstream in(dir / "checkpoints.ndjson");
+        size_t lines = 0;
+        for (std::string line; std::getline(in, line);) ++lines;
+        return lines;
+    };
+    {
+        IngestionCheckpoints checkpoints(dir.string());
+        checkpoints.begin("aa", "a.pdf", "v1", "id_a");
+        checkpoints.begin("bb", "b.pdf", "v1", "id_b");
+        checkpoints.mark("aa", "a.pdf", IngestionStage::Extracted);
+        checkpoints.mark("aa", "a.pdf", IngestionStage::Narrative);
+        checkpoints.savePayload("aa", "a.pdf", IngestionStage::Narrative, {{"ok", true}});
+        checkpoints.remove("bb", "b.pdf");
+    }
+    IW_ASSERT(countLines() == 5, "F1.C4: cada mudança acrescenta uma linha (sem regravar o manifesto)");
+    {
+        std::ofstream torn(dir / "checkpoints.ndjson", std::ios::app);
+        torn << "{\"op\":\"entry\",\"sourceSha256\":\"aa\",\"fil";
+    }
+
+    IngestionCheckpoints reopened(dir.string());
+    auto entry = reopened.find("aa", "a.pdf", "v1");
+    IW_ASSERT(entry && entry->artifactId == "id_a" && entry->has(IngestionStage::Narrative),
+              "F1.C4: log reproduzido ao reabrir, linha truncada ignorada");
+    IW_ASSERT(!reopened.find("bb", "b.pdf", "v1"), "F1.C4: entrada removida não volta");
+
+    reopened.discard("aa", "a.pdf", IngestionStage::Narrative);
+    entry = reopened.find("aa", "a.pdf", "v1");
+    IW_ASSERT(entry && !entry->has(IngestionStage::Narrative) &&
+              !reopened.loadPayload("aa", "a.pdf", IngestionStage::Narrative),
+              "F1.C4: etapa descartada perde a marca e o payload");
+    return true;
+}
+
 int main() {
-    std::cout << "=== IW Scientific Resilience Tests (F1.B2, F1.C2) ===\n";
+    std::cout << "=== IW Scientific Resilience Tests (F1.B2, F1.C2, F1.C4) ===\n";
 
     RUN_TEST(Test_F1_C2_DiscursiveFailureNotBlocking);
     RUN_TEST(Test_F1_B2_ExclusionLogging);
+    RUN_TEST(Test_F1_C4_ResumeRedoesOnlyUnfinishedStages);
+    RUN_TEST(Test_F1_C4_InvalidBundleIsNotResumed);
+    RUN_TEST(Test_F1_C4_CheckpointLogIsAppendOnly);
 
     std::cout << "\n=== Results: " << g_passed << " passed, " << g_failed << " failed ===\n";
     return (g_failed == 0) ? 0 : 1;
@@ -1,9 +1,15 @@
-#include <cassert>
+#include <chrono>
 #include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <thread>
+#include <vector>
+
+#include <nlohmann/json.hpp>
 
 #include "application/writing/WritingTrajectoryService.hpp"
 #include "domain/writing/WritingTrajectory.hpp"
+#include "infrastructure/JsonScanner.hpp"
 #include "infrastructure/PersistenceService.hpp"
 #include "infrastructure/writing/WritingEventStoreFs.hpp"
 #include "infrastructure/writing/WritingTrajectoryRepositoryFs.hpp"
@@ -12,7 +18,391 @@ using namespace ideawalker::domain::writing;
 using namespace ideawalker::application::writing;
 using namespace ideawalker::infrastructure::writing;
 
-int main() {
+// Checks stay active in Release builds (NDEBUG), where assert() would check nothing; a failure ends the test.
+#define IW_CHECK(condition)                                                     \
+    do {                                                                        \
+        if (!(condition)) {                                                     \
+            std::cerr << "[FAIL] " << #condition << "\n";                      \
+            std::cerr << "       at " << __FILE__ << ":" << __LINE__ << "\n";  \
+            return false;                                                       \
+        }                                                                       \
+    } while (false)
+
+static int g_passed = 0;
+static int g_failed = 0;
+
+#define RUN_TEST(fn)                                                            \
+    do {                                                                        \
+        if (fn()) {                                                             \
+            ++g_passed;                                                         \
+        } else {                                                                \
+            ++g_failed;                                                         \
+        }                                                                       \
+    } while (false)
+
+static bool SameState(const WritingTrajectory& a, const WritingTrajectory& b) {
+    IW_CHECK(a.getId() == b.getId());
+    IW_CHECK(a.getIntent() == b.getIntent());
+    IW_CHECK(a.getStage() == b.getStage());
+
+    IW_CHECK(a.getSegments().size() == b.getSegments().size());
+    for (const auto& [segId, seg] : a.getSegments()) {
+        auto it = b.getSegments().find(segId);
+        IW_CHECK(it != b.getSegments().end());
+        IW_CHECK(seg.title == it->second.title);
+        IW_CHECK(seg.content == it->second.content);
+        IW_CHECK(seg.source == it->second.source);
+        IW_CHECK(seg.version == it->second.version);
+    }
+
+    IW_CHECK(a.getHistory().size() == b.getHistory().size());
+    for (size_t i = 0; i < a.getHistory().size(); ++i) {
+        IW_CHECK(a.getHistory()[i].decisionId == b.getHistory()[i].decisionId);
+        IW_CHECK(a.getHistory()[i].targetSegmentId == b.getHistory()[i].targetSegmentId);
+        IW_CHECK(a.getHistory()[i].operation == b.getHistory()[i].operation);
+        IW_CHECK(a.getHistory()[i].rationale == b.getHistory()[i].rationale);
+    }
+
+    IW_CHECK(a.getDefenseCards().size() == b.getDefenseCards().size());
+    for (size_t i = 0; i < a.getDefenseCards().size(); ++i) {
+        IW_CHECK(a.getDefenseCards()[i].cardId == b.getDefenseCards()[i].cardId);
+        IW_CHECK(a.getDefenseCards()[i].status == b.getDefenseCards()[i].status);
+        IW_CHECK(a.getDefenseCards()[i].userDefenseResponse == b.getDefenseCards()[i].userDefenseResponse);
+        IW_CHECK(a.getDefenseCards()[i].expectedDefensePoints == b.getDefenseCards()[i].expectedDefensePoints);
+    }
+    return true;
+}
+
+// Snapshot + tail replay must rebuild exactly the state of a full replay.
+static bool TestSnapshotReplayMatchesFullReplay() {
+    std::cout << "[Test] Starting Snapshot Replay Consistency Test..." << std::endl;
+
+    std::string testRoot = "test_project_root_writing_snapshot";
+    std::filesystem::remove_all(testRoot);
+    std::filesystem::create_directories(testRoot);
+
+    auto persistence = std::make_shared<ideawalker::infrastructure::PersistenceService>();
+    auto snapshotRepo = std::make_shared<WritingTrajectoryRepositoryFs>(
+        std::make_unique<WritingEventStoreFs>(testRoot, persistence), 4);
+    auto fullReplayRepo = std::make_shared<WritingTrajectoryRepositoryFs>(
+        std::make_unique<WritingEventStoreFs>(testRoot, persistence), 0);
+    WritingTrajectoryService service(snapshotRepo);
+
+    std::string id = service.createTrajectory("Argumentar", "Banca", "Tese", "");
+    service.addSegment(id, "Introdução", "v0", SourceTag::Human);
+    service.addSegment(id, "Método", "m0", SourceTag::AiGenerated);
+    auto traj = service.getTrajectory(id);
+    IW_CHECK(traj);
+    std::string firstSeg = traj->getSegments().begin()->first;
+    std::string lastSeg = traj->getSegments().rbegin()->first;
+
+    for (int i = 1; i <= 10; ++i) {
+        service.reviseSegment(id, (i % 2) ? firstSeg : lastSeg, "v" + std::to_string(i),
+                              RevisionOperation::Expand, "Iteração " + std::to_string(i), SourceTag::AiAssisted);
+    }
+    service.advanceStage(id, TrajectoryStage::Outline);
+    service.addDefenseCard(id, "card-1", firstSeg, "Por quê?", {"A"});
+
+    // Events written after the latest snapshot form the replayed tail.
+    persistence->flush();
+    IW_CHECK(std::filesystem::exists(std::filesystem::path(testRoot) / "writing" / "trajectories" / id / "snapshot.json"));
+    service.reviseSegment(id, firstSeg, "final", RevisionOperation::Compress, "Enxugar", SourceTag::Human);
+    service.updateDefenseStatus(id, "card-1", DefenseStatus::Passed, "");
+
+    auto fromSnapshot = snapshotRepo->findById(id);
+    auto fromFullReplay = fullReplayRepo->findById(id);
+    IW_CHECK(fromSnapshot && fromFullReplay);
+    IW_CHECK(SameState(*fromSnapshot, *fromFullReplay));
+    IW_CHECK(fromSnapshot->getSegments().at(firstSeg).content == "final");
+    IW_CHECK(fromSnapshot->getHistory().size() == 11);
+
+    persistence->stop();
+    std::filesystem::remove_all(testRoot);
+    std::cout << "[PASS] Snapshot Replay Consistency Test." << std::endl;
+    return true;
+}
+
+// Revisions are stored as word deltas (schemaVersion 2); legacy logs stay readable and compactable.
+static bool TestDeltaEncodedRevisions() {
+    std::cout << "[Test] Starting Delta-Encoded Revision Test..." << std::endl;
+
+    std::string testRoot = "test_project_root_writing_delta";
+    std::filesystem::remove_all(testRoot);
+    std::filesystem::create_directories(testRoot);
+
+    auto persistence = std::make_shared<ideawalker::infrastructure::PersistenceService>();
+    auto repo = std::make_shared<WritingTrajectoryRepositoryFs>(
+        std::make_unique<WritingEventStoreFs>(testRoot, persistence), 0);
+    WritingTrajectoryService service(repo);
+
+    std::string text;
+    for (int i = 0; i < 400; ++i) text += "palavra" + std::to_string(i) + (i % 12 == 11 ? ".\n" : " ");
+
+    std::string id = service.createTrajectory("Argumentar", "Banca", "Tese", "");
+    service.addSegment(id, "Capítulo", text, SourceTag::Human);
+    std::string segmentId = service.getTrajectory(id)->getSegments().begin()->first;
+
+    std::size_t verbatimBytes = 0;
+    for (int i = 0; i < 40; ++i) {
+        std::string revised = text;
+        const std::string needle = "palavra" + std::to_string(i * 7) + " ";
+        auto pos = revised.find(needle);
+        if (pos != std::string::npos) revised.replace(pos, needle.size(), "termo" + std::to_string(i) + " ");
+        revised += "acréscimo" + std::to_string(i) + " ";
+        verbatimBytes += text.size() + revised.size();
+        service.reviseSegment(id, segmentId, revised, RevisionOperation::Expand, "Revisão " + std::to_string(i), SourceTag::Human);
+        text = revised;
+    }
+
+    auto traj = repo->findById(id);
+    IW_CHECK(traj);
+    IW_CHECK(traj->getSegments().at(segmentId).content == text);
+    IW_CHECK(traj->getHistory().size() == 40);
+
+    auto eventsPath = std::filesystem::path(testRoot) / "writing" / "trajectories" / id / "events.ndjson";
+    const auto logBytes = std::filesystem::file_size(eventsPath);
+    std::cout << "[Test] Log size: " << logBytes << " bytes (verbatim revisions: " << verbatimBytes << ")" << std::endl;
+    IW_CHECK(logBytes * 5 < verbatimBytes);
+
+    // Legacy schemaVersion 1 log: readable as-is, then rewritten by compaction.
+    const std::string legacyId = "legacy-trajectory";
+    auto legacyDir = std::filesystem::path(testRoot) / "writing" / "trajectories" / legacyId;
+    std::filesystem::create_directories(legacyDir);
+    {
+        std::ofstream out(legacyDir / "events.ndjson");
+        out << R"({"schemaVersion":1,"type":"TrajectoryCreated","data":{"intent":{"purpose":"P","audience":"A","coreClaim":"","constraints":""}},"ts":1})" << "\n";
+        out << R"({"schemaVersion":1,"type":"SegmentAdded","data":{"segmentId":"s1","title":"T","content":"um dois tres","sourceTag":"human"},"ts":2})" << "\n";
+        out << R"({"schemaVersion":1,"type":"SegmentRevised","data":{"segmentId":"s1","oldContent":"um dois tres","newContent":"um dois quatro tres","decisionId":"d1","operation":"expand","rationale":"r1","sourceTag":"ai_assisted"},"ts":3})" << "\n";
+        out << R"({"schemaVersion":1,"type":"SegmentRevised","data":{"segmentId":"s1","oldContent":"um dois quatro tres","newContent":"zero um dois quatro","decisionId":"d2","operation":"reframe","rationale":"r2","sourceTag":"human"},"ts":4})" << "\n";
+    }
+    auto legacy = repo->findById(legacyId);
+    IW_CHECK(legacy);
+    IW_CHECK(legacy->getSegments().at("s1").content == "zero um dois quatro");
+
+    auto stats = repo->compactLog(legacyId);
+    IW_CHECK(stats && stats->revisionsReencoded == 2);
+    auto compacted = repo->findById(legacyId);
+    IW_CHECK(compacted);
+    IW_CHECK(SameState(*legacy, *compacted));
+
+    std::ifstream in(legacyDir / "events.ndjson");
+    std::string all((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    IW_CHECK(all.find("oldContent") == std::string::npos);
+    IW_CHECK(all.find("\"schemaVersion\":2") != std::string::npos);
+
+    // A torn line would be lost by the rewrite: compaction refuses and leaves the log as it was.
+    {
+        std::ofstream out(legacyDir / "events.ndjson", std::ios::app);
+        out << R"({"schemaVersion":2,"type":"SegmentRev)" << "\n";
+    }
+    const auto tornBytes = std::filesystem::file_size(legacyDir / "events.ndjson");
+    IW_CHECK(!repo->compactLog(legacyId));
+    IW_CHECK(std::filesystem::file_size(legacyDir / "events.ndjson") == tornBytes);
+
+    persistence->stop();
+    std::filesystem::remove_all(testRoot);
+    std::cout << "[PASS] Delta-Encoded Revision Test." << std::endl;
+    return true;
+}
+
+// Two services over the same root: the stale identity map must detect the conflict and retry.
+static bool TestConcurrentWritersAndSummaryIndex() {
+    std::cout << "[Test] Starting Optimistic Concurrency Test..." << std::endl;
+
+    std::string testRoot = "test_project_root_writing_concurrency";
+    std::filesystem::remove_all(testRoot);
+    std::filesystem::create_directories(testRoot);
+
+    auto persistence = std::make_shared<ideawalker::infrastructure::PersistenceService>();
+    auto repoA = std::make_shared<WritingTrajectoryRepositoryFs>(std::make_unique<WritingEventStoreFs>(testRoot, persistence));
+    auto repoB = std::make_shared<WritingTrajectoryRepositoryFs>(std::make_unique<WritingEventStoreFs>(testRoot, persistence));
+    WritingTrajectoryService serviceA(repoA);
+    WritingTrajectoryService serviceB(repoB);
+
+    std::string id = serviceA.createTrajectory("Argumentar", "Banca", "Tese", "");
+    IW_CHECK(serviceA.listTrajectories().size() == 1); // A's summaries are cached from here on
+    serviceA.addSegment(id, "Introdução", "a", SourceTag::Human);
+    auto live = serviceB.getLiveTrajectory(id); // B caches version 2
+    IW_CHECK(live && live->getPersistedVersion() == 2);
+
+    serviceA.addSegment(id, "Método", "b", SourceTag::Human);
+
+    // A direct update from the stale copy is rejected...
+    WritingTrajectory stale = *live;
+    stale.advanceStage(TrajectoryStage::Outline);
+    bool rejected = false;
+    try {
+        repoB->update(stale);
+    } catch (const ConcurrencyError&) {
+        rejected = true;
+    }
+    IW_CHECK(rejected);
+
+    // ...while the service reloads and retries the command.
+    serviceB.addSegment(id, "Conclusão", "c", SourceTag::Human);
+    auto merged = repoA->findById(id);
+    IW_CHECK(merged && merged->getSegments().size() == 3);
+    IW_CHECK(merged->getPersistedVersion() == 4);
+
+    // Listings come from the service's cache: B's append shows up after an explicit refresh.
+    auto summaries = serviceB.listTrajectories();
+    IW_CHECK(summaries.size() == 1 && summaries[0].segmentCount == 3 && summaries[0].eventCount == 4);
+    summaries = serviceA.listTrajectories();
+    IW_CHECK(summaries.size() == 1 && summaries[0].segmentCount == 2);
+    serviceA.refreshCache();
+    summaries = serviceA.listTrajectories();
+    IW_CHECK(summaries.size() == 1);
+    IW_CHECK(summaries[0].id == id && summaries[0].segmentCount == 3 && summaries[0].eventCount == 4);
+    IW_CHECK(serviceA.getTrajectoryCount() == 1);
+
+    persistence->flush();
+    IW_CHECK(std::filesystem::exists(std::filesystem::path(testRoot) / "writing" / "trajectories" / "index.json"));
+
+    // The index alone serves a fresh repository.
+    auto coldRepo = std::make_shared<WritingTrajectoryRepositoryFs>(std::make_unique<WritingEventStoreFs>(testRoot, persistence));
+    auto coldSummaries = coldRepo->listSummaries();
+    IW_CHECK(coldSummaries.size() == 1 && coldSummaries[0].segmentCount == 3);
+
+    persistence->stop();
+    std::filesystem::remove_all(testRoot);
+    std::cout << "[PASS] Optimistic Concurrency Test." << std::endl;
+    return true;
+}
+
+// A live pointer held across a command keeps its version; concurrent commands on one trajectory all land.
+static bool TestLiveTrajectoryCopyOnWrite() {
+    std::cout << "[Test] Starting Live Trajectory Copy-On-Write Test..." << std::endl;
+
+    std::string testRoot = "test_project_root_writing_cow";
+    std::filesystem::remove_all(testRoot);
+    std::filesystem::create_directories(testRoot);
+
+    auto persistence = std::make_shared<ideawalker::infrastructure::PersistenceService>();
+    auto repo = std::make_shared<WritingTrajectoryRepositoryFs>(std::make_unique<WritingEventStoreFs>(testRoot, persistence), 8);
+    WritingTrajectoryService service(repo);
+
+    std::string id = service.createTrajectory("Argumentar", "Banca", "Tese", "");
+    service.addSegment(id, "Introdução", "a", SourceTag::Human);
+    auto held = service.getLiveTrajectory(id);
+    IW_CHECK(held && held->getSegments().size() == 1);
+    const std::string segmentId = held->getSegments().begin()->first;
+
+    service.reviseSegment(id, segmentId, "a b", RevisionOperation::Expand, "Mais", SourceTag::Human);
+    IW_CHECK(held->getSegments().at(segmentId).content == "a");
+    IW_CHECK(held->getPersistedVersion() == 2);
+    IW_CHECK(service.getLiveTrajectory(id)->getSegments().at(segmentId).content == "a b");
+
+    // A rejected command leaves the live version as it was.
+    bool rejected = false;
+    try {
+        service.reviseSegment(id, "inexistente", "x", RevisionOperation::Expand, "r", SourceTag::Human);
+    } catch (const std::exception&) {
+        rejected = true;
+    }
+    IW_CHECK(rejected);
+    IW_CHECK(service.getLiveTrajectory(id)->getPersistedVersion() == 3);
+
+    const int perWriter = 20;
+    std::vector<std::thread> writers;
+    for (int w = 0; w < 3; ++w) {
+        writers.emplace_back([&service, &id, w]() {
+            for (int i = 0; i < perWriter; ++i) {
+                service.addSegment(id, "W" + std::to_string(w) + "-" + std::to_string(i), "x", SourceTag::Human);
+            }
+        });
+    }
+    for (auto& writer : writers) writer.join();
+
+    const std::size_t expected = 1 + 3 * perWriter;
+    IW_CHECK(service.getLiveTrajectory(id)->getSegments().size() == expected);
+    auto reloaded = repo->findById(id);
+    IW_CHECK(reloaded && reloaded->getSegments().size() == expected);
+    IW_CHECK(reloaded->getPersistedVersion() == 3 + 3 * perWriter);
+
+    persistence->stop();
+    std::filesystem::remove_all(testRoot);
+    std::cout << "[PASS] Live Trajectory Copy-On-Write Test." << std::endl;
+    return true;
+}
+
+// Event lines are read without a DOM: same accepted lines and payloads as nlohmann, same bytes written.
+static bool TestEventLogScanning() {
+    std::cout << "[Test] Starting Event Log Scanning Test..." << std::endl;
+    using ideawalker::infrastructure::JsonScanner;
+
+    const std::vector<std::string> samples = {
+        R"({"a":[1,-0.5e+3,true,null,{"b":"é😀\n"}]})", R"(  "x"  )", "-0", "[]",
+        R"({"a":1,})", "01", "1.", R"("\ud83d")", R"("\x")", "[1 2]", "{\"a\":\"\xc3\"}", "\"\xed\xa0\x80\"", "1e999", ""
+    };
+    for (const auto& sample : samples) {
+        const bool expected = !nlohmann::json::parse(sample, nullptr, false).is_discarded();
+        IW_CHECK(JsonScanner::parse(sample).has_value() == expected);
+    }
+    auto decoded = JsonScanner::parse(R"("tab\t é 😀 \"q\"")");
+    IW_CHECK(decoded && decoded->asString() == nlohmann::json::parse(R"("tab\t é 😀 \"q\"")").get<std::string>());
+
+    std::string testRoot = "test_project_root_writing_scan";
+    std::filesystem::remove_all(testRoot);
+    WritingEventStoreFs store(testRoot, nullptr);
+
+    // Spliced lines are byte-identical to the DOM path.
+    const nlohmann::json payload = {{"segmentId", "s1"}, {"content", "aspas \" e acentuação\n"}, {"n", 3}};
+    StoredEvent evt{"SegmentAdded", payload.dump(), std::chrono::system_clock::time_point(std::chrono::milliseconds(42)), 2};
+    store.append("t1", {evt});
+    const auto eventsPath = std::filesystem::path(testRoot) / "writing" / "trajectories" / "t1" / "events.ndjson";
+    {
+        std::ifstream in(eventsPath);
+        std::string line;
+        std::getline(in, line);
+        const nlohmann::json expected = {{"schemaVersion", 2}, {"type", "SegmentAdded"}, {"data", payload}, {"ts", 42}};
+        IW_CHECK(line == expected.dump());
+    }
+
+    // Malformed or mistyped lines are skipped exactly as before; payload text survives as-is.
+    {
+        std::ofstream out(eventsPath, std::ios::app);
+        out << R"({"schemaVersion":"2","type":"SegmentAdded","data":{},"ts":1})" << "\n";
+        out << R"({"schemaVersion":1,"type":"SegmentAdded","data":{"a":)" << "\n";
+        out << R"({"type":7,"data":{},"ts":1})" << "\n";
+        out << R"({ "type" : "StageAdvanced", "data" : { "oldStage" : "Intent", "newStage" : "Outline" } })" << "\n";
+    }
+    auto events = store.readAll("t1");
+    IW_CHECK(events.size() == 2);
+    IW_CHECK(nlohmann::json::parse(events[0].eventDataJson) == payload);
+    IW_CHECK(events[0].schemaVersion == 2 && events[0].timestamp.time_since_epoch() == std::chrono::milliseconds(42));
+    IW_CHECK(events[1].eventType == "StageAdvanced" && events[1].schemaVersion == 1);
+    IW_CHECK(nlohmann::json::parse(events[1].eventDataJson)["newStage"] == "Outline");
+
+    // Replay cost of a long log: envelope scan vs. the previous parse + dump per line.
+    std::vector<StoredEvent> many(20000, evt);
+    for (size_t i = 0; i < many.size(); ++i) {
+        many[i].eventDataJson = nlohmann::json{{"segmentId", "s" + std::to_string(i % 50)},
+                                               {"content", std::string(400, static_cast<char>('a' + i % 26))}}.dump();
+    }
+    store.append("t2", many);
+    const auto start = std::chrono::steady_clock::now();
+    const auto replayed = store.readAll("t2");
+    const auto scanMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::ifstream in(std::filesystem::path(testRoot) / "writing" / "trajectories" / "t2" / "events.ndjson");
+    std::string line;
+    size_t domEvents = 0;
+    const auto domStart = std::chrono::steady_clock::now();
+    while (std::getline(in, line)) {
+        auto j = nlohmann::json::parse(line);
+        domEvents += !j["data"].dump().empty();
+    }
+    const auto domMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - domStart).count();
+    std::cout << "[Test] Replay of 20000 events: " << scanMs << " ms (scan) vs " << domMs << " ms (DOM)" << std::endl;
+    IW_CHECK(replayed.size() == many.size() && domEvents == many.size());
+    IW_CHECK(replayed.back().eventDataJson == many.back().eventDataJson);
+
+    std::filesystem::remove_all(testRoot);
+    std::cout << "[PASS] Event Log Scanning Test." << std::endl;
+    return true;
+}
+
+// Create, edit and rehydrate one trajectory through the service.
+static bool TestRoundTrip() {
     std::cout << "[Test] Starting WritingTrajectory Round-Trip Test..." << std::endl;
 
     std::string testRoot = "test_project_root_writing";
@@ -36,7 +426,7 @@ int main() {
 
     // Revise segment
     auto trajAfterAdd = service.getTrajectory(id);
-    assert(trajAfterAdd && "Trajectory should exist after creation.");
+    IW_CHECK(trajAfterAdd && "Trajectory should exist after creation.");
 
     std::string segmentId = trajAfterAdd->getSegments().begin()->first;
     service.reviseSegment(
@@ -57,23 +447,36 @@ int main() {
 
     // Rehydrate
     auto traj = repo->findById(id);
-    assert(traj && "Trajectory should be rehydrated.");
+    IW_CHECK(traj && "Trajectory should be rehydrated.");
 
     // Validate
-    assert(traj->getIntent().purpose == "Argumentar");
-    assert(traj->getStage() == TrajectoryStage::Outline);
-    assert(traj->getSegments().size() == 1);
-    assert(traj->getHistory().size() == 1);
+    IW_CHECK(traj->getIntent().purpose == "Argumentar");
+    IW_CHECK(traj->getStage() == TrajectoryStage::Outline);
+    IW_CHECK(traj->getSegments().size() == 1);
+    IW_CHECK(traj->getHistory().size() == 1);
 
     const auto& seg = traj->getSegments().begin()->second;
-    assert(seg.content == "Texto revisado");
-    assert(seg.source == SourceTag::AiAssisted);
+    IW_CHECK(seg.content == "Texto revisado");
+    IW_CHECK(seg.source == SourceTag::AiAssisted);
 
     const auto& cards = traj->getDefenseCards();
-    assert(cards.size() == 1);
-    assert(cards[0].status == DefenseStatus::Rehearsed);
+    IW_CHECK(cards.size() == 1);
+    IW_CHECK(cards[0].status == DefenseStatus::Rehearsed);
 
     std::filesystem::remove_all(testRoot);
     std::cout << "[PASS] WritingTrajectory Round-Trip Test." << std::endl;
-    return 0;
+    return true;
+
+}
+
+int main() {
+    RUN_TEST(TestRoundTrip);
+    RUN_TEST(TestSnapshotReplayMatchesFullReplay);
+    RUN_TEST(TestDeltaEncodedRevisions);
+    RUN_TEST(TestConcurrentWritersAndSummaryIndex);
+    RUN_TEST(TestLiveTrajectoryCopyOnWrite);
+    RUN_TEST(TestEventLogScanning);
+
+    std::cout << "\n=== Results: " << g_passed << " passed, " << g_failed << " failed ===\n";
+    return (g_failed == 0) ? 0 : 1;
 }
@@ -0,0 +1,127 @@
+/**
+ * @file EpistemicValidatorBench.cpp
+ * @brief Micro-benchmark for the epistemic validator (single bundle and batch).
+ *
+ * Usage: ideawalker_validator_bench [bundles|observationsDir] [iterations] [workers]
+ * With a directory, every *.json bundle in it is validated; otherwise synthetic
+ * bundles mixing clean, normative and incomplete content are generated.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "application/AsyncTaskManager.hpp"
+#include "application/scientific/EpistemicValidator.hpp"
+
+using ideawalker::application::AsyncTaskManager;
+using ideawalker::application::scientific::EpistemicValidator;
+namespace fs = std::filesystem;
+
+namespace {
+
+nlohmann::json MakeBundle(size_t seed) {
+    const bool normative = seed % 3 == 0;
+    const bool incomplete = seed % 7 == 0;
+    nlohmann::json bundle = {
+        {"sourceProfile", {{"temporalScale", seed % 2 ? "long" : "short"}}},
+        {"baselineAssumptions", {{{"baselineType", seed % 4 ? "fixed" : "dynamic"}}}},
+        {"requestedTargets", seed % 11 ? nlohmann::json::array({"STRATA-CAC"}) : nlohmann::json::array({"STRATA-Core", "STRATA-CAC"})},
+        {"narrativeObservations", nlohmann::json::array()},
+        {"allegedMechanisms", nlohmann::json::array()},
+        {"temporalWindowReferences", nlohmann::json::array()},
+        {"interpretationLayers", {{"authorInterpretations", nlohmann::json::array()}}}
+    };
+    for (size_t i = 0; i < 12; ++i) {
+        std::string text = "Observed grazing pressure changes vegetation cover across plots " + std::to_string(i) +
+                           " during the monitoring campaign, with heterogeneous responses among sites.";
+        if (normative && i == 11) text += " Managers should reduce stocking.";
+        bundle["narrativeObservations"].push_back({{"observation", text}, {"contextuality", "Pampa grasslands"}});
+    }
+    for (size_t i = 0; i < 6; ++i) {
+        bundle["allegedMechanisms"].push_back({
+            {"mechanism", "Selective grazing shifts competitive balance among tussock species " + std::to_string(i)},
+            {"status", i % 2 ? "tested" : "suggested"},
+            {"limitations", "Single region, short series."},
+            {"evidenceSnippet", "grazing shifts competitive balance"},
+            {"contextuality", "Pampa grasslands"}
+        });
+    }
+    bundle["temporalWindowReferences"].push_back({
+        {"timeWindow", seed % 5 ? "2001-2018" : "several decades"},
+        {"changeRhythm", "gradual"},
+        {"delaysOrHysteresis", incomplete ? "" : "lagged recovery"}
+    });
+    bundle["interpretationLayers"]["authorInterpretations"].push_back("Results suggest adaptive management matters.");
+    return bundle;
+}
+
+std::vector<nlohmann::json> LoadCorpus(const fs::path& dir) {
+    std::vector<nlohmann::json> bundles;
+    for (const auto& entry : fs::directory_iterator(dir)) {
+        if (!entry.is_regular_file() || entry.path().extension() != ".json") continue;
+        std::ifstream in(entry.path());
+        nlohmann::json bundle = nlohmann::json::parse(in, nullptr, false);
+        if (!bundle.is_discarded()) bundles.push_back(std::move(bundle));
+    }
+    return bundles;
+}
+
+template <typename F>
+double TimeMs(F&& f) {
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<nlohmann::json> bundles;
+    const std::string source = argc > 1 ? argv[1] : "2000";
+    if (fs::is_directory(source)) {
+        bundles = LoadCorpus(source);
+    } else {
+        const size_t count = std::stoul(source);
+        for (size_t i = 0; i < count; ++i) bundles.push_back(MakeBundle(i));
+    }
+    const size_t iterations = argc > 2 ? std::stoul(argv[2]) : 5;
+    const size_t workers = argc > 3 ? std::stoul(argv[3]) : std::max(1u, std::thread::hardware_concurrency());
+    if (bundles.empty() || iterations == 0) {
+        std::cerr << "Uso: " << argv[0] << " [bundles|observationsDir] [iterations] [workers]" << std::endl;
+        return 2;
+    }
+
+    EpistemicValidator validator;
+    AsyncTaskManager taskManager;
+    size_t blocked = 0;
+    double sequentialMs = 0.0;
+    double batchMs = 0.0;
+    for (size_t it = 0; it < iterations; ++it) {
+        sequentialMs += TimeMs([&] {
+            blocked = 0;
+            for (const auto& bundle : bundles) {
+                if (!validator.Validate(bundle).exportAllowed) ++blocked;
+            }
+        });
+        batchMs += TimeMs([&] { validator.ValidateBatch(bundles, &taskManager, workers); });
+    }
+
+    const double perBundleUs = sequentialMs * 1000.0 / static_cast<double>(iterations * bundles.size());
+    std::cout << bundles.size() << " bundles (" << blocked << " bloqueados), " << iterations << " iterações" << std::endl;
+    std::cout << "Sequencial: " << sequentialMs / iterations << " ms/lote, " << perBundleUs << " us/bundle" << std::endl;
+    std::cout << "Lote (" << workers << " workers): " << batchMs / iterations << " ms/lote, speedup "
+              << sequentialMs / std::max(batchMs, 1e-9) << "x" << std::endl;
+
+    while (!taskManager.GetActiveTasks().empty()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return 0;
+}
@@ -0,0 +1,477 @@
+/**
+ * @file IdeaWalkerCli.cpp
+ * @brief Headless batch front-end for the application services (no SDL/ImGui).
+ *
+ * Usage: ideawalker_cli <command> [--root DIR] [--jobs N] [--json] [options]
+ *
+ * Commands: ingest-scientific, process-inbox, index-embeddings, consolidate-tasks,
+ * export, validate (see Usage() below for their options).
+ *
+ * stdout carries only the command's output (with --json: NDJSON status, progress
+ * and result events); the services' own logs go to stderr. Exit codes: 0 success,
+ * 1 finished with errors (failed articles, failed tasks, blocked bundles), 2 usage
+ * error, 3 project root not usable.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "app/HeadlessSupport.hpp"
+#include "app/ServiceComposition.hpp"
+#include "application/AppServices.hpp"
+#include "application/GraphService.hpp"
+#include "application/KnowledgeExportService.hpp"
+#include "application/scientific/EpistemicValidator.hpp"
+#include "infrastructure/PersistenceService.hpp"
+
+using namespace ideawalker;
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr int kExitOk = 0;
+constexpr int kExitErrors = 1;
+constexpr int kExitUsage = 2;
+constexpr int kExitSetup = 3;
+
+struct Options {
+    std::string command;
+    fs::path root = fs::current_path();
+    size_t jobs = 0;        ///< 0 = command default.
+    size_t llmCalls = 0;    ///< ingest-scientific only; 0 = derived from --jobs or settings.json.
+    size_t articles = 0;    ///< ingest-scientific only; 0 = llmCalls + 1.
+    bool force = false;
+    bool fast = false;
+    bool json = false;
+    bool tasks = false;
+    std::string format = "markdown";
+    std::string output = "-";
+    int progressMs = 500;
+};
+
+void Usage(std::ostream& out, const char* argv0) {
+    out << "Uso: " << argv0 << " <comando> [--root DIR] [--jobs N] [--json] [--progress-ms MS]\n"
+        << "\n"
+        << "Comandos:\n"
+        << "  ingest-scientific  Ingere a inbox científica e exporta os consumíveis STRATA\n"
+        << "                     [--llm-calls N] [--articles N] (padrão: settings.json)\n"
+        << "  process-inbox      Processa as notas da inbox com a IA [--force] [--fast]\n"
+        << "  index-embeddings   Calcula os embeddings das notas que mudaram\n"
+        << "  consolidate-tasks  Regera _Consolidated_Tasks.md\n"
+        << "  export             Exporta a base [--format markdown|mermaid] [--tasks] [--output ARQ]\n"
+        << "  validate           Revalida os bundles científicos (somente leitura)\n"
+        << "\n"
+        << "--jobs N: trabalhos em paralelo (padrão: 1 nos comandos limitados pelo LLM,\n"
+        << "todos os núcleos em validate; em ingest-scientific equivale a --llm-calls).\n"
+        << "Saída: 0 ok, 1 concluído com erros, 2 uso inválido, 3 projeto inacessível.\n";
+}
+
+bool ParseArgs(int argc, char** argv, Options& options, std::string& error) {
+    if (argc < 2) {
+        error = "comando ausente";
+        return false;
+    }
+    options.command = argv[1];
+    for (int i = 2; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto value = [&](std::string& out) {
+            if (i + 1 >= argc) {
+                error = arg + " exige um valor";
+                return false;
+            }
+            out = argv[++i];
+            return true;
+        };
+        auto count = [&](size_t& out) {
+            std::string text;
+            if (!value(text)) return false;
+            if (!app::ParseCount(text, out)) {
+                error = arg + " espera um inteiro: " + text;
+                return false;
+            }
+            return true;
+        };
+
+        std::string text;
+        size_t number = 0;
+        if (arg == "--root") {
+            if (!value(text)) return false;
+            options.root = text;
+        } else if (arg == "--jobs") {
+            if (!count(options.jobs)) return false;
+        } else if (arg == "--llm-calls") {
+            if (!count(options.llmCalls)) return false;
+        } else if (arg == "--articles") {
+            if (!count(options.articles)) return false;
+        } else if (arg == "--progress-ms") {
+            if (!count(number)) return false;
+            options.progressMs = static_cast<int>(std::max<size_t>(50, number));
+        } else if (arg == "--format") {
+            if (!value(options.format)) return false;
+        } else if (arg == "--output") {
+            if (!value(options.output)) return false;
+        } else if (arg == "--force") {
+            options.force = true;
+        } else if (arg == "--fast") {
+            options.fast = true;
+        } else if (arg == "--tasks") {
+            options.tasks = true;
+        } else if (arg == "--json") {
+            options.json = true;
+        } else {
+            error = "opção desconhecida: " + arg;
+            return false;
+        }
+    }
+
+    static const std::vector<std::string> commands = {
+        "ingest-scientific", "process-inbox", "index-embeddings", "consolidate-tasks", "export", "validate"
+    };
+    if (std::find(commands.begin(), commands.end(), options.command) == commands.end()) {
+        error = "comando desconhecido: " + options.command;
+        return false;
+    }
+    if (options.format != "markdown" && options.format != "mermaid") {
+        error = "formato desconhecido: " + options.format;
+        return false;
+    }
+    if (options.json && options.command == "export" && options.output == "-") {
+        error = "export com --json exige --output (stdout é reservado aos eventos)";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @class Reporter
+ * @brief Serializes status/progress/result output, as NDJSON on stdout or as text.
+ */
+class Reporter {
+public:
+    Reporter(std::ostream& out, const Options& options) : m_out(out), m_options(options) {}
+
+    void status(const std::string& message) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_options.json) {
+            emitLocked({{"event", "status"}, {"command", m_options.command}, {"message", message}});
+        } else {
+            std::cerr << message << std::endl;
+        }
+    }
+
+    void progress(const nlohmann::json& tasks) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_options.json) {
+            emitLocked({{"event", "progress"}, {"command", m_options.command}, {"tasks", tasks}});
+            return;
+        }
+        for (const auto& task : tasks) {
+            std::cerr << "[" << static_cast<int>(task["progress"].get<double>() * 100.0) << "%] "
+                      << task["description"].get<std::string>() << std::endl;
+        }
+    }
+
+    void result(const nlohmann::json& summary, const std::vector<std::string>& errors, int exitCode, double elapsedMs) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_options.json) {
+            emitLocked({{"event", "result"}, {"command", m_options.command}, {"ok", exitCode == kExitOk},
+                        {"exitCode", exitCode}, {"elapsedMs", elapsedMs}, {"summary", summary}, {"errors", errors}});
+            return;
+        }
+        for (auto it = summary.begin(); it != summary.end(); ++it) {
+            m_out << it.key() << ": " << (it->is_string() ? it->get<std::string>() : it->dump()) << "\n";
+        }
+        for (const auto& error : errors) {
+            std::cerr << "[Erro] " << error << "\n";
+        }
+        m_out << m_options.command << (exitCode == kExitOk ? " concluído" : " concluído com erros") << " em "
+              << static_cast<long long>(elapsedMs) << " ms" << std::endl;
+    }
+
+private:
+    void emitLocked(const nlohmann::json& event) {
+        m_out << event.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace) << std::endl;
+    }
+
+    std::ostream& m_out;
+    const Options& m_options;
+    std::mutex m_mutex;
+};
+
+/**
+ * @class TaskWatcher
+ * @brief Polls the AsyncTaskManager for progress and remembers every task it saw fail.
+ *
+ * Fire-and-forget service calls (process-inbox, consolidate-tasks) only end when the
+ * task list drains, so the watcher is also what the command waits on.
+ */
+class TaskWatcher {
+public:
+    TaskWatcher(application::AsyncTaskManager& taskManager, Reporter& reporter, int intervalMs)
+        : m_taskManager(taskManager), m_reporter(reporter), m_interval(intervalMs) {
+        m_thread = std::thread([this] { run(); });
+    }
+
+    ~TaskWatcher() { stop(); }
+
+    /** @brief Remembers a task the caller started, so its failure counts even if no poll saw it. */
+    void track(const std::shared_ptr<application::TaskStatus>& status) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (status) m_seen[status->id] = status;
+    }
+
+    /** @brief Blocks until no background task is left. */
+    void drain() {
+        app::WaitForBackgroundTasks(m_taskManager, [this] { poll(); });
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_stopped) return;
+            m_stopped = true;
+        }
+        m_cv.notify_all();
+        if (m_thread.joinable()) m_thread.join();
+    }
+
+    std::vector<std::string> failures() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::vector<std::string> errors;
+        for (const auto& [id, status] : m_seen) {
+            if (status->failed) errors.push_back(status->description + ": " + status->errorMessage);
+        }
+        return errors;
+    }
+
+private:
+    void run() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (!m_stopped) {
+            lock.unlock();
+            poll();
+            lock.lock();
+            m_cv.wait_for(lock, m_interval, [this] { return m_stopped; });
+        }
+    }
+
+    void poll() {
+        nlohmann::json tasks = nlohmann::json::array();
+        for (const auto& status : m_taskManager.GetActiveTasks()) {
+            tasks.push_back({{"id", status->id}, {"type", app::TaskTypeName(status->type)},
+                             {"description", status->description}, {"progress", status->progress.load()}});
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_seen.emplace(status->id, status);
+        }
+        std::string snapshot = tasks.dump();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (tasks.empty() || snapshot == m_lastSnapshot) return;
+            m_lastSnapshot = std::move(snapshot);
+        }
+        m_reporter.progress(tasks);
+    }
+
+    application::AsyncTaskManager& m_taskManager;
+    Reporter& m_reporter;
+    std::chrono::milliseconds m_interval;
+    std::map<int, std::shared_ptr<application::TaskStatus>> m_seen;
+    std::string m_lastSnapshot;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_stopped = false;
+    std::thread m_thread;
+};
+
+struct Outcome {
+    nlohmann::json summary = nlohmann::json::object();
+    std::vector<std::string> errors;
+};
+
+Outcome IngestScientific(application::AppServices& services, Reporter& reporter) {
+    Outcome outcome;
+    auto result = services.scientificIngestionService->ingestPending([&](std::string message) {
+        reporter.status(message);
+    });
+    outcome.summary = {{"artifactsDetected", result.artifactsDetected},
+                       {"bundlesGenerated", result.bundlesGenerated},
+                       {"artifactsSkipped", result.artifactsSkipped}};
+    outcome.errors = std::move(result.errors);
+    return outcome;
+}
+
+Outcome ProcessInbox(application::AppServices& services, TaskWatcher& watcher, const Options& options) {
+    Outcome outcome;
+    outcome.summary["inboxItems"] = services.knowledgeService->GetRawThoughts().size();
+    watcher.track(services.aiProcessingService->ProcessInboxAsync(options.force, options.fast,
+                                                                  std::max<size_t>(1, options.jobs)));
+    watcher.drain(); // Includes the consolidation the batch chains at the end.
+    return outcome;
+}
+
+Outcome IndexEmbeddings(application::AppServices& services, const Options& options) {
+    Outcome outcome;
+    const auto notes = services.knowledgeService->GetAllInsights();
+    const size_t indexed = services.suggestionService->indexProject(notes, services.taskManager.get(),
+                                                                    std::max<size_t>(1, options.jobs));
+    outcome.summary = {{"notes", notes.size()}, {"indexed", indexed}};
+    return outcome;
+}
+
+Outcome ConsolidateTasks(application::AppServices& services, TaskWatcher& watcher) {
+    Outcome outcome;
+    watcher.track(services.aiProcessingService->ConsolidateTasksAsync());
+    watcher.drain();
+    return outcome;
+}
+
+Outcome Export(application::AppServices& services, std::ostream& out, const Options& options) {
+    Outcome outcome;
+    const auto insights = services.knowledgeService->GetAllInsights();
+    // A private graph without a task manager: the export needs the structure, not a running layout.
+    application::GraphService graph;
+    std::vector<domain::writing::GraphNode> nodes;
+    std::vector<domain::writing::GraphLink> links;
+    graph.SyncGraph(insights, options.tasks, nodes, links);
+
+    const std::string document = options.format == "mermaid"
+        ? application::KnowledgeExportService::ToMermaidMindmap(nodes, links)
+        : application::KnowledgeExportService::ToFullMarkdown(insights, nodes, links);
+    outcome.summary = {{"notes", insights.size()}, {"nodes", nodes.size()}, {"links", links.size()},
+                       {"bytes", document.size()}};
+
+    if (options.output == "-") {
+        out << document;
+        out.flush();
+        return outcome;
+    }
+    const fs::path target = fs::absolute(options.output);
+    std::string error;
+    if (!infrastructure::PersistenceService::WriteGroup({{target.string(), document}},
+                                                       infrastructure::FsyncPolicy::Rename, 1, error)) {
+        outcome.errors.push_back("Falha ao gravar exportação: " + error);
+    }
+    outcome.summary["output"] = target.string();
+    return outcome;
+}
+
+Outcome Validate(const fs::path& root, application::AppServices& services, const Options& options) {
+    Outcome outcome;
+    std::vector<std::string> ids;
+    std::vector<nlohmann::json> bundles;
+    const fs::path observations = root / "observations" / "scientific";
+    if (fs::exists(observations)) {
+        for (const auto& entry : fs::directory_iterator(observations)) {
+            if (!entry.is_regular_file() || entry.path().extension() != ".json") continue;
+            std::ifstream in(entry.path());
+            auto bundle = nlohmann::json::parse(in, nullptr, false);
+            if (bundle.is_discarded()) {
+                outcome.errors.push_back("Bundle ilegível: " + entry.path().filename().string());
+                continue;
+            }
+            ids.push_back(entry.path().stem().string());
+            bundles.push_back(std::move(bundle));
+        }
+    }
+
+    application::scientific::EpistemicValidator validator;
+    const auto results = validator.ValidateBatch(bundles, services.taskManager.get(), options.jobs);
+    nlohmann::json blocked = nlohmann::json::array();
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (results[i].exportAllowed) continue;
+        blocked.push_back(ids[i]);
+        outcome.errors.push_back("Exportação bloqueada pelo Validador Epistemológico: " + ids[i]);
+    }
+    outcome.summary = {{"bundles", bundles.size()}, {"exportAllowed", bundles.size() - blocked.size()},
+                       {"blocked", blocked}};
+    return outcome;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    std::string usageError;
+    if (!ParseArgs(argc, argv, options, usageError)) {
+        std::cerr << "[IdeaWalkerCli] " << usageError << "\n\n";
+        Usage(std::cerr, argv[0]);
+        return kExitUsage;
+    }
+
+    // stdout carries only the command's output (events, summary or exported document);
+    // anything the services print goes to stderr.
+    std::ostream out(std::cout.rdbuf());
+    std::cout.rdbuf(std::cerr.rdbuf());
+    Reporter reporter(out, options);
+
+    std::error_code ec;
+    const fs::path root = fs::absolute(options.root, ec);
+    if (ec || !fs::is_directory(root)) {
+        reporter.result({{"root", options.root.string()}}, {"Raiz de projeto inexistente: " + options.root.string()},
+                        kExitSetup, 0.0);
+        return kExitSetup;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    application::AppServices services;
+    try {
+        app::ServiceOptions serviceOptions;
+        if (options.command == "ingest-scientific" && (options.llmCalls > 0 || options.jobs > 0)) {
+            application::scientific::IngestionConcurrency concurrency;
+            concurrency.llmCalls = options.llmCalls > 0 ? options.llmCalls : options.jobs;
+            concurrency.articlesInFlight = options.articles > 0 ? options.articles : concurrency.llmCalls + 1;
+            serviceOptions.ingestionConcurrency = concurrency;
+        }
+        services = app::BuildServicesForRoot(root, std::move(serviceOptions));
+    } catch (const std::exception& e) {
+        reporter.result({{"root", root.string()}}, {std::string("Falha ao abrir o projeto: ") + e.what()}, kExitSetup,
+                        0.0);
+        return kExitSetup;
+    }
+
+    Outcome outcome;
+    {
+        TaskWatcher watcher(*services.taskManager, reporter, options.progressMs);
+        try {
+            if (options.command == "ingest-scientific") {
+                outcome = IngestScientific(services, reporter);
+            } else if (options.command == "process-inbox") {
+                outcome = ProcessInbox(services, watcher, options);
+            } else if (options.command == "index-embeddings") {
+                outcome = IndexEmbeddings(services, options);
+            } else if (options.command == "consolidate-tasks") {
+                outcome = ConsolidateTasks(services, watcher);
+            } else if (options.command == "export") {
+                outcome = Export(services, out, options);
+            } else {
+                outcome = Validate(root, services, options);
+            }
+        } catch (const std::exception& e) {
+            outcome.errors.push_back(std::string("Falha inesperada: ") + e.what());
+        }
+        // Detached tasks hold pointers into the services: nothing is torn down while one still runs.
+        watcher.drain();
+        watcher.stop();
+        for (auto& failure : watcher.failures()) outcome.errors.push_back(std::move(failure));
+    }
+    if (services.persistenceService) services.persistenceService->flush();
+
+    const double elapsedMs =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    const int exitCode = outcome.errors.empty() ? kExitOk : kExitErrors;
+    reporter.result(outcome.summary, outcome.errors, exitCode, elapsedMs);
+    return exitCode;
+}
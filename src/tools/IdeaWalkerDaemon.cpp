@@ -0,0 +1,607 @@
+/**
+ * @file IdeaWalkerDaemon.cpp
+ * @brief Local HTTP/JSON daemon serving the application services of one project.
+ *
+ * Usage: ideawalker_daemon [--root DIR] [--port N] [--workers N] [--ai-requests N]
+ *
+ * One warm process keeps the note repository, the embedding cache and the model
+ * connection loaded for every editor integration on the machine. It only listens on
+ * 127.0.0.1. Connections are kept alive, so a client may pipeline requests on one
+ * socket; they are answered in order by a fixed pool of workers. Calls that reach the
+ * LLM (chat, suggestions, indexing) share a small number of slots and get 503 +
+ * Retry-After when all are taken instead of queueing behind each other.
+ *
+ * stdout carries a single NDJSON "listening" event once the port is bound; logs go to
+ * stderr. Exit codes: 0 clean shutdown (SIGINT/SIGTERM), 2 usage error, 3 project root
+ * not usable or port unavailable.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <httplib.h>
+#include <nlohmann/json.hpp>
+
+#include "app/HeadlessSupport.hpp"
+#include "app/ServiceComposition.hpp"
+#include "application/AppServices.hpp"
+
+using namespace ideawalker;
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr int kExitOk = 0;
+constexpr int kExitUsage = 2;
+constexpr int kExitSetup = 3;
+
+constexpr const char* kHost = "127.0.0.1";
+constexpr const char* kJsonType = "application/json";
+constexpr const char* kNdjsonType = "application/x-ndjson";
+constexpr size_t kMaxPayloadBytes = 4 * 1024 * 1024; // Notes are sent whole for suggestions.
+
+volatile std::sig_atomic_t g_stopRequested = 0;
+
+void RequestStop(int) { g_stopRequested = 1; }
+
+struct Options {
+    fs::path root = fs::current_path();
+    size_t port = 7807;
+    size_t workers = 8;             ///< Pooled connection workers (an idle keep-alive socket holds one).
+    size_t aiRequests = 2;          ///< Concurrent LLM/embedding calls; the excess gets 503.
+    size_t keepAliveRequests = 100; ///< Requests served on one connection before it is closed.
+    size_t keepAliveSeconds = 5;    ///< Idle time before a kept-alive connection releases its worker.
+    int heartbeatMs = 500;          ///< Interval of "thinking" events while a chat reply is pending.
+};
+
+void Usage(std::ostream& out, const char* argv0) {
+    out << "Uso: " << argv0 << " [--root DIR] [--port N] [--workers N] [--ai-requests N]\n"
+        << "       [--keep-alive-requests N] [--keep-alive-seconds N] [--heartbeat-ms MS]\n"
+        << "\n"
+        << "Serve a API HTTP/JSON do projeto em http://127.0.0.1:PORT (padrão 7807; 0 = porta livre).\n"
+        << "--workers N: conexões atendidas ao mesmo tempo (padrão 8; conexões keep-alive ociosas\n"
+        << "ocupam um worker até --keep-alive-seconds).\n"
+        << "--ai-requests N: chamadas simultâneas à IA (chat, sugestões, indexação; padrão 2), o excedente\n"
+        << "recebe 503 com Retry-After.\n"
+        << "Saída: 0 encerrado por sinal, 2 uso inválido, 3 projeto ou porta indisponível.\n";
+}
+
+bool ParseArgs(int argc, char** argv, Options& options, std::string& error) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto count = [&](size_t& out, size_t minimum) {
+            if (i + 1 >= argc) {
+                error = arg + " exige um valor";
+                return false;
+            }
+            const std::string text = argv[++i];
+            if (!app::ParseCount(text, out) || out < minimum) {
+                error = arg + " espera um inteiro >= " + std::to_string(minimum) + ": " + text;
+                return false;
+            }
+            return true;
+        };
+
+        size_t number = 0;
+        if (arg == "--root") {
+            if (i + 1 >= argc) {
+                error = arg + " exige um valor";
+                return false;
+            }
+            options.root = argv[++i];
+        } else if (arg == "--port") {
+            if (!count(options.port, 0)) return false;
+            if (options.port > 65535) {
+                error = "porta inválida: " + std::to_string(options.port);
+                return false;
+            }
+        } else if (arg == "--workers") {
+            if (!count(options.workers, 1)) return false;
+        } else if (arg == "--ai-requests") {
+            if (!count(options.aiRequests, 1)) return false;
+        } else if (arg == "--keep-alive-requests") {
+            if (!count(options.keepAliveRequests, 1)) return false;
+        } else if (arg == "--keep-alive-seconds") {
+            if (!count(options.keepAliveSeconds, 1)) return false;
+        } else if (arg == "--heartbeat-ms") {
+            if (!count(number, 50)) return false;
+            options.heartbeatMs = static_cast<int>(number);
+        } else if (arg == "--help" || arg == "-h") {
+            error.clear();
+            return false;
+        } else {
+            error = "opção desconhecida: " + arg;
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string DumpJson(const nlohmann::json& value) {
+    return value.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+}
+
+void SendJson(httplib::Response& res, int status, const nlohmann::json& body) {
+    res.status = status;
+    res.set_content(DumpJson(body), kJsonType);
+}
+
+void SendError(httplib::Response& res, int status, const std::string& message) {
+    SendJson(res, status, {{"error", message}});
+}
+
+/** @brief Parses the request body as a JSON object; answers 400 itself on failure. */
+bool ParseBody(const httplib::Request& req, httplib::Response& res, nlohmann::json& body) {
+    body = req.body.empty() ? nlohmann::json::object() : nlohmann::json::parse(req.body, nullptr, false);
+    if (body.is_discarded() || !body.is_object()) {
+        SendError(res, 400, "corpo da requisição deve ser um objeto JSON");
+        return false;
+    }
+    return true;
+}
+
+/** @brief Note ids are plain file names inside the notes directory. */
+bool IsValidNoteId(const std::string& id) {
+    return !id.empty() && id != "." && id != ".." && id.find_first_of("/\\") == std::string::npos;
+}
+
+/**
+ * @class AiGate
+ * @brief Non-blocking counter of LLM calls in flight; a full gate is reported, never waited on.
+ */
+class AiGate {
+public:
+    explicit AiGate(size_t capacity) : m_capacity(capacity) {}
+
+    bool tryAcquire() {
+        size_t current = m_inFlight.load();
+        while (current < m_capacity) {
+            if (m_inFlight.compare_exchange_weak(current, current + 1)) return true;
+        }
+        return false;
+    }
+
+    void release() { m_inFlight.fetch_sub(1); }
+    size_t inFlight() const { return m_inFlight.load(); }
+    size_t capacity() const { return m_capacity; }
+
+private:
+    const size_t m_capacity;
+    std::atomic<size_t> m_inFlight{0};
+};
+
+/** @brief Holds one AiGate slot for as long as the call (or the stream carrying it) lives. */
+class AiSlot {
+public:
+    explicit AiSlot(AiGate& gate) : m_gate(gate) {}
+    ~AiSlot() { m_gate.release(); }
+    AiSlot(const AiSlot&) = delete;
+    AiSlot& operator=(const AiSlot&) = delete;
+
+private:
+    AiGate& m_gate;
+};
+
+/**
+ * @class Daemon
+ * @brief Maps the HTTP routes onto the application services.
+ *
+ * The services were written for the desktop's single UI thread, so each one is only
+ * entered under its own lock; the locks are per service so that a slow embedding
+ * request does not hold up note reads.
+ */
+class Daemon {
+public:
+    Daemon(application::AppServices& services, fs::path root, const Options& options)
+        : m_services(services),
+          m_root(std::move(root)),
+          m_options(options),
+          m_aiGate(options.aiRequests),
+          m_started(std::chrono::steady_clock::now()) {}
+
+    void registerRoutes(httplib::Server& server) {
+        server.Get("/v1/health", guarded(&Daemon::health));
+        server.Get("/v1/tasks", guarded(&Daemon::tasks));
+        server.Get("/v1/notes", guarded(&Daemon::listNotes));
+        server.Get(R"(/v1/notes/([^/]+))", guarded(&Daemon::getNote));
+        server.Post("/v1/suggestions", guarded(&Daemon::suggestions));
+        server.Post("/v1/embeddings/index", guarded(&Daemon::indexEmbeddings));
+        server.Get("/v1/scientific", guarded(&Daemon::scientificStatus));
+        server.Post("/v1/scientific/ingest", guarded(&Daemon::ingestScientific));
+        server.Get("/v1/conversation", guarded(&Daemon::conversation));
+        server.Post("/v1/conversation", guarded(&Daemon::startConversation));
+        server.Post("/v1/conversation/messages", guarded(&Daemon::sendMessage));
+    }
+
+private:
+    using Handler = void (Daemon::*)(const httplib::Request&, httplib::Response&);
+
+    /** @brief Turns a service exception into a JSON 500 instead of httplib's bare one. */
+    httplib::Server::Handler guarded(Handler handler) {
+        return [this, handler](const httplib::Request& req, httplib::Response& res) {
+            try {
+                (this->*handler)(req, res);
+            } catch (const std::exception& e) {
+                std::cerr << "[IdeaWalkerDaemon] " << req.method << " " << req.path << ": " << e.what() << std::endl;
+                SendError(res, 500, std::string("falha interna: ") + e.what());
+            }
+        };
+    }
+
+    /** @brief Takes an AI slot, or answers 503 and returns null when all are busy. */
+    std::shared_ptr<AiSlot> acquireAi(httplib::Response& res) {
+        if (!m_aiGate.tryAcquire()) {
+            res.set_header("Retry-After", "1");
+            SendError(res, 503, "todas as " + std::to_string(m_aiGate.capacity()) + " chamadas à IA estão ocupadas");
+            return nullptr;
+        }
+        return std::make_shared<AiSlot>(m_aiGate);
+    }
+
+    void health(const httplib::Request&, httplib::Response& res) {
+        const auto uptime = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - m_started).count();
+        SendJson(res, 200, {{"ok", true},
+                            {"root", m_root.string()},
+                            {"uptimeMs", uptime},
+                            {"workers", m_options.workers},
+                            {"aiRequests", {{"inFlight", m_aiGate.inFlight()}, {"capacity", m_aiGate.capacity()}}},
+                            {"activeTasks", m_services.taskManager->GetActiveTasks().size()}});
+    }
+
+    void tasks(const httplib::Request&, httplib::Response& res) {
+        nlohmann::json list = nlohmann::json::array();
+        for (const auto& status : m_services.taskManager->GetActiveTasks()) {
+            list.push_back({{"id", status->id}, {"type", app::TaskTypeName(status->type)},
+                            {"description", status->description}, {"progress", status->progress.load()}});
+        }
+        SendJson(res, 200, {{"tasks", list}});
+    }
+
+    void listNotes(const httplib::Request&, httplib::Response& res) {
+        std::vector<domain::Insight> insights;
+        {
+            std::lock_guard<std::mutex> lock(m_knowledgeMutex);
+            insights = m_services.knowledgeService->GetAllInsights();
+        }
+        nlohmann::json notes = nlohmann::json::array();
+        for (const auto& insight : insights) {
+            const auto& metadata = insight.getMetadata();
+            notes.push_back({{"id", metadata.id}, {"title", metadata.title}, {"bytes", insight.getContent().size()}});
+        }
+        SendJson(res, 200, {{"notes", notes}});
+    }
+
+    void getNote(const httplib::Request& req, httplib::Response& res) {
+        const std::string id = req.matches[1];
+        if (!IsValidNoteId(id)) {
+            SendError(res, 400, "id de nota inválido: " + id);
+            return;
+        }
+        std::optional<domain::Insight> insight;
+        std::vector<std::string> backlinks;
+        {
+            std::lock_guard<std::mutex> lock(m_knowledgeMutex);
+            insight = m_services.knowledgeService->GetInsight(id);
+            if (insight) backlinks = m_services.knowledgeService->GetBacklinks(id);
+        }
+        if (!insight) {
+            SendError(res, 404, "nota inexistente: " + id);
+            return;
+        }
+        SendJson(res, 200, {{"id", insight->getMetadata().id},
+                            {"title", insight->getMetadata().title},
+                            {"content", insight->getContent()},
+                            {"backlinks", backlinks}});
+    }
+
+    /** Body: {"noteId": "...", "content": "..."}; content defaults to the stored note. */
+    void suggestions(const httplib::Request& req, httplib::Response& res) {
+        nlohmann::json body;
+        if (!ParseBody(req, res, body)) return;
+        const std::string noteId = body.value("noteId", "");
+        if (!IsValidNoteId(noteId)) {
+            SendError(res, 400, "noteId ausente ou inválido");
+            return;
+        }
+        std::string content = body.value("content", "");
+        if (content.empty()) {
+            std::lock_guard<std::mutex> lock(m_knowledgeMutex);
+            content = m_services.knowledgeService->GetNoteContent(noteId);
+        }
+
+        auto slot = acquireAi(res);
+        if (!slot) return;
+        std::vector<domain::Suggestion> found;
+        {
+            std::lock_guard<std::mutex> lock(m_suggestionMutex);
+            found = m_services.suggestionService->generateSemanticSuggestions(noteId, content);
+        }
+        nlohmann::json list = nlohmann::json::array();
+        for (const auto& suggestion : found) {
+            nlohmann::json reasons = nlohmann::json::array();
+            for (const auto& reason : suggestion.reasons) {
+                reasons.push_back({{"kind", reason.kind}, {"evidence", reason.evidence}});
+            }
+            list.push_back({{"targetId", suggestion.targetId}, {"score", suggestion.score}, {"reasons", reasons}});
+        }
+        SendJson(res, 200, {{"noteId", noteId}, {"suggestions", list}});
+    }
+
+    /** Body: {"workers": N}; fetches the embeddings of notes that changed since the last run. */
+    void indexEmbeddings(const httplib::Request& req, httplib::Response& res) {
+        nlohmann::json body;
+        if (!ParseBody(req, res, body)) return;
+        const size_t workers = std::clamp<size_t>(body.value("workers", size_t{1}), 1, m_aiGate.capacity());
+
+        auto slot = acquireAi(res);
+        if (!slot) return;
+        std::vector<domain::Insight> notes;
+        {
+            std::lock_guard<std::mutex> lock(m_knowledgeMutex);
+            notes = m_services.knowledgeService->GetAllInsights();
+        }
+        size_t indexed = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_suggestionMutex);
+            indexed = m_services.suggestionService->indexProject(notes, m_services.taskManager.get(), workers);
+        }
+        SendJson(res, 200, {{"notes", notes.size()}, {"indexed", indexed}});
+    }
+
+    void scientificStatus(const httplib::Request&, httplib::Response& res) {
+        auto& science = *m_services.scientificIngestionService;
+        nlohmann::json status = {{"bundles", science.getBundlesCount()},
+                                 {"exported", science.getExportedCount()},
+                                 {"ingesting", m_ingesting.load()}};
+        if (const auto summary = science.getLatestValidationSummary()) {
+            status["latestValidation"] = {{"path", summary->path},
+                                          {"status", summary->status},
+                                          {"exportAllowed", summary->exportAllowed},
+                                          {"errors", summary->errorCount},
+                                          {"warnings", summary->warningCount}};
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_ingestionMutex);
+            if (!m_lastIngestion.is_null()) status["lastIngestion"] = m_lastIngestion;
+        }
+        SendJson(res, 200, status);
+    }
+
+    /** Starts one background ingestion of the scientific inbox; progress is read from /v1/tasks. */
+    void ingestScientific(const httplib::Request&, httplib::Response& res) {
+        bool expected = false;
+        if (!m_ingesting.compare_exchange_strong(expected, true)) {
+            SendError(res, 409, "ingestão científica já em andamento");
+            return;
+        }
+        auto task = m_services.taskManager->SubmitTask(
+            application::TaskType::AI_Processing, "Daemon: ingestão científica",
+            [this](std::shared_ptr<application::TaskStatus>) {
+                nlohmann::json summary;
+                try {
+                    const auto result = m_services.scientificIngestionService->ingestPending();
+                    summary = {{"artifactsDetected", result.artifactsDetected},
+                               {"bundlesGenerated", result.bundlesGenerated},
+                               {"artifactsSkipped", result.artifactsSkipped},
+                               {"errors", result.errors}};
+                } catch (const std::exception& e) {
+                    summary = {{"errors", {std::string("Falha inesperada: ") + e.what()}}};
+                }
+                {
+                    std::lock_guard<std::mutex> lock(m_ingestionMutex);
+                    m_lastIngestion = std::move(summary);
+                }
+                m_ingesting = false;
+            });
+        SendJson(res, 202, {{"taskId", task->id}});
+    }
+
+    void conversation(const httplib::Request&, httplib::Response& res) {
+        auto& service = *m_services.conversationService;
+        nlohmann::json messages = nlohmann::json::array();
+        for (const auto& message : service.getHistory()) {
+            if (message.role == domain::AIService::ChatMessage::Role::System) continue;
+            messages.push_back({{"role", domain::AIService::ChatMessage::RoleToString(message.role)},
+                                {"content", message.content}});
+        }
+        std::lock_guard<std::mutex> lock(m_conversationMutex);
+        SendJson(res, 200, {{"active", service.isSessionActive()},
+                            {"noteId", service.getCurrentNoteId()},
+                            {"thinking", service.isThinking()},
+                            {"messages", messages}});
+    }
+
+    /** Body: {"noteId": "..."}; (re)starts the shared session with the note's assembled context. */
+    void startConversation(const httplib::Request& req, httplib::Response& res) {
+        nlohmann::json body;
+        if (!ParseBody(req, res, body)) return;
+        const std::string noteId = body.value("noteId", "");
+        if (!IsValidNoteId(noteId)) {
+            SendError(res, 400, "noteId ausente ou inválido");
+            return;
+        }
+        application::ContextBundle bundle;
+        {
+            std::lock_guard<std::mutex> lock(m_knowledgeMutex);
+            bundle = m_services.contextAssembler->assemble(noteId, m_services.knowledgeService->GetNoteContent(noteId));
+        }
+        std::lock_guard<std::mutex> lock(m_conversationMutex);
+        if (m_services.conversationService->isThinking()) {
+            SendError(res, 409, "a IA ainda está respondendo na sessão atual");
+            return;
+        }
+        m_services.conversationService->startSession(bundle);
+        SendJson(res, 201, {{"noteId", noteId}, {"backlinks", bundle.backlinks.size()},
+                            {"observations", bundle.observations.size()}});
+    }
+
+    /**
+     * Body: {"message": "..."}. Answers with an NDJSON stream: "accepted", a "thinking"
+     * event every heartbeat while the model works, then "message" (or "error").
+     * The reply is appended to the session log whether or not the client stays connected.
+     */
+    void sendMessage(const httplib::Request& req, httplib::Response& res) {
+        nlohmann::json body;
+        if (!ParseBody(req, res, body)) return;
+        const std::string message = body.value("message", "");
+        if (message.empty()) {
+            SendError(res, 400, "message ausente");
+            return;
+        }
+
+        auto& service = *m_services.conversationService;
+        size_t replyIndex = 0;
+        std::string noteId;
+        std::shared_ptr<AiSlot> slot;
+        {
+            std::lock_guard<std::mutex> lock(m_conversationMutex);
+            if (!service.isSessionActive()) {
+                SendError(res, 409, "nenhuma sessão ativa (POST /v1/conversation)");
+                return;
+            }
+            if (service.isThinking()) {
+                SendError(res, 409, "a IA ainda está respondendo na sessão atual");
+                return;
+            }
+            slot = acquireAi(res);
+            if (!slot) return;
+            replyIndex = service.getHistory().size() + 1; // After the user message about to be added.
+            noteId = service.getCurrentNoteId(); // The stream must not read it while a new session starts.
+            service.sendMessage(message);
+        }
+
+        const auto started = std::chrono::steady_clock::now();
+        const auto heartbeat = std::chrono::milliseconds(m_options.heartbeatMs);
+        auto accepted = std::make_shared<bool>(false);
+        res.set_chunked_content_provider(
+            kNdjsonType,
+            [&service, slot, accepted, replyIndex, noteId, started, heartbeat](size_t, httplib::DataSink& sink) {
+                auto emit = [&sink](const nlohmann::json& event) {
+                    const std::string line = DumpJson(event) + "\n";
+                    return sink.write(line.data(), line.size());
+                };
+                if (!*accepted) {
+                    *accepted = true;
+                    return emit({{"event", "accepted"}, {"noteId", noteId}});
+                }
+                if (service.isThinking()) {
+                    std::this_thread::sleep_for(heartbeat);
+                    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::steady_clock::now() - started).count();
+                    // A failed write means the client left: stop streaming, the session keeps the reply.
+                    return emit({{"event", "thinking"}, {"elapsedMs", elapsed}});
+                }
+                const auto history = service.getHistory();
+                const bool replied = history.size() > replyIndex &&
+                                     history[replyIndex].role == domain::AIService::ChatMessage::Role::Assistant;
+                const bool ok = replied ? emit({{"event", "message"}, {"role", "assistant"},
+                                                {"content", history[replyIndex].content}})
+                                        : emit({{"event", "error"}, {"error", "sessão reiniciada antes da resposta"}});
+                sink.done();
+                return ok;
+            });
+    }
+
+    application::AppServices& m_services;
+    const fs::path m_root;
+    const Options& m_options;
+    AiGate m_aiGate;
+    const std::chrono::steady_clock::time_point m_started;
+
+    std::mutex m_knowledgeMutex;    ///< KnowledgeService and ContextAssembler.
+    std::mutex m_suggestionMutex;   ///< SuggestionService (embedding cache).
+    std::mutex m_conversationMutex; ///< Check-then-act on the shared conversation session.
+    std::mutex m_ingestionMutex;    ///< m_lastIngestion.
+    std::atomic<bool> m_ingesting{false};
+    nlohmann::json m_lastIngestion;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    std::string usageError;
+    if (!ParseArgs(argc, argv, options, usageError)) {
+        if (!usageError.empty()) std::cerr << "[IdeaWalkerDaemon] " << usageError << "\n\n";
+        Usage(std::cerr, argv[0]);
+        return usageError.empty() ? kExitOk : kExitUsage;
+    }
+
+    // stdout only carries the "listening" event; anything the services print goes to stderr.
+    std::ostream out(std::cout.rdbuf());
+    std::cout.rdbuf(std::cerr.rdbuf());
+
+    std::error_code ec;
+    const fs::path root = fs::absolute(options.root, ec);
+    if (ec || !fs::is_directory(root)) {
+        std::cerr << "[IdeaWalkerDaemon] Raiz de projeto inexistente: " << options.root.string() << std::endl;
+        return kExitSetup;
+    }
+
+    application::AppServices services;
+    try {
+        services = app::BuildServicesForRoot(root);
+    } catch (const std::exception& e) {
+        std::cerr << "[IdeaWalkerDaemon] Falha ao abrir o projeto: " << e.what() << std::endl;
+        return kExitSetup;
+    }
+
+    httplib::Server server;
+    const size_t workers = options.workers;
+    server.new_task_queue = [workers] { return new httplib::ThreadPool(workers); };
+    server.set_keep_alive_max_count(options.keepAliveRequests);
+    server.set_keep_alive_timeout(static_cast<time_t>(options.keepAliveSeconds));
+    server.set_read_timeout(10, 0);
+    server.set_payload_max_length(kMaxPayloadBytes);
+
+    Daemon daemon(services, root, options);
+    daemon.registerRoutes(server);
+
+    int port = static_cast<int>(options.port);
+    if (port == 0) {
+        port = server.bind_to_any_port(kHost);
+    } else if (!server.bind_to_port(kHost, port)) {
+        port = -1;
+    }
+    if (port <= 0) {
+        std::cerr << "[IdeaWalkerDaemon] Porta indisponível em " << kHost << ": " << options.port << std::endl;
+        return kExitSetup;
+    }
+
+    std::signal(SIGINT, RequestStop);
+    std::signal(SIGTERM, RequestStop);
+    std::atomic<bool> serving{true};
+    // Server::stop() is not async-signal-safe, so the handler only raises a flag. A stop that
+    // lands before listen_after_bind() starts is a no-op, hence the retry until it returns.
+    std::thread stopper([&server, &serving] {
+        while (serving) {
+            if (g_stopRequested) server.stop();
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+    });
+
+    out << DumpJson({{"event", "listening"}, {"host", kHost}, {"port", port}, {"root", root.string()},
+                     {"workers", options.workers}})
+        << std::endl;
+    std::cerr << "[IdeaWalkerDaemon] Servindo " << root.string() << " em http://" << kHost << ":" << port << std::endl;
+
+    const bool listened = server.listen_after_bind();
+    serving = false;
+    stopper.join();
+
+    app::WaitForBackgroundTasks(*services.taskManager); // Ingestion and chat replies still running
+    if (services.suggestionService) services.suggestionService->shutdown();
+    if (services.persistenceService) services.persistenceService->flush();
+    std::cerr << "[IdeaWalkerDaemon] Encerrado." << std::endl;
+    return listened || g_stopRequested ? kExitOk : kExitSetup;
+}
@@ -0,0 +1,54 @@
+/**
+ * @file WritingLogCompact.cpp
+ * @brief Offline tool that rewrites writing-trajectory event logs with delta-encoded revisions.
+ *
+ * Usage: ideawalker_writing_compact <projectRoot> [trajectoryId...]
+ * Run it while IdeaWalker is closed: logs are replaced in place and snapshots dropped.
+ */
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "infrastructure/writing/WritingEventStoreFs.hpp"
+#include "infrastructure/writing/WritingTrajectoryRepositoryFs.hpp"
+
+using namespace ideawalker::infrastructure::writing;
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Uso: " << argv[0] << " <projectRoot> [trajectoryId...]" << std::endl;
+        return 2;
+    }
+
+    const std::string projectRoot = argv[1];
+    auto eventStore = std::make_unique<WritingEventStoreFs>(projectRoot, nullptr);
+    WritingEventStoreFs* store = eventStore.get();
+    WritingTrajectoryRepositoryFs repo(std::move(eventStore), 0);
+
+    std::vector<std::string> ids;
+    for (int i = 2; i < argc; ++i) ids.emplace_back(argv[i]);
+    if (ids.empty()) ids = store->getAllTrajectoryIds();
+
+    int failures = 0;
+    std::uint64_t totalBefore = 0;
+    std::uint64_t totalAfter = 0;
+    for (const auto& id : ids) {
+        auto stats = repo.compactLog(id);
+        if (!stats) {
+            std::cerr << "[WritingLogCompact] Falha ao compactar " << id << std::endl;
+            ++failures;
+            continue;
+        }
+        totalBefore += stats->bytesBefore;
+        totalAfter += stats->bytesAfter;
+        std::cout << id << ": " << stats->events << " eventos, "
+                  << stats->revisionsReencoded << " revisões recodificadas, "
+                  << stats->bytesBefore << " -> " << stats->bytesAfter << " bytes" << std::endl;
+    }
+
+    std::cout << "Total: " << totalBefore << " -> " << totalAfter << " bytes ("
+              << ids.size() - failures << "/" << ids.size() << " trajetórias)" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -81,6 +81,7 @@ bool AppState::OpenProject(const std::string& rootPath) {
     ui.selectedFilename.clear();
     ui.selectedNoteContent.clear();
     ui.unifiedKnowledge.clear();
+    ++ui.selectedNoteRevision;
     project.consolidatedInsight.reset();
     ui.currentBacklinks.clear();
 
@@ -151,6 +152,7 @@ bool AppState::CloseProject() {
     ui.selectedFilename.clear();
     ui.selectedNoteContent.clear();
     ui.unifiedKnowledge.clear();
+    ++ui.selectedNoteRevision;
     project.consolidatedInsight.reset();
     ui.currentBacklinks.clear();
     project.inboxThoughts.clear();
@@ -214,21 +216,42 @@ void AppState::RefreshAllInsights() {
             return a.getMetadata().id < b.getMetadata().id;
         });
 
-        std::ostringstream combined;
-        for (size_t i = 0; i < project.allInsights.size(); ++i) {
-            const auto& insight = project.allInsights[i];
-            combined << "## " << insight.getMetadata().id << "\n\n";
-            combined << insight.getContent();
-            if (i + 1 < project.allInsights.size()) {
-                combined << "\n\n---\n\n";
-            }
-        }
-        ui.unifiedKnowledge = combined.str();
-        
+        RebuildUnifiedKnowledge();
         RebuildGraph();
     }
 }
 
+void AppState::RefreshInsight(const std::string& filename) {
+    if (!services.knowledgeService) return;
+    if (filename == "_Consolidated_Tasks.md") {
+        RefreshAllInsights();
+        return;
+    }
+
+    auto insight = services.knowledgeService->GetInsight(filename);
+    auto& insights = project.allInsights;
+    auto it = std::lower_bound(insights.begin(), insights.end(), filename,
+        [](const domain::Insight& a, const std::string& id) { return a.getMetadata().id < id; });
+    const bool known = (it != insights.end() && it->getMetadata().id == filename);
+    if (insight) {
+        if (known) *it = std::move(*insight);
+        else insights.insert(it, std::move(*insight));
+    } else if (known) {
+        insights.erase(it);
+    }
+
+    RebuildUnifiedKnowledge();
+    if (services.graphService) {
+        services.graphService->UpdateNote(insights, filename, neuralWeb.nodes, neuralWeb.links);
+        neuralWeb.initialized = false;
+    }
+}
+
+void AppState::RebuildUnifiedKnowledge() {
+    // O(1): the view reads the notes in place when (and only if) it is drawn.
+    ui.unifiedKnowledge.invalidate();
+}
+
 void AppState::AppendLog(const std::string& line) {
     std::lock_guard<std::mutex> lock(ui.logMutex);
     ui.outputLog += line;
@@ -301,18 +324,19 @@ void AppState::CheckForUpdates() {
 
 void AppState::RebuildGraph() {
     if (!services.graphService) return;
-    services.graphService->RebuildGraph(project.allInsights, neuralWeb.showTasks, neuralWeb.nodes, neuralWeb.links);
-    neuralWeb.initialized = false; 
+    services.graphService->SyncGraph(project.allInsights, neuralWeb.showTasks, neuralWeb.nodes, neuralWeb.links);
+    neuralWeb.initialized = false;
 }
 
-void AppState::UpdateGraphPhysics(const std::unordered_set<int>& selectedNodes) {
-    if (!services.graphService) return;
-    services.graphService->UpdatePhysics(neuralWeb.nodes, neuralWeb.links, selectedNodes);
+bool AppState::UpdateGraphPhysics(const std::unordered_set<int>& selectedNodes) {
+    if (!services.graphService) return false;
+    return services.graphService->UpdatePhysics(neuralWeb.nodes, neuralWeb.links, selectedNodes);
 }
 
 void AppState::CenterGraph() {
     if (!services.graphService) return;
     services.graphService->CenterGraph(neuralWeb.nodes);
+    neuralWeb.initialized = false;
 }
 
 void AppState::HandleFileDrop(const std::string& filePath) {
@@ -382,6 +406,7 @@ void AppState::OpenExternalFile(const std::string& path) {
             external.selectedIndex = i;
             // Update content just in case
             external.files[i].content = buffer.str();
+            ++external.files[i].revision;
             return;
         }
     }
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 #include <functional>
 #include <map>
 #include <memory>
@@ -24,6 +25,9 @@
 #include "domain/writing/services/CoherenceLensService.hpp"
 #include "domain/writing/services/RevisionQualityService.hpp"
 #include "application/AppServices.hpp"
+#include "application/GraphViewport.hpp"
+#include "application/MarkdownDocument.hpp"
+#include "application/UnifiedKnowledge.hpp"
 
 namespace ideawalker::infrastructure { class PersistenceService; }
 
@@ -47,6 +51,8 @@ namespace ideawalker::ui {
         std::string filename; ///< Basename for display.
         std::string content;  ///< Current text content in editor.
         bool modified = false; ///< True if content has unsaved changes.
+        std::uint64_t revision = 0; ///< Bumped on every content change.
+        application::MarkdownPreview preview; ///< Parsed preview of content.
     };
 
     /**
@@ -75,9 +81,13 @@ namespace ideawalker::ui {
         bool initialized = false;
         bool showTasks = true;
         bool physicsEnabled = true;
+        application::GraphCamera camera;          ///< Pan/zoom shared by ImNodes (zoom 1) and the overview.
+        application::GraphLodConfig lod;
+        application::GraphViewport viewport;      ///< Per-frame culling/clustering scratch.
+        std::unordered_set<int> submittedNodes;   ///< Nodes handed to ImNodes last frame.
+        bool overview = false;                    ///< Last frame was drawn by the LOD renderer.
         void* mainContext = nullptr;
         void* previewContext = nullptr;
-        std::map<int, PreviewGraphState> previewGraphs;
     };
 
     /**
@@ -98,8 +108,14 @@ namespace ideawalker::ui {
         std::string selectedNoteContent;
         std::string selectedFilename;
         std::string selectedInboxFilename;
-        std::string unifiedKnowledge;
+        application::UnifiedKnowledge unifiedKnowledge; ///< Piece table over the notes, assembled when shown.
         bool unifiedKnowledgeView = true;
+        // Revision counters of the previewed texts (bump on every change) and their parsed previews.
+        std::uint64_t selectedNoteRevision = 0;
+        std::uint64_t selectedTaskRevision = 0;
+        application::MarkdownPreview notePreview;
+        application::MarkdownPreview unifiedPreview;
+        application::MarkdownPreview taskPreview;
         bool emojiEnabled = false;
         int activeTab = 0;
         int requestedTab = -1;
@@ -124,6 +140,8 @@ namespace ideawalker::ui {
         bool showTrajectoryPanel = false;
         bool showSegmentEditor = false;
         bool showDefensePanel = false;
+        bool showProfiler = false;
+        std::string profilerStatus;     ///< Result of the last trace export.
         bool showConversation = true;
 
         char saveAsFilename[128] = "";
@@ -205,13 +223,17 @@ struct AppState {
     bool CloseProject();
     /** @brief Triggers a reload of the inbox from the filesystem. */
     void RefreshInbox();
-    /** @brief Triggers a reload of all notes and rebuilds the Neural Web graph. */
+    /** @brief Triggers a reload of all notes and syncs the Neural Web graph. */
     void RefreshAllInsights();
+    /** @brief Reloads a single note after it was saved (only its graph nodes and links change). */
+    void RefreshInsight(const std::string& filename);
+    /** @brief Marks the unified knowledge view stale (its pieces are rebuilt when it is shown). */
+    void RebuildUnifiedKnowledge();
     /** @brief Handles file dnd events (e.g., audio files for transcription). */
     void HandleFileDrop(const std::string& filePath);
     /** @brief Explicitly requests transcription for a file path. */
     void RequestTranscription(const std::string& filePath);
-    /** @brief Regenerates the Neural Web graph nodes and links from notes. */
+    /** @brief Syncs the Neural Web graph nodes and links with the notes (incremental). */
     void RebuildGraph();
     /** @brief Thread-safe log append. */
     void AppendLog(const std::string& line);
@@ -234,8 +256,8 @@ struct AppState {
     std::string ExportToMermaid() const;
     /** @brief Exports the entire knowledge base to a single Markdown file with Mermaid diagrams. */
     std::string ExportFullMarkdown() const;
-    /** @brief Advances the force-directed graph physics by one step. */
-    void UpdateGraphPhysics(const std::unordered_set<int>& selectedNodes = {});
+    /** @brief Advances the force-directed graph physics by one step. Returns true if nodes moved. */
+    bool UpdateGraphPhysics(const std::unordered_set<int>& selectedNodes = {});
     /** @brief Resets all node positions to the center of the viewport. */
     void CenterGraph();
 
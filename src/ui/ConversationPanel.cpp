@@ -95,6 +95,13 @@ void ConversationPanel::DrawContent(AppState& app) {
                      service.startSession(bundle);
                  }
              }
+             ImGui::SameLine();
+             if (ImGui::SmallButton("Exportar .md")) {
+                 std::string exported = service.exportMarkdownTranscript();
+                 if (!exported.empty()) {
+                     app.AppendLog("[SISTEMA] Diálogo exportado: " + exported + "\n");
+                 }
+             }
         }
     }
 
@@ -1,12 +1,16 @@
 #include "ui/UiMarkdownRenderer.hpp"
 #include "domain/writing/MermaidParser.hpp"
+#include "infrastructure/FrameProfiler.hpp"
 #include "imgui.h"
 #include "imnodes.h"
 #include <algorithm>
 #include <cmath>
 #include <cfloat>
 #include <cstring>
-#include <sstream>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace ideawalker::ui {
@@ -14,32 +18,84 @@ namespace ideawalker::ui {
 namespace {
     constexpr float NODE_MAX_WIDTH = 250.0f;
 
-bool StartsWith(const std::string& text, const char* prefix) {
-    return text.rfind(prefix, 0) == 0;
-}
+    using ideawalker::domain::writing::MermaidParser;
 
-} // namespace
+    // ImGui::CalcTextSize on an explicit font: Mermaid layout tasks measure off the
+    // render thread, where the context's current font is not theirs to read. The font
+    // atlas is built once at startup, so its glyph tables are read-only by then.
+    ImVec2 MeasureText(const ImFont* font, float fontSize, const std::string& text, float wrap) {
+        ImVec2 size = font->CalcTextSizeA(fontSize, FLT_MAX, wrap, text.data(), text.data() + text.size());
+        size.x = std::floor(size.x + 0.99999f);
+        return size;
+    }
 
-NodeSizeResult EstimateNodeSizeAdaptive(const std::string& text, float minWrap, float maxWrap, float step, float padX, float padY) {
-    float bestWrap = minWrap;
-    float bestCost = FLT_MAX;
-    ImVec2 bestSize = ImVec2(0, 0);
+    NodeSizeResult EstimateNodeSize(const ImFont* font, float fontSize, const std::string& text,
+                                    float minWrap, float maxWrap, float step, float padX, float padY) {
+        float bestWrap = minWrap;
+        float bestCost = FLT_MAX;
+        ImVec2 bestSize = ImVec2(0, 0);
 
-    for (float wrap = minWrap; wrap <= maxWrap; wrap += step) {
-        ImVec2 sz = ImGui::CalcTextSize(text.c_str(), nullptr, false, wrap);
-        
-        // Cost: Area + penalty for extremely tall nodes
-        float area = (sz.x + padX) * (sz.y + padY);
-        float tallPenalty = (sz.y > 150.0f) ? (sz.y - 150.0f) * 60.0f : 0.0f;
-        float cost = area + tallPenalty;
-
-        if (cost < bestCost) {
-            bestCost = cost;
-            bestWrap = wrap;
-            bestSize = sz;
+        for (float wrap = minWrap; wrap <= maxWrap; wrap += step) {
+            ImVec2 sz = MeasureText(font, fontSize, text, wrap);
+
+            // Cost: Area + penalty for extremely tall nodes
+            float area = (sz.x + padX) * (sz.y + padY);
+            float tallPenalty = (sz.y > 150.0f) ? (sz.y - 150.0f) * 60.0f : 0.0f;
+            float cost = area + tallPenalty;
+
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestWrap = wrap;
+                bestSize = sz;
+            }
         }
+        return { bestSize.x + padX, bestSize.y + padY, bestWrap };
     }
-    return { bestSize.x + padX, bestSize.y + padY, bestWrap };
+
+    /**
+     * @brief Mermaid node sizes memoized per (label, font, size).
+     * Labels repeat across diagrams and edits; each one costs seven wrapped measurements.
+     */
+    class NodeSizeMemo {
+    public:
+        MermaidParser::NodeSize measure(const ImFont* font, float fontSize, const std::string& label) {
+            std::string key = label;
+            key.push_back('\0');
+            key.append(reinterpret_cast<const char*>(&font), sizeof(font));
+            key.append(reinterpret_cast<const char*>(&fontSize), sizeof(fontSize));
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                auto it = m_sizes.find(key);
+                if (it != m_sizes.end()) return it->second;
+            }
+            const NodeSizeResult res = EstimateNodeSize(font, fontSize, label, 160.0f, 420.0f, 40.0f, 30.0f, 20.0f);
+            const MermaidParser::NodeSize size{res.w, res.h, res.wrap};
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_sizes.size() >= kMaxEntries) m_sizes.clear();
+            m_sizes.emplace(std::move(key), size);
+            return size;
+        }
+
+    private:
+        static constexpr std::size_t kMaxEntries = 16384;
+        std::mutex m_mutex;
+        std::unordered_map<std::string, MermaidParser::NodeSize> m_sizes;
+    };
+
+    NodeSizeMemo& NodeSizes() {
+        static NodeSizeMemo memo;
+        return memo;
+    }
+
+    std::uint64_t MeasureKey(const ImFont* font, float fontSize) {
+        std::uint32_t sizeBits = 0;
+        std::memcpy(&sizeBits, &fontSize, sizeof(sizeBits));
+        return (static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(font)) << 16) ^ sizeBits;
+    }
+} // namespace
+
+NodeSizeResult EstimateNodeSizeAdaptive(const std::string& text, float minWrap, float maxWrap, float step, float padX, float padY) {
+    return EstimateNodeSize(ImGui::GetFont(), ImGui::GetFontSize(), text, minWrap, maxWrap, step, padX, padY);
 }
 
 void DrawStaticMermaidPreview(const ideawalker::domain::writing::PreviewGraphState& graph) {
@@ -242,194 +298,308 @@ void DrawStaticMermaidPreview(const ideawalker::domain::writing::PreviewGraphSta
     }
 }
 
-void DrawMarkdownPreview(AppState& app, const std::string& content, bool staticMermaidPreview) {
-    auto label = [&app](const char* withEmoji, const char* plain) {
-        return app.ui.emojiEnabled ? withEmoji : plain;
-    };
+namespace {
 
-    std::stringstream ss(content);
-    std::string line;
-    
-    bool inCodeBlock = false;
-    std::string codeBlockLanguage = "";
-    std::string codeBlockContent = "";
-    int codeBlockIdCounter = 0;
-
-    while (std::getline(ss, line)) {
-        if (!line.empty() && line.back() == '\r') line.pop_back();
-
-        if (StartsWith(line, "```")) {
-            if (inCodeBlock) {
-                int blockId = codeBlockIdCounter++;
-                ImGui::PushID(blockId);
-                if (codeBlockLanguage == "mermaid") {
-                    int mermaidBlockId = static_cast<int>(std::hash<std::string>{}(codeBlockContent)) % 10000;
-                    auto& graph = app.neuralWeb.previewGraphs[mermaidBlockId];
-                    
-                    bool newLayout = ideawalker::domain::writing::MermaidParser::Parse(
-                        codeBlockContent, 
-                        graph,
-                        [](const std::string& text) {
-                            NodeSizeResult res = EstimateNodeSizeAdaptive(text, 160.0f, 420.0f, 40.0f, 30.0f, 20.0f);
-                            return ideawalker::domain::writing::MermaidParser::NodeSize{res.w, res.h, res.wrap};
-                        },
-                        10000 + (mermaidBlockId * 10)
-                    );
-
-                    if (newLayout && !staticMermaidPreview) {
-                        ImNodes::EditorContextSet((ImNodesEditorContext*)app.neuralWeb.previewContext);
-                        for (const auto& node : graph.nodes) {
-                            ImNodes::SetNodeGridSpacePos(node.id, ImVec2(node.x, node.y));
-                        }
-                    }
-
-                    ImGui::PushStyleColor(ImGuiCol_ChildBg, ImVec4(0.12f, 0.14f, 0.18f, 1.0f));
-
-                    if (staticMermaidPreview) {
-                        ImGui::BeginChild("##mermaid_graph", ImVec2(0, 700), true);
-                        DrawStaticMermaidPreview(graph);
-                        ImGui::EndChild();
-                        ImGui::PopStyleColor();
-                    } else {
-                        if (ImGui::Button("Fit to Screen") || newLayout) {
-                            ImNodes::EditorContextSet((ImNodesEditorContext*)app.neuralWeb.previewContext);
-                            ImVec2 min(FLT_MAX, FLT_MAX), max(-FLT_MAX, -FLT_MAX);
-                            if (graph.nodes.empty()) { min = max = ImVec2(0,0); }
-                            else {
-                                for(auto& n : graph.nodes) {
-                                    if(n.x < min.x) min.x = n.x; if(n.y < min.y) min.y = n.y;
-                                    if(n.x > max.x) max.x = n.x; if(n.y > max.y) max.y = n.y;
-                                }
-                            }
-                            ImVec2 center = ImVec2((min.x + max.x)*0.5f, (min.y + max.y)*0.5f);
-                            ImVec2 canvasSize(ImGui::GetContentRegionAvail().x, 400.0f);
-                            ImVec2 pan = ImVec2(canvasSize.x * 0.5f - center.x, canvasSize.y * 0.5f - center.y);
-                            ImNodes::EditorContextResetPanning(pan);
-                        }
-                        
-                        ImGui::BeginChild("##mermaid_graph", ImVec2(0, 700), true);
-                        ImNodes::EditorContextSet((ImNodesEditorContext*)app.neuralWeb.previewContext);
-                        ImNodes::PushColorStyle(ImNodesCol_GridBackground, ImGui::GetColorU32(ImVec4(0.12f, 0.14f, 0.18f, 1.0f)));
-                        ImNodes::PushColorStyle(ImNodesCol_GridLine, ImGui::GetColorU32(ImVec4(0.2f, 0.2f, 0.2f, 0.5f)));
-                        ImNodes::BeginNodeEditor();
-
-                        for (auto& node : graph.nodes) {
-                            std::hash<std::string> hasher;
-                            size_t h = hasher(node.title);
-                            float hue = (h % 100) / 100.0f;
-                            ImVec4 bgCol, titleCol, titleSelCol;
-                            ImGui::ColorConvertHSVtoRGB(hue, 0.6f, 0.3f, bgCol.x, bgCol.y, bgCol.z); bgCol.w = 1.0f;
-                            ImGui::ColorConvertHSVtoRGB(hue, 0.6f, 0.5f, titleCol.x, titleCol.y, titleCol.z); titleCol.w = 1.0f;
-                            ImGui::ColorConvertHSVtoRGB(hue, 0.6f, 0.6f, titleSelCol.x, titleSelCol.y, titleSelCol.z); titleSelCol.w = 1.0f;
-
-                            ImNodes::PushColorStyle(ImNodesCol_NodeBackground, ImGui::GetColorU32(bgCol));
-                            ImNodes::PushColorStyle(ImNodesCol_TitleBar, ImGui::GetColorU32(titleCol));
-                            ImNodes::PushColorStyle(ImNodesCol_TitleBarSelected, ImGui::GetColorU32(titleSelCol));
-
-                            ImNodes::BeginNode(node.id);
-                            ImNodes::BeginNodeTitleBar();
-                            ImGui::PushTextWrapPos(ImGui::GetCursorPos().x + NODE_MAX_WIDTH);
-                            ImGui::TextUnformatted(node.title.c_str());
-                            ImGui::PopTextWrapPos();
-                            ImNodes::EndNodeTitleBar();
-                            ImNodes::BeginOutputAttribute(node.id << 8); ImNodes::EndOutputAttribute();
-                            ImNodes::BeginInputAttribute((node.id << 8) + 1); ImNodes::EndInputAttribute();
-                            ImNodes::EndNode();
-                            ImNodes::PopColorStyle(); ImNodes::PopColorStyle(); ImNodes::PopColorStyle();
-                        }
-                        
-                        for (const auto& link : graph.links) {
-                            ImNodes::Link(link.id, link.startNode << 8, (link.endNode << 8) + 1);
-                        }
-                        ImNodes::EndNodeEditor();
-                        ImNodes::PopColorStyle(); ImNodes::PopColorStyle();
-                        ImGui::EndChild();
-                        ImGui::PopStyleColor();
-                    }
-                } else {
-                    ImGui::PushStyleColor(ImGuiCol_ChildBg, ImVec4(0.1f, 0.1f, 0.1f, 1.0f));
-                    ImGui::BeginChild("##code", ImVec2(0, 0), true, ImGuiWindowFlags_AlwaysAutoResize);
-                    if (!codeBlockLanguage.empty()) {
-                         ImGui::TextDisabled("%s", codeBlockLanguage.c_str()); ImGui::Separator();
-                    }
-                    ImGui::PushFont(ImGui::GetIO().Fonts->Fonts[0]); 
-                    ImGui::TextUnformatted(codeBlockContent.c_str());
-                    ImGui::PopFont();
-                    ImGui::EndChild();
-                    ImGui::PopStyleColor();
-                }
-                ImGui::PopID();
-                inCodeBlock = false; codeBlockContent = "";
+void TextRange(std::string_view text) {
+    ImGui::TextUnformatted(text.data(), text.data() + text.size());
+}
+
+void TextRangeColored(const ImVec4& color, std::string_view text) {
+    ImGui::PushStyleColor(ImGuiCol_Text, color);
+    TextRange(text);
+    ImGui::PopStyleColor();
+}
+
+void TextRangeWrapped(std::string_view text) {
+    ImGui::PushTextWrapPos(0.0f);
+    TextRange(text);
+    ImGui::PopTextWrapPos();
+}
+
+void DrawMermaidBlock(AppState& app, application::MarkdownPreview& preview, const application::MarkdownBlock& block,
+                      std::string_view body, bool staticMermaidPreview) {
+    const auto diagram = static_cast<std::size_t>(block.diagram);
+
+    // Only diagrams of a freshly parsed document are looked up again. The layout cache
+    // returns the very same graph when the body did not change, so nothing is relaid out;
+    // large diagrams are laid out in background while the previous graph stays on screen.
+    bool newLayout = false;
+    if (preview.diagramStale[diagram]) {
+        application::MermaidLayoutCache* layouts = app.services.mermaidLayouts.get();
+        std::uint64_t& key = preview.diagramKeys[diagram];
+        application::MermaidLayout layout;
+        if (layouts && key != 0) {
+            layout = layouts->find(key);
+            if (!layout && !layouts->pending(key)) key = 0; // Evicted before it was picked up
+        } else {
+            std::string source;
+            source.reserve(body.size());
+            for (char c : body) {
+                if (c != '\r') source.push_back(c);
+            }
+            const int baseId = 10000 + block.diagram * 1000;
+            const ImFont* font = ImGui::GetFont();
+            const float fontSize = ImGui::GetFontSize();
+            auto calculator = [font, fontSize](const std::string& text) {
+                return NodeSizes().measure(font, fontSize, text);
+            };
+            if (layouts) {
+                key = application::MermaidLayoutCache::Key(source, baseId, MeasureKey(font, fontSize));
+                layout = layouts->acquire(key, source, baseId, calculator);
             } else {
-                inCodeBlock = true;
-                if (line.length() > 3) {
-                    codeBlockLanguage = line.substr(3);
-                    auto start = codeBlockLanguage.find_first_not_of(" \t");
-                    if (start != std::string::npos) codeBlockLanguage = codeBlockLanguage.substr(start);
-                    auto end = codeBlockLanguage.find_last_not_of(" \t");
-                    if (end != std::string::npos) codeBlockLanguage = codeBlockLanguage.substr(0, end + 1);
-                } else { codeBlockLanguage = ""; }
+                auto graph = std::make_shared<ideawalker::domain::writing::PreviewGraphState>();
+                MermaidParser::Parse(source, *graph, calculator, baseId);
+                layout = std::move(graph);
             }
-            continue;
         }
+        if (layout) {
+            preview.diagramStale[diagram] = 0;
+            key = 0;
+            newLayout = layout != preview.diagrams[diagram];
+            preview.diagrams[diagram] = std::move(layout);
+        }
+    }
+
+    ImGui::PushStyleColor(ImGuiCol_ChildBg, ImVec4(0.12f, 0.14f, 0.18f, 1.0f));
+    if (!preview.diagrams[diagram]) {
+        ImGui::BeginChild("##mermaid_graph", ImVec2(0, 700), true);
+        ImGui::TextDisabled("Calculando layout do diagrama...");
+        ImGui::EndChild();
+        ImGui::PopStyleColor();
+        return;
+    }
+    if (preview.diagramStale[diagram]) ImGui::TextDisabled("Atualizando layout...");
+    const auto& graph = *preview.diagrams[diagram];
 
-        if (inCodeBlock) {
-            codeBlockContent += line + "\n";
-            continue;
+    if (newLayout && !staticMermaidPreview) {
+        ImNodes::EditorContextSet((ImNodesEditorContext*)app.neuralWeb.previewContext);
+        for (const auto& node : graph.nodes) {
+            ImNodes::SetNodeGridSpacePos(node.id, ImVec2(node.x, node.y));
         }
+    }
 
-        size_t firstChar = line.find_first_not_of(" \t");
-        if (firstChar == std::string::npos) { ImGui::Spacing(); continue; }
-        std::string indent = line.substr(0, firstChar);
-        std::string trimmed = line.substr(firstChar);
-        
-        if (StartsWith(trimmed, "# ")) {
-            ImGui::TextColored(ImVec4(0.4f, 0.7f, 1.0f, 1.0f), "%s", trimmed.substr(2).c_str()); ImGui::Separator();
-        } else if (StartsWith(trimmed, "## ")) {
-            ImGui::TextColored(ImVec4(0.3f, 0.6f, 0.9f, 1.0f), "%s", trimmed.substr(3).c_str());
-        } else if (StartsWith(trimmed, "### ")) {
-            ImGui::TextColored(ImVec4(0.2f, 0.5f, 0.8f, 1.0f), "%s", trimmed.substr(4).c_str());
-        } else if (StartsWith(trimmed, "- [ ] ") || StartsWith(trimmed, "* [ ] ")) {
-            ImGui::TextUnformatted(indent.c_str()); ImGui::SameLine(0, 0);
-            ImGui::TextUnformatted(label("📋", "[ ]")); ImGui::SameLine();
-            ImGui::TextWrapped("%s", trimmed.substr(6).c_str());
-        } else if (StartsWith(trimmed, "- [x] ") || StartsWith(trimmed, "* [x] ")) {
-            ImGui::TextUnformatted(indent.c_str()); ImGui::SameLine(0, 0);
-            ImGui::TextColored(ImVec4(0.5f, 1.0f, 0.5f, 1.0f), "%s", label("✅", "[x]")); ImGui::SameLine();
-            ImGui::TextDisabled("%s", trimmed.substr(6).c_str());
-        } else if (StartsWith(trimmed, "- ") || StartsWith(trimmed, "* ") || StartsWith(trimmed, "• ") || StartsWith(trimmed, "– ") || StartsWith(trimmed, "— ")) {
-            ImGui::TextUnformatted(indent.c_str()); ImGui::SameLine(0, 0);
+    if (staticMermaidPreview) {
+        ImGui::BeginChild("##mermaid_graph", ImVec2(0, 700), true);
+        DrawStaticMermaidPreview(graph);
+        ImGui::EndChild();
+        ImGui::PopStyleColor();
+        return;
+    }
+
+    if (ImGui::Button("Fit to Screen") || newLayout) {
+        ImNodes::EditorContextSet((ImNodesEditorContext*)app.neuralWeb.previewContext);
+        ImVec2 min(FLT_MAX, FLT_MAX), max(-FLT_MAX, -FLT_MAX);
+        if (graph.nodes.empty()) { min = max = ImVec2(0,0); }
+        else {
+            for(auto& n : graph.nodes) {
+                if(n.x < min.x) min.x = n.x; if(n.y < min.y) min.y = n.y;
+                if(n.x > max.x) max.x = n.x; if(n.y > max.y) max.y = n.y;
+            }
+        }
+        ImVec2 center = ImVec2((min.x + max.x)*0.5f, (min.y + max.y)*0.5f);
+        ImVec2 canvasSize(ImGui::GetContentRegionAvail().x, 400.0f);
+        ImVec2 pan = ImVec2(canvasSize.x * 0.5f - center.x, canvasSize.y * 0.5f - center.y);
+        ImNodes::EditorContextResetPanning(pan);
+    }
+
+    ImGui::BeginChild("##mermaid_graph", ImVec2(0, 700), true);
+    ImNodes::EditorContextSet((ImNodesEditorContext*)app.neuralWeb.previewContext);
+    ImNodes::PushColorStyle(ImNodesCol_GridBackground, ImGui::GetColorU32(ImVec4(0.12f, 0.14f, 0.18f, 1.0f)));
+    ImNodes::PushColorStyle(ImNodesCol_GridLine, ImGui::GetColorU32(ImVec4(0.2f, 0.2f, 0.2f, 0.5f)));
+    ImNodes::BeginNodeEditor();
+
+    for (const auto& node : graph.nodes) {
+        std::hash<std::string> hasher;
+        size_t h = hasher(node.title);
+        float hue = (h % 100) / 100.0f;
+        ImVec4 bgCol, titleCol, titleSelCol;
+        ImGui::ColorConvertHSVtoRGB(hue, 0.6f, 0.3f, bgCol.x, bgCol.y, bgCol.z); bgCol.w = 1.0f;
+        ImGui::ColorConvertHSVtoRGB(hue, 0.6f, 0.5f, titleCol.x, titleCol.y, titleCol.z); titleCol.w = 1.0f;
+        ImGui::ColorConvertHSVtoRGB(hue, 0.6f, 0.6f, titleSelCol.x, titleSelCol.y, titleSelCol.z); titleSelCol.w = 1.0f;
+
+        ImNodes::PushColorStyle(ImNodesCol_NodeBackground, ImGui::GetColorU32(bgCol));
+        ImNodes::PushColorStyle(ImNodesCol_TitleBar, ImGui::GetColorU32(titleCol));
+        ImNodes::PushColorStyle(ImNodesCol_TitleBarSelected, ImGui::GetColorU32(titleSelCol));
+
+        ImNodes::BeginNode(node.id);
+        ImNodes::BeginNodeTitleBar();
+        ImGui::PushTextWrapPos(ImGui::GetCursorPos().x + NODE_MAX_WIDTH);
+        ImGui::TextUnformatted(node.title.c_str());
+        ImGui::PopTextWrapPos();
+        ImNodes::EndNodeTitleBar();
+        ImNodes::BeginOutputAttribute(node.id << 8); ImNodes::EndOutputAttribute();
+        ImNodes::BeginInputAttribute((node.id << 8) + 1); ImNodes::EndInputAttribute();
+        ImNodes::EndNode();
+        ImNodes::PopColorStyle(); ImNodes::PopColorStyle(); ImNodes::PopColorStyle();
+    }
+
+    for (const auto& link : graph.links) {
+        ImNodes::Link(link.id, link.startNode << 8, (link.endNode << 8) + 1);
+    }
+    ImNodes::EndNodeEditor();
+    ImNodes::PopColorStyle(); ImNodes::PopColorStyle();
+    ImGui::EndChild();
+    ImGui::PopStyleColor();
+}
+
+void DrawCodeBlock(std::string_view lang, std::string_view body) {
+    ImGui::PushStyleColor(ImGuiCol_ChildBg, ImVec4(0.1f, 0.1f, 0.1f, 1.0f));
+    ImGui::BeginChild("##code", ImVec2(0, 0), true, ImGuiWindowFlags_AlwaysAutoResize);
+    if (!lang.empty()) {
+        TextRangeColored(ImGui::GetStyle().Colors[ImGuiCol_TextDisabled], lang); ImGui::Separator();
+    }
+    ImGui::PushFont(ImGui::GetIO().Fonts->Fonts[0]);
+    TextRange(body);
+    ImGui::PopFont();
+    ImGui::EndChild();
+    ImGui::PopStyleColor();
+}
+
+void DrawBlock(AppState& app, application::MarkdownPreview& preview, const application::MarkdownPieces& pieces,
+               const application::MarkdownBlock& block, bool staticMermaidPreview) {
+    using application::MarkdownBlockKind;
+    using application::MarkdownDocument;
+
+    auto label = [&app](const char* withEmoji, const char* plain) {
+        return app.ui.emojiEnabled ? withEmoji : plain;
+    };
+
+    const auto& spans = preview.document.spans();
+    const std::string_view source = pieces[block.piece];
+    const std::string_view indent = MarkdownDocument::Slice(source, block.indentBegin, block.indentLength);
+    const std::string_view text = MarkdownDocument::Slice(source, block.textBegin, block.textLength);
+
+    switch (block.kind) {
+        case MarkdownBlockKind::Blank:
+            ImGui::Spacing();
+            break;
+        case MarkdownBlockKind::Mermaid:
+            DrawMermaidBlock(app, preview, block, text, staticMermaidPreview);
+            break;
+        case MarkdownBlockKind::Code:
+            DrawCodeBlock(MarkdownDocument::Slice(source, block.langBegin, block.langLength), text);
+            break;
+        case MarkdownBlockKind::Heading:
+            if (block.level == 1) {
+                TextRangeColored(ImVec4(0.4f, 0.7f, 1.0f, 1.0f), text); ImGui::Separator();
+            } else if (block.level == 2) {
+                TextRangeColored(ImVec4(0.3f, 0.6f, 0.9f, 1.0f), text);
+            } else {
+                TextRangeColored(ImVec4(0.2f, 0.5f, 0.8f, 1.0f), text);
+            }
+            break;
+        case MarkdownBlockKind::Task:
+            TextRange(indent); ImGui::SameLine(0, 0);
+            if (block.checked) {
+                ImGui::TextColored(ImVec4(0.5f, 1.0f, 0.5f, 1.0f), "%s", label("✅", "[x]")); ImGui::SameLine();
+                TextRangeColored(ImGui::GetStyle().Colors[ImGuiCol_TextDisabled], text);
+            } else {
+                ImGui::TextUnformatted(label("📋", "[ ]")); ImGui::SameLine();
+                TextRangeWrapped(text);
+            }
+            break;
+        case MarkdownBlockKind::Bullet:
+            TextRange(indent); ImGui::SameLine(0, 0);
             ImGui::TextUnformatted("- "); ImGui::SameLine(0, 0);
-            size_t skip = 2;
-            if (StartsWith(trimmed, "• ")) skip = std::strlen("• ");
-            else if (StartsWith(trimmed, "– ")) skip = std::strlen("– ");
-            else if (StartsWith(trimmed, "— ")) skip = std::strlen("— ");
-            ImGui::TextWrapped("%s", trimmed.substr(skip).c_str());
-        } else if (StartsWith(trimmed, "> ")) {
+            TextRangeWrapped(text);
+            break;
+        case MarkdownBlockKind::Quote:
             ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.7f, 0.7f, 0.7f, 1.0f));
-            ImGui::TextUnformatted(indent.c_str()); ImGui::SameLine(0, 0);
-            ImGui::TextWrapped(" | %s", trimmed.substr(2).c_str());
+            TextRange(indent); ImGui::SameLine(0, 0);
+            ImGui::TextUnformatted(" | "); ImGui::SameLine(0, 0);
+            TextRangeWrapped(text);
             ImGui::PopStyleColor();
-        } else {
-            if (!indent.empty()) { ImGui::TextUnformatted(indent.c_str()); ImGui::SameLine(0, 0); }
-            size_t lastPos = 0;
-            size_t startPos = trimmed.find("[[");
-            while (startPos != std::string::npos) {
-                if (startPos > lastPos) {
-                    ImGui::TextWrapped("%s", trimmed.substr(lastPos, startPos - lastPos).c_str()); ImGui::SameLine(0, 0);
-                }
-                size_t endPos = trimmed.find("]]", startPos + 2);
-                if (endPos != std::string::npos) {
-                    std::string linkName = trimmed.substr(startPos + 2, endPos - startPos - 2);
+            break;
+        case MarkdownBlockKind::Paragraph:
+            if (!indent.empty()) { TextRange(indent); ImGui::SameLine(0, 0); }
+            if (block.spanCount == 0) {
+                TextRangeWrapped(text);
+                break;
+            }
+            for (std::uint32_t i = 0; i < block.spanCount; ++i) {
+                const auto& span = spans[block.spanBegin + i];
+                const std::string_view part = MarkdownDocument::Slice(source, span.begin, span.length);
+                if (span.link) {
+                    std::string linkName(part);
                     ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.2f, 0.3f, 0.5f, 1.0f));
                     if (ImGui::SmallButton(linkName.c_str())) { app.ui.selectedFilename = linkName + ".md"; }
-                    ImGui::PopStyleColor(); ImGui::SameLine(0, 0);
-                    lastPos = endPos + 2; startPos = trimmed.find("[[", lastPos);
-                } else { break; }
+                    ImGui::PopStyleColor();
+                } else {
+                    TextRangeWrapped(part);
+                }
+                if (i + 1 < block.spanCount) ImGui::SameLine(0, 0);
             }
-            if (lastPos < trimmed.size()) { ImGui::TextWrapped("%s", trimmed.substr(lastPos).c_str()); }
+            break;
+    }
+}
+
+application::MarkdownMetrics CurrentMetrics() {
+    const ImGuiStyle& style = ImGui::GetStyle();
+    application::MarkdownMetrics metrics;
+    metrics.lineHeight = ImGui::GetTextLineHeightWithSpacing();
+    metrics.charWidth = ImGui::CalcTextSize("abcdefghijklmnopqrstuvwxyz").x / 26.0f;
+    metrics.spacing = style.ItemSpacing.y;
+    metrics.separator = style.ItemSpacing.y + 1.0f;
+    metrics.codeChrome = style.WindowPadding.y * 2.0f + style.ItemSpacing.y * 2.0f + 1.0f;
+    metrics.diagramHeight = 700.0f + ImGui::GetFrameHeightWithSpacing() + style.ItemSpacing.y;
+    return metrics;
+}
+
+} // namespace
+
+void DrawMarkdownPreview(AppState& app, application::MarkdownPreview& preview, const std::string& content,
+                         std::uint64_t revision, bool staticMermaidPreview) {
+    DrawMarkdownPreview(app, preview, application::MarkdownPieces{content}, revision, staticMermaidPreview);
+}
+
+void DrawMarkdownPreview(AppState& app, application::MarkdownPreview& preview, const application::MarkdownPieces& source,
+                         std::uint64_t revision, bool staticMermaidPreview) {
+    infrastructure::ProfileZone zone("DrawMarkdownPreview");
+    preview.sync(source, revision);
+    const auto& blocks = preview.document.blocks();
+    auto& layout = preview.layout;
+
+    const float width = ImGui::GetContentRegionAvail().x;
+    if (preview.layoutStale || std::fabs(layout.width() - width) > 0.5f) {
+        layout.reset(preview.document, source, width, CurrentMetrics());
+        preview.layoutStale = false;
+    }
+    if (blocks.empty()) return;
+
+    // Only blocks that intersect the scrolled window are laid out and drawn; the rest
+    // is reserved with one Dummy so the scrollbar still covers the whole document.
+    const float top = ImGui::GetCursorPosY();
+    const double viewBegin = std::max(0.0, static_cast<double>(ImGui::GetScrollY() - top));
+    const double viewEnd = static_cast<double>(ImGui::GetScrollY() - top + ImGui::GetWindowHeight());
+
+    std::size_t index = layout.blockAt(viewBegin);
+    ImGui::SetCursorPosY(top + static_cast<float>(layout.offsetOf(index)));
+    for (; index < blocks.size(); ++index) {
+        const float blockTop = ImGui::GetCursorPosY();
+        if (blockTop - top >= viewEnd) break;
+        ImGui::PushID(static_cast<int>(index));
+        DrawBlock(app, preview, source, blocks[index], staticMermaidPreview);
+        ImGui::PopID();
+        layout.setHeight(index, ImGui::GetCursorPosY() - blockTop);
+    }
+
+    const double remaining = layout.totalHeight() - layout.offsetOf(index);
+    if (remaining > 0.5) ImGui::Dummy(ImVec2(1.0f, static_cast<float>(remaining)));
+}
+
+void DrawTextLines(application::MarkdownPreview& preview, const application::MarkdownPieces& source, std::uint64_t revision) {
+    preview.sync(source, revision);
+    const auto& lines = preview.document.lines();
+
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(lines.size()));
+    while (clipper.Step()) {
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+            const auto& line = lines[row];
+            TextRange(application::MarkdownDocument::Slice(source[line.piece], line.begin, line.length));
         }
     }
+    clipper.End();
 }
 
 } // namespace ideawalker::ui
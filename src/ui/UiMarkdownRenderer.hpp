@@ -1,6 +1,8 @@
 #pragma once
 
 #include "ui/AppState.hpp"
+#include "application/MarkdownDocument.hpp"
+#include <cstdint>
 #include <string>
 
 namespace ideawalker::ui {
@@ -18,8 +20,22 @@ NodeSizeResult EstimateNodeSizeAdaptive(const std::string& text, float minWrap,
 
 /**
  * @brief Renders a Markdown preview in an ImGui context.
+ *
+ * Must be the last content of a scrolling window: only the blocks on screen are drawn
+ * (heights are estimated, then measured as blocks appear).
+ * @param preview Cache owned by the view; reparsed only when @p revision changes.
+ * @param revision Counter the owner bumps whenever @p content is modified.
  */
-void DrawMarkdownPreview(AppState& app, const std::string& content, bool staticMermaidPreview);
+void DrawMarkdownPreview(AppState& app, application::MarkdownPreview& preview, const std::string& content,
+                         std::uint64_t revision, bool staticMermaidPreview);
+/** @brief Same, for a text made of several pieces (e.g. the unified knowledge view). */
+void DrawMarkdownPreview(AppState& app, application::MarkdownPreview& preview, const application::MarkdownPieces& source,
+                         std::uint64_t revision, bool staticMermaidPreview);
+
+/**
+ * @brief Renders a read-only text line by line, drawing only the visible lines.
+ */
+void DrawTextLines(application::MarkdownPreview& preview, const application::MarkdownPieces& source, std::uint64_t revision);
 
 /**
  * @brief Draws a static preview of a Mermaid graph.
@@ -5,26 +5,40 @@
 #include "ui/UiRenderer.hpp"
 #include "ui/panels/MainPanels.hpp"
 #include "ui/panels/WritingPanels.hpp"
+#include "infrastructure/FrameProfiler.hpp"
 
 namespace ideawalker::ui {
 
 void DrawUI(AppState& app) {
     // Check if we need to refresh data (e.g., after AI finishing in background)
     if (app.ui.pendingRefresh.exchange(false)) {
+        infrastructure::ProfileZone zone("RefreshAfterTask");
         app.RefreshInbox();
         app.RefreshAllInsights();
     }
 
     // 1. Draw the Main Window (which includes Menu Bar and Workspace/Tabs)
-    DrawMainWindow(app);
+    {
+        infrastructure::ProfileZone zone("MainWindow");
+        DrawMainWindow(app);
+    }
 
     // 2. Draw all Modals (Task Details, History, Help, Update, Project Modals)
-    DrawAllModals(app);
+    {
+        infrastructure::ProfileZone zone("Modals");
+        DrawAllModals(app);
+    }
     
     // 3. Draw Writing Trajectory Panels (Overlay/Separate Windows)
-    DrawTrajectoryPanel(app);
-    DrawSegmentEditorPanel(app);
-    DrawDefensePanel(app);
+    {
+        infrastructure::ProfileZone zone("WritingPanels");
+        DrawTrajectoryPanel(app);
+        DrawSegmentEditorPanel(app);
+        DrawDefensePanel(app);
+    }
+
+    // 4. Diagnostics overlay (not timed itself)
+    DrawProfilerPanel(app);
 }
 
 } // namespace ideawalker::ui
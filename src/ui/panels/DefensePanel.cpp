@@ -42,7 +42,7 @@ void DrawDefensePanel(AppState& state) {
             return;
         }
 
-        auto trajPtr = state.services.writingTrajectoryService->getTrajectory(state.ui.activeTrajectoryId);
+        auto trajPtr = state.services.writingTrajectoryService->getLiveTrajectory(state.ui.activeTrajectoryId);
         if (!trajPtr) {
             ImGui::Text("Trajectory not found.");
             ImGui::End();
@@ -584,6 +584,7 @@ void DrawDocOpsTab(AppState& app) {
             app.services.conversationService->startSession(fallback);
             app.ui.selectedFilename = fallback.activeNoteId;
             app.ui.selectedNoteContent = fallback.activeNoteContent;
+            ++app.ui.selectedNoteRevision;
             docopsSessionStatus = "fallback:" + fallback.activeNoteId;
             {
                 std::lock_guard<std::mutex> lock(outputMutex);
@@ -599,6 +600,7 @@ void DrawDocOpsTab(AppState& app) {
                 app.services.conversationService->startSession(fallback);
                 app.ui.selectedFilename = fallback.activeNoteId;
                 app.ui.selectedNoteContent = fallback.activeNoteContent;
+                ++app.ui.selectedNoteRevision;
                 docopsSessionStatus = "fallback-read-error:" + fallback.activeNoteId;
                 {
                     std::lock_guard<std::mutex> lock(outputMutex);
@@ -619,6 +621,7 @@ void DrawDocOpsTab(AppState& app) {
                 app.services.conversationService->startSession(bundle);
                 app.ui.selectedFilename = noteId;
                 app.ui.selectedNoteContent = fileContent;
+                ++app.ui.selectedNoteRevision;
                 docopsSessionStatus = "file:" + noteId;
                 {
                     std::lock_guard<std::mutex> lock(outputMutex);
@@ -71,6 +71,7 @@ void DrawExecutionTab(AppState& app) {
                         if (TaskCard(itemId.c_str(), actionables[i].description, cardWidth)) {
                             app.ui.selectedFilename = insight->getMetadata().id;
                             app.ui.selectedNoteContent = insight->getContent();
+                            ++app.ui.selectedNoteRevision;
 
                             domain::Insight::Metadata meta;
                             meta.id = app.ui.selectedFilename;
@@ -82,6 +83,7 @@ void DrawExecutionTab(AppState& app) {
                             app.ui.showTaskDetails = true;
                             app.ui.selectedTaskTitle = "Detalhes da Tarefa";
                             app.ui.selectedTaskContent = actionables[i].description;
+                            ++app.ui.selectedTaskRevision;
                             app.ui.selectedTaskOrigin = insight->getMetadata().id;
                         }
 
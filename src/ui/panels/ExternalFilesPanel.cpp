@@ -45,11 +45,12 @@ void DrawExternalFilesTab(AppState& app) {
 
                         if (app.ui.previewMode) {
                             ImGui::BeginChild("ExtPreview", ImVec2(0, -10), true);
-                            DrawMarkdownPreview(app, file.content, true);
+                            DrawMarkdownPreview(app, file.preview, file.content, file.revision, true);
                             ImGui::EndChild();
                         } else {
                             if (InputTextMultilineString("##exteditor", &file.content, ImVec2(-FLT_MIN, -10))) {
                                 file.modified = true;
+                                ++file.revision;
                             }
                         }
                         
@@ -1,41 +1,258 @@
 #include "ui/panels/MainPanels.hpp"
 #include "application/KnowledgeService.hpp"
+#include "infrastructure/FrameProfiler.hpp"
 #include "imgui.h"
 #include "imnodes.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
 #include <unordered_set>
+#include <vector>
 
 namespace ideawalker::ui {
 
+namespace {
+
+using application::GraphDetail;
+
+struct NodeColors {
+    ImU32 background;
+    ImU32 titleBar;
+};
+
+NodeColors ColorsFor(const GraphNode& node) {
+    switch (node.type) {
+    case NodeType::TASK:
+        return {IM_COL32(50, 50, 50, 255), node.isCompleted ? IM_COL32(46, 125, 50, 200) : IM_COL32(230, 81, 0, 200)};
+    case NodeType::CONCEPT: // Dark Purple for Concepts
+        return {IM_COL32(40, 30, 60, 255), IM_COL32(100, 60, 150, 200)};
+    case NodeType::HYPOTHESIS: // Cyan/Teal for Hypotheses
+        return {IM_COL32(0, 50, 50, 255), IM_COL32(0, 150, 150, 200)};
+    default:
+        return {ImNodes::GetStyle().Colors[ImNodesCol_NodeBackground], ImNodes::GetStyle().Colors[ImNodesCol_TitleBar]};
+    }
+}
+
+/** Node size in grid units (ImNodes measurement from the last frame it was submitted, or the default). */
+ImVec2 NodeSize(const GraphNode& node, const application::GraphLodConfig& lod) {
+    return ImVec2(node.w > 0.0f ? node.w : lod.defaultNodeWidth, node.h > 0.0f ? node.h : lod.defaultNodeHeight);
+}
+
+bool SegmentVisible(const ImVec2& a, const ImVec2& b, const ImVec2& size) {
+    return std::max(a.x, b.x) >= 0.0f && std::min(a.x, b.x) <= size.x &&
+           std::max(a.y, b.y) >= 0.0f && std::min(a.y, b.y) <= size.y;
+}
+
+/** All links in one pass through the draw list (one draw call, no ImNodes link objects). */
+void DrawLinks(AppState& app, ImDrawList* drawList, const ImVec2& origin, const ImVec2& size, bool curved) {
+    auto& web = app.neuralWeb;
+    const auto& camera = web.camera;
+    const ImU32 color = ImNodes::GetStyle().Colors[ImNodesCol_Link];
+    const float thickness = std::max(1.0f, ImNodes::GetStyle().LinkThickness * camera.zoom);
+
+    for (const auto& link : web.links) {
+        const int a = web.viewport.indexOf(link.startNode);
+        const int b = web.viewport.indexOf(link.endNode);
+        if (a < 0 || b < 0) continue;
+        const GraphNode& from = web.nodes[a];
+        const GraphNode& to = web.nodes[b];
+        const ImVec2 fromSize = NodeSize(from, web.lod);
+        const ImVec2 toSize = NodeSize(to, web.lod);
+        // Output on the right edge, input on the left edge, both at mid height.
+        const ImVec2 p1(camera.toCanvasX(from.x + fromSize.x), camera.toCanvasY(from.y + fromSize.y * 0.5f));
+        const ImVec2 p2(camera.toCanvasX(to.x), camera.toCanvasY(to.y + toSize.y * 0.5f));
+        if (!SegmentVisible(p1, p2, size)) continue;
+
+        const ImVec2 s1(origin.x + p1.x, origin.y + p1.y);
+        const ImVec2 s2(origin.x + p2.x, origin.y + p2.y);
+        if (curved) {
+            const float dx = std::min(std::fabs(s2.x - s1.x) * 0.5f, 80.0f) + 10.0f;
+            drawList->AddBezierCubic(s1, ImVec2(s1.x + dx, s1.y), ImVec2(s2.x - dx, s2.y), s2, color, thickness, 12);
+        } else {
+            drawList->AddLine(s1, s2, color, thickness);
+        }
+    }
+}
+
+/** Titles/Dots levels: drawn straight into the draw list, clustered when dots get dense. */
+void DrawGraphOverview(AppState& app, GraphDetail detail) {
+    auto& web = app.neuralWeb;
+    auto& camera = web.camera;
+    ImGuiIO& io = ImGui::GetIO();
+
+    ImGui::BeginChild("##NeuralWebOverview", ImVec2(0, 0), false,
+                      ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoScrollWithMouse | ImGuiWindowFlags_NoMove);
+    const ImVec2 origin = ImGui::GetCursorScreenPos();
+    const ImVec2 size = ImGui::GetContentRegionAvail();
+    ImGui::InvisibleButton("##canvas", ImVec2(std::max(size.x, 1.0f), std::max(size.y, 1.0f)),
+                           ImGuiButtonFlags_MouseButtonLeft | ImGuiButtonFlags_MouseButtonMiddle);
+    const bool hovered = ImGui::IsItemHovered();
+    if (ImGui::IsItemActive() && (ImGui::IsMouseDragging(ImGuiMouseButton_Left) || ImGui::IsMouseDragging(ImGuiMouseButton_Middle))) {
+        camera.panX += io.MouseDelta.x;
+        camera.panY += io.MouseDelta.y;
+    }
+    const ImVec2 mouse(io.MousePos.x - origin.x, io.MousePos.y - origin.y);
+    if (hovered && io.MouseWheel != 0.0f) {
+        camera.zoomAt(std::pow(1.15f, io.MouseWheel), mouse.x, mouse.y);
+    }
+    if (hovered && ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left)) {
+        camera.zoomAt(2.0f, mouse.x, mouse.y);
+    }
+
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    drawList->AddRectFilled(origin, ImVec2(origin.x + size.x, origin.y + size.y),
+                            ImNodes::GetStyle().Colors[ImNodesCol_GridBackground]);
+    drawList->PushClipRect(origin, ImVec2(origin.x + size.x, origin.y + size.y), true);
+
+    web.viewport.update(web.nodes, camera, size.x, size.y, web.lod);
+    const GraphNode* hoveredNode = nullptr;
+
+    if (detail == GraphDetail::Titles) {
+        DrawLinks(app, drawList, origin, size, false);
+        ImFont* font = ImGui::GetFont();
+        const float fontSize = ImGui::GetFontSize() * camera.zoom;
+        for (std::uint32_t index : web.viewport.visible()) {
+            const GraphNode& node = web.nodes[index];
+            const ImVec2 nodeSize = NodeSize(node, web.lod);
+            const ImVec2 min(origin.x + camera.toCanvasX(node.x), origin.y + camera.toCanvasY(node.y));
+            const ImVec2 max(min.x + nodeSize.x * camera.zoom, min.y + nodeSize.y * camera.zoom);
+            const NodeColors colors = ColorsFor(node);
+            drawList->AddRectFilled(min, max, colors.background, 4.0f * camera.zoom);
+            drawList->AddRectFilled(min, ImVec2(max.x, std::min(max.y, min.y + fontSize * 1.6f)), colors.titleBar, 4.0f * camera.zoom);
+            drawList->AddText(font, fontSize, ImVec2(min.x + 4.0f * camera.zoom, min.y + 2.0f * camera.zoom),
+                              ImGui::GetColorU32(ImGuiCol_Text), node.title.c_str(), nullptr, (node.wrapW - 30.0f) * camera.zoom);
+            if (hovered && io.MousePos.x >= min.x && io.MousePos.x < max.x && io.MousePos.y >= min.y && io.MousePos.y < max.y) {
+                hoveredNode = &node;
+            }
+        }
+    } else {
+        const auto& clusters = web.viewport.cluster(web.nodes, camera, web.lod);
+
+        // Links between items (clusters collapse parallel links into one).
+        const ImU32 linkColor = ImNodes::GetStyle().Colors[ImNodesCol_Link];
+        std::unordered_set<std::uint64_t> drawn;
+        for (const auto& link : web.links) {
+            const int a = web.viewport.indexOf(link.startNode);
+            const int b = web.viewport.indexOf(link.endNode);
+            if (a < 0 || b < 0) continue;
+            const int ca = web.viewport.clusterOf(static_cast<std::uint32_t>(a));
+            const int cb = web.viewport.clusterOf(static_cast<std::uint32_t>(b));
+            if (ca >= 0 && ca == cb) continue;
+            const ImVec2 p1 = ca >= 0 ? ImVec2(clusters[ca].x, clusters[ca].y)
+                                      : ImVec2(camera.toCanvasX(web.nodes[a].x), camera.toCanvasY(web.nodes[a].y));
+            const ImVec2 p2 = cb >= 0 ? ImVec2(clusters[cb].x, clusters[cb].y)
+                                      : ImVec2(camera.toCanvasX(web.nodes[b].x), camera.toCanvasY(web.nodes[b].y));
+            if (!SegmentVisible(p1, p2, size)) continue;
+            if (ca >= 0 && cb >= 0) {
+                const auto key = (static_cast<std::uint64_t>(std::min(ca, cb)) << 32) | static_cast<std::uint32_t>(std::max(ca, cb));
+                if (!drawn.insert(key).second) continue;
+            }
+            drawList->AddLine(ImVec2(origin.x + p1.x, origin.y + p1.y), ImVec2(origin.x + p2.x, origin.y + p2.y), linkColor, 1.0f);
+        }
+
+        for (const auto& item : clusters) {
+            const ImVec2 center(origin.x + item.x, origin.y + item.y);
+            const GraphNode& node = web.nodes[item.node];
+            if (item.count == 1) {
+                drawList->AddCircleFilled(center, 4.0f, ColorsFor(node).titleBar, 8);
+                const float dx = io.MousePos.x - center.x, dy = io.MousePos.y - center.y;
+                if (hovered && dx * dx + dy * dy <= 36.0f) hoveredNode = &node;
+                continue;
+            }
+            // Super-node: area grows with the number of merged nodes.
+            const float radius = 6.0f + 2.0f * std::sqrt(static_cast<float>(item.count));
+            drawList->AddCircleFilled(center, radius, IM_COL32(90, 110, 160, 220), 16);
+            drawList->AddCircle(center, radius, IM_COL32(200, 210, 240, 255), 16, 1.0f);
+            if (radius >= 10.0f) {
+                char label[16];
+                std::snprintf(label, sizeof(label), "%u", item.count);
+                const ImVec2 textSize = ImGui::CalcTextSize(label);
+                drawList->AddText(ImVec2(center.x - textSize.x * 0.5f, center.y - textSize.y * 0.5f),
+                                  IM_COL32(255, 255, 255, 255), label);
+            }
+        }
+    }
+
+    drawList->PopClipRect();
+    if (hoveredNode) ImGui::SetTooltip("%s", hoveredNode->title.c_str());
+    ImGui::EndChild();
+}
+
+} // namespace
+
 void DrawNodeGraph(AppState& app) {
-    auto label = [&app](const char* withEmoji, const char* plain) {
-        return app.ui.emojiEnabled ? withEmoji : plain;
-    };
-    ImNodes::EditorContextSet((ImNodesEditorContext*)app.neuralWeb.mainContext);
+    infrastructure::ProfileZone zone("DrawNodeGraph");
+    auto& web = app.neuralWeb;
+    ImNodes::EditorContextSet((ImNodesEditorContext*)web.mainContext);
+
+    // 0. Physics step (selected nodes are pinned; a settled layout costs nothing)
+    std::unordered_set<int> selectedNodes;
+    if (!web.overview) {
+        if (const int numSelected = ImNodes::NumSelectedNodes(); numSelected > 0) {
+            std::vector<int> selectedIds(numSelected);
+            ImNodes::GetSelectedNodes(selectedIds.data());
+            selectedNodes.insert(selectedIds.begin(), selectedIds.end());
+        }
+    }
+    bool moved = web.physicsEnabled && app.UpdateGraphPhysics(selectedNodes);
+    bool pushPositions = moved || !web.initialized;
+    web.initialized = true;
+
+    // 1. Level of detail: below zoom 1 the overview renderer takes over from ImNodes.
+    const GraphDetail detail = application::SelectDetail(web.camera.zoom, ImGui::GetFontSize(), web.lod);
+    if (detail != GraphDetail::Full) {
+        web.overview = true;
+        web.submittedNodes.clear(); // ImNodes drops nodes it does not see; re-place them on return
+        DrawGraphOverview(app, detail);
+        return;
+    }
+    if (web.overview) {
+        ImNodes::EditorContextResetPanning(ImVec2(web.camera.panX, web.camera.panY));
+        ImNodes::ClearNodeSelection();
+        web.overview = false;
+    }
+    const ImVec2 panning = ImNodes::EditorContextGetPanning();
+    web.camera.panX = panning.x;
+    web.camera.panY = panning.y;
+
+    // 2. Cull against the editor canvas (it fills the remaining content region).
+    const ImVec2 canvasSize = ImGui::GetContentRegionAvail();
+    web.viewport.update(web.nodes, web.camera, canvasSize.x, canvasSize.y, web.lod);
+
     ImNodes::BeginNodeEditor();
+    const ImVec2 origin = ImGui::GetCursorScreenPos();
 
-    // 1. Draw Nodes
-    for (auto& node : app.neuralWeb.nodes) {
-        // Set position for physics, but skip if currently selected (let user drag)
-        if (app.neuralWeb.physicsEnabled && !ImNodes::IsNodeSelected(node.id)) {
-            ImNodes::SetNodeGridSpacePos(node.id, ImVec2(node.x, node.y));
+    // 3. Links go through the canvas draw list, under the nodes.
+    DrawLinks(app, ImGui::GetWindowDrawList(), origin, canvasSize, true);
+
+    // 4. Nodes: visible ones, plus anything selected so drags survive leaving the screen.
+    std::vector<std::uint32_t> submit = web.viewport.visible();
+    for (int id : selectedNodes) {
+        const int index = web.viewport.indexOf(id);
+        if (index >= 0 && !web.viewport.isVisible(static_cast<std::uint32_t>(index))) {
+            submit.push_back(static_cast<std::uint32_t>(index));
         }
+    }
 
-        bool isTask = (node.type == NodeType::TASK);
-        bool isConcept = (node.type == NodeType::CONCEPT);
-        bool isHypothesis = (node.type == NodeType::HYPOTHESIS);
+    std::unordered_set<int> submitted;
+    submitted.reserve(submit.size());
+    for (std::uint32_t index : submit) {
+        GraphNode& node = web.nodes[index];
+        submitted.insert(node.id);
 
-        if (isTask) {
-            ImNodes::PushColorStyle(ImNodesCol_NodeBackground, IM_COL32(50, 50, 50, 255));
-            ImNodes::PushColorStyle(ImNodesCol_TitleBar, 
-                node.isCompleted ? IM_COL32(46, 125, 50, 200) : IM_COL32(230, 81, 0, 200));
-        } else if (isConcept) {
-             // Dark Purple for Concepts
-             ImNodes::PushColorStyle(ImNodesCol_NodeBackground, IM_COL32(40, 30, 60, 255));
-             ImNodes::PushColorStyle(ImNodesCol_TitleBar, IM_COL32(100, 60, 150, 200));
-        } else if (isHypothesis) {
-             // Cyan/Teal for Hypotheses
-             ImNodes::PushColorStyle(ImNodesCol_NodeBackground, IM_COL32(0, 50, 50, 255));
-             ImNodes::PushColorStyle(ImNodesCol_TitleBar, IM_COL32(0, 150, 150, 200));
+        // Set position for physics (and for nodes ImNodes has not seen recently), but let the user drag.
+        const bool wasSubmitted = web.submittedNodes.count(node.id) > 0;
+        if ((pushPositions || !wasSubmitted) && !selectedNodes.count(node.id)) {
+            ImNodes::SetNodeGridSpacePos(node.id, ImVec2(node.x, node.y));
+        }
+
+        const bool isTask = (node.type == NodeType::TASK);
+        const bool isHypothesis = (node.type == NodeType::HYPOTHESIS);
+        const bool styled = (node.type != NodeType::INSIGHT);
+        if (styled) {
+            const NodeColors colors = ColorsFor(node);
+            ImNodes::PushColorStyle(ImNodesCol_NodeBackground, colors.background);
+            ImNodes::PushColorStyle(ImNodesCol_TitleBar, colors.titleBar);
         }
 
         ImNodes::BeginNode(node.id);
@@ -57,33 +274,22 @@ void DrawNodeGraph(AppState& app) {
         ImGui::PopTextWrapPos();
         ImNodes::EndNodeTitleBar();
 
-        ImNodes::BeginOutputAttribute(node.id << 8); 
-        ImGui::Dummy(ImVec2(10, 0));
-        ImNodes::EndOutputAttribute();
-
-        ImNodes::BeginInputAttribute((node.id << 8) + 1);
-        ImGui::Dummy(ImVec2(10, 0));
-        ImNodes::EndInputAttribute();
-
         ImNodes::EndNode();
 
-        if (isTask || isConcept || isHypothesis) {
+        if (styled) {
             ImNodes::PopColorStyle();
             ImNodes::PopColorStyle();
         }
     }
 
-    // 2. Draw Links
-    for (const auto& link : app.neuralWeb.links) {
-        int startAttr = (link.startNode << 8);
-        int endAttr = (link.endNode << 8) + 1;
-        ImNodes::Link(link.id, startAttr, endAttr);
-    }
-
     ImNodes::EndNodeEditor();
 
-    // 3. Sync User Dragging back to AppState
-    for (auto& node : app.neuralWeb.nodes) {
+    // 5. Measure submitted nodes (culling and link anchors) and sync user dragging back to AppState
+    for (std::uint32_t index : submit) {
+        GraphNode& node = web.nodes[index];
+        const ImVec2 dims = ImNodes::GetNodeDimensions(node.id);
+        node.w = dims.x;
+        node.h = dims.y;
         if (ImNodes::IsNodeSelected(node.id)) {
             ImVec2 pos = ImNodes::GetNodeGridSpacePos(node.id);
             node.x = pos.x;
@@ -92,6 +298,13 @@ void DrawNodeGraph(AppState& app) {
             node.vy = 0;
         }
     }
+    web.submittedNodes.swap(submitted);
+
+    // 6. Wheel zooms out into the overview (ImNodes itself has no zoom).
+    ImGuiIO& io = ImGui::GetIO();
+    if (ImNodes::IsEditorHovered() && io.MouseWheel < 0.0f) {
+        web.camera.zoomAt(std::pow(1.15f, io.MouseWheel), io.MousePos.x - origin.x, io.MousePos.y - origin.y);
+    }
 }
 
 void DrawGraphTab(AppState& app) {
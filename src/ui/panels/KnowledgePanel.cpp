@@ -34,14 +34,25 @@ void DrawKnowledgeTab(AppState& app) {
                 ImGui::SameLine();
                 ImGui::Checkbox("Modo Preview", &app.ui.unifiedPreviewMode);
 
-                ImGui::BeginChild("UnifiedKnowledge", ImVec2(0, 0), true);
-                if (app.ui.unifiedKnowledge.empty()) {
+                if (!app.ui.unifiedPreviewMode) {
+                    ImGui::SameLine();
+                    if (ImGui::SmallButton("Copiar tudo")) {
+                        ImGui::SetClipboardText(app.ui.unifiedKnowledge.assemble(app.project.allInsights).c_str());
+                    }
+                }
+
+                // Both modes draw only the visible part of the text (no giant InputText buffer).
+                ImGui::BeginChild("UnifiedKnowledge", ImVec2(0, 0), true,
+                                  app.ui.unifiedPreviewMode ? 0 : ImGuiWindowFlags_HorizontalScrollbar);
+                if (app.project.allInsights.empty()) {
                     ImGui::TextDisabled("Nenhum insight disponivel.");
                 } else {
+                    const auto& pieces = app.ui.unifiedKnowledge.pieces(app.project.allInsights);
+                    const auto revision = app.ui.unifiedKnowledge.revision();
                     if (app.ui.unifiedPreviewMode) {
-                            DrawMarkdownPreview(app, app.ui.unifiedKnowledge, false);
+                            DrawMarkdownPreview(app, app.ui.unifiedPreview, pieces, revision, false);
                     } else {
-                            InputTextMultilineString("##unifiedRaw", &app.ui.unifiedKnowledge, ImVec2(-FLT_MIN, -FLT_MIN), ImGuiInputTextFlags_ReadOnly);
+                            DrawTextLines(app.ui.unifiedPreview, pieces, revision);
                     }
                 }
                 ImGui::EndChild();
@@ -73,6 +84,7 @@ void DrawKnowledgeTab(AppState& app) {
                         if (ImGui::Selectable((filename + "###selectable").c_str(), isSelected)) {
                             app.ui.selectedFilename = filename;
                             app.ui.selectedNoteContent = insight.getContent();
+                            ++app.ui.selectedNoteRevision;
                             std::snprintf(app.ui.saveAsFilename, sizeof(app.ui.saveAsFilename), "%s", filename.c_str());
 
                             // Update Domain Insight
@@ -99,7 +111,7 @@ void DrawKnowledgeTab(AppState& app) {
                     if (ImGui::Button(label("💾 Save Changes", "Save Changes"), ImVec2(150, 30))) {
                         app.services.knowledgeService->UpdateNote(app.ui.selectedFilename, app.ui.selectedNoteContent);
                         app.AppendLog("[SYSTEM] Saved changes to " + app.ui.selectedFilename + "\n");
-                        app.RefreshAllInsights();
+                        app.RefreshInsight(app.ui.selectedFilename);
                     }
                     ImGui::SameLine();
 
@@ -115,7 +127,7 @@ void DrawKnowledgeTab(AppState& app) {
                             app.services.knowledgeService->UpdateNote(newName, app.ui.selectedNoteContent);
                             app.ui.selectedFilename = newName;
                             app.AppendLog("[SYSTEM] Saved as " + newName + "\n");
-                            app.RefreshAllInsights();
+                            app.RefreshInsight(newName);
                         }
                     }
 
@@ -136,11 +148,12 @@ void DrawKnowledgeTab(AppState& app) {
 
                     if (app.ui.previewMode) {
                         ImGui::BeginChild("PreviewScroll", ImVec2(0, -200), true);
-                        DrawMarkdownPreview(app, app.ui.selectedNoteContent, false);
+                        DrawMarkdownPreview(app, app.ui.notePreview, app.ui.selectedNoteContent, app.ui.selectedNoteRevision, false);
                         ImGui::EndChild();
                     } else {
                         // Editor de texto (InputTextMultiline com Resize)
                         if (InputTextMultilineString("##editor", &app.ui.selectedNoteContent, ImVec2(-FLT_MIN, -200))) {
+                            ++app.ui.selectedNoteRevision;
                             if (app.project.currentInsight) {
                                 app.project.currentInsight->setContent(app.ui.selectedNoteContent);
                                 app.project.currentInsight->parseActionablesFromContent();
@@ -159,6 +172,7 @@ void DrawKnowledgeTab(AppState& app) {
                                 app.ui.selectedFilename = link;
                                 if (app.services.knowledgeService) {
                                     app.ui.selectedNoteContent = app.services.knowledgeService->GetNoteContent(link);
+                                    ++app.ui.selectedNoteRevision;
                                     std::snprintf(app.ui.saveAsFilename, sizeof(app.ui.saveAsFilename), "%s", link.c_str());
                                     
                                     domain::Insight::Metadata meta;
@@ -186,6 +200,7 @@ void DrawKnowledgeTab(AppState& app) {
                             std::string sugLabel = sug.targetId + " (" + (sug.reasons.empty() ? "" : sug.reasons[0].evidence) + ")";
                             if (ImGui::Button(sugLabel.c_str())) {
                                 app.ui.selectedNoteContent += "\n\n[[" + sug.targetId + "]]";
+                                ++app.ui.selectedNoteRevision;
                                 if (app.project.currentInsight) {
                                     app.project.currentInsight->setContent(app.ui.selectedNoteContent);
                                     // Auto-save to disk to ensure backlinks are detectable immediately
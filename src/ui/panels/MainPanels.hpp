@@ -30,4 +30,7 @@ void DrawMenuBar(AppState& app);
 void DrawWorkspace(AppState& app);
 void DrawMainWindow(AppState& app);
 
+// Diagnostics
+void DrawProfilerPanel(AppState& app);
+
 } // namespace ideawalker::ui
@@ -64,6 +64,10 @@ void DrawMenuBar(AppState& app) {
             if (ImGui::MenuItem("Segment Editor", nullptr, app.ui.showSegmentEditor)) {
                  app.ui.showSegmentEditor = !app.ui.showSegmentEditor;
             }
+            ImGui::Separator();
+            if (ImGui::MenuItem("Frame Profiler", nullptr, app.ui.showProfiler)) {
+                 app.ui.showProfiler = !app.ui.showProfiler;
+            }
             ImGui::EndMenu();
         }
 
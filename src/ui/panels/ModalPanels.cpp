@@ -230,7 +230,7 @@ void DrawTaskDetailsModal(AppState& app) {
         ImGui::Separator();
 
         ImGui::BeginChild("TaskContent", ImVec2(0, 200), true);
-        DrawMarkdownPreview(app, app.ui.selectedTaskContent, false);
+        DrawMarkdownPreview(app, app.ui.taskPreview, app.ui.selectedTaskContent, app.ui.selectedTaskRevision, false);
         ImGui::EndChild();
 
         ImGui::Spacing();
@@ -292,6 +292,8 @@ void DrawHelpModal(AppState& app) {
 
     if (ImGui::BeginPopupModal("Help & Documentation", &app.ui.showHelp, ImGuiWindowFlags_NoCollapse)) {
         static std::string helpContent;
+        static std::uint64_t helpRevision = 0;
+        static application::MarkdownPreview helpPreview;
         static std::string lastLoadedFile;
 
         struct HelpDoc { std::string name; std::string path; };
@@ -310,6 +312,7 @@ void DrawHelpModal(AppState& app) {
                 std::stringstream ss;
                 ss << f.rdbuf();
                 helpContent = ss.str();
+                ++helpRevision;
             }
         }
 
@@ -324,8 +327,10 @@ void DrawHelpModal(AppState& app) {
                     std::stringstream ss;
                     ss << f.rdbuf();
                     helpContent = ss.str();
+                    ++helpRevision;
                 } else {
                     helpContent = "Não foi possível carregar: " + doc.path;
+                    ++helpRevision;
                 }
             }
         }
@@ -335,7 +340,7 @@ void DrawHelpModal(AppState& app) {
         if (helpContent.empty()) {
             ImGui::Text("Select a document to read.");
         } else {
-            DrawMarkdownPreview(app, helpContent, false);
+            DrawMarkdownPreview(app, helpPreview, helpContent, helpRevision, false);
         }
         ImGui::EndChild();
 
@@ -420,7 +425,7 @@ void DrawHistoryModal(AppState& app) {
             if (ImGui::Button("Restaurar esta versao")) {
                 app.services.knowledgeService->UpdateNote(app.ui.selectedNoteIdForHistory, app.ui.selectedHistoryContent);
                 app.AppendLog("[SYSTEM] Versao restaurada: " + app.ui.selectedNoteIdForHistory + "\n");
-                app.RefreshAllInsights();
+                app.RefreshInsight(app.ui.selectedNoteIdForHistory);
                 app.LoadHistory(app.ui.selectedNoteIdForHistory);
             }
             ImGui::SameLine();
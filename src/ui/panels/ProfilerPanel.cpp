@@ -0,0 +1,112 @@
+#include "ui/panels/MainPanels.hpp"
+#include "infrastructure/FrameProfiler.hpp"
+#include "imgui.h"
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <filesystem>
+
+namespace ideawalker::ui {
+
+namespace {
+
+std::string TracePath(const AppState& app) {
+    const std::time_t now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    char stamp[32];
+    std::strftime(stamp, sizeof(stamp), "%Y%m%d_%H%M%S", std::localtime(&now));
+    const std::filesystem::path dir = app.project.root.empty() ? std::filesystem::current_path()
+                                                               : std::filesystem::path(app.project.root);
+    return (dir / ("ideawalker_trace_" + std::string(stamp) + ".json")).string();
+}
+
+} // namespace
+
+void DrawProfilerPanel(AppState& app) {
+    auto& profiler = infrastructure::FrameProfiler::Instance();
+    // Zones only record while someone looks at them (or a trace is being captured).
+    profiler.setEnabled(app.ui.showProfiler || profiler.capturing());
+    if (!app.ui.showProfiler) return;
+
+    ImGui::SetNextWindowSize(ImVec2(640, 480), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("Frame Profiler", &app.ui.showProfiler)) {
+        ImGui::End();
+        return;
+    }
+
+    const std::vector<float> frames = profiler.frameHistory();
+    if (!frames.empty()) {
+        float sum = 0.0f, worst = 0.0f;
+        for (float ms : frames) {
+            sum += ms;
+            worst = std::max(worst, ms);
+        }
+        const float avg = sum / static_cast<float>(frames.size());
+        ImGui::Text("Frame: %.2f ms (média %.2f, máx %.2f) | %.0f FPS", frames.back(), avg, worst,
+                    avg > 0.0f ? 1000.0f / avg : 0.0f);
+        ImGui::PlotLines("##frames", frames.data(), static_cast<int>(frames.size()), 0, nullptr,
+                         0.0f, std::max(33.3f, worst), ImVec2(-1, 60));
+    }
+
+    if (profiler.capturing()) {
+        if (ImGui::Button("Parar captura")) profiler.stopCapture();
+        ImGui::SameLine();
+        ImGui::TextDisabled("%zu eventos", profiler.capturedEvents());
+    } else if (ImGui::Button("Iniciar captura")) {
+        profiler.startCapture();
+        app.ui.profilerStatus.clear();
+    }
+    ImGui::SameLine();
+    ImGui::BeginDisabled(profiler.capturing() || profiler.capturedEvents() == 0);
+    if (ImGui::Button("Exportar trace (Chrome)")) {
+        const std::string path = TracePath(app);
+        app.ui.profilerStatus = profiler.exportChromeTrace(path) ? "Trace salvo em " + path
+                                                                 : "Falha ao salvar " + path;
+    }
+    ImGui::EndDisabled();
+    ImGui::SameLine();
+    if (ImGui::Button("Limpar")) {
+        profiler.reset();
+        app.ui.profilerStatus.clear();
+    }
+    if (!app.ui.profilerStatus.empty()) ImGui::TextWrapped("%s", app.ui.profilerStatus.c_str());
+    if (const auto dropped = profiler.droppedEvents()) {
+        ImGui::TextDisabled("Eventos descartados (buffer cheio): %llu", static_cast<unsigned long long>(dropped));
+    }
+    ImGui::Separator();
+
+    const auto zones = profiler.zones();
+    const ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY;
+    if (ImGui::BeginTable("ProfilerZones", 6, flags)) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Zona", ImGuiTableColumnFlags_WidthFixed, 200.0f);
+        ImGui::TableSetupColumn("Último (ms)", ImGuiTableColumnFlags_WidthFixed, 80.0f);
+        ImGui::TableSetupColumn("Média", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+        ImGui::TableSetupColumn("Máx", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+        ImGui::TableSetupColumn("Chamadas", ImGuiTableColumnFlags_WidthFixed, 64.0f);
+        ImGui::TableSetupColumn("Histórico", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableHeadersRow();
+        for (const auto& zone : zones) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(zone.name.c_str());
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", zone.lastMs);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", zone.avgMs);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", zone.maxMs);
+            ImGui::TableNextColumn();
+            ImGui::Text("%u", zone.lastCalls);
+            ImGui::TableNextColumn();
+            ImGui::PushID(zone.name.c_str());
+            ImGui::PlotLines("##history", zone.history.data(), static_cast<int>(zone.history.size()), 0, nullptr,
+                             0.0f, std::max(1.0f, zone.maxMs), ImVec2(-1, 24));
+            ImGui::PopID();
+        }
+        ImGui::EndTable();
+    }
+
+    ImGui::End();
+}
+
+} // namespace ideawalker::ui
@@ -67,6 +67,16 @@ void DrawScientificTab(AppState& app) {
             }
         }
         if (!hasSelection) ImGui::EndDisabled();
+        ImGui::SameLine();
+        if (ImGui::Button("Rebuild Indexes")) {
+            app.AppendLog("[SCIENTIFIC] Rebuilding ingestion catalog and STRATA manifest (full scan)...\n");
+            app.services.taskManager->SubmitTask(application::TaskType::Indexing, "Reconstrução dos Índices Científicos", [&app](std::shared_ptr<application::TaskStatus>) {
+                const size_t bundles = app.services.scientificIngestionService->rebuildIngestionCatalog();
+                const size_t articles = app.services.scientificIngestionService->rebuildGlobalManifest();
+                app.AppendLog("[SCIENTIFIC] Indexes rebuilt: " + std::to_string(bundles) + " bundles, " +
+                              std::to_string(articles) + " STRATA articles.\n");
+            });
+        }
 
         ImGui::Separator();
 
@@ -118,6 +128,7 @@ void DrawScientificTab(AppState& app) {
         ImGui::Separator();
 
         ImGui::Text("Bundles Generated: %zu", app.services.scientificIngestionService->getBundlesCount());
+        ImGui::Text("Exported to STRATA: %zu", app.services.scientificIngestionService->getExportedCount());
         
         if (auto summary = app.services.scientificIngestionService->getLatestValidationSummary()) {
             ImGui::Spacing();
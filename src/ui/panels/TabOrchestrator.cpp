@@ -1,18 +1,20 @@
 #include "ui/panels/MainPanels.hpp"
 #include "ui/ConversationPanel.hpp"
+#include "infrastructure/FrameProfiler.hpp"
 #include "imgui.h"
 
 namespace ideawalker::ui {
 
 void DrawMainTabs(AppState& app) {
     if (ImGui::BeginTabBar("MyTabs")) {
-        DrawDashboardTab(app);
-        DrawKnowledgeTab(app);
-        DrawExecutionTab(app);
-        DrawGraphTab(app);
-        DrawScientificTab(app);
-        DrawDocOpsTab(app);
-        DrawExternalFilesTab(app);
+        // Only the selected tab draws its content; the others cost a BeginTabItem.
+        { infrastructure::ProfileZone zone("Tab.Dashboard"); DrawDashboardTab(app); }
+        { infrastructure::ProfileZone zone("Tab.Knowledge"); DrawKnowledgeTab(app); }
+        { infrastructure::ProfileZone zone("Tab.Execution"); DrawExecutionTab(app); }
+        { infrastructure::ProfileZone zone("Tab.Graph"); DrawGraphTab(app); }
+        { infrastructure::ProfileZone zone("Tab.Scientific"); DrawScientificTab(app); }
+        { infrastructure::ProfileZone zone("Tab.DocOps"); DrawDocOpsTab(app); }
+        { infrastructure::ProfileZone zone("Tab.ExternalFiles"); DrawExternalFilesTab(app); }
         ImGui::EndTabBar();
     }
 }
@@ -49,6 +51,7 @@ void DrawWorkspace(AppState& app) {
         }
 
         ImGui::BeginChild("ConversationDock", ImVec2(0, 0), true);
+        infrastructure::ProfileZone zone("ConversationPanel");
         ConversationPanel::DrawContent(app);
         ImGui::EndChild();
     }
@@ -48,22 +48,29 @@ void DrawTrajectoryPanel(AppState& state) {
     if (ImGui::Button("New Trajectory")) {
         ImGui::OpenPopup("CreateTrajectoryPopup");
     }
+    ImGui::SameLine();
+    if (ImGui::Button("Refresh") && state.services.writingTrajectoryService) {
+        state.services.writingTrajectoryService->refreshCache(); // Picks up logs written by other instances
+    }
 
     ImGui::Separator();
 
     if (state.services.writingTrajectoryService) {
-        auto trajectories = state.services.writingTrajectoryService->getAllTrajectories();
+        // Cached summaries: no filesystem access per frame
+        auto trajectories = state.services.writingTrajectoryService->listTrajectories();
         
         for (const auto& traj : trajectories) {
-            std::string label = traj.getIntent().purpose + " (" + StageToString(traj.getStage()) + ")";
-            if (ImGui::Selectable(label.c_str(), state.ui.activeTrajectoryId == traj.getId())) {
-                state.ui.activeTrajectoryId = traj.getId();
+            std::string label = traj.intent.purpose + " (" + StageToString(traj.stage) + ")##" + traj.id;
+            if (ImGui::Selectable(label.c_str(), state.ui.activeTrajectoryId == traj.id)) {
+                state.ui.activeTrajectoryId = traj.id;
                 state.ui.showSegmentEditor = true;
             }
             if (ImGui::IsItemHovered()) {
-                ImGui::SetTooltip("Audience: %s\nClaim: %s", 
-                    traj.getIntent().audience.c_str(), 
-                    traj.getIntent().coreClaim.c_str());
+                ImGui::SetTooltip("Audience: %s\nClaim: %s\nSegments: %zu | Revisions: %zu", 
+                    traj.intent.audience.c_str(), 
+                    traj.intent.coreClaim.c_str(),
+                    traj.segmentCount,
+                    traj.revisionCount);
             }
         }
     } else {
@@ -120,7 +127,8 @@ void DrawSegmentEditorPanel(AppState& state) {
     if (!state.ui.showSegmentEditor) return;
     if (state.ui.activeTrajectoryId.empty()) return;
 
-    auto trajPtr = state.services.writingTrajectoryService->getTrajectory(state.ui.activeTrajectoryId);
+    // Live aggregate (identity map): no replay or copy per frame
+    auto trajPtr = state.services.writingTrajectoryService->getLiveTrajectory(state.ui.activeTrajectoryId);
     if (!trajPtr) {
         ImGui::Text("Error loading trajectory.");
         return;